@@ -39,6 +39,12 @@ source_files+=" ${source_folder}/entry.c"
 # -- Clean build
 mkdir -p $build_folder
 
+# NOTE(cmat): wasm-opt (Binaryen) runs the asyncify pass fibers need, see below.
+if ! command -v wasm-opt > /dev/null 2>&1; then
+echo "wasm-opt not found, install Binaryen: fibers need its asyncify pass."
+exit 1
+fi
+
 # ------------------------------------------------------------
 # -- WASM build path
 
@@ -59,11 +65,8 @@ compiler_flags+=" -g"
 else
 compiler_flags+=" -O3"
 
-# TODO(cmat): strlen optimizations are probably significant enough
-# that we want to roll our own strlen
-
 # NOTE(cmat): Clang will insert strlen calls, which calls into the CRT,
-# which we have disabled.
+# which we have disabled. cstring_len (core.c) is our own simd128 strlen.
 
 fi
 
@@ -81,6 +84,7 @@ linker_flags+=" -Wl,--export-table"
 linker_flags+=" -Wl,--lto-O3"
 linker_flags+=" -Wl,-z,stack-size=${wasm_stack_size}"
 linker_flags+=" -Wl,--no-entry"
+linker_flags+=" -Wl,--export=__stack_pointer"
 linker_flags+=" -Wl,-allow-undefined"
 linker_flags+=" -o alice_canvas.wasm"
 
@@ -99,6 +103,19 @@ pushd build > /dev/null 2>&1
 echo "compiler flags: ${compiler_flags}"
 $compiler_exec $source_files $define_flags $include_folders $compiler_flags $linker_flags
 
+# NOTE(cmat): Fibers on WASM unwind / rewind the stack through Binaryen's asyncify pass,
+# only js_co_fiber_switch can suspend. The app's loaders run on fibers from the first frame.
+wasm_opt_flags="--asyncify --pass-arg=asyncify-imports@env.js_co_fiber_switch"
+wasm_opt_flags+=" --enable-simd --enable-bulk-memory --enable-mutable-globals --enable-sign-ext --enable-nontrapping-float-to-int"
+
+if [[ -n ${debug-} ]]; then
+wasm_opt_flags+=" -g"
+else
+wasm_opt_flags+=" -O2"
+fi
+
+wasm-opt alice_canvas.wasm $wasm_opt_flags -o alice_canvas.wasm
+
 popd > /dev/null 2>&1
 
 echo "build successful!"
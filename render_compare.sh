@@ -0,0 +1,34 @@
+#!/bin/bash
+# (C) Copyright 2025 Matyas Constans
+# Licensed under the MIT License (https://opensource.org/license/mit/)
+
+# NOTE(cmat): Renders the render_compare.c scenes on the software backend, then on OpenGL 4.5
+# - through a surfaceless EGL pbuffer, and compares the two. Frames are written as PPM images
+# - to build/render_compare/{software,opengl4}. Needs Mesa (EGL_MESA_platform_surfaceless),
+# - llvmpipe is enough, no display server.
+
+# NOTE(cmat): Exit on error.
+set -eu
+
+# NOTE(cmat): Set working directory to the render_compare.sh folder.
+cd "$(dirname "$0")"
+
+source_folder=$(realpath "./src")
+build_folder="build"
+
+compiler_flags="-std=c23 -O1 -g -I${source_folder}"
+define_flags="-DBUILD_DEBUG=1 -DBUILD_ASSERT=1"
+
+mkdir -p $build_folder
+pushd $build_folder > /dev/null 2>&1
+
+echo "compiling render compare..."
+clang ${source_folder}/render/render_compare.c $compiler_flags $define_flags -DBUILD_RENDER_SOFTWARE=1 -lm -lpthread -o render_compare_software
+clang ${source_folder}/render/render_compare.c $compiler_flags $define_flags -lEGL -lGL -lX11 -lm -lpthread -o render_compare_opengl4
+
+./render_compare_software
+./render_compare_opengl4
+
+popd > /dev/null 2>&1
+
+echo "render compare successful!"
@@ -271,23 +271,1470 @@ fn_internal void arena_temp_end(Arena_Temp *temporary) {
   }
 }
 
-thread_local struct {
-  Arena scratch_1;
-  Arena scratch_2;
-} Scratch_Thread;
+thread_local Thread_Context Thread_Context_Current = { };
 
 fn_internal Arena *scratch_get_for_thread(Arena *conflict) {
-  Arena *scratch = &Scratch_Thread.scratch_1;
-  If_Unlikely(conflict == &Scratch_Thread.scratch_1) {
-    scratch = &Scratch_Thread.scratch_2;
+  Arena *scratch = &Thread_Context_Current.scratch_1;
+  If_Unlikely(conflict == &Thread_Context_Current.scratch_1) {
+    scratch = &Thread_Context_Current.scratch_2;
   }
   
   return scratch;
 }
 
-fn_internal void scratch_init_for_thread(void) {
-  arena_init(&Scratch_Thread.scratch_1);
-  arena_init(&Scratch_Thread.scratch_2);
+// ------------------------------------------------------------
+// #-- Thread Context
+
+// NOTE(cmat): co_entry_point initializes the main thread first, so it gets index 0.
+var_global volatile U32 Thread_Context_Count = 0;
+
+fn_internal void thread_context_init(Str name) {
+  Thread_Context *context = &Thread_Context_Current;
+  context->index = atomic_increment_u32(&Thread_Context_Count) - 1;
+  context->name  = name;
+  arena_init(&context->scratch_1);
+  arena_init(&context->scratch_2);
+}
+
+fn_internal void thread_context_release(void) {
+  Thread_Context *context = &Thread_Context_Current;
+  arena_destroy(&context->scratch_1);
+  arena_destroy(&context->scratch_2);
+  zero_fill(context);
+}
+
+fn_internal Thread_Context *thread_context(void) {
+  return &Thread_Context_Current;
+}
+
+// NOTE(cmat): Launch records outlive the launching call, so they come from a global arena
+// - and get recycled through a free list once the thread is joined.
+typedef struct Thread_Launch {
+  struct Thread_Launch *next;
+  U08                   name_buffer[64];
+  Str                   name;
+  Thread_Proc          *proc;
+  void                 *user_data;
+} Thread_Launch;
+
+var_global struct {
+  Mutex          mutex;
+  Arena          arena;
+  Thread_Launch *free_list;
+  Thread_Launch *slots[CO_Thread_Max];
+} Thread_Launcher = { };
+
+fn_internal void thread_launch_entry(void *user_data) {
+  Thread_Launch *launch = (Thread_Launch *)user_data;
+
+  thread_context_init(launch->name);
+  co_thread_set_name(launch->name);
+
+  launch->proc(launch->user_data);
+
+  thread_context_release();
+}
+
+fn_internal CO_Thread thread_launch(Str name, Thread_Proc *proc, void *user_data) {
+  Thread_Launch *launch = 0;
+  Mutex_Scope(&Thread_Launcher.mutex) {
+    if (!Thread_Launcher.arena.flags) {
+      arena_init(&Thread_Launcher.arena);
+    }
+
+    launch = Thread_Launcher.free_list;
+    if (launch) {
+      Thread_Launcher.free_list = launch->next;
+    } else {
+      launch = arena_push_type(&Thread_Launcher.arena, Thread_Launch);
+    }
+  }
+
+  U64 name_len = u64_min(name.len, sizeof(launch->name_buffer));
+  memory_copy(launch->name_buffer, name.txt, name_len);
+
+  launch->next      = 0;
+  launch->name      = str(name_len, launch->name_buffer);
+  launch->proc      = proc;
+  launch->user_data = user_data;
+
+  CO_Thread result = co_thread_create(thread_launch_entry, launch);
+  if (result.slot) {
+    Mutex_Scope(&Thread_Launcher.mutex) {
+      Thread_Launcher.slots[result.slot - 1] = launch;
+    }
+  }
+
+  return result;
+}
+
+// NOTE(cmat): The launch record leaves its slot before co_thread_join, which frees the slot
+// - for the next thread_launch. It goes on the free list once the thread is done with it.
+fn_internal void thread_join(CO_Thread *thread) {
+  U32            slot   = thread->slot;
+  Thread_Launch *launch = 0;
+
+  if (slot) {
+    Mutex_Scope(&Thread_Launcher.mutex) {
+      launch                          = Thread_Launcher.slots[slot - 1];
+      Thread_Launcher.slots[slot - 1] = 0;
+    }
+  }
+
+  co_thread_join(thread);
+
+  if (launch) {
+    Mutex_Scope(&Thread_Launcher.mutex) {
+      launch->next              = Thread_Launcher.free_list;
+      Thread_Launcher.free_list = launch;
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Concurrent Queues
+
+// NOTE(cmat): How many times a blocking call retries before going to sleep on the futex.
+// - Handoffs between busy threads usually complete well within this window.
+enum {
+  Queue_Spin_Count = 64,
+};
+
+fn_internal U32 queue_capacity_pow2(U32 capacity) {
+  Assert(capacity && capacity <= (1u << 31), "invalid queue capacity");
+  return capacity <= 1 ? 1 : 1u << (32 - u32_count_leading_zeros(capacity - 1));
+}
+
+fn_internal void spsc_queue_init(SPSC_Queue *queue, Arena *arena, U32 capacity, U32 element_bytes) {
+  capacity = queue_capacity_pow2(capacity);
+
+  zero_fill(queue);
+  queue->mask          = capacity - 1;
+  queue->element_bytes = element_bytes;
+  queue->buffer        = arena_push_size(arena, (U64)capacity * element_bytes, .align = Cache_Line_Bytes, .flags = 0);
+}
+
+fn_internal B32 spsc_queue_push(SPSC_Queue *queue, void *element) {
+  U32 tail = queue->tail;
+  if (tail - queue->head_cached > queue->mask) {
+    queue->head_cached = atomic_read_u32(&queue->head);
+    if (tail - queue->head_cached > queue->mask) {
+      return 0;
+    }
+  }
+
+  memory_copy(queue->buffer + (U64)(tail & queue->mask) * queue->element_bytes, element, queue->element_bytes);
+  atomic_write_u32(&queue->tail, tail + 1);
+
+  if (atomic_read_u32(&queue->sleepers)) {
+    co_futex_wake(&queue->tail, u32_limit_max);
+  }
+
+  return 1;
+}
+
+fn_internal B32 spsc_queue_pop(SPSC_Queue *queue, void *element) {
+  U32 head = queue->head;
+  if (head == queue->tail_cached) {
+    queue->tail_cached = atomic_read_u32(&queue->tail);
+    if (head == queue->tail_cached) {
+      return 0;
+    }
+  }
+
+  memory_copy(element, queue->buffer + (U64)(head & queue->mask) * queue->element_bytes, queue->element_bytes);
+  atomic_write_u32(&queue->head, head + 1);
+
+  if (atomic_read_u32(&queue->sleepers)) {
+    co_futex_wake(&queue->head, u32_limit_max);
+  }
+
+  return 1;
+}
+
+// NOTE(cmat): Blocking side registers as a sleeper, then re-checks before waiting, so a
+// - push / pop landing in between either is seen by the re-check or sees the sleeper and wakes.
+fn_internal void spsc_queue_push_wait(SPSC_Queue *queue, void *element) {
+  For_U32(it, Queue_Spin_Count) {
+    if (spsc_queue_push(queue, element)) return;
+    spinlock_pause;
+  }
+
+  for (;;) {
+    atomic_increment_u32(&queue->sleepers);
+    U32 head = atomic_read_u32(&queue->head);
+    B32 pushed = spsc_queue_push(queue, element);
+    if (!pushed) {
+      co_futex_wait(&queue->head, head);
+    }
+    atomic_decrement_u32(&queue->sleepers);
+    if (pushed) return;
+  }
+}
+
+fn_internal void spsc_queue_pop_wait(SPSC_Queue *queue, void *element) {
+  For_U32(it, Queue_Spin_Count) {
+    if (spsc_queue_pop(queue, element)) return;
+    spinlock_pause;
+  }
+
+  for (;;) {
+    atomic_increment_u32(&queue->sleepers);
+    U32 tail = atomic_read_u32(&queue->tail);
+    B32 popped = spsc_queue_pop(queue, element);
+    if (!popped) {
+      co_futex_wait(&queue->tail, tail);
+    }
+    atomic_decrement_u32(&queue->sleepers);
+    if (popped) return;
+  }
+}
+
+// NOTE(cmat): Cell layout is a U32 sequence followed by the element, padded to 8 bytes.
+// - A cell at position p is free for the producer claiming p when sequence == p,
+// - and holds data for the consumer claiming p when sequence == p + 1.
+fn_internal void mpmc_queue_init(MPMC_Queue *queue, Arena *arena, U32 capacity, U32 element_bytes) {
+  capacity = queue_capacity_pow2(capacity);
+
+  zero_fill(queue);
+  queue->mask          = capacity - 1;
+  queue->element_bytes = element_bytes;
+  queue->cell_bytes    = (U32)address_align(sizeof(U32) + element_bytes, 8);
+  queue->cells         = arena_push_size(arena, (U64)capacity * queue->cell_bytes, .align = Cache_Line_Bytes, .flags = 0);
+
+  For_U32(it, capacity) {
+    *(U32 *)(queue->cells + (U64)it * queue->cell_bytes) = it;
+  }
+}
+
+force_inline fn_internal volatile U32 *mpmc_queue_cell(MPMC_Queue *queue, U32 position) {
+  return (volatile U32 *)(queue->cells + (U64)(position & queue->mask) * queue->cell_bytes);
+}
+
+fn_internal B32 mpmc_queue_push(MPMC_Queue *queue, void *element) {
+  volatile U32 *cell = 0;
+  U32 position = atomic_read_u32(&queue->enqueue_at);
+  for (;;) {
+    cell = mpmc_queue_cell(queue, position);
+    I32 delta = (I32)(atomic_read_u32(cell) - position);
+    if (delta == 0) {
+      if (atomic_compare_exchange_u32(&queue->enqueue_at, position, position + 1)) break;
+    } else if (delta < 0) {
+      return 0;
+    }
+
+    position = atomic_read_u32(&queue->enqueue_at);
+  }
+
+  memory_copy((U08 *)cell + sizeof(U32), element, queue->element_bytes);
+  atomic_write_u32(cell, position + 1);
+  atomic_increment_u32(&queue->published);
+
+  if (atomic_read_u32(&queue->sleepers_pop)) {
+    co_futex_wake(&queue->published, u32_limit_max);
+  }
+
+  return 1;
+}
+
+fn_internal B32 mpmc_queue_pop(MPMC_Queue *queue, void *element) {
+  volatile U32 *cell = 0;
+  U32 position = atomic_read_u32(&queue->dequeue_at);
+  for (;;) {
+    cell = mpmc_queue_cell(queue, position);
+    I32 delta = (I32)(atomic_read_u32(cell) - (position + 1));
+    if (delta == 0) {
+      if (atomic_compare_exchange_u32(&queue->dequeue_at, position, position + 1)) break;
+    } else if (delta < 0) {
+      return 0;
+    }
+
+    position = atomic_read_u32(&queue->dequeue_at);
+  }
+
+  memory_copy(element, (U08 *)cell + sizeof(U32), queue->element_bytes);
+  atomic_write_u32(cell, position + queue->mask + 1);
+  atomic_increment_u32(&queue->released);
+
+  if (atomic_read_u32(&queue->sleepers_push)) {
+    co_futex_wake(&queue->released, u32_limit_max);
+  }
+
+  return 1;
+}
+
+fn_internal void mpmc_queue_push_wait(MPMC_Queue *queue, void *element) {
+  For_U32(it, Queue_Spin_Count) {
+    if (mpmc_queue_push(queue, element)) return;
+    spinlock_pause;
+  }
+
+  for (;;) {
+    atomic_increment_u32(&queue->sleepers_push);
+    U32 released = atomic_read_u32(&queue->released);
+    B32 pushed = mpmc_queue_push(queue, element);
+    if (!pushed) {
+      co_futex_wait(&queue->released, released);
+    }
+    atomic_decrement_u32(&queue->sleepers_push);
+    if (pushed) return;
+  }
+}
+
+fn_internal void mpmc_queue_pop_wait(MPMC_Queue *queue, void *element) {
+  For_U32(it, Queue_Spin_Count) {
+    if (mpmc_queue_pop(queue, element)) return;
+    spinlock_pause;
+  }
+
+  for (;;) {
+    atomic_increment_u32(&queue->sleepers_pop);
+    U32 published = atomic_read_u32(&queue->published);
+    B32 popped = mpmc_queue_pop(queue, element);
+    if (!popped) {
+      co_futex_wait(&queue->published, published);
+    }
+    atomic_decrement_u32(&queue->sleepers_pop);
+    if (popped) return;
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Ring Buffer
+
+fn_internal void ring_buffer_init(Ring_Buffer *ring, U64 capacity, Ring_Buffer_Flag flags) {
+  Assert(capacity > 0, "ring buffer without capacity");
+
+  zero_fill(ring);
+  ring->capacity = address_align(capacity, co_context()->mmu_page_bytes);
+
+  if (!(flags & Ring_Buffer_Flag_Copy)) {
+    ring->base     = co_memory_map_mirrored(ring->capacity);
+    ring->mirrored = ring->base != 0;
+  }
+
+  if (!ring->mirrored) {
+    ring->base = co_memory_reserve(2 * ring->capacity);
+    co_memory_commit(ring->base, 2 * ring->capacity, CO_Commit_Flag_Read | CO_Commit_Flag_Write);
+  }
+}
+
+fn_internal void ring_buffer_destroy(Ring_Buffer *ring) {
+  if (ring->mirrored) {
+    co_memory_unmap_mirrored(ring->base, ring->capacity);
+  } else {
+    co_memory_unreserve(ring->base, 2 * ring->capacity);
+  }
+
+  zero_fill(ring);
+}
+
+fn_internal U08 *ring_buffer_write_begin(Ring_Buffer *ring, U64 bytes) {
+  U64 write_at = ring->write_at;
+  if (write_at + bytes - ring->read_cached > ring->capacity) {
+    ring->read_cached = atomic_read_u64(&ring->read_at);
+    if (write_at + bytes - ring->read_cached > ring->capacity) {
+      return 0;
+    }
+  }
+
+  return ring->base + write_at % ring->capacity;
+}
+
+fn_internal void ring_buffer_write_end(Ring_Buffer *ring, U64 bytes) {
+  U64 write_at = ring->write_at;
+  Assert(write_at + bytes - ring->read_cached <= ring->capacity, "ring buffer write past write_begin");
+
+  // NOTE(cmat): Copying fallback, bytes that landed in the lower half are copied up, bytes
+  // - that ran past the end into the upper half are copied down.
+  if (!ring->mirrored && bytes) {
+    U64 offset = write_at % ring->capacity;
+    U64 lower  = u64_min(bytes, ring->capacity - offset);
+
+    memory_copy(ring->base + ring->capacity + offset, ring->base + offset, lower);
+    memory_copy(ring->base, ring->base + ring->capacity, bytes - lower);
+  }
+
+  atomic_write_u64(&ring->write_at, write_at + bytes);
+}
+
+fn_internal U08 *ring_buffer_read_begin(Ring_Buffer *ring, U64 *bytes) {
+  U64 read_at = ring->read_at;
+  ring->write_cached = atomic_read_u64(&ring->write_at);
+
+  *bytes = ring->write_cached - read_at;
+  return ring->base + read_at % ring->capacity;
+}
+
+fn_internal void ring_buffer_read_end(Ring_Buffer *ring, U64 bytes) {
+  U64 read_at = ring->read_at;
+  Assert(read_at + bytes <= ring->write_cached, "ring buffer read past read_begin");
+  atomic_write_u64(&ring->read_at, read_at + bytes);
+}
+
+fn_internal B32 ring_buffer_write(Ring_Buffer *ring, void *data, U64 bytes) {
+  U08 *span = ring_buffer_write_begin(ring, bytes);
+  if (!span) {
+    return 0;
+  }
+
+  memory_copy(span, data, bytes);
+  ring_buffer_write_end(ring, bytes);
+  return 1;
+}
+
+fn_internal B32 ring_buffer_read(Ring_Buffer *ring, void *data, U64 bytes) {
+  U64  available = 0;
+  U08 *span      = ring_buffer_read_begin(ring, &available);
+  if (available < bytes) {
+    return 0;
+  }
+
+  memory_copy(data, span, bytes);
+  ring_buffer_read_end(ring, bytes);
+  return 1;
+}
+
+// ------------------------------------------------------------
+// #-- Parallel For
+
+typedef struct Parallel_Job {
+  Range_U64             range;
+  U64                   chunk_size;
+  U32                   chunk_count;
+  volatile U32          chunk_next;
+  volatile U32          helpers_pending;
+
+  Parallel_For_Proc    *for_proc;
+  Parallel_Reduce_Proc *reduce_proc;
+  void                 *user_data;
+  U08                  *partials;
+  U64                   partial_stride;
+} Parallel_Job;
+
+var_global struct {
+  Mutex        mutex;
+  volatile U32 initialized;
+  volatile U32 exiting;
+  U32          worker_count;
+  Arena        arena;
+  MPMC_Queue   jobs;
+  CO_Thread    workers[Parallel_Worker_Max];
+} Parallel_Pool = { };
+
+// NOTE(cmat): Set on worker threads, and on the calling thread while it helps with its
+// - own job, so that nested calls stay serial instead of waiting on themselves.
+var_global thread_local B32 Parallel_Inside_Job = 0;
+
+// NOTE(cmat): Set while a thread runs tasks of a graph. The pool's workers are all busy helping
+// - the graph then, so jobs started from a task hand their chunks to the graph's threads instead.
+var_global thread_local Task_Graph *Parallel_Graph = 0;
+
+fn_internal void parallel_job_work(Parallel_Job *job) {
+  for (;;) {
+    U32 chunk = atomic_increment_u32(&job->chunk_next) - 1;
+    if (chunk >= job->chunk_count) {
+      break;
+    }
+
+    Range_U64 range = { };
+    range.min = job->range.min + chunk * job->chunk_size;
+    range.max = u64_min(range.min + job->chunk_size, job->range.max);
+
+    if (job->reduce_proc) {
+      job->reduce_proc(job->user_data, range, job->partials + chunk * job->partial_stride);
+    } else {
+      job->for_proc(job->user_data, range);
+    }
+  }
+}
+
+// NOTE(cmat): Each queued entry is one helper for one job. The job lives on the caller's stack,
+// - the caller doesn't return before every helper has checked out, so the pointer stays valid.
+// - The wake after the last check-out may land after the caller is gone, which is harmless,
+// - every futex wait re-checks its condition. A null entry, pushed by parallel_pool_shutdown
+// - once exiting is set, tells the worker to return.
+fn_internal void parallel_worker_proc(void *user_data) {
+  Parallel_Inside_Job = 1;
+
+  for (;;) {
+    Parallel_Job *job = 0;
+    mpmc_queue_pop_wait(&Parallel_Pool.jobs, &job);
+    if (!job) {
+      Assert(atomic_read_u32(&Parallel_Pool.exiting), "null parallel job outside of shutdown");
+      break;
+    }
+
+    parallel_job_work(job);
+    if (!atomic_decrement_u32(&job->helpers_pending)) {
+      co_futex_wake(&job->helpers_pending, 1);
+    }
+  }
+}
+
+fn_internal void parallel_pool_init(void) {
+  Mutex_Scope(&Parallel_Pool.mutex) {
+    if (!Parallel_Pool.initialized) {
+#if OS_WASM
+      U32 worker_count = 0;
+#else
+      U32 worker_count = (U32)u64_clamp(co_context()->cpu_logical_cores, 1, Parallel_Worker_Max + 1) - 1;
+#endif
+
+      arena_init(&Parallel_Pool.arena);
+      mpmc_queue_init(&Parallel_Pool.jobs, &Parallel_Pool.arena, 4 * Parallel_Worker_Max, sizeof(Parallel_Job *));
+
+      For_U32(it, worker_count) {
+        Parallel_Pool.workers[it] = thread_launch(str_lit("parallel"), parallel_worker_proc, 0);
+      }
+
+      Parallel_Pool.worker_count = worker_count;
+      atomic_write_u32(&Parallel_Pool.initialized, 1);
+    }
+  }
+}
+
+fn_internal void parallel_pool_shutdown(void) {
+  Assert(!Parallel_Inside_Job && !Parallel_Graph, "parallel_pool_shutdown called from a job or task");
+
+  Mutex_Scope(&Parallel_Pool.mutex) {
+    if (Parallel_Pool.initialized) {
+      atomic_write_u32(&Parallel_Pool.exiting, 1);
+
+      Parallel_Job *exit_entry = 0;
+      For_U32(it, Parallel_Pool.worker_count) {
+        mpmc_queue_push_wait(&Parallel_Pool.jobs, &exit_entry);
+      }
+
+      For_U32(it, Parallel_Pool.worker_count) {
+        thread_join(&Parallel_Pool.workers[it]);
+      }
+
+      arena_destroy(&Parallel_Pool.arena);
+      zero_fill(&Parallel_Pool.jobs);
+      Parallel_Pool.worker_count = 0;
+
+      atomic_write_u32(&Parallel_Pool.exiting,     0);
+      atomic_write_u32(&Parallel_Pool.initialized, 0);
+    }
+  }
+}
+
+fn_internal U32 parallel_thread_count(void) {
+  If_Unlikely(!atomic_read_u32(&Parallel_Pool.initialized)) {
+    parallel_pool_init();
+  }
+
+  return Parallel_Pool.worker_count + 1;
+}
+
+fn_internal void parallel_job_prepare(Parallel_Job *job, Range_U64 range, U64 grain) {
+  U64 count   = range.max > range.min ? range.max - range.min : 0;
+  U32 threads = 1;
+  if (!Parallel_Inside_Job) {
+    threads = Parallel_Graph ? Parallel_Graph->helper_count + 1 : parallel_thread_count();
+  }
+
+  grain = u64_max(grain, 1);
+
+  U64 chunk_count = u64_min((count + grain - 1) / grain, (U64)threads * Parallel_Chunks_Per_Thread);
+  U64 chunk_size  = chunk_count ? (count + chunk_count - 1) / chunk_count : 0;
+
+  job->range       = range;
+  job->chunk_size  = chunk_size;
+  job->chunk_count = chunk_size ? (U32)((count + chunk_size - 1) / chunk_size) : 0;
+}
+
+fn_internal void parallel_job_launch(Parallel_Job *job, U32 helper_count) {
+  job->chunk_next      = 0;
+  job->helpers_pending = helper_count;
+  For_U32(it, helper_count) {
+    mpmc_queue_push_wait(&Parallel_Pool.jobs, &job);
+  }
+}
+
+fn_internal void parallel_job_wait(Parallel_Job *job) {
+  for (;;) {
+    U32 pending = atomic_read_u32(&job->helpers_pending);
+    if (!pending) {
+      break;
+    }
+
+    co_futex_wait(&job->helpers_pending, pending);
+  }
+}
+
+fn_internal void task_graph_job_execute(Task_Graph *graph, Parallel_Job *job);
+
+fn_internal void parallel_job_execute(Parallel_Job *job) {
+  if (!Parallel_Inside_Job && Parallel_Graph) {
+    task_graph_job_execute(Parallel_Graph, job);
+    return;
+  }
+
+  U32 helper_count = 0;
+  if (!Parallel_Inside_Job && job->chunk_count > 1) {
+    helper_count = u32_min(Parallel_Pool.worker_count, job->chunk_count - 1);
+  }
+
+  parallel_job_launch(job, helper_count);
+
+  B32 inside_job      = Parallel_Inside_Job;
+  Parallel_Inside_Job = 1;
+  parallel_job_work(job);
+  Parallel_Inside_Job = inside_job;
+
+  parallel_job_wait(job);
+}
+
+fn_internal void parallel_for(Range_U64 range, U64 grain, Parallel_For_Proc *proc, void *user_data) {
+  Parallel_Job job = { };
+  job.for_proc  = proc;
+  job.user_data = user_data;
+
+  parallel_job_prepare(&job, range, grain);
+  parallel_job_execute(&job);
+}
+
+fn_internal void parallel_reduce(Range_U64 range, U64 grain, Parallel_Reduce_Proc *proc, Parallel_Combine_Proc *combine, void *user_data, void *result, U64 result_bytes) {
+  Parallel_Job job = { };
+  job.reduce_proc    = proc;
+  job.user_data      = user_data;
+  job.partial_stride = address_align(result_bytes, 16);
+
+  parallel_job_prepare(&job, range, grain);
+  if (!job.chunk_count) {
+    return;
+  }
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    job.partials = arena_push_size(scratch.arena, job.chunk_count * job.partial_stride, .align = 16, .flags = 0);
+    For_U32(it, job.chunk_count) {
+      memory_copy(job.partials + it * job.partial_stride, result, result_bytes);
+    }
+
+    parallel_job_execute(&job);
+
+    For_U32(it, job.chunk_count) {
+      combine(user_data, result, job.partials + it * job.partial_stride);
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Radix Sort
+
+typedef struct Radix_Sort_Job {
+  U08 *src;
+  U08 *dst;
+  U64  count;
+  U32  element_bytes;
+  U32  key_bytes;
+  U32  shift;
+  U32  mask;
+  U32  radix;
+  U32  block_count;
+  U64  block_size;
+  U32 *histograms;
+} Radix_Sort_Job;
+
+force_inline fn_internal U32 radix_digit(U08 *element, U32 key_bytes, U32 shift, U32 mask) {
+  U64 key = (key_bytes == 8) ? *(U64 *)element : *(U32 *)element;
+  return (U32)(key >> shift) & mask;
+}
+
+fn_internal U32 radix_digit_bits(U64 count) {
+  return (count < Radix_Sort_Wide_Count) ? 8 : 11;
+}
+
+force_inline fn_internal void radix_sort_core(U08 *data, U08 *temp, U64 count, U32 element_bytes, U32 key_bytes, U32 *histograms) {
+  U32 digit_bits = radix_digit_bits(count);
+  U32 pass_count = (8 * key_bytes + digit_bits - 1) / digit_bits;
+  U32 radix      = 1u << digit_bits;
+  U32 mask       = radix - 1;
+
+  // NOTE(cmat): One read to count every pass's histogram.
+  For_U64 (it, count) {
+    U08 *element = data + it * element_bytes;
+    For_U32 (pass, pass_count) {
+      histograms[pass * radix + radix_digit(element, key_bytes, pass * digit_bits, mask)] += 1;
+    }
+  }
+
+  U08 *src = data;
+  U08 *dst = temp;
+  For_U32 (pass, pass_count) {
+    U32 *histogram = histograms + pass * radix;
+    U32  shift     = pass * digit_bits;
+
+    if (histogram[radix_digit(src, key_bytes, shift, mask)] == count) {
+      continue;
+    }
+
+    U32 sum = 0;
+    For_U32 (digit, radix) {
+      U32 digit_count  = histogram[digit];
+      histogram[digit] = sum;
+      sum             += digit_count;
+    }
+
+    For_U64 (it, count) {
+      U08 *element = src + it * element_bytes;
+      U32  digit   = radix_digit(element, key_bytes, shift, mask);
+      memory_copy(dst + (U64)histogram[digit]++ * element_bytes, element, element_bytes);
+    }
+
+    U08 *swap = src;
+    src       = dst;
+    dst       = swap;
+  }
+
+  if (src != data) {
+    memory_copy(data, src, count * element_bytes);
+  }
+}
+
+force_inline fn_internal void radix_sort_block_count(Radix_Sort_Job *job, U64 block, U32 element_bytes, U32 key_bytes) {
+  U32 *histogram = job->histograms + block * job->radix;
+  U64  begin     = block * job->block_size;
+  U64  end       = u64_min(begin + job->block_size, job->count);
+
+  memory_fill(histogram, 0, job->radix * sizeof(U32));
+  For_U64_Range (it, begin, end) {
+    histogram[radix_digit(job->src + it * element_bytes, key_bytes, job->shift, job->mask)] += 1;
+  }
+}
+
+force_inline fn_internal void radix_sort_block_scatter(Radix_Sort_Job *job, U64 block, U32 element_bytes, U32 key_bytes) {
+  U32 *offsets = job->histograms + block * job->radix;
+  U64  begin   = block * job->block_size;
+  U64  end     = u64_min(begin + job->block_size, job->count);
+
+  For_U64_Range (it, begin, end) {
+    U08 *element = job->src + it * element_bytes;
+    U32  digit   = radix_digit(element, key_bytes, job->shift, job->mask);
+    memory_copy(job->dst + (U64)offsets[digit]++ * element_bytes, element, element_bytes);
+  }
+}
+
+// NOTE(cmat): Element / key sizes are dispatched once per block, so the inner loops
+// - above get compiled with constant sizes.
+#define Radix_Sort_Dispatch(job_, proc_, block_)                                  \
+  switch ((job_)->element_bytes * 16 + (job_)->key_bytes) {                       \
+    case  4 * 16 + 4: proc_((job_), (block_),  4, 4); break;                      \
+    case  8 * 16 + 4: proc_((job_), (block_),  8, 4); break;                      \
+    case  8 * 16 + 8: proc_((job_), (block_),  8, 8); break;                      \
+    case 16 * 16 + 8: proc_((job_), (block_), 16, 8); break;                      \
+    default: Assert(0, "unsupported radix sort element"); break;                  \
+  }
+
+fn_internal void radix_sort_count_proc(void *user_data, Range_U64 range) {
+  Radix_Sort_Job *job = (Radix_Sort_Job *)user_data;
+  For_U64_Range (block, range.min, range.max) {
+    Radix_Sort_Dispatch(job, radix_sort_block_count, block);
+  }
+}
+
+fn_internal void radix_sort_scatter_proc(void *user_data, Range_U64 range) {
+  Radix_Sort_Job *job = (Radix_Sort_Job *)user_data;
+  For_U64_Range (block, range.min, range.max) {
+    Radix_Sort_Dispatch(job, radix_sort_block_scatter, block);
+  }
+}
+
+fn_internal void radix_sort_parallel(Arena *arena, U08 *data, U64 count, U32 element_bytes, U32 key_bytes) {
+  Radix_Sort_Job job = { };
+  job.count          = count;
+  job.element_bytes  = element_bytes;
+  job.key_bytes      = key_bytes;
+  job.block_count    = parallel_thread_count();
+  job.block_size     = (count + job.block_count - 1) / job.block_count;
+
+  U32 digit_bits = 11;
+  U32 pass_count = (8 * key_bytes + digit_bits - 1) / digit_bits;
+  job.radix      = 1u << digit_bits;
+  job.mask       = job.radix - 1;
+
+  U08 *temp      = arena_push_size(arena, count * element_bytes, .align = 64, .flags = 0);
+  job.histograms = arena_push_count(arena, U32, job.block_count * job.radix, .align = 64, .flags = 0);
+
+  job.src = data;
+  job.dst = temp;
+  For_U32 (pass, pass_count) {
+    job.shift = pass * digit_bits;
+    parallel_for(range_u64(0, job.block_count), 1, radix_sort_count_proc, &job);
+
+    // NOTE(cmat): Each block scatters digit d right after the same digit of the blocks
+    // - before it, which keeps the sort stable.
+    U32 sum  = 0;
+    B32 skip = 0;
+    For_U32 (digit, job.radix) {
+      U32 digit_start = sum;
+      For_U32 (block, job.block_count) {
+        U32 *slot   = job.histograms + block * job.radix + digit;
+        U32  blocks = *slot;
+        *slot       = sum;
+        sum        += blocks;
+      }
+
+      skip |= (sum - digit_start) == count;
+    }
+
+    if (skip) {
+      continue;
+    }
+
+    parallel_for(range_u64(0, job.block_count), 1, radix_sort_scatter_proc, &job);
+
+    U08 *swap = job.src;
+    job.src   = job.dst;
+    job.dst   = swap;
+  }
+
+  if (job.src != data) {
+    memory_copy(data, job.src, count * element_bytes);
+  }
+}
+
+fn_internal void radix_sort_serial(Arena *arena, U08 *data, U64 count, U32 element_bytes, U32 key_bytes) {
+  U32 digit_bits = radix_digit_bits(count);
+  U32 pass_count = (8 * key_bytes + digit_bits - 1) / digit_bits;
+
+  U08 *temp       = arena_push_size(arena, count * element_bytes, .align = 64, .flags = 0);
+  U32 *histograms = arena_push_count(arena, U32, pass_count << digit_bits, .align = 64);
+
+  switch (element_bytes * 16 + key_bytes) {
+    case  4 * 16 + 4: radix_sort_core(data, temp, count,  4, 4, histograms); break;
+    case  8 * 16 + 4: radix_sort_core(data, temp, count,  8, 4, histograms); break;
+    case  8 * 16 + 8: radix_sort_core(data, temp, count,  8, 8, histograms); break;
+    case 16 * 16 + 8: radix_sort_core(data, temp, count, 16, 8, histograms); break;
+    default: Assert(0, "unsupported radix sort element"); break;
+  }
+}
+
+fn_internal void radix_sort(Arena *arena, void *data, U64 count, U32 element_bytes, U32 key_bytes, B32 parallel) {
+  Assert(count <= u32_limit_max, "radix sort count limited to U32");
+  if (count < 2) {
+    return;
+  }
+
+  if (parallel && count >= Radix_Sort_Parallel_Count && parallel_thread_count() > 1) {
+    radix_sort_parallel(arena, (U08 *)data, count, element_bytes, key_bytes);
+  } else {
+    radix_sort_serial(arena, (U08 *)data, count, element_bytes, key_bytes);
+  }
+}
+
+// NOTE(cmat): F32 keys as U32 bits, flipped so that unsigned order matches float order.
+fn_internal void radix_float_flip_proc(void *user_data, Range_U64 range) {
+  Radix_Sort_Job *job = (Radix_Sort_Job *)user_data;
+  For_U64_Range (it, range.min, range.max) {
+    U32 *key  = (U32 *)(job->src + it * job->element_bytes);
+    U32  bits = *key;
+    *key      = bits ^ ((U32)(-(I32)(bits >> 31)) | 0x80000000u);
+  }
+}
+
+fn_internal void radix_float_unflip_proc(void *user_data, Range_U64 range) {
+  Radix_Sort_Job *job = (Radix_Sort_Job *)user_data;
+  For_U64_Range (it, range.min, range.max) {
+    U32 *key  = (U32 *)(job->src + it * job->element_bytes);
+    U32  bits = *key;
+    *key      = bits ^ (((bits >> 31) - 1) | 0x80000000u);
+  }
+}
+
+fn_internal void radix_sort_float(Arena *arena, void *data, U64 count, U32 element_bytes, B32 parallel) {
+  Radix_Sort_Job job   = { .src = (U08 *)data, .element_bytes = element_bytes };
+  Range_U64      range = range_u64(0, count);
+  U64            grain = Radix_Sort_Parallel_Count / 4;
+
+  if (parallel) parallel_for(range, grain, radix_float_flip_proc, &job);
+  else          radix_float_flip_proc(&job, range);
+
+  radix_sort(arena, data, count, element_bytes, 4, parallel);
+
+  if (parallel) parallel_for(range, grain, radix_float_unflip_proc, &job);
+  else          radix_float_unflip_proc(&job, range);
+}
+
+fn_internal void radix_sort_u32                (Arena *arena, U32           *keys,  U64 count) { radix_sort       (arena, keys,  count, sizeof(U32),           sizeof(U32), 0); }
+fn_internal void radix_sort_u64                (Arena *arena, U64           *keys,  U64 count) { radix_sort       (arena, keys,  count, sizeof(U64),           sizeof(U64), 0); }
+fn_internal void radix_sort_f32                (Arena *arena, F32           *keys,  U64 count) { radix_sort_float (arena, keys,  count, sizeof(F32),                        0); }
+fn_internal void radix_sort_pairs_u32          (Arena *arena, Sort_Pair_U32 *pairs, U64 count) { radix_sort       (arena, pairs, count, sizeof(Sort_Pair_U32), sizeof(U32), 0); }
+fn_internal void radix_sort_pairs_u64          (Arena *arena, Sort_Pair_U64 *pairs, U64 count) { radix_sort       (arena, pairs, count, sizeof(Sort_Pair_U64), sizeof(U64), 0); }
+fn_internal void radix_sort_pairs_f32          (Arena *arena, Sort_Pair_F32 *pairs, U64 count) { radix_sort_float (arena, pairs, count, sizeof(Sort_Pair_F32),              0); }
+
+fn_internal void radix_sort_u32_parallel       (Arena *arena, U32           *keys,  U64 count) { radix_sort       (arena, keys,  count, sizeof(U32),           sizeof(U32), 1); }
+fn_internal void radix_sort_u64_parallel       (Arena *arena, U64           *keys,  U64 count) { radix_sort       (arena, keys,  count, sizeof(U64),           sizeof(U64), 1); }
+fn_internal void radix_sort_f32_parallel       (Arena *arena, F32           *keys,  U64 count) { radix_sort_float (arena, keys,  count, sizeof(F32),                        1); }
+fn_internal void radix_sort_pairs_u32_parallel (Arena *arena, Sort_Pair_U32 *pairs, U64 count) { radix_sort       (arena, pairs, count, sizeof(Sort_Pair_U32), sizeof(U32), 1); }
+fn_internal void radix_sort_pairs_u64_parallel (Arena *arena, Sort_Pair_U64 *pairs, U64 count) { radix_sort       (arena, pairs, count, sizeof(Sort_Pair_U64), sizeof(U64), 1); }
+fn_internal void radix_sort_pairs_f32_parallel (Arena *arena, Sort_Pair_F32 *pairs, U64 count) { radix_sort_float (arena, pairs, count, sizeof(Sort_Pair_F32),              1); }
+
+// ------------------------------------------------------------
+// #-- Task Graph
+
+fn_internal void task_graph_begin(Task_Graph *graph, Arena *arena) {
+  zero_fill(graph);
+  graph->arena = arena;
+}
+
+fn_internal Task *task_graph_add(Task_Graph *graph, Str name, Task_Proc *proc, void *user_data, U64 reads, U64 writes, Task_Flag flags) {
+  Task *task = arena_push_type(graph->arena, Task);
+  task->name      = name;
+  task->proc      = proc;
+  task->user_data = user_data;
+  task->flags     = flags;
+  task->reads     = reads;
+  task->writes    = writes;
+
+  // NOTE(cmat): Graphs are a handful of tasks, so the quadratic scan is fine, and it keeps
+  // - redundant (transitive) edges, which cost one extra decrement each.
+  for (Task *it = graph->first; it; it = it->next) {
+    B32 depends = (it->writes & (reads | writes)) || (it->reads & writes);
+    if (depends) {
+      Task_Edge *dependency = arena_push_type(graph->arena, Task_Edge);
+      dependency->task      = it;
+      dependency->next      = task->dependencies;
+      task->dependencies    = dependency;
+      task->dependency_count += 1;
+
+      Task_Edge *dependent = arena_push_type(graph->arena, Task_Edge);
+      dependent->task      = task;
+      dependent->next      = it->dependents;
+      it->dependents       = dependent;
+    }
+  }
+
+  if (graph->last) {
+    graph->last->next = task;
+  } else {
+    graph->first = task;
+  }
+
+  graph->last        = task;
+  graph->task_count += 1;
+
+  return task;
+}
+
+// NOTE(cmat): ready_any carries either a task or one helper's share of a job started from
+// - inside a task. A zeroed entry tells a helper to leave.
+typedef struct Task_Graph_Entry {
+  Task         *task;
+  Parallel_Job *job;
+} Task_Graph_Entry;
+
+// NOTE(cmat): The calling thread and threads waiting on a nested job all sleep on signal,
+// - any of them may be the one that can make progress, so wake them all.
+fn_internal void task_graph_signal(Task_Graph *graph) {
+  atomic_increment_u32(&graph->signal);
+  co_futex_wake(&graph->signal, u32_limit_max);
+}
+
+fn_internal void task_graph_push_ready(Task_Graph *graph, Task *task) {
+  if (task->flags & Task_Flag_Calling_Thread) {
+    mpmc_queue_push_wait(&graph->ready_calling, &task);
+  } else {
+    Task_Graph_Entry entry = { .task = task };
+    mpmc_queue_push_wait(&graph->ready_any, &entry);
+  }
+
+  task_graph_signal(graph);
+}
+
+fn_internal void task_graph_run(Task_Graph *graph, Task *task) {
+  task->thread_index = thread_context()->index;
+  task->start_ns     = co_timer_nanoseconds();
+  task->proc(task->user_data);
+  task->end_ns       = co_timer_nanoseconds();
+
+  for (Task_Edge *it = task->dependents; it; it = it->next) {
+    if (!atomic_decrement_u32(&it->task->dependencies_pending)) {
+      task_graph_push_ready(graph, it->task);
+    }
+  }
+
+  if (!atomic_decrement_u32(&graph->remaining)) {
+    task_graph_signal(graph);
+  }
+}
+
+// NOTE(cmat): The job lives on the stack of the thread that started it, it isn't touched again
+// - once this helper has checked out.
+fn_internal void task_graph_run_entry(Task_Graph *graph, Task_Graph_Entry entry) {
+  if (entry.job) {
+    B32 inside_job      = Parallel_Inside_Job;
+    Parallel_Inside_Job = 1;
+    parallel_job_work(entry.job);
+    Parallel_Inside_Job = inside_job;
+
+    if (!atomic_decrement_u32(&entry.job->helpers_pending)) {
+      task_graph_signal(graph);
+    }
+  } else {
+    task_graph_run(graph, entry.task);
+  }
+}
+
+// NOTE(cmat): Jobs started from a task push one entry per helper into ready_any. While the
+// - starting thread waits for them it keeps draining ready_any, so even with every thread
+// - inside a nested job, the entries they wait on still get taken.
+fn_internal void task_graph_job_execute(Task_Graph *graph, Parallel_Job *job) {
+  U32 helper_count = 0;
+  if (job->chunk_count > 1) {
+    helper_count = u32_min(graph->helper_count, job->chunk_count - 1);
+  }
+
+  job->chunk_next      = 0;
+  job->helpers_pending = helper_count;
+
+  Task_Graph_Entry entry = { .job = job };
+  For_U32(it, helper_count) {
+    mpmc_queue_push_wait(&graph->ready_any, &entry);
+  }
+
+  if (helper_count) {
+    task_graph_signal(graph);
+  }
+
+  Parallel_Inside_Job = 1;
+  parallel_job_work(job);
+  Parallel_Inside_Job = 0;
+
+  for (;;) {
+    U32 signal = atomic_read_u32(&graph->signal);
+    if (!atomic_read_u32(&job->helpers_pending)) {
+      break;
+    }
+
+    Task_Graph_Entry next = { };
+    if (mpmc_queue_pop(&graph->ready_any, &next)) {
+      task_graph_run_entry(graph, next);
+    } else {
+      co_futex_wait(&graph->signal, signal);
+    }
+  }
+}
+
+// NOTE(cmat): Helpers only take from ready_any and leave once they pop a zeroed entry. One per
+// - helper chunk is queued when the last task finishes.
+fn_internal void task_graph_helper(void *user_data, Range_U64 range) {
+  Task_Graph *graph = (Task_Graph *)user_data;
+
+  Task_Graph *outer_graph = Parallel_Graph;
+  B32         inside_job  = Parallel_Inside_Job;
+  Parallel_Graph          = graph;
+  Parallel_Inside_Job     = 0;
+
+  for (;;) {
+    Task_Graph_Entry entry = { };
+    mpmc_queue_pop_wait(&graph->ready_any, &entry);
+    if (!entry.task && !entry.job) {
+      break;
+    }
+
+    task_graph_run_entry(graph, entry);
+  }
+
+  Parallel_Graph      = outer_graph;
+  Parallel_Inside_Job = inside_job;
+}
+
+fn_internal void task_graph_execute(Task_Graph *graph) {
+  graph->start_ns  = co_timer_nanoseconds();
+  graph->remaining = graph->task_count;
+
+  // NOTE(cmat): A graph run from inside a task or job gets no helpers, the pool's workers are
+  // - already taken.
+  U32 helper_count    = (Parallel_Inside_Job || Parallel_Graph) ? 0 : parallel_thread_count() - 1;
+  helper_count        = u32_min(helper_count, graph->task_count);
+  graph->helper_count = helper_count;
+
+  // NOTE(cmat): Every task may have one nested job in flight, each with up to helper_count entries.
+  U32 ready_capacity = graph->task_count * (helper_count + 1) + helper_count + 1;
+  mpmc_queue_init(&graph->ready_any,     graph->arena, ready_capacity,        sizeof(Task_Graph_Entry));
+  mpmc_queue_init(&graph->ready_calling, graph->arena, graph->task_count + 1, sizeof(Task *));
+
+  for (Task *it = graph->first; it; it = it->next) {
+    it->dependencies_pending = it->dependency_count;
+  }
+
+  for (Task *it = graph->first; it; it = it->next) {
+    if (!it->dependency_count) {
+      task_graph_push_ready(graph, it);
+    }
+  }
+
+  Parallel_Job job = { };
+  job.for_proc    = task_graph_helper;
+  job.user_data   = graph;
+  job.range       = range_u64(0, helper_count);
+  job.chunk_size  = 1;
+  job.chunk_count = helper_count;
+  parallel_job_launch(&job, helper_count);
+
+  Task_Graph *outer_graph = Parallel_Graph;
+  Parallel_Graph          = graph;
+
+  for (;;) {
+    U32 signal = atomic_read_u32(&graph->signal);
+    if (!atomic_read_u32(&graph->remaining)) {
+      break;
+    }
+
+    Task             *task  = 0;
+    Task_Graph_Entry  entry = { };
+    if (mpmc_queue_pop(&graph->ready_calling, &task)) {
+      task_graph_run(graph, task);
+    } else if (mpmc_queue_pop(&graph->ready_any, &entry)) {
+      task_graph_run_entry(graph, entry);
+    } else {
+      co_futex_wait(&graph->signal, signal);
+    }
+  }
+
+  Parallel_Graph = outer_graph;
+
+  Task_Graph_Entry done = { };
+  For_U32(it, helper_count) {
+    mpmc_queue_push_wait(&graph->ready_any, &done);
+  }
+
+  parallel_job_wait(&job);
+  graph->end_ns = co_timer_nanoseconds();
+}
+
+// NOTE(cmat): Tasks are added in dependency order, so one forward pass finds the longest
+// - chain by measured duration. Returns its length and marks the tasks on it.
+fn_internal U64 task_graph_critical_path(Task_Graph *graph) {
+  Task *tail = 0;
+  for (Task *it = graph->first; it; it = it->next) {
+    it->path_ns   = 0;
+    it->path_prev = 0;
+    it->critical  = 0;
+
+    for (Task_Edge *dependency = it->dependencies; dependency; dependency = dependency->next) {
+      if (dependency->task->path_ns > it->path_ns) {
+        it->path_ns   = dependency->task->path_ns;
+        it->path_prev = dependency->task;
+      }
+    }
+
+    it->path_ns += it->end_ns - it->start_ns;
+    if (!tail || it->path_ns > tail->path_ns) {
+      tail = it;
+    }
+  }
+
+  for (Task *it = tail; it; it = it->path_prev) {
+    it->critical = 1;
+  }
+
+  return tail ? tail->path_ns : 0;
+}
+
+fn_internal void task_graph_log(Task_Graph *graph) {
+  U64 critical_ns = task_graph_critical_path(graph);
+
+  Log_Zone_Scope("task graph") {
+    log_info("%u tasks, %.3f ms wall, %.3f ms critical path", graph->task_count,
+             1e-6 * (F64)(graph->end_ns - graph->start_ns), 1e-6 * (F64)critical_ns);
+
+    for (Task *it = graph->first; it; it = it->next) {
+      log_info("%c %-20.*s thread %2u, start %8.3f ms, %8.3f ms",
+               it->critical ? '*' : ' ', str_expand(it->name), it->thread_index,
+               1e-6 * (F64)(it->start_ns - graph->start_ns), 1e-6 * (F64)(it->end_ns - it->start_ns));
+    }
+  }
+}
+
+fn_internal Str task_graph_trace(Task_Graph *graph, Arena *arena) {
+  task_graph_critical_path(graph);
+
+  enum { Event_Bytes = 192 };
+
+  U64 capacity = 16;
+  for (Task *it = graph->first; it; it = it->next) {
+    capacity += Event_Bytes + it->name.len;
+  }
+
+  U08 *buffer = arena_push_size(arena, capacity, .flags = 0);
+  U64  at     = 0;
+
+  at += stbsp_snprintf((char *)buffer + at, (I32)(capacity - at), "[");
+  for (Task *it = graph->first; it; it = it->next) {
+    at += stbsp_snprintf((char *)buffer + at, (I32)(capacity - at),
+                         "%s\n{\"name\":\"%.*s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"critical\":%u}}",
+                         it == graph->first ? "" : ",", str_expand(it->name), it->thread_index,
+                         1e-3 * (F64)(it->start_ns - graph->start_ns), 1e-3 * (F64)(it->end_ns - it->start_ns), it->critical);
+  }
+  at += stbsp_snprintf((char *)buffer + at, (I32)(capacity - at), "\n]\n");
+
+  return str(at, buffer);
+}
+
+// ------------------------------------------------------------
+// #-- Fibers
+
+var_global thread_local Fiber_Scheduler *Fiber_Scheduler_Current = 0;
+
+fn_internal void fiber_guard_check(Fiber *fiber) {
+#if OS_WASM
+  For_U64 (it, fiber->guard_bytes) {
+    if (fiber->guard_base[it] != Fiber_Guard_Pattern) {
+      co_panic(str_lit("fiber stack overflow"));
+    }
+  }
+#endif
+}
+
+fn_internal void fiber_scheduler_init(Fiber_Scheduler *scheduler, Arena *arena, U32 fiber_capacity, U64 stack_bytes) {
+  Assert(fiber_capacity > 0, "fiber scheduler without fibers");
+
+  U64 page_bytes = co_context()->mmu_page_bytes;
+  if (!stack_bytes) {
+    stack_bytes = Fiber_Stack_Bytes_Default;
+  }
+
+  zero_fill(scheduler);
+  scheduler->guard_bytes   = page_bytes;
+  scheduler->slot_bytes    = page_bytes + address_align(stack_bytes, page_bytes);
+  scheduler->slot_count    = fiber_capacity;
+  scheduler->reserve_bytes = scheduler->slot_bytes * fiber_capacity;
+  scheduler->reserve_base  = co_memory_reserve(scheduler->reserve_bytes);
+  scheduler->slots         = arena_push_count(arena, Fiber, fiber_capacity);
+
+  // NOTE(cmat): Each slot is [guard page | stack], stacks grow down into their own guard.
+  // - Stack pages are only committed when a fiber is spawned into the slot.
+  For_U32 (it, fiber_capacity) {
+    Fiber *fiber       = scheduler->slots + it;
+    fiber->guard_base  = scheduler->reserve_base + it * scheduler->slot_bytes;
+    fiber->guard_bytes = scheduler->guard_bytes;
+    fiber->next        = scheduler->free;
+    scheduler->free    = fiber;
+  }
+}
+
+fn_internal void fiber_scheduler_destroy(Fiber_Scheduler *scheduler) {
+  Assert(!scheduler->running, "destroying a fiber scheduler from one of its fibers");
+  co_memory_unreserve(scheduler->reserve_base, scheduler->reserve_bytes);
+  zero_fill(scheduler);
+}
+
+fn_internal Fiber *fiber_spawn(Fiber_Scheduler *scheduler, Str name, CO_Fiber_Proc *proc, void *user_data) {
+  Fiber *fiber = scheduler->free;
+  if (!fiber) {
+    co_panic(str_lit("out of fiber slots"));
+  }
+
+  scheduler->free = fiber->next;
+
+  U08 *stack_base  = fiber->guard_base + fiber->guard_bytes;
+  U64  stack_bytes = scheduler->slot_bytes - fiber->guard_bytes;
+  co_memory_commit(stack_base, stack_bytes, CO_Commit_Flag_Read | CO_Commit_Flag_Write);
+
+#if OS_WASM
+  memory_fill(fiber->guard_base, Fiber_Guard_Pattern, fiber->guard_bytes);
+#endif
+
+  co_fiber_init(&fiber->context, stack_base, stack_bytes, proc, user_data);
+  fiber->name = name;
+  fiber->next = 0;
+
+  if (scheduler->last) {
+    scheduler->last->next = fiber;
+  } else {
+    scheduler->first = fiber;
+  }
+
+  scheduler->last = fiber;
+  scheduler->live_count += 1;
+  return fiber;
+}
+
+fn_internal U32 fiber_scheduler_run(Fiber_Scheduler *scheduler) {
+  Assert(!Fiber_Scheduler_Current, "fiber_scheduler_run called from inside a fiber");
+  Fiber_Scheduler_Current = scheduler;
+
+  Fiber *prev  = 0;
+  Fiber *fiber = scheduler->first;
+  while (fiber) {
+    Fiber *next = fiber->next;
+
+    scheduler->running = fiber;
+    co_fiber_switch(&scheduler->root, &fiber->context);
+    scheduler->running = 0;
+
+    fiber_guard_check(fiber);
+
+    if (fiber->context.done) {
+      if (prev) {
+        prev->next = next;
+      } else {
+        scheduler->first = next;
+      }
+
+      if (scheduler->last == fiber) {
+        scheduler->last = prev;
+      }
+
+      // NOTE(cmat): Give the stack pages back, the slot keeps its address range.
+      co_memory_uncommit(fiber->context.stack_base, fiber->context.stack_bytes);
+      fiber->next     = scheduler->free;
+      scheduler->free = fiber;
+      scheduler->live_count -= 1;
+    } else {
+      prev = fiber;
+    }
+
+    fiber = next;
+  }
+
+  Fiber_Scheduler_Current = 0;
+  return scheduler->live_count;
+}
+
+fn_internal void fiber_yield(void) {
+  Fiber_Scheduler *scheduler = Fiber_Scheduler_Current;
+  Assert(scheduler && scheduler->running, "fiber_yield called outside of a fiber");
+  co_fiber_switch(&scheduler->running->context, &scheduler->root);
+}
+
+fn_internal Fiber *fiber_current(void) {
+  Fiber_Scheduler *scheduler = Fiber_Scheduler_Current;
+  return scheduler ? scheduler->running : 0;
+}
+
+// ------------------------------------------------------------
+// #-- String Interning
+
+// NOTE(cmat): Entries live in fixed pages so they never move, and the open-addressed slot
+// - table holds atoms. When the slot table grows, the old one is left in the arena:
+// - a reader racing with the grow either finds its atom in the stale table (entries are
+// - immutable once published), or misses and retries under the mutex.
+#define Atom_Page_Shift 12
+#define Atom_Page_Size  (1u << Atom_Page_Shift)
+#define Atom_Page_Count 1024
+
+typedef struct Atom_Entry {
+  Str string;
+  U64 hash;
+} Atom_Entry;
+
+typedef struct Atom_Slots {
+  U32           capacity;
+  volatile U32 *atoms;
+} Atom_Slots;
+
+var_global struct {
+  Mutex                 mutex;
+  Arena                 arena;
+  volatile U32          count;
+  Atom_Entry           *pages[Atom_Page_Count];
+  Atom_Slots * volatile slots;
+} Atom_Table = { };
+
+force_inline fn_internal Atom_Entry *atom_entry(Str_Atom atom) {
+  return Atom_Table.pages[atom >> Atom_Page_Shift] + (atom & (Atom_Page_Size - 1));
+}
+
+fn_internal Atom_Slots *atom_slots_allocate(U32 capacity) {
+  Atom_Slots *slots = arena_push_type(&Atom_Table.arena, Atom_Slots);
+  slots->capacity   = capacity;
+  slots->atoms      = arena_push_count(&Atom_Table.arena, U32, capacity);
+  return slots;
+}
+
+fn_internal void atom_slots_insert(Atom_Slots *slots, Str_Atom atom, U64 hash) {
+  U32 mask = slots->capacity - 1;
+  U32 it   = (U32)hash & mask;
+  while (slots->atoms[it]) {
+    it = (it + 1) & mask;
+  }
+
+  atomic_write_u32(slots->atoms + it, atom);
+}
+
+fn_internal Str_Atom atom_slots_find(Atom_Slots *slots, Str string, U64 hash) {
+  U32 mask = slots->capacity - 1;
+  for (U32 it = (U32)hash & mask;; it = (it + 1) & mask) {
+    Str_Atom atom = atomic_read_u32(slots->atoms + it);
+    if (!atom) {
+      return 0;
+    }
+
+    Atom_Entry *entry = atom_entry(atom);
+    if (entry->hash == hash && str_equals(entry->string, string)) {
+      return atom;
+    }
+  }
+}
+
+fn_internal void atom_table_init(void) {
+  arena_init(&Atom_Table.arena);
+  Atom_Table.pages[0] = arena_push_count(&Atom_Table.arena, Atom_Entry, Atom_Page_Size);
+  Atom_Table.count    = 1;
+  Atom_Table.slots    = atom_slots_allocate(1024);
+}
+
+fn_internal Str_Atom atom_from_str(Str string) {
+  if (!string.len) {
+    return 0;
+  }
+
+  U64      hash   = str_hash(string);
+  Str_Atom result = atom_slots_find(atomic_read_ptr((void * volatile *)&Atom_Table.slots), string, hash);
+
+  if (!result) {
+    Mutex_Scope(&Atom_Table.mutex) {
+      Atom_Slots *slots = Atom_Table.slots;
+      result = atom_slots_find(slots, string, hash);
+
+      if (!result) {
+        Assert(Atom_Table.count < Atom_Page_Size * Atom_Page_Count, "atom table is full");
+
+        // NOTE(cmat): Keep the load factor at or below 1/2.
+        if (2 * Atom_Table.count >= slots->capacity) {
+          Atom_Slots *grown = atom_slots_allocate(2 * slots->capacity);
+          For_U32_Range(it, 1, Atom_Table.count) {
+            atom_slots_insert(grown, it, atom_entry(it)->hash);
+          }
+
+          atomic_write_ptr((void * volatile *)&Atom_Table.slots, grown);
+          slots = grown;
+        }
+
+        result = Atom_Table.count;
+        if (!Atom_Table.pages[result >> Atom_Page_Shift]) {
+          Atom_Table.pages[result >> Atom_Page_Shift] = arena_push_count(&Atom_Table.arena, Atom_Entry, Atom_Page_Size, .flags = 0);
+        }
+
+        Atom_Entry *entry = atom_entry(result);
+        entry->string     = arena_push_str(&Atom_Table.arena, string);
+        entry->hash       = hash;
+
+        // NOTE(cmat): Publishing the atom in a slot is what makes it visible to lock-free readers,
+        // - so the entry has to be complete before this.
+        atomic_increment_u32(&Atom_Table.count);
+        atom_slots_insert(slots, result, hash);
+      }
+    }
+  }
+
+  return result;
+}
+
+fn_internal Str str_from_atom(Str_Atom atom) {
+  Assert(atom < atomic_read_u32(&Atom_Table.count), "invalid atom");
+  return atom ? atom_entry(atom)->string : (Str) { };
+}
+
+fn_internal U64 atom_hash(Str_Atom atom) {
+  Assert(atom < atomic_read_u32(&Atom_Table.count), "invalid atom");
+  return atom ? atom_entry(atom)->hash : 0;
 }
 
 // ------------------------------------------------------------
@@ -395,6 +1842,11 @@ fn_internal void logger_format_entry_minimal(Logger_Entry *entry, U08 *entry_buf
    }
    
    Assert(buffer_at <= Logger_Max_Entry_Length, "logger buffer overflow");
+
+   // NOTE(cmat): Tag messages coming from anything but the main thread.
+   if (entry->thread_index) {
+     buffer_at += stbsp_snprintf((char *)entry_buffer + buffer_at, Logger_Max_Entry_Length - buffer_at, "[%.*s] ", str_expand(entry->thread_name));
+   }
    
    if (entry->type == Logger_Entry_Zone_Start) {
      stbsp_snprintf((char *)entry_buffer + buffer_at, Logger_Max_Entry_Length - buffer_at, "# %s\n", entry->message);
@@ -434,6 +1886,11 @@ fn_internal void logger_format_entry_detailed(Logger_Entry *entry, U08 *entry_bu
    }
    
    Assert(buffer_at <= Logger_Max_Entry_Length, "logger buffer overflow");
+
+   // NOTE(cmat): Tag messages coming from anything but the main thread.
+   if (entry->thread_index) {
+     buffer_at += stbsp_snprintf((char *)entry_buffer + buffer_at, Logger_Max_Entry_Length - buffer_at, "[%.*s] ", str_expand(entry->thread_name));
+   }
    
    if (entry->type == Logger_Entry_Zone_Start) {
      stbsp_snprintf((char *)entry_buffer + buffer_at, Logger_Max_Entry_Length - buffer_at, "# %s\n", entry->message);
@@ -466,80 +1923,399 @@ fn_internal void logger_write_entry_standard_stream(Logger_Entry_Type type, Str
         co_stream_write(buffer, CO_Stream_Standard_Error);
     } break;
 
-    default: {
-        co_stream_write(buffer, CO_Stream_Standard_Output);
-    } break;
+    default: {
+        co_stream_write(buffer, CO_Stream_Standard_Output);
+    } break;
+  }
+}
+
+fn_internal void log_message_ext(Logger_Entry_Type type, Function_Metadata func_meta, char *format, ...) {
+  if (logger_filter_type(type)) {
+    Logger_Entry entry = { 
+      .type         = type, 
+      .time         = co_local_time(), 
+      .meta         = func_meta,
+      .thread_index = thread_context()->index,
+      .thread_name  = thread_context()->name,
+    }; 
+
+    va_list args;
+    va_start(args, format);
+    entry.message[stbsp_vsnprintf((char *)entry.message, Logger_Max_Entry_Length, format, args)] = 0;
+    va_end(args);
+
+    logger_entry(&entry);
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Color Spaces
+
+fn_internal RGB rgb_from_hsv(HSV hsv) {
+
+  // NOTE(cmat): Compute hue only (assume saturation = 1, value = 1)
+  F32 h_prime = 6.f * hsv.h;
+  V3F hue_rgb = v3f_abs(v3f_sub(v3f_f32(h_prime), v3f(3.f, 2.f, 4.f)));
+  hue_rgb = v3f(hue_rgb.r - 1.f, 2.f - hue_rgb.g, 2.f - hue_rgb.b);
+  hue_rgb = v3f_saturate(hue_rgb);
+
+  // NOTE(cmat): Apply saturation and value.
+  V3F hsv_rgb = v3f_mul(hsv.v, v3f_add(v3f_mul(hsv.s, v3f_sub(hue_rgb, v3f_f32(1.f))), v3f_f32(1.f)));
+  return hsv_rgb; 
+}
+
+fn_internal HSV hsv_from_rgb(RGB rgb) {
+  F32 value  = f32_max(rgb.r, f32_max(rgb.g, rgb.b));
+  F32 chroma = value - f32_min(rgb.r, f32_min(rgb.g, rgb.b));
+
+  F32 hue = 0.f;
+  if (chroma > 0.f) {
+    if (rgb.r >= value) {
+      hue = (rgb.g - rgb.b) / chroma;
+      if (hue < 0.f) hue += 6.f;
+    } else if (rgb.g >= value) {
+      hue = (rgb.b - rgb.r) / chroma + 2.f;
+    } else {
+      hue = (rgb.r - rgb.g) / chroma + 4.f;
+    }
+
+    hue *= 1.f / 6.f;
+  }
+
+  F32 saturation = value > 0.f ? chroma / value : 0.f;
+  return v3f(hue, saturation, value);
+}
+
+fn_internal RGBA rgba_from_hsva(HSVA hsva) {
+  return (RGBA) { .rgb = rgb_from_hsv(hsva.hsv), .a = hsva.a };
+}
+
+fn_internal HSVA hsva_from_rgba(RGBA rgba) {
+  return (HSVA) { .hsv = hsv_from_rgb(rgba.rgb), .a = rgba.a };
+}
+
+force_inline fn_internal U32 color_u08_from_f32(F32 x) {
+  return (U32)(f32_clamp(x, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+fn_internal RGBA_U32 rgba_u32_from_rgba(RGBA rgba) {
+  U32 packed = (color_u08_from_f32(rgba.r) << 24) | (color_u08_from_f32(rgba.g) << 16) | (color_u08_from_f32(rgba.b) <<  8) | (color_u08_from_f32(rgba.a));
+  return packed;
+}
+
+fn_internal RGBA_U32 abgr_u32_from_rgba(RGBA rgba) {
+  U32 packed = (color_u08_from_f32(rgba.a) << 24) | (color_u08_from_f32(rgba.b) << 16) | (color_u08_from_f32(rgba.g) <<  8) | (color_u08_from_f32(rgba.r));
+  return packed;
+}
+
+fn_internal RGBA rgba_from_rgba_u32(RGBA_U32 rgba) {
+  return rbga_u32((rgba >> 24) & 0xFF, (rgba >> 16) & 0xFF, (rgba >> 8) & 0xFF, rgba & 0xFF);
+}
+
+fn_internal RGBA rgba_from_abgr_u32(RGBA_U32 abgr) {
+  return rbga_u32(abgr & 0xFF, (abgr >> 8) & 0xFF, (abgr >> 16) & 0xFF, (abgr >> 24) & 0xFF);
+}
+
+fn_internal RGBA_U32 rgba_u32_from_rgba_premul(RGBA rgba) {
+  return rgba_u32_from_rgba(rgba_premul_from_rgba(rgba));
+}
+
+fn_internal RGBA_U32 abgr_u32_from_rgba_premul(RGBA rgba) {
+  return abgr_u32_from_rgba(rgba_premul_from_rgba(rgba));
+}
+
+fn_internal RGBA rgba_premul_from_rgba(RGBA rgba) {
+  rgba.r *= rgba.a;
+  rgba.g *= rgba.a;
+  rgba.b *= rgba.a;
+  return rgba;
+}
+
+fn_internal RGBA rgba_from_rgba_premul(RGBA rgba) {
+  F32 inverse_alpha = rgba.a > 0.f ? 1.f / rgba.a : 0.f;
+  rgba.r *= inverse_alpha;
+  rgba.g *= inverse_alpha;
+  rgba.b *= inverse_alpha;
+  return rgba;
+}
+
+fn_internal F32 f32_linear_from_srgb(F32 x) {
+  return x <= 0.04045f ? x * (1.f / 12.92f) : f32_pow((x + 0.055f) * (1.f / 1.055f), 2.4f);
+}
+
+fn_internal F32 f32_srgb_from_linear(F32 x) {
+  return x <= 0.0031308f ? x * 12.92f : 1.055f * f32_pow(x, 1.f / 2.4f) - 0.055f;
+}
+
+fn_internal RGB linear_from_srgb(RGB srgb) {
+  return v3f(f32_linear_from_srgb(srgb.r), f32_linear_from_srgb(srgb.g), f32_linear_from_srgb(srgb.b));
+}
+
+fn_internal RGB srgb_from_linear(RGB linear) {
+  return v3f(f32_srgb_from_linear(linear.r), f32_srgb_from_linear(linear.g), f32_srgb_from_linear(linear.b));
+}
+
+// NOTE(cmat): Bulk conversions. Colors are gathered 4 at a time into one F32_X04 per channel,
+// - converted with the same formulas as above, and scattered back. Tails go through the scalar path.
+#if F32_X04_Available
+
+typedef struct Color_X04 {
+  F32_X04 c[4];
+} Color_X04;
+
+force_inline fn_internal Color_X04 color_x04_load(F32 *src, U32 stride, U32 channels) {
+  Color_X04 result = { };
+  For_U32 (lane, 4) {
+    For_U32 (channel, channels) {
+      result.c[channel].data[lane] = src[lane * stride + channel];
+    }
+  }
+
+  return result;
+}
+
+force_inline fn_internal void color_x04_store(Color_X04 *color, F32 *dst, U32 stride, U32 channels) {
+  For_U32 (lane, 4) {
+    For_U32 (channel, channels) {
+      dst[lane * stride + channel] = color->c[channel].data[lane];
+    }
+  }
+}
+
+force_inline fn_internal F32_X04 color_x04_saturate(F32_X04 x) {
+  return f32_x04_min(f32_x04_max(x, f32_x04_load_f32(0.f)), f32_x04_load_f32(1.f));
+}
+
+// NOTE(cmat): log2(x) = e + log2(m). m is folded into [sqrt(1/2), sqrt(2)), then
+// - ln(m) = 2 atanh(z), z = (m - 1) / (m + 1), |z| < 0.172, so the odd series to z^9 is
+// - good to ~1e-9.
+force_inline fn_internal F32_X04 color_x04_log2(F32_X04 x) {
+  F32_X04  one      = f32_x04_load_f32(1.f);
+  F32_X04  exponent = f32_x04_exponent(x);
+  F32_X04  mantissa = f32_x04_mantissa(x);
+  Mask_X04 high     = f32_x04_mask_greater_than_or_equal(mantissa, f32_x04_load_f32(1.41421356f));
+
+  mantissa = f32_x04_blend(f32_x04_mul(mantissa, f32_x04_load_f32(.5f)), mantissa, high);
+  exponent = f32_x04_blend(f32_x04_add(exponent, one), exponent, high);
+
+  F32_X04 z  = f32_x04_div(f32_x04_sub(mantissa, one), f32_x04_add(mantissa, one));
+  F32_X04 z2 = f32_x04_mul(z, z);
+
+  F32_X04 series = f32_x04_load_f32(1.f / 9.f);
+  series = f32_x04_fused_mul_add(series, z2, f32_x04_load_f32(1.f / 7.f));
+  series = f32_x04_fused_mul_add(series, z2, f32_x04_load_f32(1.f / 5.f));
+  series = f32_x04_fused_mul_add(series, z2, f32_x04_load_f32(1.f / 3.f));
+  series = f32_x04_fused_mul_add(series, z2, one);
+
+  // NOTE(cmat): 2 / ln(2).
+  return f32_x04_fused_mul_add(f32_x04_mul(z, series), f32_x04_load_f32(2.88539008f), exponent);
+}
+
+// NOTE(cmat): exp2(y) = 2^n * e^(f ln 2), n = round(y), |f ln 2| <= 0.347, Taylor to the 7th term (~5e-9).
+force_inline fn_internal F32_X04 color_x04_exp2(F32_X04 y) {
+  y = f32_x04_min(f32_x04_max(y, f32_x04_load_f32(-126.f)), f32_x04_load_f32(127.f));
+
+  F32_X04 n = f32_x04_round(y);
+  F32_X04 u = f32_x04_mul(f32_x04_sub(y, n), f32_x04_load_f32(0.693147181f));
+
+  F32_X04 series = f32_x04_load_f32(1.f / 5040.f);
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f / 720.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f / 120.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f / 24.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f / 6.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f / 2.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f));
+  series = f32_x04_fused_mul_add(series, u, f32_x04_load_f32(1.f));
+
+  return f32_x04_mul(series, f32_x04_exp2_integer(n));
+}
+
+force_inline fn_internal F32_X04 color_x04_pow(F32_X04 x, F32 power) {
+  return color_x04_exp2(f32_x04_mul(color_x04_log2(x), f32_x04_load_f32(power)));
+}
+
+force_inline fn_internal F32_X04 color_x04_linear_from_srgb(F32_X04 x) {
+  F32_X04  curve  = color_x04_pow(f32_x04_mul(f32_x04_add(x, f32_x04_load_f32(0.055f)), f32_x04_load_f32(1.f / 1.055f)), 2.4f);
+  F32_X04  linear = f32_x04_mul(x, f32_x04_load_f32(1.f / 12.92f));
+  Mask_X04 upper  = f32_x04_mask_greater_than_or_equal(f32_x04_load_f32(0.04045f), x);
+  return f32_x04_blend(linear, curve, upper);
+}
+
+force_inline fn_internal F32_X04 color_x04_srgb_from_linear(F32_X04 x) {
+  F32_X04  curve  = f32_x04_fused_mul_sub(color_x04_pow(x, 1.f / 2.4f), f32_x04_load_f32(1.055f), f32_x04_load_f32(0.055f));
+  F32_X04  linear = f32_x04_mul(x, f32_x04_load_f32(12.92f));
+  Mask_X04 lower  = f32_x04_mask_greater_than_or_equal(f32_x04_load_f32(0.0031308f), x);
+  return f32_x04_blend(linear, curve, lower);
+}
+
+force_inline fn_internal Color_X04 color_x04_rgb_from_hsv(Color_X04 hsv) {
+  F32_X04 one     = f32_x04_load_f32(1.f);
+  F32_X04 two     = f32_x04_load_f32(2.f);
+  F32_X04 h_prime = f32_x04_mul(hsv.c[0], f32_x04_load_f32(6.f));
+
+  F32_X04 hue[3] = {
+    f32_x04_sub(f32_x04_abs(f32_x04_sub(h_prime, f32_x04_load_f32(3.f))), one),
+    f32_x04_sub(two, f32_x04_abs(f32_x04_sub(h_prime, two))),
+    f32_x04_sub(two, f32_x04_abs(f32_x04_sub(h_prime, f32_x04_load_f32(4.f)))),
+  };
+
+  Color_X04 result = { };
+  For_U32 (channel, 3) {
+    F32_X04 saturated = f32_x04_fused_mul_add(hsv.c[1], f32_x04_sub(color_x04_saturate(hue[channel]), one), one);
+    result.c[channel] = f32_x04_mul(hsv.c[2], saturated);
+  }
+
+  return result;
+}
+
+force_inline fn_internal Color_X04 color_x04_hsv_from_rgb(Color_X04 rgb) {
+  F32_X04 zero   = f32_x04_load_f32(0.f);
+  F32_X04 r      = rgb.c[0];
+  F32_X04 g      = rgb.c[1];
+  F32_X04 b      = rgb.c[2];
+  F32_X04 value  = f32_x04_max(r, f32_x04_max(g, b));
+  F32_X04 chroma = f32_x04_sub(value, f32_x04_min(r, f32_x04_min(g, b)));
+
+  Mask_X04 gray  = f32_x04_mask_greater_than_or_equal(zero, chroma);
+  Mask_X04 black = f32_x04_mask_greater_than_or_equal(zero, value);
+  F32_X04  safe  = f32_x04_blend(f32_x04_load_f32(1.f), chroma, gray);
+
+  F32_X04 hue_r = f32_x04_div(f32_x04_sub(g, b), safe);
+  F32_X04 hue_g = f32_x04_add(f32_x04_div(f32_x04_sub(b, r), safe), f32_x04_load_f32(2.f));
+  F32_X04 hue_b = f32_x04_add(f32_x04_div(f32_x04_sub(r, g), safe), f32_x04_load_f32(4.f));
+
+  hue_r = f32_x04_blend(hue_r, f32_x04_add(hue_r, f32_x04_load_f32(6.f)), f32_x04_mask_greater_than_or_equal(hue_r, zero));
+
+  F32_X04 hue = f32_x04_blend(hue_g, hue_b, f32_x04_mask_greater_than_or_equal(g, value));
+  hue         = f32_x04_blend(hue_r, hue, f32_x04_mask_greater_than_or_equal(r, value));
+  hue         = f32_x04_blend(zero, f32_x04_mul(hue, f32_x04_load_f32(1.f / 6.f)), gray);
+
+  Color_X04 result = { };
+  result.c[0] = hue;
+  result.c[1] = f32_x04_blend(zero, f32_x04_div(chroma, f32_x04_blend(f32_x04_load_f32(1.f), value, black)), black);
+  result.c[2] = value;
+  return result;
+}
+
+force_inline fn_internal void color_x04_abgr_u32(Color_X04 *rgba, RGBA_U32 *dst) {
+  For_U32 (channel, 4) {
+    rgba->c[channel] = f32_x04_fused_mul_add(color_x04_saturate(rgba->c[channel]), f32_x04_load_f32(255.f), f32_x04_load_f32(0.5f));
+  }
+
+  For_U32 (lane, 4) {
+    dst[lane] = ((U32)rgba->c[3].data[lane] << 24) | ((U32)rgba->c[2].data[lane] << 16) | ((U32)rgba->c[1].data[lane] << 8) | ((U32)rgba->c[0].data[lane]);
+  }
+}
+
+#endif
+
+fn_internal void rgb_from_hsv_array(U64 count, HSV *src, RGB *dst) {
+  U64 it = 0;
+
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 rgb = color_x04_rgb_from_hsv(color_x04_load(src[it].dat, 3, 3));
+    color_x04_store(&rgb, dst[it].dat, 3, 3);
+  }
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = rgb_from_hsv(src[index]);
   }
 }
 
-fn_internal void log_message_ext(Logger_Entry_Type type, Function_Metadata func_meta, char *format, ...) {
-  if (logger_filter_type(type)) {
-    Logger_Entry entry = { 
-      .type = type, 
-      .time = co_local_time(), 
-      .meta = func_meta,
-    }; 
+fn_internal void hsv_from_rgb_array(U64 count, RGB *src, HSV *dst) {
+  U64 it = 0;
 
-    va_list args;
-    va_start(args, format);
-    entry.message[stbsp_vsnprintf((char *)entry.message, Logger_Max_Entry_Length, format, args)] = 0;
-    va_end(args);
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 hsv = color_x04_hsv_from_rgb(color_x04_load(src[it].dat, 3, 3));
+    color_x04_store(&hsv, dst[it].dat, 3, 3);
+  }
+#endif
 
-    logger_entry(&entry);
+  For_U64_Range (index, it, count) {
+    dst[index] = hsv_from_rgb(src[index]);
   }
 }
 
-// ------------------------------------------------------------
-// #-- Color Spaces
-
-fn_internal RGB rgb_from_hsv(HSV hsv) {
+fn_internal void linear_from_srgb_array(U64 count, RGB *src, RGB *dst) {
+  U64 it = 0;
 
-  // NOTE(cmat): Compute hue only (assume saturation = 1, value = 1)
-  F32 h_prime = 6.f * hsv.h;
-  V3F hue_rgb = v3f_abs(v3f_sub(v3f_f32(h_prime), v3f(3.f, 2.f, 4.f)));
-  hue_rgb = v3f(hue_rgb.r - 1.f, 2.f - hue_rgb.g, 2.f - hue_rgb.b);
-  hue_rgb = v3f_saturate(hue_rgb);
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 color = color_x04_load(src[it].dat, 3, 3);
+    For_U32 (channel, 3) color.c[channel] = color_x04_linear_from_srgb(color.c[channel]);
+    color_x04_store(&color, dst[it].dat, 3, 3);
+  }
+#endif
 
-  // NOTE(cmat): Apply saturation and value.
-  V3F hsv_rgb = v3f_mul(hsv.v, v3f_add(v3f_mul(hsv.s, v3f_sub(hue_rgb, v3f_f32(1.f))), v3f_f32(1.f)));
-  return hsv_rgb; 
+  For_U64_Range (index, it, count) {
+    dst[index] = linear_from_srgb(src[index]);
+  }
 }
 
-fn_internal HSV hsv_from_rgb(RGB rgb) {
-  Not_Implemented;
-  return v3f(0, 0, 0);
-}
+fn_internal void srgb_from_linear_array(U64 count, RGB *src, RGB *dst) {
+  U64 it = 0;
 
-fn_internal RGBA rgba_from_hsva(HSVA hsva) {
-  return (RGBA) { .rgb = rgb_from_hsv(hsva.hsv), .a = hsva.a };
-}
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 color = color_x04_load(src[it].dat, 3, 3);
+    For_U32 (channel, 3) color.c[channel] = color_x04_srgb_from_linear(color.c[channel]);
+    color_x04_store(&color, dst[it].dat, 3, 3);
+  }
+#endif
 
-fn_internal HSVA hsva_from_rgba(RGBA rgba) {
-  return (HSVA) { .hsv = hsv_from_rgb(rgba.rgb), .a = rgba.a };
+  For_U64_Range (index, it, count) {
+    dst[index] = srgb_from_linear(src[index]);
+  }
 }
 
-fn_internal RGBA_U32 rgba_u32_from_rgba(RGBA rgba) {
-  U32 packed = ((U32)(U08)rgba.r << 24) | ((U32)(U08)rgba.g << 16) | ((U32)(U08)rgba.b <<  8) | ((U32)(U08)rgba.a);
-  return packed;
-}
+fn_internal void rgba_premul_from_rgba_array(U64 count, RGBA *src, RGBA *dst) {
+  U64 it = 0;
 
-fn_internal RGBA_U32 abgr_u32_from_rgba(RGBA rgba) {
-  U32 packed = ((U32)(U08)(rgba.a * 255.f) << 24) | ((U32)(U08)(rgba.b * 255.f) << 16) | ((U32)(U08)(rgba.g * 255.f) <<  8) | ((U32)(U08)(rgba.r * 255.f));
-  return packed;
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 color = color_x04_load(src[it].dat, 4, 4);
+    For_U32 (channel, 3) color.c[channel] = f32_x04_mul(color.c[channel], color.c[3]);
+    color_x04_store(&color, dst[it].dat, 4, 4);
+  }
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = rgba_premul_from_rgba(src[index]);
+  }
 }
 
-fn_internal RGBA_U32 rgba_u32_from_rgba_premul(RGBA rgba) {
-  rgba.r *= rgba.a;
-  rgba.g *= rgba.a;
-  rgba.b *= rgba.a;
-  return rgba_u32_from_rgba(rgba);
+fn_internal void abgr_u32_from_rgba_array(U64 count, RGBA *src, RGBA_U32 *dst) {
+  U64 it = 0;
+
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 color = color_x04_load(src[it].dat, 4, 4);
+    color_x04_abgr_u32(&color, dst + it);
+  }
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = abgr_u32_from_rgba(src[index]);
+  }
 }
 
-fn_internal RGBA_U32 abgr_u32_from_rgba_premul(RGBA rgba) {
-  rgba.r *= rgba.a;
-  rgba.g *= rgba.a;
-  rgba.b *= rgba.a;
-  return abgr_u32_from_rgba(rgba);
+fn_internal void abgr_u32_from_rgba_premul_array(U64 count, RGBA *src, RGBA_U32 *dst) {
+  U64 it = 0;
+
+#if F32_X04_Available
+  for (; it + 4 <= count; it += 4) {
+    Color_X04 color = color_x04_load(src[it].dat, 4, 4);
+    For_U32 (channel, 3) color.c[channel] = f32_x04_mul(color.c[channel], color.c[3]);
+    color_x04_abgr_u32(&color, dst + it);
+  }
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = abgr_u32_from_rgba_premul(src[index]);
+  }
 }
 
 // ------------------------------------------------------------
@@ -814,6 +2590,54 @@ fn_internal B32 m4f_inv(M4F x, M4F *solved) {
   return result;
 }
 
+// ------------------------------------------------------------
+// #-- Array Parsing
+
+fn_internal Array_F32 array_f32_from_str(Arena *arena, Str text) {
+  Array_F32 result = { };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, arena) {
+
+    // NOTE(cmat): We don't know the count up front, so grow in scratch and copy once at the end.
+    U64  capacity = 1024;
+    U64  count    = 0;
+    F32 *values   = arena_push_count(scratch.arena, F32, capacity, .flags = 0);
+
+    U64 at = 0;
+    while (at < text.len) {
+      U08 c = text.txt[at];
+      if (!char_is_number(c) && c != '-' && c != '+' && c != '.') {
+        at += 1;
+        continue;
+      }
+
+      F32 value    = 0;
+      U64 consumed = f32_from_str_ext(str_slice(text, at, text.len - at), &value);
+      if (!consumed) {
+        at += 1;
+        continue;
+      }
+
+      If_Unlikely (count == capacity) {
+        F32 *grown = arena_push_count(scratch.arena, F32, 2 * capacity, .flags = 0);
+        memory_copy(grown, values, count * sizeof(F32));
+        values    = grown;
+        capacity *= 2;
+      }
+
+      values[count++] = value;
+      at += consumed;
+    }
+
+    array_reserve(arena, &result, count);
+    memory_copy(result.dat, values, count * sizeof(F32));
+    result.len = count;
+  }
+
+  return result;
+}
+
 // ------------------------------------------------------------
 // #-- CRC32
 
@@ -865,14 +2689,593 @@ var_global U32 CRC32_Lookup_Table[] = {
 	0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-fn_internal U32 crc32(U64 bytes, U08 *dat) {
-  U32 crc = ~0U;
+// NOTE(cmat): Slicing-by-16 tables, Slice[k][b] is the crc of byte b followed by k zero bytes.
+// - Slice[0] is the lookup table above. Built once in crc32_init (16 KB).
+var_global U32 CRC32_Slice_Table[16][256] = { };
+
+fn_internal void crc32_init(void) {
+  For_U32(it, 256) {
+    CRC32_Slice_Table[0][it] = CRC32_Lookup_Table[it];
+  }
+
+  For_U32(slice, 15) {
+    For_U32(it, 256) {
+      U32 prev = CRC32_Slice_Table[slice][it];
+      CRC32_Slice_Table[slice + 1][it] = (prev >> 8) ^ CRC32_Lookup_Table[prev & 0xFF];
+    }
+  }
+}
+
+// NOTE(cmat): All the crc32_state_* functions work on the raw (non-inverted) register.
+fn_internal U32 crc32_state_bytes(U32 crc, U64 bytes, U08 *dat) {
   while (bytes--) {
     crc = CRC32_Lookup_Table[(crc ^ *dat++) & 0xFF] ^ (crc >> 8);
   }
 
-  U32 result = crc ^ ~0U;
-  return result;
+  return crc;
+}
+
+force_inline fn_internal U32 crc32_read_u32(U08 *dat) { U32 v; memory_copy(&v, dat, sizeof(v)); return v; }
+
+fn_internal U32 crc32_state_slice(U32 crc, U64 bytes, U08 *dat) {
+  Assert(CRC32_Slice_Table[1][1], "crc32_init not called");
+  U32 (*t)[256] = CRC32_Slice_Table;
+
+  while (bytes >= 16) {
+    U32 w0 = crc32_read_u32(dat +  0) ^ crc;
+    U32 w1 = crc32_read_u32(dat +  4);
+    U32 w2 = crc32_read_u32(dat +  8);
+    U32 w3 = crc32_read_u32(dat + 12);
+
+    crc = t[15][w0 & 0xFF] ^ t[14][(w0 >> 8) & 0xFF] ^ t[13][(w0 >> 16) & 0xFF] ^ t[12][w0 >> 24] ^
+          t[11][w1 & 0xFF] ^ t[10][(w1 >> 8) & 0xFF] ^ t[ 9][(w1 >> 16) & 0xFF] ^ t[ 8][w1 >> 24] ^
+          t[ 7][w2 & 0xFF] ^ t[ 6][(w2 >> 8) & 0xFF] ^ t[ 5][(w2 >> 16) & 0xFF] ^ t[ 4][w2 >> 24] ^
+          t[ 3][w3 & 0xFF] ^ t[ 2][(w3 >> 8) & 0xFF] ^ t[ 1][(w3 >> 16) & 0xFF] ^ t[ 0][w3 >> 24];
+
+    dat   += 16;
+    bytes -= 16;
+  }
+
+  if (bytes >= 8) {
+    U32 w0 = crc32_read_u32(dat + 0) ^ crc;
+    U32 w1 = crc32_read_u32(dat + 4);
+
+    crc = t[7][w0 & 0xFF] ^ t[6][(w0 >> 8) & 0xFF] ^ t[5][(w0 >> 16) & 0xFF] ^ t[4][w0 >> 24] ^
+          t[3][w1 & 0xFF] ^ t[2][(w1 >> 8) & 0xFF] ^ t[1][(w1 >> 16) & 0xFF] ^ t[0][w1 >> 24];
+
+    dat   += 8;
+    bytes -= 8;
+  }
+
+  return crc32_state_bytes(crc, bytes, dat);
+}
+
+// NOTE(cmat): Carry-less multiply folding.
+// - Based on "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+// - Gopal et al, Intel 2009. Folds 4 x 128 bits in parallel, then down to 128, then Barrett-reduces to 32.
+// - Constants are x^(k) mod P(x) in the bit-reflected domain, see the paper's appendix.
+// - Takes the raw register, consumes a multiple of 16 bytes, at least 64.
+
+#define CRC32_CLMUL_Fold_Available (ARCH_X86 || ARCH_ARM) && (COMPILER_CLANG || COMPILER_GCC)
+
+#if CRC32_CLMUL_Fold_Available
+alignas(16) var_global U64 CRC32_Fold_K1K2[2] = { 0x0154442bd4, 0x01c6e41596 };
+alignas(16) var_global U64 CRC32_Fold_K3K4[2] = { 0x01751997d0, 0x00ccaa009e };
+alignas(16) var_global U64 CRC32_Fold_K5K0[2] = { 0x0163cd6124, 0x0000000000 };
+alignas(16) var_global U64 CRC32_Fold_Poly[2] = { 0x01db710641, 0x01f7011641 };
+#endif
+
+#if ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)
+
+__attribute__((target("pclmul,sse4.1")))
+fn_internal U32 crc32_state_clmul(U32 crc, U64 bytes, U08 *dat) {
+  Assert(bytes >= 64 && !(bytes & 15), "crc32_state_clmul needs a multiple of 16 bytes, at least 64");
+
+  __m128i k  = _mm_load_si128((__m128i *)CRC32_Fold_K1K2);
+  __m128i x1 = _mm_loadu_si128((__m128i *)(dat + 0x00));
+  __m128i x2 = _mm_loadu_si128((__m128i *)(dat + 0x10));
+  __m128i x3 = _mm_loadu_si128((__m128i *)(dat + 0x20));
+  __m128i x4 = _mm_loadu_si128((__m128i *)(dat + 0x30));
+
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((I32)crc));
+  dat   += 64;
+  bytes -= 64;
+
+  // NOTE(cmat): Fold 4 x 128 bits in parallel.
+  while (bytes >= 64) {
+    __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+    __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+    __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i *)(dat + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((__m128i *)(dat + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((__m128i *)(dat + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((__m128i *)(dat + 0x30)));
+
+    dat   += 64;
+    bytes -= 64;
+  }
+
+  // NOTE(cmat): Fold into 128 bits.
+  k = _mm_load_si128((__m128i *)CRC32_Fold_K3K4);
+
+  __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // NOTE(cmat): Single folds of 16 bytes.
+  while (bytes >= 16) {
+    x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((__m128i *)dat)), x5);
+
+    dat   += 16;
+    bytes -= 16;
+  }
+
+  // NOTE(cmat): Fold 128 bits to 64 bits.
+  __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  k  = _mm_loadl_epi64((__m128i *)CRC32_Fold_K5K0);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask);
+  x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // NOTE(cmat): Barrett reduction to 32 bits.
+  k  = _mm_load_si128((__m128i *)CRC32_Fold_Poly);
+  x2 = _mm_and_si128(x1, mask);
+  x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+  x2 = _mm_and_si128(x2, mask);
+  x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (U32)_mm_extract_epi32(x1, 1);
+}
+
+#elif ARCH_ARM && (COMPILER_CLANG || COMPILER_GCC)
+
+// NOTE(cmat): Same folding as the x86 path, _mm_clmulepi64_si128(a, b, imm) maps to
+// - vmull_p64 of the 64-bit lanes selected by imm (bit 0 for a, bit 4 for b).
+
+#if COMPILER_CLANG
+# define CRC32_Target_PMULL __attribute__((target("aes")))
+#else
+# define CRC32_Target_PMULL __attribute__((target("+crypto")))
+#endif
+
+CRC32_Target_PMULL force_inline fn_internal uint64x2_t crc32_pmull(uint64x2_t a, uint64x2_t b, U32 a_lane, U32 b_lane) {
+  poly64_t pa = (poly64_t)vgetq_lane_u64(a, 0);
+  poly64_t pb = (poly64_t)vgetq_lane_u64(b, 0);
+  if (a_lane) pa = (poly64_t)vgetq_lane_u64(a, 1);
+  if (b_lane) pb = (poly64_t)vgetq_lane_u64(b, 1);
+  return vreinterpretq_u64_p128(vmull_p64(pa, pb));
+}
+
+CRC32_Target_PMULL
+fn_internal U32 crc32_state_clmul(U32 crc, U64 bytes, U08 *dat) {
+  Assert(bytes >= 64 && !(bytes & 15), "crc32_state_clmul needs a multiple of 16 bytes, at least 64");
+
+  uint64x2_t k  = vld1q_u64(CRC32_Fold_K1K2);
+  uint64x2_t x1 = vld1q_u64((U64 *)(dat + 0x00));
+  uint64x2_t x2 = vld1q_u64((U64 *)(dat + 0x10));
+  uint64x2_t x3 = vld1q_u64((U64 *)(dat + 0x20));
+  uint64x2_t x4 = vld1q_u64((U64 *)(dat + 0x30));
+
+  x1 = veorq_u64(x1, vsetq_lane_u64((U64)crc, vdupq_n_u64(0), 0));
+  dat   += 64;
+  bytes -= 64;
+
+  while (bytes >= 64) {
+    uint64x2_t x5 = crc32_pmull(x1, k, 0, 0);
+    uint64x2_t x6 = crc32_pmull(x2, k, 0, 0);
+    uint64x2_t x7 = crc32_pmull(x3, k, 0, 0);
+    uint64x2_t x8 = crc32_pmull(x4, k, 0, 0);
+
+    x1 = crc32_pmull(x1, k, 1, 1);
+    x2 = crc32_pmull(x2, k, 1, 1);
+    x3 = crc32_pmull(x3, k, 1, 1);
+    x4 = crc32_pmull(x4, k, 1, 1);
+
+    x1 = veorq_u64(veorq_u64(x1, x5), vld1q_u64((U64 *)(dat + 0x00)));
+    x2 = veorq_u64(veorq_u64(x2, x6), vld1q_u64((U64 *)(dat + 0x10)));
+    x3 = veorq_u64(veorq_u64(x3, x7), vld1q_u64((U64 *)(dat + 0x20)));
+    x4 = veorq_u64(veorq_u64(x4, x8), vld1q_u64((U64 *)(dat + 0x30)));
+
+    dat   += 64;
+    bytes -= 64;
+  }
+
+  k = vld1q_u64(CRC32_Fold_K3K4);
+
+  uint64x2_t x5 = crc32_pmull(x1, k, 0, 0);
+  x1 = crc32_pmull(x1, k, 1, 1);
+  x1 = veorq_u64(veorq_u64(x1, x2), x5);
+
+  x5 = crc32_pmull(x1, k, 0, 0);
+  x1 = crc32_pmull(x1, k, 1, 1);
+  x1 = veorq_u64(veorq_u64(x1, x3), x5);
+
+  x5 = crc32_pmull(x1, k, 0, 0);
+  x1 = crc32_pmull(x1, k, 1, 1);
+  x1 = veorq_u64(veorq_u64(x1, x4), x5);
+
+  while (bytes >= 16) {
+    x5 = crc32_pmull(x1, k, 0, 0);
+    x1 = crc32_pmull(x1, k, 1, 1);
+    x1 = veorq_u64(veorq_u64(x1, vld1q_u64((U64 *)dat)), x5);
+
+    dat   += 16;
+    bytes -= 16;
+  }
+
+  uint64x2_t mask = vreinterpretq_u64_u32((uint32x4_t) { ~0u, 0, ~0u, 0 });
+  x2 = crc32_pmull(x1, k, 0, 1);
+  x1 = veorq_u64(vextq_u64(x1, vdupq_n_u64(0), 1), x2);
+
+  k  = vld1q_u64(CRC32_Fold_K5K0);
+  x2 = vreinterpretq_u64_u8(vextq_u8(vreinterpretq_u8_u64(x1), vdupq_n_u8(0), 4));
+  x1 = vandq_u64(x1, mask);
+  x1 = crc32_pmull(x1, k, 0, 0);
+  x1 = veorq_u64(x1, x2);
+
+  k  = vld1q_u64(CRC32_Fold_Poly);
+  x2 = vandq_u64(x1, mask);
+  x2 = crc32_pmull(x2, k, 0, 1);
+  x2 = vandq_u64(x2, mask);
+  x2 = crc32_pmull(x2, k, 0, 0);
+  x1 = veorq_u64(x1, x2);
+
+  return vgetq_lane_u32(vreinterpretq_u32_u64(x1), 1);
+}
+
+#endif
+
+fn_internal U32 crc32_update(U32 crc, U64 bytes, U08 *dat) {
+  U32 state = ~crc;
+
+#if CRC32_CLMUL_Fold_Available
+  If_Likely (bytes >= 64 && (co_context()->cpu_features & CO_CPU_Feature_CLMUL)) {
+    U64 fold_bytes = bytes & ~15ull;
+    state  = crc32_state_clmul(state, fold_bytes, dat);
+    dat   += fold_bytes;
+    bytes -= fold_bytes;
+  }
+#endif
+
+  state = crc32_state_slice(state, bytes, dat);
+  return ~state;
+}
+
+fn_internal U32 crc32(U64 bytes, U08 *dat) {
+  return crc32_update(0, bytes, dat);
+}
+
+// ------------------------------------------------------------
+// #-- Half Precision
+
+force_inline fn_internal U32 half_u32_from_f32(F32 x) { U32 bits; memory_copy(&bits, &x, sizeof(bits)); return bits; }
+force_inline fn_internal F32 half_f32_from_u32(U32 x) { F32 bits; memory_copy(&bits, &x, sizeof(bits)); return bits; }
+
+fn_internal F16 f16_from_f32(F32 x) {
+  U32 bits = half_u32_from_f32(x);
+  U32 sign = (bits >> 16) & 0x8000;
+  U32 abs  = bits & 0x7FFFFFFF;
+
+  U32 result = 0;
+  if (abs > 0x7F800000) {
+    // NOTE(cmat): NaN, keep the top of the payload and force it quiet.
+    result = 0x7E00 | ((abs >> 13) & 0x3FF);
+  } else if (abs >= 0x477FF000) {
+    // NOTE(cmat): 65520 and above round to infinity (65520 is halfway between 65504 and 2^16).
+    result = 0x7C00;
+  } else if (abs < 0x38800000) {
+    // NOTE(cmat): Below the smallest normal F16 (2^-14). Adding 0.5 lines the F16 denormal
+    // - ulp (2^-24) up with the F32 ulp at 0.5, so the FPU does the round to nearest even.
+    result = half_u32_from_f32(half_f32_from_u32(abs) + 0.5f) - 0x3F000000;
+  } else {
+    // NOTE(cmat): Rebias the exponent (127 -> 15) and round to nearest even on the 13 dropped bits.
+    U32 odd = (abs >> 13) & 1;
+    result  = (abs + 0xC8000FFF + odd) >> 13;
+  }
+
+  return (F16)(result | sign);
+}
+
+fn_internal F32 f32_from_f16(F16 x) {
+  U32 sign     = (U32)(x & 0x8000) << 16;
+  U32 exponent = (x >> 10) & 0x1F;
+  U32 mantissa = x & 0x3FF;
+
+  U32 result = 0;
+  if (exponent == 0x1F) {
+    result = 0x7F800000 | (mantissa << 13);
+  } else if (exponent) {
+    result = ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa) {
+    result = half_u32_from_f32((F32)mantissa * (1.f / 16777216.f));
+  }
+
+  return half_f32_from_u32(result | sign);
+}
+
+fn_internal BF16 bf16_from_f32(F32 x) {
+  U32 bits = half_u32_from_f32(x);
+  if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+    return (BF16)((bits | 0x00400000) >> 16);
+  }
+
+  U32 odd = (bits >> 16) & 1;
+  return (BF16)((bits + 0x7FFF + odd) >> 16);
+}
+
+fn_internal F32 f32_from_bf16(BF16 x) {
+  return half_f32_from_u32((U32)x << 16);
+}
+
+#if ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)
+
+__attribute__((target("f16c")))
+fn_internal U64 f16_from_f32_f16c(U64 count, F32 *src, F16 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    __m128i half = _mm_cvtps_ph(_mm_loadu_ps(src + it), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storel_epi64((__m128i *)(dst + it), half);
+  }
+
+  return it;
+}
+
+__attribute__((target("f16c")))
+fn_internal U64 f32_from_f16_f16c(U64 count, F16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    _mm_storeu_ps(dst + it, _mm_cvtph_ps(_mm_loadl_epi64((__m128i *)(src + it))));
+  }
+
+  return it;
+}
+
+fn_internal U64 bf16_from_f32_simd(U64 count, F32 *src, BF16 *dst) {
+  __m128i one       = _mm_set1_epi32(1);
+  __m128i round     = _mm_set1_epi32(0x7FFF);
+  __m128i abs_mask  = _mm_set1_epi32(0x7FFFFFFF);
+  __m128i infinity  = _mm_set1_epi32(0x7F800000);
+  __m128i quiet     = _mm_set1_epi32(0x00400000);
+
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    __m128i bits    = _mm_castps_si128(_mm_loadu_ps(src + it));
+    __m128i odd     = _mm_and_si128(_mm_srli_epi32(bits, 16), one);
+    __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(round, odd));
+    __m128i is_nan  = _mm_cmpgt_epi32(_mm_and_si128(bits, abs_mask), infinity);
+    __m128i result  = _mm_or_si128(_mm_and_si128(is_nan, _mm_or_si128(bits, quiet)), _mm_andnot_si128(is_nan, rounded));
+
+    // NOTE(cmat): Arithmetic shift, so the signed pack keeps all 16 bits.
+    result = _mm_srai_epi32(result, 16);
+    _mm_storel_epi64((__m128i *)(dst + it), _mm_packs_epi32(result, result));
+  }
+
+  return it;
+}
+
+fn_internal U64 f32_from_bf16_simd(U64 count, BF16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    __m128i half = _mm_loadl_epi64((__m128i *)(src + it));
+    _mm_storeu_si128((__m128i *)(dst + it), _mm_unpacklo_epi16(_mm_setzero_si128(), half));
+  }
+
+  return it;
+}
+
+#elif ARCH_ARM
+
+fn_internal U64 f16_from_f32_simd(U64 count, F32 *src, F16 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    float16x4_t half = vcvt_f16_f32(vld1q_f32(src + it));
+    vst1_u16(dst + it, vreinterpret_u16_f16(half));
+  }
+
+  return it;
+}
+
+fn_internal U64 f32_from_f16_simd(U64 count, F16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    vst1q_f32(dst + it, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + it))));
+  }
+
+  return it;
+}
+
+fn_internal U64 bf16_from_f32_simd(U64 count, F32 *src, BF16 *dst) {
+  uint32x4_t one      = vdupq_n_u32(1);
+  uint32x4_t round    = vdupq_n_u32(0x7FFF);
+  uint32x4_t abs_mask = vdupq_n_u32(0x7FFFFFFF);
+  uint32x4_t infinity = vdupq_n_u32(0x7F800000);
+  uint32x4_t quiet    = vdupq_n_u32(0x00400000);
+
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    uint32x4_t bits    = vreinterpretq_u32_f32(vld1q_f32(src + it));
+    uint32x4_t odd     = vandq_u32(vshrq_n_u32(bits, 16), one);
+    uint32x4_t rounded = vaddq_u32(bits, vaddq_u32(round, odd));
+    uint32x4_t is_nan  = vcgtq_u32(vandq_u32(bits, abs_mask), infinity);
+    uint32x4_t result  = vbslq_u32(is_nan, vorrq_u32(bits, quiet), rounded);
+    vst1_u16(dst + it, vshrn_n_u32(result, 16));
+  }
+
+  return it;
+}
+
+fn_internal U64 f32_from_bf16_simd(U64 count, BF16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    vst1q_u32((U32 *)(dst + it), vshll_n_u16(vld1_u16(src + it), 16));
+  }
+
+  return it;
+}
+
+#elif ARCH_WASM
+
+// NOTE(cmat): simd128 has no half floats, these are the scalar f16_from_f32 / f32_from_f16
+// - branches computed for every lane and selected with masks.
+force_inline fn_internal v128_t half_f16_from_f32_x4(v128_t bits) {
+  v128_t sign     = wasm_v128_and(wasm_u32x4_shr(bits, 16), wasm_i32x4_splat(0x8000));
+  v128_t abs      = wasm_v128_and(bits, wasm_i32x4_splat(0x7FFFFFFF));
+  v128_t odd      = wasm_v128_and(wasm_u32x4_shr(abs, 13), wasm_i32x4_splat(1));
+  v128_t normal   = wasm_u32x4_shr(wasm_i32x4_add(wasm_i32x4_add(abs, wasm_i32x4_splat((I32)0xC8000FFF)), odd), 13);
+  v128_t denormal = wasm_i32x4_sub(wasm_f32x4_add(abs, wasm_f32x4_splat(0.5f)), wasm_i32x4_splat(0x3F000000));
+  v128_t nan      = wasm_v128_or(wasm_i32x4_splat(0x7E00), wasm_v128_and(wasm_u32x4_shr(abs, 13), wasm_i32x4_splat(0x3FF)));
+
+  v128_t result = wasm_v128_bitselect(denormal, normal, wasm_i32x4_lt(abs, wasm_i32x4_splat(0x38800000)));
+  result        = wasm_v128_bitselect(wasm_i32x4_splat(0x7C00), result, wasm_i32x4_ge(abs, wasm_i32x4_splat(0x477FF000)));
+  result        = wasm_v128_bitselect(nan, result, wasm_i32x4_gt(abs, wasm_i32x4_splat(0x7F800000)));
+  return wasm_v128_or(result, sign);
+}
+
+force_inline fn_internal v128_t half_f32_from_f16_x4(v128_t half) {
+  v128_t exponent_mask = wasm_i32x4_splat(0x1F << 23);
+  v128_t rebias        = wasm_i32x4_splat(112 << 23);
+
+  v128_t result   = wasm_i32x4_shl(wasm_v128_and(half, wasm_i32x4_splat(0x7FFF)), 13);
+  v128_t exponent = wasm_v128_and(result, exponent_mask);
+  result          = wasm_i32x4_add(result, rebias);
+
+  // NOTE(cmat): Infinity / NaN get the maximum exponent, zero / denormals are renormalized
+  // - by subtracting 2^-14 from 2^-14 * (1 + mantissa / 1024).
+  result = wasm_i32x4_add(result, wasm_v128_and(wasm_i32x4_eq(exponent, exponent_mask), rebias));
+
+  v128_t denormal = wasm_f32x4_sub(wasm_i32x4_add(result, wasm_i32x4_splat(1 << 23)), wasm_i32x4_splat(113 << 23));
+  result          = wasm_v128_bitselect(denormal, result, wasm_i32x4_eq(exponent, wasm_i32x4_splat(0)));
+  return wasm_v128_or(result, wasm_i32x4_shl(wasm_v128_and(half, wasm_i32x4_splat(0x8000)), 16));
+}
+
+force_inline fn_internal v128_t half_bf16_from_f32_x4(v128_t bits) {
+  v128_t odd     = wasm_v128_and(wasm_u32x4_shr(bits, 16), wasm_i32x4_splat(1));
+  v128_t rounded = wasm_i32x4_add(bits, wasm_i32x4_add(wasm_i32x4_splat(0x7FFF), odd));
+  v128_t is_nan  = wasm_i32x4_gt(wasm_v128_and(bits, wasm_i32x4_splat(0x7FFFFFFF)), wasm_i32x4_splat(0x7F800000));
+  v128_t result  = wasm_v128_bitselect(wasm_v128_or(bits, wasm_i32x4_splat(0x00400000)), rounded, is_nan);
+  return wasm_u32x4_shr(result, 16);
+}
+
+fn_internal U64 f16_from_f32_simd(U64 count, F32 *src, F16 *dst) {
+  U64 it = 0;
+  for (; it + 8 <= count; it += 8) {
+    v128_t lo = half_f16_from_f32_x4(wasm_v128_load(src + it + 0));
+    v128_t hi = half_f16_from_f32_x4(wasm_v128_load(src + it + 4));
+    wasm_v128_store(dst + it, wasm_u16x8_narrow_i32x4(lo, hi));
+  }
+
+  return it;
+}
+
+fn_internal U64 f32_from_f16_simd(U64 count, F16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    wasm_v128_store(dst + it, half_f32_from_f16_x4(wasm_u32x4_load16x4(src + it)));
+  }
+
+  return it;
+}
+
+fn_internal U64 bf16_from_f32_simd(U64 count, F32 *src, BF16 *dst) {
+  U64 it = 0;
+  for (; it + 8 <= count; it += 8) {
+    v128_t lo = half_bf16_from_f32_x4(wasm_v128_load(src + it + 0));
+    v128_t hi = half_bf16_from_f32_x4(wasm_v128_load(src + it + 4));
+    wasm_v128_store(dst + it, wasm_u16x8_narrow_i32x4(lo, hi));
+  }
+
+  return it;
+}
+
+fn_internal U64 f32_from_bf16_simd(U64 count, BF16 *src, F32 *dst) {
+  U64 it = 0;
+  for (; it + 4 <= count; it += 4) {
+    wasm_v128_store(dst + it, wasm_i32x4_shl(wasm_u32x4_load16x4(src + it), 16));
+  }
+
+  return it;
+}
+
+#endif
+
+// NOTE(cmat): Each SIMD loop reads a block before storing its (smaller or equal) result at the
+// - same index, which is what makes the in-place narrowing safe. The tails are scalar.
+fn_internal void f16_from_f32_array(U64 count, F32 *src, F16 *dst) {
+  U64 it = 0;
+
+#if ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)
+  if (co_context()->cpu_features & CO_CPU_Feature_F16C) {
+    it = f16_from_f32_f16c(count, src, dst);
+  }
+#elif ARCH_ARM || ARCH_WASM
+  it = f16_from_f32_simd(count, src, dst);
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = f16_from_f32(src[index]);
+  }
+}
+
+fn_internal void f32_from_f16_array(U64 count, F16 *src, F32 *dst) {
+  U64 it = 0;
+
+#if ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)
+  if (co_context()->cpu_features & CO_CPU_Feature_F16C) {
+    it = f32_from_f16_f16c(count, src, dst);
+  }
+#elif ARCH_ARM || ARCH_WASM
+  it = f32_from_f16_simd(count, src, dst);
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = f32_from_f16(src[index]);
+  }
+}
+
+fn_internal void bf16_from_f32_array(U64 count, F32 *src, BF16 *dst) {
+  U64 it = 0;
+
+#if (ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)) || ARCH_ARM || ARCH_WASM
+  it = bf16_from_f32_simd(count, src, dst);
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = bf16_from_f32(src[index]);
+  }
+}
+
+fn_internal void f32_from_bf16_array(U64 count, BF16 *src, F32 *dst) {
+  U64 it = 0;
+
+#if (ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)) || ARCH_ARM || ARCH_WASM
+  it = f32_from_bf16_simd(count, src, dst);
+#endif
+
+  For_U64_Range (index, it, count) {
+    dst[index] = f32_from_bf16(src[index]);
+  }
 }
 
 // ------------------------------------------------------------
@@ -880,9 +3283,15 @@ fn_internal U32 crc32(U64 bytes, U08 *dat) {
 
 fn_internal void co_entry_point(I32 argument_count, char **argument_values) {
   
-  // TODO(cmat): Just have a thread_local thread context initialization instead.
-  scratch_init_for_thread();
+  thread_context_init(str_lit("main"));
+  crc32_init();
+  atom_table_init();
 
   Array_Str command_line = { };
   base_entry_point(command_line);
+
+  // NOTE(cmat): On WASM the program keeps running from JS exports after this returns.
+#if !OS_WASM
+  parallel_pool_shutdown();
+#endif
 }
@@ -186,8 +186,6 @@ fn_internal void       arena_temp_end   (Arena_Temp *temp);
 // - so when we ask for a new scrath arena, we're making sure it's not the arena that's been
 // - passed to the function.
 
-// TODO(cmat): struct Thread_Context
-fn_internal void         scratch_init_for_thread (void);
 fn_internal Arena *      scratch_get_for_thread  (Arena *conflict);
 
 typedef Arena_Temp Scratch;
@@ -265,6 +263,371 @@ typedef Array_Type(F64) Array_F64;
 typedef Array_Type(Codepoint) Array_Codepoint;
 typedef Array_Type(Str)       Array_Str;
 
+// NOTE(cmat): Parses every number in text into an array, in a single pass.
+// - Anything that can't start a number (whitespace, commas, brackets, keywords like
+// - "vertex" in ASCII STL) is treated as a separator.
+fn_internal Array_F32 array_f32_from_str(Arena *arena, Str text);
+
+// ------------------------------------------------------------
+// #-- Thread Context
+
+// NOTE(cmat): Every thread that runs base code has a context, with its own scratch arenas.
+// - Indices are handed out in init order, the main thread gets 0 in co_entry_point.
+// - Threads started with thread_launch get their context set up and named (the OS thread too,
+// - so it shows up in debuggers), and torn down when the proc returns.
+// - Log entries are tagged with the thread index and name.
+
+typedef struct Thread_Context {
+  U32   index;
+  Str   name;
+  Arena scratch_1;
+  Arena scratch_2;
+} Thread_Context;
+
+typedef void Thread_Proc(void *user_data);
+
+fn_internal void             thread_context_init    (Str name);
+fn_internal void             thread_context_release (void);
+fn_internal Thread_Context * thread_context         (void);
+
+fn_internal CO_Thread        thread_launch          (Str name, Thread_Proc *proc, void *user_data);
+fn_internal void             thread_join            (CO_Thread *thread);
+
+// ------------------------------------------------------------
+// #-- Concurrent Queues
+
+// NOTE(cmat): Bounded, lock-free queues of fixed-size elements (copied in and out).
+// - SPSC_Queue: one producer thread, one consumer thread. Each side keeps a cached copy of
+// - the other side's index, so the shared cache line is only touched when the cached view
+// - says full / empty.
+// - MPMC_Queue: any number of producers and consumers (Dmitry Vyukov's bounded queue),
+// - every cell carries a sequence number that says whose turn it is.
+// - push / pop never block and return 0 when full / empty, the _wait variants sleep on
+// - a futex instead. Capacity is rounded up to a power of two, storage comes from the arena.
+// - Producer and consumer indices are padded a full cache line apart, whatever the alignment
+// - of the queue itself.
+
+enum {
+  Cache_Line_Bytes = 64,
+};
+
+typedef struct SPSC_Queue {
+  volatile U32 tail;
+  U32          head_cached;
+  U08          pad_producer[Cache_Line_Bytes - 2 * sizeof(U32)];
+
+  volatile U32 head;
+  U32          tail_cached;
+  U08          pad_consumer[Cache_Line_Bytes - 2 * sizeof(U32)];
+
+  volatile U32 sleepers;
+  U32          mask;
+  U32          element_bytes;
+  U08         *buffer;
+} SPSC_Queue;
+
+fn_internal void spsc_queue_init      (SPSC_Queue *queue, Arena *arena, U32 capacity, U32 element_bytes);
+fn_internal B32  spsc_queue_push      (SPSC_Queue *queue, void *element);
+fn_internal B32  spsc_queue_pop       (SPSC_Queue *queue, void *element);
+fn_internal void spsc_queue_push_wait (SPSC_Queue *queue, void *element);
+fn_internal void spsc_queue_pop_wait  (SPSC_Queue *queue, void *element);
+
+// NOTE(cmat): enqueue_at / dequeue_at move when a cell is claimed, before its contents are
+// - written, so sleepers wait on published / released instead, bumped once the cell is done.
+typedef struct MPMC_Queue {
+  volatile U32 enqueue_at;
+  volatile U32 published;
+  U08          pad_producer[Cache_Line_Bytes - 2 * sizeof(U32)];
+
+  volatile U32 dequeue_at;
+  volatile U32 released;
+  U08          pad_consumer[Cache_Line_Bytes - 2 * sizeof(U32)];
+
+  volatile U32 sleepers_pop;
+  volatile U32 sleepers_push;
+  U32          mask;
+  U32          element_bytes;
+  U32          cell_bytes;
+  U08         *cells;
+} MPMC_Queue;
+
+fn_internal void mpmc_queue_init      (MPMC_Queue *queue, Arena *arena, U32 capacity, U32 element_bytes);
+fn_internal B32  mpmc_queue_push      (MPMC_Queue *queue, void *element);
+fn_internal B32  mpmc_queue_pop       (MPMC_Queue *queue, void *element);
+fn_internal void mpmc_queue_push_wait (MPMC_Queue *queue, void *element);
+fn_internal void mpmc_queue_pop_wait  (MPMC_Queue *queue, void *element);
+
+// ------------------------------------------------------------
+// #-- Ring Buffer
+
+// NOTE(cmat): Byte ring buffer whose wraparound is contiguous: the same pages are mapped twice
+// - back to back (co_memory_map_mirrored), so base[i] and base[i + capacity] alias and any span
+// - up to capacity bytes can be read or written through one pointer, no split copies.
+// - Where pages can't be aliased (WASM), or with Ring_Buffer_Flag_Copy, the buffer is twice the
+// - capacity and write_end copies the freshly written bytes into the other half instead.
+// - One producer, one consumer (same scheme as SPSC_Queue). write_begin returns 0 if there is
+// - not enough free space, read_begin returns every readable byte in one span.
+// - Capacity is rounded up to mmu_page_bytes.
+
+typedef U32 Ring_Buffer_Flag;
+enum {
+  Ring_Buffer_Flag_Copy = 1 << 0,
+};
+
+typedef struct Ring_Buffer {
+  volatile U64 write_at;
+  U64          read_cached;
+  U08          pad_producer[Cache_Line_Bytes - 2 * sizeof(U64)];
+
+  volatile U64 read_at;
+  U64          write_cached;
+  U08          pad_consumer[Cache_Line_Bytes - 2 * sizeof(U64)];
+
+  U64          capacity;
+  U08         *base;
+  B32          mirrored;
+} Ring_Buffer;
+
+fn_internal void ring_buffer_init         (Ring_Buffer *ring, U64 capacity, Ring_Buffer_Flag flags);
+fn_internal void ring_buffer_destroy      (Ring_Buffer *ring);
+
+fn_internal U08 *ring_buffer_write_begin  (Ring_Buffer *ring, U64 bytes);
+fn_internal void ring_buffer_write_end    (Ring_Buffer *ring, U64 bytes);
+fn_internal U08 *ring_buffer_read_begin   (Ring_Buffer *ring, U64 *bytes);
+fn_internal void ring_buffer_read_end     (Ring_Buffer *ring, U64 bytes);
+
+fn_internal B32  ring_buffer_write        (Ring_Buffer *ring, void *data, U64 bytes);
+fn_internal B32  ring_buffer_read         (Ring_Buffer *ring, void *data, U64 bytes);
+
+// ------------------------------------------------------------
+// #-- Parallel For
+
+// NOTE(cmat): Splits an index range [min, max) into chunks and runs them on a pool of
+// - worker threads (cpu_logical_cores - 1, started on first use), the calling thread
+// - helps out and returns once every chunk is done.
+// - Chunks are at least grain indices long, and there are at most Parallel_Chunks_Per_Thread
+// - chunks per thread, so uneven chunks still balance out.
+// - Callbacks run on any thread, thread_context() scratch arenas are per-thread and free to use.
+// - Nested calls (from inside a callback) run serially on the calling thread.
+// - parallel_reduce gives each chunk its own partial, initialized to a copy of *result
+// - (the identity), then combines the partials into *result in chunk order, so
+// - the outcome doesn't depend on scheduling.
+
+enum {
+  Parallel_Worker_Max        = 64,
+  Parallel_Chunks_Per_Thread = 4,
+};
+
+typedef struct Range_U64 {
+  U64 min;
+  U64 max;
+} Range_U64;
+
+force_inline fn_internal Range_U64 range_u64(U64 min, U64 max) { return (Range_U64) { .min = min, .max = max }; }
+
+typedef void Parallel_For_Proc     (void *user_data, Range_U64 range);
+typedef void Parallel_Reduce_Proc  (void *user_data, Range_U64 range, void *partial);
+typedef void Parallel_Combine_Proc (void *user_data, void *result, void *partial);
+
+// NOTE(cmat): The pool starts on first use. parallel_pool_shutdown joins its workers (no job may
+// - be in flight), the next parallel call starts a fresh pool. co_entry_point calls it on exit.
+fn_internal void parallel_pool_shutdown(void);
+fn_internal U32  parallel_thread_count (void);
+fn_internal void parallel_for          (Range_U64 range, U64 grain, Parallel_For_Proc *proc, void *user_data);
+fn_internal void parallel_reduce       (Range_U64 range, U64 grain, Parallel_Reduce_Proc *proc, Parallel_Combine_Proc *combine, void *user_data, void *result, U64 result_bytes);
+
+// ------------------------------------------------------------
+// #-- Radix Sort
+
+// NOTE(cmat): LSD radix sort, stable, ascending. Keys sit at offset 0 of each element, pairs
+// - carry an index next to the key (sort the pairs, then gather whatever they point at).
+// - Digits are 8 bits for small inputs and 11 bits past Radix_Sort_Wide_Count (3 passes
+// - instead of 4 for 32-bit keys, 6 instead of 8 for 64-bit keys). Passes where every key
+// - has the same digit are skipped, so keys with a narrow range sort in fewer passes.
+// - F32 keys are flipped into order-preserving U32s (negatives get every bit flipped,
+// - positives only the sign bit), sorted, and flipped back. NaNs sort past +inf (or before
+// - -inf when negative).
+// - The _parallel variants split the elements into one block per thread, count per-block
+// - histograms and scatter each block on its own thread. Small inputs fall back to serial.
+// - A scratch copy of the elements (plus histograms) is pushed on arena, pop it after.
+// - Count is limited to U32.
+
+enum {
+  Radix_Sort_Wide_Count     = 1 << 16,
+  Radix_Sort_Parallel_Count = 1 << 17,
+};
+
+typedef struct Sort_Pair_U32 {
+  U32 key;
+  U32 index;
+} Sort_Pair_U32;
+
+typedef struct Sort_Pair_U64 {
+  U64 key;
+  U32 index;
+} Sort_Pair_U64;
+
+typedef struct Sort_Pair_F32 {
+  F32 key;
+  U32 index;
+} Sort_Pair_F32;
+
+fn_internal void radix_sort_u32                (Arena *arena, U32           *keys,  U64 count);
+fn_internal void radix_sort_u64                (Arena *arena, U64           *keys,  U64 count);
+fn_internal void radix_sort_f32                (Arena *arena, F32           *keys,  U64 count);
+fn_internal void radix_sort_pairs_u32          (Arena *arena, Sort_Pair_U32 *pairs, U64 count);
+fn_internal void radix_sort_pairs_u64          (Arena *arena, Sort_Pair_U64 *pairs, U64 count);
+fn_internal void radix_sort_pairs_f32          (Arena *arena, Sort_Pair_F32 *pairs, U64 count);
+
+fn_internal void radix_sort_u32_parallel       (Arena *arena, U32           *keys,  U64 count);
+fn_internal void radix_sort_u64_parallel       (Arena *arena, U64           *keys,  U64 count);
+fn_internal void radix_sort_f32_parallel       (Arena *arena, F32           *keys,  U64 count);
+fn_internal void radix_sort_pairs_u32_parallel (Arena *arena, Sort_Pair_U32 *pairs, U64 count);
+fn_internal void radix_sort_pairs_u64_parallel (Arena *arena, Sort_Pair_U64 *pairs, U64 count);
+fn_internal void radix_sort_pairs_f32_parallel (Arena *arena, Sort_Pair_F32 *pairs, U64 count);
+
+// ------------------------------------------------------------
+// #-- Task Graph
+
+// NOTE(cmat): A graph of tasks rebuilt every frame out of an arena, then executed on the
+// - parallel workers plus the calling thread.
+// - Tasks name the resources they read and write as bits (Task_Resource(index)). A task depends
+// - on every earlier task that writes something it touches, or reads something it writes,
+// - so the result matches running the tasks in the order they were added.
+// - Task_Flag_Calling_Thread pins a task to the thread calling task_graph_execute (anything
+// - bound to a graphics context, for example).
+// - parallel_for inside a task runs serially, the workers are busy with the graph.
+// - After execution, start / end times are kept per task. task_graph_log prints the critical
+// - path (the longest chain of dependent tasks), task_graph_trace emits Chrome trace JSON
+// - (chrome://tracing, ui.perfetto.dev) with the critical tasks marked.
+
+#define Task_Resource(index_) (1ull << (index_))
+
+typedef void Task_Proc(void *user_data);
+
+typedef U32 Task_Flag;
+enum {
+  Task_Flag_None           = 0,
+  Task_Flag_Calling_Thread = 1 << 0,
+};
+
+typedef struct Task_Edge {
+  struct Task_Edge *next;
+  struct Task      *task;
+} Task_Edge;
+
+typedef struct Task {
+  struct Task  *next;
+  Str           name;
+  Task_Proc    *proc;
+  void         *user_data;
+  Task_Flag     flags;
+  U64           reads;
+  U64           writes;
+
+  U32           dependency_count;
+  volatile U32  dependencies_pending;
+  Task_Edge    *dependencies;
+  Task_Edge    *dependents;
+
+  U32           thread_index;
+  U64           start_ns;
+  U64           end_ns;
+
+  U64           path_ns;
+  struct Task  *path_prev;
+  B32           critical;
+} Task;
+
+typedef struct Task_Graph {
+  Arena        *arena;
+  Task         *first;
+  Task         *last;
+  U32           task_count;
+  U32           helper_count;
+
+  volatile U32  remaining;
+  volatile U32  signal;
+  MPMC_Queue    ready_any;
+  MPMC_Queue    ready_calling;
+
+  U64           start_ns;
+  U64           end_ns;
+} Task_Graph;
+
+fn_internal void  task_graph_begin         (Task_Graph *graph, Arena *arena);
+fn_internal Task *task_graph_add           (Task_Graph *graph, Str name, Task_Proc *proc, void *user_data, U64 reads, U64 writes, Task_Flag flags);
+fn_internal void  task_graph_execute       (Task_Graph *graph);
+fn_internal U64   task_graph_critical_path (Task_Graph *graph);
+fn_internal void  task_graph_log           (Task_Graph *graph);
+fn_internal Str   task_graph_trace         (Task_Graph *graph, Arena *arena);
+
+// ------------------------------------------------------------
+// #-- Fibers
+
+// NOTE(cmat): A cooperative scheduler on top of co_fiber, so that loaders can be written as
+// - straight-line code: spawn a fiber, and have it fiber_yield while its I/O is still pending.
+// - fiber_scheduler_run resumes every live fiber once, in spawn order, on the calling thread,
+// - meant to be called once per frame. Fibers never migrate between threads.
+// - Stacks come out of one virtual memory reservation, each one sitting on top of an
+// - uncommitted guard page, so an overflow faults instead of corrupting the neighbour.
+// - WASM has no page protection, there the guard is filled with a pattern that gets checked
+// - every time the fiber yields or returns.
+
+enum {
+  Fiber_Stack_Bytes_Default = 256 * 1024,
+  Fiber_Guard_Pattern       = 0xFB,
+};
+
+typedef struct Fiber {
+  CO_Fiber      context;
+  struct Fiber *next;
+  Str           name;
+  U08          *guard_base;
+  U64           guard_bytes;
+} Fiber;
+
+typedef struct Fiber_Scheduler {
+  CO_Fiber  root;
+  Fiber    *running;
+
+  Fiber    *slots;
+  U32       slot_count;
+  U64       slot_bytes;
+  U64       guard_bytes;
+  U08      *reserve_base;
+  U64       reserve_bytes;
+
+  Fiber    *free;
+  Fiber    *first;
+  Fiber    *last;
+  U32       live_count;
+} Fiber_Scheduler;
+
+fn_internal void   fiber_scheduler_init    (Fiber_Scheduler *scheduler, Arena *arena, U32 fiber_capacity, U64 stack_bytes);
+fn_internal void   fiber_scheduler_destroy (Fiber_Scheduler *scheduler);
+fn_internal Fiber *fiber_spawn             (Fiber_Scheduler *scheduler, Str name, CO_Fiber_Proc *proc, void *user_data);
+fn_internal U32    fiber_scheduler_run     (Fiber_Scheduler *scheduler);
+fn_internal void   fiber_yield             (void);
+fn_internal Fiber *fiber_current           (void);
+
+// ------------------------------------------------------------
+// #-- String Interning
+
+// NOTE(cmat): Maps a string to a stable 32-bit atom, atom 0 is the empty string.
+// - Every distinct string is stored once and hashed once, on insertion, so comparing
+// - and hashing interned strings are integer ops. Atoms live until the program exits.
+// - Lookups of existing strings are lock-free, insertions take a mutex, so loaders on
+// - worker threads can intern concurrently with the main thread.
+// - Named Str_Atom rather than Atom, which X11 already defines.
+
+typedef U32 Str_Atom;
+
+fn_internal void     atom_table_init (void);
+fn_internal Str_Atom atom_from_str   (Str string);
+fn_internal Str      str_from_atom   (Str_Atom atom);
+fn_internal U64      atom_hash       (Str_Atom atom);
+
 // ------------------------------------------------------------
 // #-- Hash Table
 #if 0
@@ -371,6 +734,8 @@ typedef struct Logger_Entry {
   U08               message[Logger_Max_Entry_Length];
   Local_Time        time;
   Function_Metadata meta;
+  U32               thread_index;
+  Str               thread_name;
 } Logger_Entry;
 
 // NOTE(cmat): Callback prototypes.
@@ -1476,16 +1841,44 @@ typedef HSVA_F32 HSVA;
 #define rbga_u32(r_, g_, b_, a_) v4f((r_) / 255.f, (g_) / 255.f, (b_) / 255.f, (a_) / 255.f)
 #define hsva_u32(h_, s_, v_, a_) v4f((h_) / 360.f, (s_) / 100.f, (v_) / 100.f, (a_) / 255.f)
 
+// NOTE(cmat): Hue, saturation, value and all RGB channels are in [0, 1]. Hue 0 is red,
+// - grays get hue 0 and saturation 0.
+// - sRGB conversions are the exact piecewise IEC 61966-2-1 curves, per channel.
+// - Packing to U32 saturates to [0, 1] and rounds to the nearest 8-bit value. rgba_u32 has
+// - red in the top byte, abgr_u32 has red in the lowest byte (RGBA8 bytes in memory, what the
+// - renderer and textures use).
+// - The _array versions convert 4 colors at a time with F32_X04, for LUTs and color ramps.
+// - Their results match the scalar functions to within float rounding (the sRGB curves use
+// - polynomial log2 / exp2, ~1e-6 relative).
+
 fn_internal RGB       rgb_from_hsv       (HSV rgb);
 fn_internal HSV       hsv_from_rgb       (RGB hsv);
 fn_internal RGBA      rgba_from_hsva     (HSVA rgb);
 fn_internal HSVA      hsva_from_rgba     (RGBA hsv);
 fn_internal RGBA_U32  rgba_u32_from_rgba (RGBA_F32 rgba);
 fn_internal RGBA_U32  abgr_u32_from_rgba (RGBA_F32 rgba);
+fn_internal RGBA      rgba_from_rgba_u32 (RGBA_U32 rgba);
+fn_internal RGBA      rgba_from_abgr_u32 (RGBA_U32 abgr);
 
 fn_internal RGBA_U32  rgba_u32_from_rgba_premul (RGBA_F32 rgba);
 fn_internal RGBA_U32  abgr_u32_from_rgba_premul (RGBA_F32 rgba);
 
+fn_internal RGBA      rgba_premul_from_rgba (RGBA rgba);
+fn_internal RGBA      rgba_from_rgba_premul (RGBA rgba);
+
+fn_internal F32       f32_linear_from_srgb  (F32 x);
+fn_internal F32       f32_srgb_from_linear  (F32 x);
+fn_internal RGB       linear_from_srgb      (RGB srgb);
+fn_internal RGB       srgb_from_linear      (RGB linear);
+
+fn_internal void      rgb_from_hsv_array               (U64 count, HSV  *src, RGB      *dst);
+fn_internal void      hsv_from_rgb_array               (U64 count, RGB  *src, HSV      *dst);
+fn_internal void      linear_from_srgb_array           (U64 count, RGB  *src, RGB      *dst);
+fn_internal void      srgb_from_linear_array           (U64 count, RGB  *src, RGB      *dst);
+fn_internal void      rgba_premul_from_rgba_array      (U64 count, RGBA *src, RGBA     *dst);
+fn_internal void      abgr_u32_from_rgba_array         (U64 count, RGBA *src, RGBA_U32 *dst);
+fn_internal void      abgr_u32_from_rgba_premul_array  (U64 count, RGBA *src, RGBA_U32 *dst);
+
 // ------------------------------------------------------------
 // #-- Interpolation
 
@@ -1574,8 +1967,17 @@ inline fn_internal V4F v4f_random_bilateral  (Random_Seed *seed) { return v4f(f3
 // ------------------------------------------------------------
 // #-- SIMD
 
+// NOTE(cmat): f32_x04_blend(a, b, mask) picks a where mask is set, b elsewhere.
+// - f32_x04_fused_mul_add(a, b, c) is a * b + c, f32_x04_fused_mul_sub(a, b, c) is a * b - c
+// - (fused on NEON and x86 with FMA, separate ops otherwise).
+// - f32_x04_exponent / f32_x04_mantissa split positive normal x into 2^e * m, m in [1, 2),
+// - f32_x04_exp2_integer builds 2^n for integer n in [-126, 127]. These three are the only
+// - bit-level ops, enough to build log2 / exp2 (and pow) out of the float ops.
+// - mask_x04_bits packs lane i of a mask into bit i, for early outs on all / no lanes set.
+
 #if ARCH_ARM
 #include <arm_neon.h>
+#define F32_X04_Available 1
 
 // NOTE(cmat): Basic 4x wide types
 
@@ -1596,14 +1998,27 @@ force_inline fn_internal F32_X04  f32_x04_add                         (F32_X04 l
 force_inline fn_internal F32_X04  f32_x04_sub                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = vsubq_f32(lhs.simd, rhs.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_mul                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = vmulq_f32(lhs.simd, rhs.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_div                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = vdivq_f32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_min                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = vminq_f32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_max                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = vmaxq_f32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_abs                         (F32_X04 x)                               { return (F32_X04)  { .simd = vabsq_f32(x.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_round                       (F32_X04 x)                               { return (F32_X04)  { .simd = vrndnq_f32(x.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_square_root                 (F32_X04 x)                               { return (F32_X04)  { .simd = vsqrtq_f32(x.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_fused_mul_add               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = vfmaq_f32(c.simd, b.simd, a.simd) }; }
-force_inline fn_internal F32_X04  f32_x04_fused_mul_sub               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = vfmsq_f32(c.simd, b.simd, a.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_fused_mul_sub               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = vnegq_f32(vfmsq_f32(c.simd, b.simd, a.simd)) }; }
 force_inline fn_internal Mask_X04 f32_x04_mask_greater_than_or_equal  (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = vcgeq_f32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 f32_x04_mask_greater_than           (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = vcgtq_f32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_and                        (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = vandq_u32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_or                         (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = vorrq_u32(lhs.simd, rhs.simd) }; }
+force_inline fn_internal U32      mask_x04_bits                       (Mask_X04 mask)                           { U32 weights[4] = { 1, 2, 4, 8 }; return vaddvq_u32(vandq_u32(mask.simd, vld1q_u32(weights))); }
 force_inline fn_internal F32_X04  f32_x04_blend                       (F32_X04 a, F32_X04 b, Mask_X04 mask)     { return (F32_X04)  { .simd = vbslq_f32(mask.simd, a.simd, b.simd) }; }
 
+force_inline fn_internal F32_X04  f32_x04_exponent                    (F32_X04 x)                               { return (F32_X04)  { .simd = vsubq_f32(vcvtq_f32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x.simd), 23)), vdupq_n_f32(127.f)) }; }
+force_inline fn_internal F32_X04  f32_x04_mantissa                    (F32_X04 x)                               { return (F32_X04)  { .simd = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x.simd), vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F800000))) }; }
+force_inline fn_internal F32_X04  f32_x04_exp2_integer                (F32_X04 n)                               { return (F32_X04)  { .simd = vreinterpretq_f32_u32(vshlq_n_u32(vcvtq_u32_f32(vaddq_f32(n.simd, vdupq_n_f32(127.f))), 23)) }; }
+
 #elif ARCH_X86
 #include <immintrin.h>
+#define F32_X04_Available 1
 
 // NOTE(cmat): Basic 4x wide types
 typedef union {
@@ -1611,8 +2026,9 @@ typedef union {
   F32 data[4];
 } F32_X04;
 
+// NOTE(cmat): SSE2 compare masks (all bits set per lane), so this works on every x64 CPU.
 typedef struct {
-  __mmask8 simd;
+  __m128 simd;
 } Mask_X04;
 
 // NOTE(cmat): Basic 4x wide ops
@@ -1623,21 +2039,113 @@ force_inline fn_internal F32_X04  f32_x04_add                         (F32_X04 l
 force_inline fn_internal F32_X04  f32_x04_sub                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = _mm_sub_ps(lhs.simd, rhs.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_mul                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = _mm_mul_ps(lhs.simd, rhs.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_div                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = _mm_div_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_min                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = _mm_min_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_max                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = _mm_max_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_abs                         (F32_X04 x)                               { return (F32_X04)  { .simd = _mm_andnot_ps(_mm_set1_ps(-0.f), x.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_round                       (F32_X04 x)                               { return (F32_X04)  { .simd = _mm_cvtepi32_ps(_mm_cvtps_epi32(x.simd)) }; }
 force_inline fn_internal F32_X04  f32_x04_square_root                 (F32_X04 x)                               { return (F32_X04)  { .simd = _mm_sqrt_ps(x.simd) }; }
+#if defined(__FMA__)
 force_inline fn_internal F32_X04  f32_x04_fused_mul_add               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = _mm_fmadd_ps(a.simd, b.simd, c.simd) }; }
 force_inline fn_internal F32_X04  f32_x04_fused_mul_sub               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = _mm_fmsub_ps(a.simd, b.simd, c.simd) }; }
-force_inline fn_internal Mask_X04 f32_x04_mask_greater_than_or_equal  (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = _mm_cmp_ps_mask(lhs.simd, rhs.simd, _CMP_GE_OQ) }; }
-force_inline fn_internal F32_X04  f32_x04_blend                       (F32_X04 a, F32_X04 b, Mask_X04 mask)     { return (F32_X04)  { .simd = _mm_mask_blend_ps(mask.simd, a.simd, b.simd) }; }
+#else
+force_inline fn_internal F32_X04  f32_x04_fused_mul_add               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = _mm_add_ps(_mm_mul_ps(a.simd, b.simd), c.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_fused_mul_sub               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = _mm_sub_ps(_mm_mul_ps(a.simd, b.simd), c.simd) }; }
+#endif
+force_inline fn_internal Mask_X04 f32_x04_mask_greater_than_or_equal  (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = _mm_cmpge_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 f32_x04_mask_greater_than           (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = _mm_cmpgt_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_and                        (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = _mm_and_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_or                         (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = _mm_or_ps(lhs.simd, rhs.simd) }; }
+force_inline fn_internal U32      mask_x04_bits                       (Mask_X04 mask)                           { return (U32)_mm_movemask_ps(mask.simd); }
+force_inline fn_internal F32_X04  f32_x04_blend                       (F32_X04 a, F32_X04 b, Mask_X04 mask)     { return (F32_X04)  { .simd = _mm_or_ps(_mm_and_ps(mask.simd, a.simd), _mm_andnot_ps(mask.simd, b.simd)) }; }
+
+force_inline fn_internal F32_X04  f32_x04_exponent                    (F32_X04 x)                               { return (F32_X04)  { .simd = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srli_epi32(_mm_castps_si128(x.simd), 23)), _mm_set1_ps(127.f)) }; }
+force_inline fn_internal F32_X04  f32_x04_mantissa                    (F32_X04 x)                               { return (F32_X04)  { .simd = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(_mm_castps_si128(x.simd), _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000))) }; }
+force_inline fn_internal F32_X04  f32_x04_exp2_integer                (F32_X04 n)                               { return (F32_X04)  { .simd = _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtps_epi32(_mm_add_ps(n.simd, _mm_set1_ps(127.f))), 23)) }; }
+
+#elif ARCH_WASM
+#define F32_X04_Available 1
+
+// NOTE(cmat): Basic 4x wide types
+typedef union {
+  v128_t simd;
+  F32    data[4];
+} F32_X04;
+
+typedef struct {
+  v128_t simd;
+} Mask_X04;
 
+// NOTE(cmat): Basic 4x wide ops. simd128 has no fused multiply-add (only relaxed-simd does).
+force_inline fn_internal F32_X04  f32_x04_load                        (F32 *ptr)                                { return (F32_X04)  { .simd = wasm_v128_load(ptr) }; }
+force_inline fn_internal F32_X04  f32_x04_load_f32                    (F32 x)                                   { return (F32_X04)  { .simd = wasm_f32x4_splat(x) }; }
+
+force_inline fn_internal F32_X04  f32_x04_add                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_add(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_sub                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_sub(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_mul                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_mul(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_div                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_div(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_min                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_pmin(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_max                         (F32_X04 lhs, F32_X04 rhs)                { return (F32_X04)  { .simd = wasm_f32x4_pmax(lhs.simd, rhs.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_abs                         (F32_X04 x)                               { return (F32_X04)  { .simd = wasm_f32x4_abs(x.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_round                       (F32_X04 x)                               { return (F32_X04)  { .simd = wasm_f32x4_nearest(x.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_square_root                 (F32_X04 x)                               { return (F32_X04)  { .simd = wasm_f32x4_sqrt(x.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_fused_mul_add               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = wasm_f32x4_add(wasm_f32x4_mul(a.simd, b.simd), c.simd) }; }
+force_inline fn_internal F32_X04  f32_x04_fused_mul_sub               (F32_X04 a, F32_X04 b, F32_X04 c)         { return (F32_X04)  { .simd = wasm_f32x4_sub(wasm_f32x4_mul(a.simd, b.simd), c.simd) }; }
+force_inline fn_internal Mask_X04 f32_x04_mask_greater_than_or_equal  (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = wasm_f32x4_ge(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 f32_x04_mask_greater_than           (F32_X04 lhs, F32_X04 rhs)                { return (Mask_X04) { .simd = wasm_f32x4_gt(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_and                        (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = wasm_v128_and(lhs.simd, rhs.simd) }; }
+force_inline fn_internal Mask_X04 mask_x04_or                         (Mask_X04 lhs, Mask_X04 rhs)              { return (Mask_X04) { .simd = wasm_v128_or(lhs.simd, rhs.simd) }; }
+force_inline fn_internal U32      mask_x04_bits                       (Mask_X04 mask)                           { return (U32)wasm_i32x4_bitmask(mask.simd); }
+force_inline fn_internal F32_X04  f32_x04_blend                       (F32_X04 a, F32_X04 b, Mask_X04 mask)     { return (F32_X04)  { .simd = wasm_v128_bitselect(a.simd, b.simd, mask.simd) }; }
+
+force_inline fn_internal F32_X04  f32_x04_exponent                    (F32_X04 x)                               { return (F32_X04)  { .simd = wasm_f32x4_sub(wasm_f32x4_convert_u32x4(wasm_u32x4_shr(x.simd, 23)), wasm_f32x4_splat(127.f)) }; }
+force_inline fn_internal F32_X04  f32_x04_mantissa                    (F32_X04 x)                               { return (F32_X04)  { .simd = wasm_v128_or(wasm_v128_and(x.simd, wasm_i32x4_splat(0x007FFFFF)), wasm_i32x4_splat(0x3F800000)) }; }
+force_inline fn_internal F32_X04  f32_x04_exp2_integer                (F32_X04 n)                               { return (F32_X04)  { .simd = wasm_i32x4_shl(wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(n.simd, wasm_f32x4_splat(127.f))), 23) }; }
+
+#else
+#define F32_X04_Available 0
 #endif
 
 // ------------------------------------------------------------
 // #-- CRC32
 
-fn_internal U32 crc32(U64 bytes, U08 *dat);
+// NOTE(cmat): CRC-32 (ISO-HDLC / zlib), reflected polynomial 0xEDB88320.
+// - crc32_update continues a finished crc, so large files can be checksummed in pieces:
+// - crc32_update(crc32(a_bytes, a), b_bytes, b) == crc32 of a followed by b.
+// - Inputs of 64 bytes and above are folded with carry-less multiplies when the CPU
+// - supports it (CO_CPU_Feature_CLMUL), everything else goes through slicing-by-16.
+
+fn_internal void crc32_init   (void);
+fn_internal U32  crc32_update (U32 crc, U64 bytes, U08 *dat);
+fn_internal U32  crc32        (U64 bytes, U08 *dat);
 
 force_inline fn_internal U32 str_crc32(Str str) { return crc32(str.len, str.txt); }
 
+// ------------------------------------------------------------
+// #-- Half Precision
+
+// NOTE(cmat): IEEE binary16 (F16) and bfloat16 (BF16), stored as raw bits.
+// - F32 -> F16 / BF16 rounds to nearest even, like the hardware does. F16 keeps denormals
+// - (down to 2^-24), overflows to infinity past 65504 (from 65520 up), and NaNs stay quiet NaNs.
+// - The conversions back to F32 are exact.
+// - The array versions go 4 or 8 lanes at a time: F16C on x86 (when the CPU has it), FCVT on
+// - NEON, and the same bit operations as the scalar path on WASM simd128. BF16 is bit
+// - operations everywhere. Results match the scalar functions bit for bit.
+// - The narrowing array conversions can run in place (dst == src): the F32 buffer gets
+// - packed into its first half, and the second half is free to reuse.
+
+typedef U16 F16;
+typedef U16 BF16;
+
+fn_internal F16  f16_from_f32        (F32 x);
+fn_internal F32  f32_from_f16        (F16 x);
+fn_internal BF16 bf16_from_f32       (F32 x);
+fn_internal F32  f32_from_bf16       (BF16 x);
+
+fn_internal void f16_from_f32_array  (U64 count, F32  *src, F16  *dst);
+fn_internal void f32_from_f16_array  (U64 count, F16  *src, F32  *dst);
+fn_internal void bf16_from_f32_array (U64 count, F32  *src, BF16 *dst);
+fn_internal void f32_from_bf16_array (U64 count, BF16 *src, F32  *dst);
+
 // ------------------------------------------------------------
 // #-- Entry Point
 
@@ -80,8 +80,1871 @@ fn_internal void test_base_allocation(void) {
   log_zone_end();
 }
 
+fn_internal void test_base_hash(void) {
+  log_zone_start("hash testing");
+
+  // NOTE(cmat): Every length 0..128 of the same buffer, and every single-bit flip,
+  // - should produce distinct hashes.
+  // #--
+  U08 buffer[128];
+  For_U32(it, sarray_len(buffer)) buffer[it] = (U08)(it * 37 + 11);
+
+  U64 length_hash[sarray_len(buffer) + 1];
+  For_U32(len, sarray_len(length_hash)) {
+    length_hash[len] = hash_bytes(len, buffer);
+    Assert(length_hash[len] == hash_bytes(len, buffer), "hash is not deterministic");
+    Assert(length_hash[len] != hash_bytes_seeded(len, buffer, 1), "seed has no effect");
+    For_U32(prev, len) {
+      Assert(length_hash[prev] != length_hash[len], "length collision");
+    }
+  }
+
+  For_U32(bit, 8 * 64) {
+    buffer[bit / 8] ^= (U08)(1 << (bit % 8));
+    Assert(hash_bytes(64, buffer) != length_hash[64], "bit flip collision");
+    buffer[bit / 8] ^= (U08)(1 << (bit % 8));
+  }
+
+  log_info("correctness - ok");
+
+  // NOTE(cmat): Benchmark against djb2 on UI-like labels and asset paths.
+  // #--
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    enum { Label_Count = 4096, Bucket_Count = 1024, Repeat_Count = 64 };
+
+    var_local_persist char *label_formats[] = {
+      "Button##%u",
+      "Transfer Function###transfer_%u",
+      "data/velocity_%u.vol32",
+      "Slice Mode %u",
+      "Volume Rendering Settings / Opacity Curve Control Point %u",
+    };
+
+    Str *labels      = arena_push_count(scratch.arena, Str, Label_Count);
+    U64  label_bytes = 0;
+    For_U32(it, Label_Count) {
+      U08 *txt    = arena_push_size(scratch.arena, 128);
+      U32  len    = stbsp_snprintf((char *)txt, 128, label_formats[it % sarray_len(label_formats)], it);
+      labels[it]  = str(len, txt);
+      label_bytes += len;
+    }
+
+    U32 *buckets_djb2 = arena_push_count(scratch.arena, U32, Bucket_Count);
+    U32 *buckets_wy   = arena_push_count(scratch.arena, U32, Bucket_Count);
+    For_U32(it, Label_Count) {
+      buckets_djb2[str_hash_djb2(labels[it]) % Bucket_Count]++;
+      buckets_wy  [str_hash(labels[it])      % Bucket_Count]++;
+    }
+
+    U32 chain_djb2 = 0;
+    U32 chain_wy   = 0;
+    For_U32(it, Bucket_Count) {
+      chain_djb2 = u32_max(chain_djb2, buckets_djb2[it]);
+      chain_wy   = u32_max(chain_wy,   buckets_wy[it]);
+    }
+
+    // NOTE(cmat): Accumulate into a sink so the loops aren't optimized out.
+    volatile U64 sink = 0;
+
+    U64 djb2_start = co_timer_nanoseconds();
+    For_U32(repeat, Repeat_Count) For_U32(it, Label_Count) sink += str_hash_djb2(labels[it]);
+    U64 djb2_ns = co_timer_nanoseconds() - djb2_start;
+
+    U64 wy_start = co_timer_nanoseconds();
+    For_U32(repeat, Repeat_Count) For_U32(it, Label_Count) sink += str_hash(labels[it]);
+    U64 wy_ns = co_timer_nanoseconds() - wy_start;
+
+    U64 bulk_bytes  = u64_megabytes(4);
+    U08 *bulk       = arena_push_size(scratch.arena, bulk_bytes);
+    U64 bulk_start  = co_timer_nanoseconds();
+    sink += hash_bytes(bulk_bytes, bulk);
+    U64 bulk_ns     = co_timer_nanoseconds() - bulk_start;
+
+    F64 hash_count = (F64)Label_Count * Repeat_Count;
+    log_info("labels: %u, average %.1f bytes", Label_Count, (F64)label_bytes / Label_Count);
+    log_info("djb2   - %.2f ns/label, longest chain %u/%u buckets", (F64)djb2_ns / hash_count, chain_djb2, Bucket_Count);
+    log_info("wyhash - %.2f ns/label, longest chain %u/%u buckets", (F64)wy_ns   / hash_count, chain_wy,   Bucket_Count);
+    log_info("wyhash - bulk %.2f GB/s", (F64)bulk_bytes / (F64)u64_max(bulk_ns, 1));
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+fn_internal void test_base_crc32(void) {
+  log_zone_start("crc32 testing");
+
+  Assert(str_crc32(str_lit("123456789")) == 0xCBF43926, "crc32 check value mismatch");
+  Assert(crc32(0, 0) == 0, "crc32 of nothing should be zero");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Random_Seed rng   = 0xC4C32;
+    U64 buffer_bytes  = u64_megabytes(16);
+    U08 *buffer       = arena_push_size(scratch.arena, buffer_bytes, .flags = 0);
+    For_U64(it, buffer_bytes) buffer[it] = (U08)random_next(&rng);
+
+    // NOTE(cmat): Bit-exact against the byte-at-a-time table, for every length/alignment
+    // - combination around the clmul and slicing thresholds, and for random larger spans.
+    // #--
+    For_U32(offset, 16) {
+      For_U32(len, 300) {
+        U32 expected = ~crc32_state_bytes(~0u, len, buffer + offset);
+        Assert(crc32(len, buffer + offset) == expected, "crc32 mismatch");
+      }
+    }
+
+    For_U32(it, 64) {
+      U64 offset  = u64_random(&rng, 0, 4096);
+      U64 len     = u64_random(&rng, 0, u64_kilobytes(256));
+      U32 full    = crc32(len, buffer + offset);
+      Assert(full == ~crc32_state_bytes(~0u, len, buffer + offset), "crc32 mismatch");
+
+      U64 split   = u64_random(&rng, 0, len);
+      U32 partial = crc32_update(crc32(split, buffer + offset), len - split, buffer + offset + split);
+      Assert(full == partial, "crc32_update mismatch");
+    }
+
+    log_info("correctness - ok");
+
+    // NOTE(cmat): Throughput, byte table vs slicing-by-16 vs clmul folding.
+    // #--
+    volatile U32 sink = 0;
+
+    U64 start       = co_timer_nanoseconds();
+    sink           ^= crc32_state_bytes(~0u, buffer_bytes, buffer);
+    U64 byte_ns     = co_timer_nanoseconds() - start;
+
+    start           = co_timer_nanoseconds();
+    sink           ^= crc32_state_slice(~0u, buffer_bytes, buffer);
+    U64 slice_ns    = co_timer_nanoseconds() - start;
+
+    start           = co_timer_nanoseconds();
+    sink           ^= crc32(buffer_bytes, buffer);
+    U64 dispatch_ns = co_timer_nanoseconds() - start;
+
+    log_info("byte table  - %.2f GB/s", (F64)buffer_bytes / (F64)u64_max(byte_ns,     1));
+    log_info("slicing-16  - %.2f GB/s", (F64)buffer_bytes / (F64)u64_max(slice_ns,    1));
+    log_info("dispatched  - %.2f GB/s (clmul %s)", (F64)buffer_bytes / (F64)u64_max(dispatch_ns, 1),
+             (co_context()->cpu_features & CO_CPU_Feature_CLMUL) ? "on" : "off");
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+fn_internal U64 test_str_find_naive(Str base, Str sub, B32 any_case) {
+  if (sub.len > base.len) return str_find_none;
+  For_U64(it, base.len - sub.len + 1) {
+    B32 match = 1;
+    For_U64(c, sub.len) {
+      U08 a = base.txt[it + c];
+      U08 b = sub.txt[c];
+      if (any_case) {
+        a = (U08)char_to_lower(a);
+        b = (U08)char_to_lower(b);
+      }
+
+      if (a != b) { match = 0; break; }
+    }
+
+    if (match) return it;
+  }
+
+  return str_find_none;
+}
+
+fn_internal void test_base_strings(void) {
+  log_zone_start("string testing");
+
+  Assert( str_contains(str_lit("abc###id"), str_lit("###")),  "str_contains");
+  Assert( str_contains(str_lit("abc"),      str_lit("abc")),  "str_contains, whole string");
+  Assert( str_contains(str_lit("xxabc"),    str_lit("abc")),  "str_contains, last position");
+  Assert(!str_contains(str_lit("xxab"),     str_lit("abc")),  "str_contains, no match");
+  Assert( str_contains_any_case(str_lit("Volume RENDERING"), str_lit("rendering")), "str_contains_any_case");
+  Assert(!str_equals_any_case(str_lit("A"), str_lit("!")), "str_equals_any_case, non-letters");
+  Assert( str_equals_any_case(str_lit("Data/Velocity_0.VOL32"), str_lit("data/velocity_0.vol32")), "str_equals_any_case");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Random_Seed rng = 0x57219;
+
+    // NOTE(cmat): cstring_len for every alignment and length around the 16-byte blocks.
+    // #--
+    U08 *cstring = arena_push_size(scratch.arena, 256, .align = 16);
+    For_U32(offset, 16) {
+      For_U32(len, 64) {
+        memory_fill(cstring, 'x', 256);
+        cstring[offset + len] = 0;
+        Assert(cstring_len((char *)cstring + offset) == len, "cstring_len mismatch");
+      }
+    }
+
+    // NOTE(cmat): str_find against a naive search, small alphabet so matches are frequent.
+    // #--
+    U08 *base_txt = arena_push_size(scratch.arena, 512);
+    U08 *sub_txt  = arena_push_size(scratch.arena, 32);
+    For_U32(it, 20000) {
+      U64 base_len = u64_random(&rng, 0, 512);
+      U64 sub_len  = u64_random(&rng, 0, 32);
+      For_U64(c, base_len) base_txt[c] = "abAB#"[u64_random(&rng, 0, 4)];
+      For_U64(c, sub_len)  sub_txt[c]  = "abAB#"[u64_random(&rng, 0, 4)];
+
+      Str base = str(base_len, base_txt);
+      Str sub  = str((it & 1) ? u64_min(sub_len, 4) : sub_len, sub_txt);
+      Assert(str_find(base, sub)          == test_str_find_naive(base, sub, 0), "str_find mismatch");
+      Assert(str_find_any_case(base, sub) == test_str_find_naive(base, sub, 1), "str_find_any_case mismatch");
+    }
+
+    log_info("correctness - ok");
+
+    // NOTE(cmat): Benchmark, search a needle at the end of a large text buffer.
+    // #--
+    U64 text_bytes = u64_megabytes(8);
+    U08 *text      = arena_push_size(scratch.arena, text_bytes);
+    For_U64(c, text_bytes) text[c] = (U08)u64_random(&rng, 'a', 'z');
+
+    Str needle = str_lit("velocity_24.vol32");
+    memory_copy(text + text_bytes - needle.len, needle.txt, needle.len);
+
+    Str haystack = str(text_bytes, text);
+    volatile U64 sink = 0;
+
+    U64 start    = co_timer_nanoseconds();
+    sink        += test_str_find_naive(haystack, needle, 0);
+    U64 naive_ns = co_timer_nanoseconds() - start;
+
+    start        = co_timer_nanoseconds();
+    sink        += str_find(haystack, needle);
+    U64 simd_ns  = co_timer_nanoseconds() - start;
+
+    start        = co_timer_nanoseconds();
+    sink        += str_find_any_case(haystack, needle);
+    U64 case_ns  = co_timer_nanoseconds() - start;
+
+    Assert(str_find(haystack, needle) == text_bytes - needle.len, "str_find missed the needle");
+
+    log_info("naive find     - %.2f GB/s", (F64)text_bytes / (F64)u64_max(naive_ns, 1));
+    log_info("str_find       - %.2f GB/s", (F64)text_bytes / (F64)u64_max(simd_ns,  1));
+    log_info("any case find  - %.2f GB/s", (F64)text_bytes / (F64)u64_max(case_ns,  1));
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Atom_Worker {
+  U32       thread_index;
+  U32       label_count;
+  Str_Atom *atoms;
+} Test_Atom_Worker;
+
+// NOTE(cmat): Every worker formats the labels into its own storage and interns them starting
+// - at a different offset, so the same strings race to be inserted while the table grows.
+fn_internal void test_atom_worker_proc(void *user_data) {
+  Test_Atom_Worker *worker = (Test_Atom_Worker *)user_data;
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    For_U32(it, worker->label_count) {
+      U32  index = (it + worker->thread_index * (worker->label_count / 4)) % worker->label_count;
+      U08 *txt   = arena_push_size(scratch.arena, 64);
+      U32  len   = stbsp_snprintf((char *)txt, 64, "Concurrent Label %u", index);
+
+      worker->atoms[index] = atom_from_str(str(len, txt));
+    }
+  }
+}
+
+fn_internal void test_base_atoms(void) {
+  log_zone_start("string interning testing");
+
+  Assert(atom_from_str(str_lit("")) == 0,             "empty string is the null atom");
+  Assert(str_from_atom(0).len == 0,                    "null atom is the empty string");
+
+  Str_Atom a = atom_from_str(str_lit("data/velocity_0.vol32"));
+  Str_Atom b = atom_from_str(str_lit("data/velocity_1.vol32"));
+  Assert(a && b && a != b,                             "distinct strings, distinct atoms");
+  Assert(atom_from_str(str_lit("data/velocity_0.vol32")) == a, "same string, same atom");
+  Assert(str_equals(str_from_atom(a), str_lit("data/velocity_0.vol32")), "str_from_atom");
+  Assert(atom_hash(a) == str_hash(str_lit("data/velocity_0.vol32")),     "atom_hash");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+
+    // NOTE(cmat): Enough atoms to grow the slot table and span several entry pages.
+    // #--
+    enum { Label_Count = 20000, Repeat_Count = 16 };
+
+    Str      *labels = arena_push_count(scratch.arena, Str,      Label_Count);
+    Str_Atom *atoms  = arena_push_count(scratch.arena, Str_Atom, Label_Count);
+    For_U32(it, Label_Count) {
+      U08 *txt   = arena_push_size(scratch.arena, 64);
+      U32  len   = stbsp_snprintf((char *)txt, 64, "Interned Label %u###id_%u", it, it * 7);
+      labels[it] = str(len, txt);
+      atoms[it]  = atom_from_str(labels[it]);
+    }
+
+    U08 *first_txt = str_from_atom(atoms[0]).txt;
+    For_U32(it, Label_Count) {
+      Assert(atom_from_str(labels[it]) == atoms[it],            "atom changed after growth");
+      Assert(str_equals(str_from_atom(atoms[it]), labels[it]),  "atom string mismatch");
+      Assert(str_from_atom(atoms[it]).txt != labels[it].txt,    "atom should own its storage");
+    }
+
+    Assert(str_from_atom(atoms[0]).txt == first_txt, "atom storage moved");
+
+    // NOTE(cmat): Concurrent inserts of the same strings have to agree on one atom per string.
+    // #--
+    enum { Thread_Count = 4, Concurrent_Count = 16384 };
+
+    Test_Atom_Worker workers[Thread_Count] = { };
+    CO_Thread        threads[Thread_Count] = { };
+    For_U32(it, Thread_Count) {
+      workers[it].thread_index = it;
+      workers[it].label_count  = Concurrent_Count;
+      workers[it].atoms        = arena_push_count(scratch.arena, Str_Atom, Concurrent_Count);
+      threads[it]              = thread_launch(str_lit("test atoms"), test_atom_worker_proc, &workers[it]);
+    }
+
+    For_U32(it, Thread_Count) {
+      thread_join(&threads[it]);
+    }
+
+    Str_Atom *seen = arena_push_count(scratch.arena, Str_Atom, Concurrent_Count);
+    For_U32(it, Concurrent_Count) {
+      U08 txt[64] = { };
+      U32 len     = stbsp_snprintf((char *)txt, 64, "Concurrent Label %u", it);
+
+      Str_Atom atom = workers[0].atoms[it];
+      Assert(atom && str_equals(str_from_atom(atom), str(len, txt)), "concurrent atom string mismatch");
+      Assert(atom_from_str(str(len, txt)) == atom,                   "concurrent atom not found");
+      For_U32(thread, Thread_Count) {
+        Assert(workers[thread].atoms[it] == atom, "same string interned as different atoms");
+      }
+
+      seen[it] = atom;
+    }
+
+    radix_sort_u32(scratch.arena, seen, Concurrent_Count);
+    For_U32_Range(it, 1, Concurrent_Count) {
+      Assert(seen[it - 1] != seen[it], "different strings interned as the same atom");
+    }
+
+    log_info("correctness - ok");
+
+    // NOTE(cmat): Benchmark, the lock-free lookup path for strings already interned.
+    // #--
+    volatile U64 sink = 0;
+    U64 start = co_timer_nanoseconds();
+    For_U32(repeat, Repeat_Count) For_U32(it, Label_Count) sink += atom_from_str(labels[it]);
+    U64 lookup_ns = co_timer_nanoseconds() - start;
+
+    log_info("atom_from_str - %.2f ns/lookup", (F64)lookup_ns / ((F64)Label_Count * Repeat_Count));
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+fn_internal U64 test_write_u64(U08 *at, U64 value, U32 min_digits) {
+  U08 digits[20];
+  U32 count = 0;
+  do {
+    digits[count++] = (U08)('0' + value % 10);
+    value /= 10;
+  } while (value || count < min_digits);
+
+  For_U32(it, count) {
+    at[it] = digits[count - 1 - it];
+  }
+
+  return count;
+}
+
+fn_internal void test_base_parse(void) {
+  log_zone_start("number parsing testing");
+
+  // NOTE(cmat): Expected bits computed with exact rational arithmetic.
+  // - Covers halfway cases, subnormals, overflow, and inputs above 19 digits
+  // - that need the big decimal fallback.
+  // #--
+  struct { Str text; U64 f64_bits; U32 f32_bits; } float_cases[] = {
+    { str_lit("0"), 0x0000000000000000ull, 0x00000000u },
+    { str_lit("-0"), 0x8000000000000000ull, 0x80000000u },
+    { str_lit("1"), 0x3ff0000000000000ull, 0x3f800000u },
+    { str_lit("-1"), 0xbff0000000000000ull, 0xbf800000u },
+    { str_lit("0.1"), 0x3fb999999999999aull, 0x3dcccccdu },
+    { str_lit("3.14159"), 0x400921f9f01b866eull, 0x40490fd0u },
+    { str_lit("1e23"), 0x44b52d02c7e14af6ull, 0x65a96816u },
+    { str_lit("8.98846567431158e307"), 0x7fe0000000000000ull, 0x7f800000u },
+    { str_lit("1.7976931348623157e308"), 0x7fefffffffffffffull, 0x7f800000u },
+    { str_lit("1.7976931348623159e308"), 0x7ff0000000000000ull, 0x7f800000u },
+    { str_lit("2.2250738585072011e-308"), 0x000fffffffffffffull, 0x00000000u },
+    { str_lit("2.2250738585072014e-308"), 0x0010000000000000ull, 0x00000000u },
+    { str_lit("4.9406564584124654e-324"), 0x0000000000000001ull, 0x00000000u },
+    { str_lit("2.4703282292062327e-324"), 0x0000000000000000ull, 0x00000000u },
+    { str_lit("2.4703282292062328e-324"), 0x0000000000000001ull, 0x00000000u },
+    { str_lit("9007199254740993"), 0x4340000000000000ull, 0x5a000000u },
+    { str_lit("9007199254740992.5"), 0x4340000000000000ull, 0x5a000000u },
+    { str_lit("123456789012345678901234567890"), 0x45f8ee90ff6c373eull, 0x6fc77488u },
+    { str_lit("0.000000000000000000000000000000000000000001"), 0x37364cfda3281e39ull, 0x000002cau },
+    { str_lit("7.038531e-26"), 0x3ab5c87fb0000000ull, 0x15ae43fdu },
+    { str_lit("1.00000000000000011102230246251565404236316680908203125"), 0x3ff0000000000000ull, 0x3f800000u },
+    { str_lit("1.00000000000000011102230246251565404236316680908203124"), 0x3ff0000000000000ull, 0x3f800000u },
+    { str_lit("1.00000000000000011102230246251565404236316680908203126"), 0x3ff0000000000001ull, 0x3f800000u },
+    { str_lit("1e-400"), 0x0000000000000000ull, 0x00000000u },
+    { str_lit("1e400"), 0x7ff0000000000000ull, 0x7f800000u },
+    { str_lit("  42.5e-1  "), 0x4011000000000000ull, 0x40880000u },
+    { str_lit(".5"), 0x3fe0000000000000ull, 0x3f000000u },
+    { str_lit("5."), 0x4014000000000000ull, 0x40a00000u },
+    { str_lit("1E+2"), 0x4059000000000000ull, 0x42c80000u },
+    { str_lit("3.4028234663852886e38"), 0x47efffffe0000000ull, 0x7f7fffffu },
+    { str_lit("3.4028235677973366e38"), 0x47effffff0000000ull, 0x7f7fffffu },
+    { str_lit("1.1754943508e-38"), 0x380ffffffffd64e6ull, 0x00800000u },
+    { str_lit("1.4e-45"), 0x369ff868bf4d956aull, 0x00000001u },
+    { str_lit("7.006492321624085e-46"), 0x3690000000000000ull, 0x00000000u },
+    { str_lit("16777217"), 0x4170000010000000ull, 0x4b800000u },
+    { str_lit("1.00000005960464477539062500000000000000000000000000001"), 0x3ff0000010000000ull, 0x3f800001u },
+    { str_lit("1.000000059604644775390625"), 0x3ff0000010000000ull, 0x3f800000u },
+    { str_lit("0.30000000000000004"), 0x3fd3333333333334ull, 0x3e99999au },
+    { str_lit("340282356779733661637539395458142568448"), 0x47effffff0000000ull, 0x7f800000u },
+    { str_lit("-2.5e-3"), 0xbf647ae147ae147bull, 0xbb23d70au },
+  };
+
+  For_U64(it, sarray_len(float_cases)) {
+    F64 value_f64 = f64_from_str(float_cases[it].text);
+    F32 value_f32 = f32_from_str(float_cases[it].text);
+
+    U64 bits_f64 = 0;
+    U32 bits_f32 = 0;
+    memory_copy(&bits_f64, &value_f64, sizeof(bits_f64));
+    memory_copy(&bits_f32, &value_f32, sizeof(bits_f32));
+
+    Assert(bits_f64 == float_cases[it].f64_bits, "f64_from_str not correctly rounded");
+    Assert(bits_f32 == float_cases[it].f32_bits, "f32_from_str not correctly rounded");
+  }
+
+  F64 value = 0;
+  Assert(f64_from_str(str_lit("-Infinity")) < f64_smallest_negative,  "f64_from_str, -infinity");
+  Assert(f64_from_str(str_lit("inf"))       > f64_largest_positive,   "f64_from_str, infinity");
+  Assert(f64_from_str(str_lit("NaN"))      != f64_from_str(str_lit("nan")), "f64_from_str, nan");
+  Assert(f64_from_str_ext(str_lit("1.5e"),   &value) == 3 && value == 1.5,   "f64_from_str_ext, dangling exponent");
+  Assert(f64_from_str_ext(str_lit("1e+5x"),  &value) == 4 && value == 1e5,   "f64_from_str_ext, trailing bytes");
+  Assert(f64_from_str_ext(str_lit("-.25,"),  &value) == 4 && value == -0.25, "f64_from_str_ext, no integer part");
+  Assert(f64_from_str_ext(str_lit("-"),      &value) == 0, "f64_from_str_ext, sign only");
+  Assert(f64_from_str_ext(str_lit("."),      &value) == 0, "f64_from_str_ext, dot only");
+  Assert(f64_from_str_ext(str_lit("vertex"), &value) == 0, "f64_from_str_ext, not a number");
+
+  Assert(i64_from_str(str_lit("0"))                       == 0,              "i64_from_str");
+  Assert(i64_from_str(str_lit(" -42 "))                   == -42,            "i64_from_str, sign and whitespace");
+  Assert(i64_from_str(str_lit("+1234567890123456"))       == 1234567890123456ll, "i64_from_str, eight digits at a time");
+  Assert(i64_from_str(str_lit("0000000000000000000000012")) == 12,           "i64_from_str, leading zeros");
+  Assert(i64_from_str(str_lit("9223372036854775807"))     == i64_limit_max,  "i64_from_str, max");
+  Assert(i64_from_str(str_lit("-9223372036854775808"))    == i64_limit_min,  "i64_from_str, min");
+  Assert(i64_from_str(str_lit("9223372036854775808"))     == i64_limit_max,  "i64_from_str, saturate");
+  Assert(i64_from_str(str_lit("-99999999999999999999"))   == i64_limit_min,  "i64_from_str, saturate");
+  Assert(i64_from_str(str_lit("256 # dim"))               == 256,            "i64_from_str, trailing bytes");
+
+  Assert( b32_from_str(str_lit("true")),  "b32_from_str");
+  Assert( b32_from_str(str_lit(" Yes")),  "b32_from_str");
+  Assert( b32_from_str(str_lit("1")),     "b32_from_str");
+  Assert(!b32_from_str(str_lit("FALSE")), "b32_from_str");
+  Assert(!b32_from_str(str_lit("0")),     "b32_from_str");
+  Assert(!b32_from_str(str_lit("")),      "b32_from_str");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Str       stl    = str_lit("solid s\n facet normal 0 0 -1\n  vertex 1.5,2.5;-3e2\nendsolid");
+    Array_F32 values = array_f32_from_str(scratch.arena, stl);
+    F32       expect[] = { 0, 0, -1, 1.5f, 2.5f, -300 };
+
+    Assert(values.len == sarray_len(expect), "array_f32_from_str count");
+    For_U64(it, values.len) {
+      Assert(values.dat[it] == expect[it], "array_f32_from_str value");
+    }
+
+    log_info("correctness - ok");
+
+    // NOTE(cmat): Benchmark, OBJ-like text of random floats.
+    // #--
+    Random_Seed rng          = 0x9A75E;
+    U64         number_count = 1000000;
+    U08        *text         = arena_push_size(scratch.arena, number_count * 32, .flags = 0);
+    U64         text_bytes   = 0;
+
+    For_U64(it, number_count) {
+      if (u64_random(&rng, 0, 1)) {
+        text[text_bytes++] = '-';
+      }
+
+      text_bytes += test_write_u64(text + text_bytes, u64_random(&rng, 0, 999), 1);
+      text[text_bytes++] = '.';
+      text_bytes += test_write_u64(text + text_bytes, u64_random(&rng, 0, 999999), 6);
+      text[text_bytes++] = (it % 3 == 2) ? '\n' : ' ';
+    }
+
+    Str input = str(text_bytes, text);
+
+    U64 start    = co_timer_nanoseconds();
+    values       = array_f32_from_str(scratch.arena, input);
+    U64 bulk_ns  = co_timer_nanoseconds() - start;
+
+    volatile F64 sink = 0;
+    start = co_timer_nanoseconds();
+    for (U64 at = 0; at < input.len; ) {
+      F64 parsed   = 0;
+      U64 consumed = f64_from_str_ext(str_slice(input, at, input.len - at), &parsed);
+      sink += parsed;
+      at   += consumed + 1;
+    }
+    U64 f64_ns = co_timer_nanoseconds() - start;
+
+    Assert(values.len == number_count, "array_f32_from_str benchmark count");
+
+    log_info("array_f32_from_str - %.2f GB/s, %.1f M floats/s", (F64)text_bytes / (F64)u64_max(bulk_ns, 1), 1e3 * (F64)number_count / (F64)u64_max(bulk_ns, 1));
+    log_info("f64_from_str_ext   - %.2f GB/s, %.1f M floats/s", (F64)text_bytes / (F64)u64_max(f64_ns,  1), 1e3 * (F64)number_count / (F64)u64_max(f64_ns,  1));
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Sync_Shared {
+  Semaphore    semaphore;
+  Event        auto_event;
+  Event        manual_event;
+  Mutex        mutex;
+  Cond_Var     cond_var;
+  B32          ready;
+  Barrier      barrier;
+  volatile U32 arrived;
+  volatile U32 woken;
+  volatile U32 early;
+} Test_Sync_Shared;
+
+// NOTE(cmat): Long enough for the waiters to reach the futex before they are woken.
+fn_internal void test_sync_delay(void) {
+  U64 start = co_timer_nanoseconds();
+  while (co_timer_nanoseconds() - start < 2000000) {
+    spinlock_pause;
+  }
+}
+
+fn_internal void test_sync_semaphore_proc(void *user_data) {
+  Test_Sync_Shared *shared = (Test_Sync_Shared *)user_data;
+  semaphore_wait(&shared->semaphore);
+  atomic_increment_u32(&shared->woken);
+}
+
+fn_internal void test_sync_auto_event_proc(void *user_data) {
+  Test_Sync_Shared *shared = (Test_Sync_Shared *)user_data;
+  event_wait(&shared->auto_event);
+  atomic_increment_u32(&shared->woken);
+}
+
+fn_internal void test_sync_manual_event_proc(void *user_data) {
+  Test_Sync_Shared *shared = (Test_Sync_Shared *)user_data;
+  event_wait(&shared->manual_event);
+  atomic_increment_u32(&shared->woken);
+}
+
+fn_internal void test_sync_cond_var_proc(void *user_data) {
+  Test_Sync_Shared *shared = (Test_Sync_Shared *)user_data;
+  mutex_start(&shared->mutex);
+  while (!shared->ready) {
+    cond_var_wait(&shared->cond_var, &shared->mutex);
+  }
+  mutex_end(&shared->mutex);
+
+  atomic_increment_u32(&shared->woken);
+}
+
+// NOTE(cmat): Nobody may leave a round before everyone arrived, the last thread is late.
+fn_internal void test_sync_barrier_proc(void *user_data) {
+  Test_Sync_Shared *shared = (Test_Sync_Shared *)user_data;
+  U32 thread_count = shared->barrier.thread_count;
+  U32 index        = atomic_increment_u32(&shared->woken) - 1;
+
+  For_U32(round, 8) {
+    if (index == thread_count - 1) {
+      test_sync_delay();
+    }
+
+    atomic_increment_u32(&shared->arrived);
+    barrier_wait(&shared->barrier);
+    if (atomic_read_u32(&shared->arrived) < (round + 1) * thread_count) {
+      atomic_increment_u32(&shared->early);
+    }
+
+    barrier_wait(&shared->barrier);
+  }
+}
+
+fn_internal void test_base_sync(void) {
+  log_zone_start("synchronization testing");
+
+  // NOTE(cmat): Single-threaded semantics first, none of these calls may block.
+  Semaphore semaphore = { };
+  semaphore_init(&semaphore, 1);
+  Assert( semaphore_try_wait(&semaphore), "semaphore_try_wait, initial count");
+  Assert(!semaphore_try_wait(&semaphore), "semaphore_try_wait, empty");
+  semaphore_post(&semaphore, 2);
+  semaphore_wait(&semaphore);
+  semaphore_wait(&semaphore);
+  Assert(!semaphore_try_wait(&semaphore), "semaphore_post count");
+
+  Event auto_event = { };
+  event_init(&auto_event, Event_Mode_Auto_Reset);
+  event_signal(&auto_event);
+  event_wait(&auto_event);
+  Assert(!atomic_read_u32(&auto_event.signaled), "auto-reset event should reset on wait");
+
+  Event manual_event = { };
+  event_init(&manual_event, Event_Mode_Manual_Reset);
+  event_signal(&manual_event);
+  event_wait(&manual_event);
+  event_wait(&manual_event);
+  Assert(atomic_read_u32(&manual_event.signaled), "manual-reset event should stay signaled");
+  event_reset(&manual_event);
+  Assert(!atomic_read_u32(&manual_event.signaled), "event_reset");
+
+  Barrier barrier = { };
+  barrier_init(&barrier, 1);
+  Assert(barrier_wait(&barrier) && barrier_wait(&barrier), "single thread barrier, reusable");
+
+  Cond_Var cond_var = { };
+  cond_var_signal(&cond_var);
+  cond_var_broadcast(&cond_var);
+
+  // NOTE(cmat): Then one thread wakes others that are asleep in the wait.
+  enum { Thread_Count = 3 };
+  CO_Thread threads[Thread_Count] = { };
+
+  {
+    Test_Sync_Shared shared = { };
+    semaphore_init(&shared.semaphore, 0);
+    For_U32(it, Thread_Count) threads[it] = thread_launch(str_lit("test semaphore"), test_sync_semaphore_proc, &shared);
+
+    test_sync_delay();
+    Assert(!atomic_read_u32(&shared.woken), "semaphore_wait returned without a post");
+    semaphore_post(&shared.semaphore, 1);
+    while (atomic_read_u32(&shared.woken) < 1) spinlock_pause;
+    test_sync_delay();
+    Assert(atomic_read_u32(&shared.woken) == 1, "one post woke more than one waiter");
+
+    semaphore_post(&shared.semaphore, Thread_Count - 1);
+    For_U32(it, Thread_Count) thread_join(&threads[it]);
+    Assert(!semaphore_try_wait(&shared.semaphore), "semaphore count after wakes");
+  }
+
+  {
+    Test_Sync_Shared shared = { };
+    event_init(&shared.auto_event, Event_Mode_Auto_Reset);
+    For_U32(it, Thread_Count) threads[it] = thread_launch(str_lit("test event"), test_sync_auto_event_proc, &shared);
+
+    For_U32(it, Thread_Count) {
+      test_sync_delay();
+      Assert(atomic_read_u32(&shared.woken) == it, "auto-reset event released the wrong number of waiters");
+      event_signal(&shared.auto_event);
+      while (atomic_read_u32(&shared.woken) < it + 1) spinlock_pause;
+    }
+
+    For_U32(it, Thread_Count) thread_join(&threads[it]);
+    Assert(!atomic_read_u32(&shared.auto_event.signaled), "auto-reset event left signaled");
+  }
+
+  {
+    Test_Sync_Shared shared = { };
+    event_init(&shared.manual_event, Event_Mode_Manual_Reset);
+    For_U32(it, Thread_Count) threads[it] = thread_launch(str_lit("test event"), test_sync_manual_event_proc, &shared);
+
+    test_sync_delay();
+    Assert(!atomic_read_u32(&shared.woken), "event_wait returned before the signal");
+    event_signal(&shared.manual_event);
+    For_U32(it, Thread_Count) thread_join(&threads[it]);
+    Assert(atomic_read_u32(&shared.woken) == Thread_Count, "manual-reset event releases every waiter");
+  }
+
+  {
+    Test_Sync_Shared shared = { };
+    For_U32(it, Thread_Count) threads[it] = thread_launch(str_lit("test cond var"), test_sync_cond_var_proc, &shared);
+
+    test_sync_delay();
+    Assert(!atomic_read_u32(&shared.woken), "cond_var_wait returned before the signal");
+
+    // NOTE(cmat): A signal without a state change must not let anyone through.
+    cond_var_signal(&shared.cond_var);
+    test_sync_delay();
+    Assert(!atomic_read_u32(&shared.woken), "waiter left without its condition");
+
+    Mutex_Scope(&shared.mutex) {
+      shared.ready = 1;
+    }
+
+    cond_var_broadcast(&shared.cond_var);
+    For_U32(it, Thread_Count) thread_join(&threads[it]);
+    Assert(atomic_read_u32(&shared.woken) == Thread_Count, "cond_var_broadcast wakes every waiter");
+  }
+
+  {
+    Test_Sync_Shared shared = { };
+    barrier_init(&shared.barrier, Thread_Count);
+    For_U32(it, Thread_Count) threads[it] = thread_launch(str_lit("test barrier"), test_sync_barrier_proc, &shared);
+    For_U32(it, Thread_Count) thread_join(&threads[it]);
+
+    Assert(!shared.early,                           "thread left the barrier before everyone arrived");
+    Assert(shared.arrived == 8 * Thread_Count,      "barrier rounds");
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Thread_Shared {
+  Barrier      barrier;
+  Semaphore    ping;
+  Semaphore    pong;
+  volatile U32 index_mask;
+  volatile U32 serial_count;
+  volatile U32 scratch_ok;
+} Test_Thread_Shared;
+
+fn_internal void test_thread_proc(void *user_data) {
+  Test_Thread_Shared *shared = (Test_Thread_Shared *)user_data;
+  Thread_Context     *context = thread_context();
+
+  Assert(context->index && context->index < 32, "thread index out of range");
+  atomic_add_u32(&shared->index_mask, 1u << context->index);
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U32 *values = arena_push_count(scratch.arena, U32, 1024);
+    For_U32(it, 1024) values[it] = context->index;
+    if (values[1023] == context->index) {
+      atomic_increment_u32(&shared->scratch_ok);
+    }
+  }
+
+  For_U32(round, 16) {
+    if (barrier_wait(&shared->barrier)) {
+      atomic_increment_u32(&shared->serial_count);
+    }
+  }
+
+  For_U32(it, 64) {
+    semaphore_wait(&shared->ping);
+    semaphore_post(&shared->pong, 1);
+  }
+}
+
+fn_internal void test_thread_count_proc(void *user_data) {
+  atomic_increment_u32((volatile U32 *)user_data);
+}
+
+// NOTE(cmat): Launches and joins race across launchers, so join frees slots while the other
+// - launcher takes them. Every launched thread has to run its own proc on its own data.
+fn_internal void test_thread_launcher_proc(void *user_data) {
+  volatile U32 *counts = (volatile U32 *)user_data;
+  For_U32(it, 128) {
+    CO_Thread thread = thread_launch(str_lit("test churn"), test_thread_count_proc, (void *)(counts + (it & 1)));
+    thread_join(&thread);
+  }
+}
+
+fn_internal void test_base_threads(void) {
+  log_zone_start("thread testing");
+
+  enum { Thread_Count = 4 };
+
+  Test_Thread_Shared shared = { };
+  barrier_init  (&shared.barrier, Thread_Count);
+  semaphore_init(&shared.ping, 0);
+  semaphore_init(&shared.pong, 0);
+
+  Assert(thread_context()->index == 0, "main thread should have index 0");
+
+  CO_Thread threads[Thread_Count] = { };
+  For_U32(it, Thread_Count) {
+    threads[it] = thread_launch(str_lit("test worker"), test_thread_proc, &shared);
+  }
+
+  // NOTE(cmat): Ping-pong, every ping has to be answered by exactly one pong.
+  For_U32(it, 64 * Thread_Count) {
+    semaphore_post(&shared.ping, 1);
+    semaphore_wait(&shared.pong);
+  }
+
+  For_U32(it, Thread_Count) {
+    thread_join(&threads[it]);
+  }
+
+  Assert(u32_count_set_bits(shared.index_mask) == Thread_Count, "thread indices should be unique");
+  Assert(!(shared.index_mask & 1),                              "worker took the main thread index");
+  Assert(shared.scratch_ok   == Thread_Count,                   "per-thread scratch arenas");
+  Assert(shared.serial_count == 16,                             "one serial thread per barrier round");
+  Assert(!semaphore_try_wait(&shared.pong),                     "unanswered pong");
+
+  volatile U32 churn_counts[2 * Thread_Count] = { };
+  For_U32(it, Thread_Count) {
+    threads[it] = thread_launch(str_lit("test launcher"), test_thread_launcher_proc, (void *)(churn_counts + 2 * it));
+  }
+
+  For_U32(it, Thread_Count) {
+    thread_join(&threads[it]);
+  }
+
+  For_U32(it, 2 * Thread_Count) {
+    Assert(churn_counts[it] == 64, "launch record reused while its thread was running");
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Queue_Shared {
+  SPSC_Queue spsc;
+  MPMC_Queue mpmc;
+  MPMC_Queue reply;
+  U64        item_count;
+} Test_Queue_Shared;
+
+typedef struct Test_Queue_Worker {
+  Test_Queue_Shared *shared;
+  U64                id;
+  U64                sum;
+  U64                count;
+} Test_Queue_Worker;
+
+fn_internal void test_queue_spsc_producer(void *user_data) {
+  Test_Queue_Shared *shared = (Test_Queue_Shared *)user_data;
+  for (U64 it = 1; it <= shared->item_count; ++it) {
+    spsc_queue_push_wait(&shared->spsc, &it);
+  }
+}
+
+// NOTE(cmat): Items are (id << 32) | sequence, 0 tells a consumer to stop.
+fn_internal void test_queue_mpmc_producer(void *user_data) {
+  Test_Queue_Worker *worker = (Test_Queue_Worker *)user_data;
+  for (U64 it = 1; it <= worker->shared->item_count; ++it) {
+    U64 item = (worker->id << 32) | it;
+    mpmc_queue_push_wait(&worker->shared->mpmc, &item);
+  }
+}
+
+fn_internal void test_queue_mpmc_consumer(void *user_data) {
+  Test_Queue_Worker *worker = (Test_Queue_Worker *)user_data;
+  for (;;) {
+    U64 item = 0;
+    mpmc_queue_pop_wait(&worker->shared->mpmc, &item);
+    if (!item) break;
+
+    worker->sum   += item;
+    worker->count += 1;
+  }
+}
+
+// NOTE(cmat): Replies can come back to any pinger, each one only counts that it got one
+// - per message and that replies are never zero.
+fn_internal void test_queue_mpmc_ping(void *user_data) {
+  Test_Queue_Worker *worker = (Test_Queue_Worker *)user_data;
+  for (U64 it = 1; it <= worker->shared->item_count; ++it) {
+    U64 item  = (worker->id << 32) | it;
+    U64 reply = 0;
+    mpmc_queue_push_wait(&worker->shared->mpmc,  &item);
+    mpmc_queue_pop_wait (&worker->shared->reply, &reply);
+    worker->count += reply != 0;
+  }
+}
+
+fn_internal void test_queue_mpmc_pong(void *user_data) {
+  Test_Queue_Shared *shared = (Test_Queue_Shared *)user_data;
+  for (;;) {
+    U64 item = 0;
+    mpmc_queue_pop_wait(&shared->mpmc, &item);
+    if (!item) break;
+
+    mpmc_queue_push_wait(&shared->reply, &item);
+  }
+}
+
+fn_internal void test_base_queues(void) {
+  log_zone_start("queue testing");
+
+  enum { Thread_Max = 4, Item_Count = 200000, Stress_Count = 20000, Capacity = 1024 };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Test_Queue_Shared *shared = arena_push_type(scratch.arena, Test_Queue_Shared, .align = Cache_Line_Bytes);
+
+    // NOTE(cmat): Single thread, capacity rounding, full / empty and index wrap around.
+    // #--
+    spsc_queue_init(&shared->spsc, scratch.arena, 5, sizeof(U64));
+    mpmc_queue_init(&shared->mpmc, scratch.arena, 5, sizeof(U64));
+
+    U64 popped_spsc = 0;
+    U64 popped_mpmc = 0;
+    For_U64(round, 1000) {
+      For_U64(it, 8) {
+        U64 item = round * 8 + it;
+        Assert(spsc_queue_push(&shared->spsc, &item), "spsc push below capacity");
+        Assert(mpmc_queue_push(&shared->mpmc, &item), "mpmc push below capacity");
+      }
+
+      U64 item = 0;
+      Assert(!spsc_queue_push(&shared->spsc, &item), "spsc push when full");
+      Assert(!mpmc_queue_push(&shared->mpmc, &item), "mpmc push when full");
+
+      For_U64(it, 8) {
+        Assert(spsc_queue_pop(&shared->spsc, &item) && item == popped_spsc++, "spsc fifo order");
+        Assert(mpmc_queue_pop(&shared->mpmc, &item) && item == popped_mpmc++, "mpmc fifo order");
+      }
+
+      Assert(!spsc_queue_pop(&shared->spsc, &item), "spsc pop when empty");
+      Assert(!mpmc_queue_pop(&shared->mpmc, &item), "mpmc pop when empty");
+    }
+
+    // NOTE(cmat): SPSC across threads, everything arrives once and in order.
+    // #--
+    spsc_queue_init(&shared->spsc, scratch.arena, Capacity, sizeof(U64));
+    shared->item_count = Item_Count;
+
+    U64 start = co_timer_nanoseconds();
+    CO_Thread producer = thread_launch(str_lit("test producer"), test_queue_spsc_producer, shared);
+    for (U64 it = 1; it <= Item_Count; ++it) {
+      U64 item = 0;
+      spsc_queue_pop_wait(&shared->spsc, &item);
+      Assert(item == it, "spsc cross-thread order");
+    }
+    thread_join(&producer);
+    U64 spsc_ns = co_timer_nanoseconds() - start;
+
+    // NOTE(cmat): N pingers and N pongers through two 2-slot queues. Every message is the
+    // - last one in flight until it is answered, so a wakeup lost between claiming a cell
+    // - and publishing it leaves both sides asleep for good.
+    // #--
+    {
+      mpmc_queue_init(&shared->mpmc,  scratch.arena, 2, sizeof(U64));
+      mpmc_queue_init(&shared->reply, scratch.arena, 2, sizeof(U64));
+      shared->item_count = Stress_Count;
+
+      Test_Queue_Worker pingers[Thread_Max] = { };
+      CO_Thread         ping_threads[Thread_Max] = { };
+      CO_Thread         pong_threads[Thread_Max] = { };
+
+      For_U32(it, Thread_Max) {
+        pingers[it]      = (Test_Queue_Worker) { .shared = shared, .id = it + 1 };
+        ping_threads[it] = thread_launch(str_lit("test ping"), test_queue_mpmc_ping, &pingers[it]);
+        pong_threads[it] = thread_launch(str_lit("test pong"), test_queue_mpmc_pong, shared);
+      }
+
+      For_U32(it, Thread_Max) thread_join(&ping_threads[it]);
+
+      U64 stop = 0;
+      For_U32(it, Thread_Max) mpmc_queue_push_wait(&shared->mpmc, &stop);
+      For_U32(it, Thread_Max) thread_join(&pong_threads[it]);
+
+      U64 count = 0;
+      For_U32(it, Thread_Max) count += pingers[it].count;
+      Assert(count == Thread_Max * Stress_Count, "mpmc ping-pong lost or duplicated replies");
+    }
+
+    log_info("correctness - ok");
+
+    // NOTE(cmat): Contention benchmark on the MPMC queue, 1 producer to N consumers and
+    // - N producers to 1 consumer. Sums check that nothing was lost or duplicated.
+    // #--
+    log_info("spsc 1 -> 1  - %.2f M items/s", 1e3 * (F64)Item_Count / (F64)u64_max(spsc_ns, 1));
+
+    Test_Queue_Worker workers[Thread_Max] = { };
+    CO_Thread         threads[Thread_Max] = { };
+
+    for (U32 thread_count = 1; thread_count <= Thread_Max; thread_count *= 2) {
+      mpmc_queue_init(&shared->mpmc, scratch.arena, Capacity, sizeof(U64));
+      U64 total = (U64)Item_Count;
+
+      start = co_timer_nanoseconds();
+      For_U32(it, thread_count) {
+        workers[it] = (Test_Queue_Worker) { .shared = shared, .id = it };
+        threads[it] = thread_launch(str_lit("test consumer"), test_queue_mpmc_consumer, &workers[it]);
+      }
+
+      for (U64 it = 1; it <= total; ++it) {
+        mpmc_queue_push_wait(&shared->mpmc, &it);
+      }
+
+      U64 stop = 0;
+      For_U32(it, thread_count) mpmc_queue_push_wait(&shared->mpmc, &stop);
+
+      U64 sum   = 0;
+      U64 count = 0;
+      For_U32(it, thread_count) {
+        thread_join(&threads[it]);
+        sum   += workers[it].sum;
+        count += workers[it].count;
+      }
+      U64 elapsed_ns = co_timer_nanoseconds() - start;
+
+      Assert(count == total && sum == total * (total + 1) / 2, "mpmc 1 -> N lost or duplicated items");
+      log_info("mpmc 1 -> %u  - %.2f M items/s", thread_count, 1e3 * (F64)total / (F64)u64_max(elapsed_ns, 1));
+    }
+
+    for (U32 thread_count = 1; thread_count <= Thread_Max; thread_count *= 2) {
+      mpmc_queue_init(&shared->mpmc, scratch.arena, Capacity, sizeof(U64));
+      shared->item_count = Item_Count / thread_count;
+      U64 total = shared->item_count * thread_count;
+
+      start = co_timer_nanoseconds();
+      For_U32(it, thread_count) {
+        workers[it] = (Test_Queue_Worker) { .shared = shared, .id = it + 1 };
+        threads[it] = thread_launch(str_lit("test producer"), test_queue_mpmc_producer, &workers[it]);
+      }
+
+      U64 last[Thread_Max + 1] = { };
+      For_U64(it, total) {
+        U64 item = 0;
+        mpmc_queue_pop_wait(&shared->mpmc, &item);
+
+        U64 id       = item >> 32;
+        U64 sequence = item & u32_limit_max;
+        Assert(id && id <= thread_count && sequence == last[id] + 1, "mpmc N -> 1 per-producer order");
+        last[id] = sequence;
+      }
+
+      For_U32(it, thread_count) thread_join(&threads[it]);
+      U64 elapsed_ns = co_timer_nanoseconds() - start;
+
+      U64 item = 0;
+      Assert(!mpmc_queue_pop(&shared->mpmc, &item), "mpmc N -> 1 extra items");
+      log_info("mpmc %u -> 1  - %.2f M items/s", thread_count, 1e3 * (F64)total / (F64)u64_max(elapsed_ns, 1));
+    }
+  }
+
+  log_info("benchmark - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Ring_Shared {
+  Ring_Buffer ring;
+  U64         total_bytes;
+} Test_Ring_Shared;
+
+// NOTE(cmat): Byte i of the stream is (U08)(i * 131 + 7), chunk sizes vary so spans keep
+// - straddling the end of the ring.
+fn_internal void test_ring_producer(void *user_data) {
+  Test_Ring_Shared *shared = (Test_Ring_Shared *)user_data;
+  Random_Seed       rng    = 0x7106;
+
+  U64 written = 0;
+  while (written < shared->total_bytes) {
+    U64  bytes = u64_min(u64_random(&rng, 1, shared->ring.capacity / 2), shared->total_bytes - written);
+    U08 *span  = 0;
+    while (!(span = ring_buffer_write_begin(&shared->ring, bytes))) {
+      co_thread_yield();
+    }
+
+    For_U64(it, bytes) span[it] = (U08)((written + it) * 131 + 7);
+    ring_buffer_write_end(&shared->ring, bytes);
+    written += bytes;
+  }
+}
+
+fn_internal void test_base_ring(void) {
+  log_zone_start("ring buffer testing");
+
+  U64 page_bytes = co_context()->mmu_page_bytes;
+
+  For_U32(mode, 2) {
+    Ring_Buffer ring = { };
+    ring_buffer_init(&ring, page_bytes + 1, mode ? Ring_Buffer_Flag_Copy : 0);
+
+    Assert(ring.capacity == 2 * page_bytes, "ring capacity rounds up to pages");
+    Assert(!mode || !ring.mirrored,         "copy flag disables mirroring");
+
+    // NOTE(cmat): Full / empty, then a write that straddles the end is read back through one pointer.
+    // #--
+    U64  available = 0;
+    ring_buffer_read_begin(&ring, &available);
+    Assert(available == 0,                                     "new ring is empty");
+    Assert(!ring_buffer_write_begin(&ring, ring.capacity + 1), "write larger than the ring");
+    Assert(ring_buffer_write_begin(&ring, ring.capacity),      "write the whole ring");
+
+    U64 head = ring.capacity - 100;
+    U08 *span = ring_buffer_write_begin(&ring, head);
+    memory_fill(span, 0xAB, head);
+    ring_buffer_write_end(&ring, head);
+
+    span = ring_buffer_read_begin(&ring, &available);
+    Assert(available == head && span[head - 1] == 0xAB, "read back head");
+    ring_buffer_read_end(&ring, head);
+
+    U64 straddle = 1000;
+    span = ring_buffer_write_begin(&ring, straddle);
+    Assert(span == ring.base + head, "straddling write starts before the end");
+    For_U64(it, straddle) span[it] = (U08)it;
+    ring_buffer_write_end(&ring, straddle);
+
+    Assert(!ring_buffer_write_begin(&ring, ring.capacity - straddle + 1), "write past a full ring");
+
+    span = ring_buffer_read_begin(&ring, &available);
+    Assert(available == straddle, "straddling span size");
+    For_U64(it, straddle) Assert(span[it] == (U08)it, "straddling span contents");
+    Assert(ring.base[0] == (U08)100, "wrapped bytes visible from the start");
+    ring_buffer_read_end(&ring, straddle);
+
+    // NOTE(cmat): Record stream with the copy helpers.
+    // #--
+    Random_Seed rng      = 0x51A6;
+    U64         next_in  = 0;
+    U64         next_out = 0;
+    For_U32(round, 4096) {
+      U64 record[16] = { };
+      U64 count      = u64_random(&rng, 1, sarray_len(record));
+      For_U64(it, count) record[it] = next_in + it;
+
+      if (ring_buffer_write(&ring, record, count * sizeof(U64))) {
+        next_in += count;
+      }
+
+      U64 pop = u64_random(&rng, 0, sarray_len(record));
+      if (ring_buffer_read(&ring, record, pop * sizeof(U64))) {
+        For_U64(it, pop) Assert(record[it] == next_out + it, "ring record order");
+        next_out += pop;
+      }
+    }
+
+    // NOTE(cmat): Producer thread streaming into the consumer, spans read straight from the ring.
+    // #--
+    Test_Ring_Shared shared = { .ring = ring, .total_bytes = u64_megabytes(16) };
+    ring_buffer_read_begin(&shared.ring, &available);
+    ring_buffer_read_end(&shared.ring, available);
+    Assert(shared.ring.read_at == shared.ring.write_at, "ring drained");
+
+    U64 start = co_timer_nanoseconds();
+    CO_Thread producer = thread_launch(str_lit("test ring producer"), test_ring_producer, &shared);
+
+    U64 read = 0;
+    B32 ok   = 1;
+    while (read < shared.total_bytes) {
+      span = ring_buffer_read_begin(&shared.ring, &available);
+      if (!available) {
+        co_thread_yield();
+        continue;
+      }
+
+      For_U64(it, available) ok &= span[it] == (U08)((read + it) * 131 + 7);
+      ring_buffer_read_end(&shared.ring, available);
+      read += available;
+    }
+
+    thread_join(&producer);
+    U64 elapsed_ns = co_timer_nanoseconds() - start;
+
+    Assert(ok, "ring cross-thread stream contents");
+    log_info("%s - %.2f GB/s", shared.ring.mirrored ? "mirrored" : "copying ", (F64)shared.total_bytes / (F64)u64_max(elapsed_ns, 1));
+
+    ring_buffer_destroy(&shared.ring);
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+typedef struct Test_Parallel_Data {
+  U32          *values;
+  volatile U32 *visits;
+  volatile U32  scratch_ok;
+  volatile U32  nested_ok;
+} Test_Parallel_Data;
+
+fn_internal void test_parallel_nested_proc(void *user_data, Range_U64 range) {
+  Test_Parallel_Data *data = (Test_Parallel_Data *)user_data;
+  For_U64_Range(it, range.min, range.max) atomic_increment_u32(&data->nested_ok);
+}
+
+fn_internal void test_parallel_for_proc(void *user_data, Range_U64 range) {
+  Test_Parallel_Data *data = (Test_Parallel_Data *)user_data;
+
+  For_U64_Range(it, range.min, range.max) {
+    atomic_increment_u32(&data->visits[it]);
+  }
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U64 count = range.max - range.min;
+    U64 *copy = arena_push_count(scratch.arena, U64, count);
+    For_U64(it, count) copy[it] = range.min + it;
+    if (copy[count - 1] == range.max - 1) {
+      atomic_increment_u32(&data->scratch_ok);
+    }
+  }
+
+  if (range.min == 0) {
+    parallel_for(range_u64(0, 100), 10, test_parallel_nested_proc, data);
+  }
+}
+
+fn_internal void test_parallel_burst_proc(void *user_data, Range_U64 range) {
+  volatile U32 *hits = (volatile U32 *)user_data;
+  For_U64_Range(it, range.min, range.max) atomic_increment_u32(&hits[it]);
+}
+
+fn_internal void test_parallel_sum_proc(void *user_data, Range_U64 range, void *partial) {
+  Test_Parallel_Data *data = (Test_Parallel_Data *)user_data;
+  U64 *sum = (U64 *)partial;
+  For_U64_Range(it, range.min, range.max) *sum += data->values[it];
+}
+
+fn_internal void test_parallel_sum_combine(void *user_data, void *result, void *partial) {
+  *(U64 *)result += *(U64 *)partial;
+}
+
+fn_internal void test_base_parallel(void) {
+  log_zone_start("parallel for testing");
+
+  enum { Value_Count = 1 << 20, Grain = 1024 };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Test_Parallel_Data data = { };
+    data.values = arena_push_count(scratch.arena, U32, Value_Count);
+    data.visits = arena_push_count(scratch.arena, U32, Value_Count);
+
+    U64 expected = 0;
+    Random_Seed rng = 1234;
+    For_U32(it, Value_Count) {
+      data.values[it] = (U32)(random_next(&rng) & 0xFFFF);
+      expected += data.values[it];
+    }
+
+    parallel_for(range_u64(0, Value_Count), Grain, test_parallel_for_proc, &data);
+
+    For_U32(it, Value_Count) Assert(data.visits[it] == 1, "parallel_for visits every index once");
+    Assert(data.scratch_ok > 0 && data.scratch_ok <= Parallel_Chunks_Per_Thread * parallel_thread_count(), "per-chunk scratch");
+    Assert(data.nested_ok == 100, "nested parallel_for");
+
+    U64 sum = 0;
+    parallel_reduce(range_u64(0, Value_Count), Grain, test_parallel_sum_proc, test_parallel_sum_combine, &data, &sum, sizeof(sum));
+    Assert(sum == expected, "parallel_reduce sum");
+
+    sum = 7;
+    parallel_reduce(range_u64(10, 10), Grain, test_parallel_sum_proc, test_parallel_sum_combine, &data, &sum, sizeof(sum));
+    Assert(sum == 7, "parallel_reduce over an empty range keeps the identity");
+
+    sum = 0;
+    parallel_reduce(range_u64(0, 3), Grain, test_parallel_sum_proc, test_parallel_sum_combine, &data, &sum, sizeof(sum));
+    Assert(sum == (U64)data.values[0] + data.values[1] + data.values[2], "parallel_reduce below one grain");
+
+    // NOTE(cmat): Many tiny jobs back to back, workers go back to sleep between nearly every one,
+    // - so a lost wakeup in the job queue shows up as a hang here.
+    enum { Burst_Count = 5000, Burst_Width = 64 };
+    volatile U32 *hits = arena_push_count(scratch.arena, U32, Burst_Width);
+    U64 burst_expected = 0;
+    U64 burst_sum      = 0;
+    For_U32(it, Burst_Count) {
+      U64 width = 1 + it % Burst_Width;
+      parallel_for(range_u64(0, width), 1, test_parallel_burst_proc, (void *)hits);
+
+      U64 partial = 0;
+      parallel_reduce(range_u64(0, width), 4, test_parallel_sum_proc, test_parallel_sum_combine, &data, &partial, sizeof(partial));
+      burst_sum += partial;
+      For_U64(index, width) burst_expected += data.values[index];
+    }
+
+    For_U32(it, Burst_Width) {
+      U32 covering = 0;
+      For_U32(job, Burst_Count) covering += (it < 1 + job % Burst_Width);
+      Assert(hits[it] == covering, "back to back parallel_for visits");
+    }
+    Assert(burst_sum == burst_expected, "back to back parallel_reduce sums");
+
+    // NOTE(cmat): Shutdown joins every worker (one that doesn't exit hangs here), the next call
+    // - starts a fresh pool.
+    U32 thread_count = parallel_thread_count();
+    For_U32(round, 2) {
+      U32 worker_count = Parallel_Pool.worker_count;
+      parallel_pool_shutdown();
+
+      Assert(!Parallel_Pool.initialized && !Parallel_Pool.worker_count, "pool shut down");
+      For_U32(it, worker_count) {
+        Assert(!Parallel_Pool.workers[it].slot, "pool worker not joined");
+      }
+
+      sum = 0;
+      parallel_reduce(range_u64(0, Value_Count), Grain, test_parallel_sum_proc, test_parallel_sum_combine, &data, &sum, sizeof(sum));
+      Assert(sum == expected,                         "parallel_reduce after a pool restart");
+      Assert(parallel_thread_count() == thread_count, "restarted pool thread count");
+    }
+
+    log_info("threads: %u", parallel_thread_count());
+    log_info("correctness - ok");
+  }
+
+  log_zone_end();
+}
+
+fn_internal void test_base_sort(void) {
+  log_zone_start("radix sort testing");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U64 counts[] = { 0, 1, 2, 100, 5000, Radix_Sort_Wide_Count + 17, Radix_Sort_Parallel_Count + 3 };
+    Random_Seed rng = 1234;
+
+    For_U32(test, sarray_len(counts)) {
+      U64 count = counts[test];
+
+      U32           *keys_u32  = arena_push_count(scratch.arena, U32,           count + 1);
+      U32           *copy_u32  = arena_push_count(scratch.arena, U32,           count + 1);
+      U64           *keys_u64  = arena_push_count(scratch.arena, U64,           count + 1);
+      Sort_Pair_U32 *pairs_u32 = arena_push_count(scratch.arena, Sort_Pair_U32, count + 1);
+      Sort_Pair_U64 *pairs_u64 = arena_push_count(scratch.arena, Sort_Pair_U64, count + 1);
+      Sort_Pair_F32 *pairs_f32 = arena_push_count(scratch.arena, Sort_Pair_F32, count + 1);
+      F32           *keys_f32  = arena_push_count(scratch.arena, F32,           count + 1);
+
+      F32 specials[] = { -1.f / 0.f, -1e30f, -1.f, -1e-40f, -0.f, 0.f, 1e-40f, 1.f, 1e30f, 1.f / 0.f };
+
+      U64 checksum_u32 = 0;
+      U64 checksum_u64 = 0;
+      For_U64(it, count) {
+        keys_u32[it]  = (U32)random_next(&rng);
+        copy_u32[it]  = keys_u32[it];
+        keys_u64[it]  = random_next(&rng);
+        pairs_u32[it] = (Sort_Pair_U32) { .key = (U32)(random_next(&rng) % 16),        .index = (U32)it };
+        pairs_u64[it] = (Sort_Pair_U64) { .key = (random_next(&rng) % 16) << 40,       .index = (U32)it };
+        keys_f32[it]  = (it % 7) ? f32_random_unilateral(&rng) * 2e6f - 1e6f : specials[it % sarray_len(specials)];
+        pairs_f32[it] = (Sort_Pair_F32) { .key = (F32)(I32)(random_next(&rng) % 9) - 4.f, .index = (U32)it };
+
+        checksum_u32 += keys_u32[it];
+        checksum_u64 += keys_u64[it];
+      }
+
+      radix_sort_u32          (scratch.arena, keys_u32,  count);
+      radix_sort_u32_parallel (scratch.arena, copy_u32,  count);
+      radix_sort_u64_parallel (scratch.arena, keys_u64,  count);
+      radix_sort_pairs_u32    (scratch.arena, pairs_u32, count);
+      radix_sort_pairs_u64    (scratch.arena, pairs_u64, count);
+      radix_sort_f32_parallel (scratch.arena, keys_f32,  count);
+      radix_sort_pairs_f32    (scratch.arena, pairs_f32, count);
+
+      For_U64(it, count) {
+        checksum_u32 -= keys_u32[it];
+        checksum_u64 -= keys_u64[it];
+        Assert(keys_u32[it] == copy_u32[it], "serial and parallel sort agree");
+      }
+
+      Assert(!checksum_u32 && !checksum_u64, "sort keeps the keys");
+
+      For_U64_Range(it, 1, count) {
+        Assert(keys_u32[it - 1] <= keys_u32[it], "u32 keys sorted");
+        Assert(keys_u64[it - 1] <= keys_u64[it], "u64 keys sorted");
+        Assert(keys_f32[it - 1] <= keys_f32[it], "f32 keys sorted");
+
+        Assert(pairs_u32[it - 1].key <  pairs_u32[it].key || (pairs_u32[it - 1].key == pairs_u32[it].key && pairs_u32[it - 1].index < pairs_u32[it].index), "u32 pairs sorted, stable");
+        Assert(pairs_u64[it - 1].key <  pairs_u64[it].key || (pairs_u64[it - 1].key == pairs_u64[it].key && pairs_u64[it - 1].index < pairs_u64[it].index), "u64 pairs sorted, stable");
+        Assert(pairs_f32[it - 1].key <  pairs_f32[it].key || (pairs_f32[it - 1].key == pairs_f32[it].key && pairs_f32[it - 1].index < pairs_f32[it].index), "f32 pairs sorted, stable");
+      }
+    }
+
+    // NOTE(cmat): -0 sorts right before +0.
+    F32 zeros[] = { 0.f, -0.f, 0.f, -0.f };
+    radix_sort_f32(scratch.arena, zeros, sarray_len(zeros));
+    Assert(1.f / zeros[0] < 0 && 1.f / zeros[1] < 0 && 1.f / zeros[2] > 0 && 1.f / zeros[3] > 0, "negative zero order");
+
+    log_info("correctness - ok");
+
+    enum { Bench_Count = 1 << 22 };
+    U32 *keys = arena_push_count(scratch.arena, U32, Bench_Count, .flags = 0);
+
+    For_U32(it, Bench_Count) keys[it] = (U32)random_next(&rng);
+    U64 serial_ns = co_timer_nanoseconds();
+    radix_sort_u32(scratch.arena, keys, Bench_Count);
+    serial_ns = co_timer_nanoseconds() - serial_ns;
+
+    For_U32(it, Bench_Count) keys[it] = (U32)random_next(&rng);
+    U64 parallel_ns = co_timer_nanoseconds();
+    radix_sort_u32_parallel(scratch.arena, keys, Bench_Count);
+    parallel_ns = co_timer_nanoseconds() - parallel_ns;
+
+    log_info("u32 x %u - serial %.2f ms, parallel %.2f ms", Bench_Count, (F64)serial_ns / 1e6, (F64)parallel_ns / 1e6);
+    log_info("benchmark - ok");
+  }
+
+  log_zone_end();
+}
+
+typedef struct Test_Task {
+  volatile U32 *clock;
+  U32           start;
+  U32           end;
+  U32           thread_index;
+} Test_Task;
+
+fn_internal void test_task_proc(void *user_data) {
+  Test_Task *task = (Test_Task *)user_data;
+  task->start        = atomic_increment_u32(task->clock);
+  task->thread_index = thread_context()->index;
+
+  volatile U64 sink = 0;
+  For_U32(it, 20000) sink += it;
+
+  task->end = atomic_increment_u32(task->clock);
+}
+
+typedef struct Test_Task_Nested {
+  volatile U32 *hits;
+  volatile U32  chunks;
+} Test_Task_Nested;
+
+fn_internal void test_task_nested_chunk_proc(void *user_data, Range_U64 range) {
+  Test_Task_Nested *nested = (Test_Task_Nested *)user_data;
+  atomic_increment_u32(&nested->chunks);
+  For_U64_Range(it, range.min, range.max) atomic_increment_u32(&nested->hits[it]);
+}
+
+fn_internal void test_task_nested_proc(void *user_data) {
+  Test_Task_Nested *nested = (Test_Task_Nested *)user_data;
+  parallel_for(range_u64(0, 4096), 64, test_task_nested_chunk_proc, nested);
+}
+
+fn_internal void test_base_task_graph(void) {
+  log_zone_start("task graph testing");
+
+  enum { Task_Count = 64, Resource_Count = 6 };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    volatile U32 clock = 0;
+    Test_Task    data[Task_Count] = { };
+
+    Task_Graph graph = { };
+    task_graph_begin(&graph, scratch.arena);
+
+    Random_Seed rng = 1234;
+    U64 reads [Task_Count] = { };
+    U64 writes[Task_Count] = { };
+    For_U32(it, Task_Count) {
+      reads [it] = Task_Resource(random_next(&rng) % Resource_Count);
+      writes[it] = (random_next(&rng) % 3) ? 0 : Task_Resource(random_next(&rng) % Resource_Count);
+
+      data[it].clock = &clock;
+      task_graph_add(&graph, str_lit("test task"), test_task_proc, &data[it], reads[it], writes[it],
+                     (it % 8) ? Task_Flag_None : Task_Flag_Calling_Thread);
+    }
+
+    task_graph_execute(&graph);
+
+    For_U32(it, Task_Count) {
+      Assert(data[it].end, "every task ran");
+      if (!(it % 8)) {
+        Assert(data[it].thread_index == thread_context()->index, "calling thread task ran elsewhere");
+      }
+
+      For_U32(before, it) {
+        B32 conflict = (writes[before] & (reads[it] | writes[it])) || (reads[before] & writes[it]);
+        if (conflict) {
+          Assert(data[before].end < data[it].start, "task started before its dependency finished");
+        }
+      }
+    }
+
+    U64 critical_ns = task_graph_critical_path(&graph);
+    U64 chain_ns    = 0;
+    for (Task *it = graph.first; it; it = it->next) {
+      if (it->critical) chain_ns += it->end_ns - it->start_ns;
+    }
+
+    Assert(critical_ns && critical_ns == chain_ns, "critical path length");
+
+    Str trace = task_graph_trace(&graph, scratch.arena);
+    Assert(trace.len && trace.txt[0] == '[' && str_contains(trace, str_lit("\"critical\":1")), "trace output");
+
+    // NOTE(cmat): Empty graph.
+    task_graph_begin(&graph, scratch.arena);
+    task_graph_execute(&graph);
+
+    // NOTE(cmat): Jobs started from inside tasks are split across the graph's threads.
+    enum { Nested_Count = 8 };
+    Test_Task_Nested nested[Nested_Count] = { };
+    task_graph_begin(&graph, scratch.arena);
+    For_U32(it, Nested_Count) {
+      nested[it].hits = arena_push_count(scratch.arena, U32, 4096);
+      task_graph_add(&graph, str_lit("nested task"), test_task_nested_proc, &nested[it], 0, 0,
+                     (it % 4) ? Task_Flag_None : Task_Flag_Calling_Thread);
+    }
+
+    task_graph_execute(&graph);
+
+    For_U32(it, Nested_Count) {
+      For_U32(index, 4096) Assert(nested[it].hits[index] == 1, "nested parallel_for visits every index once");
+      Assert(parallel_thread_count() == 1 || nested[it].chunks > 1, "nested parallel_for ran serially inside a task");
+    }
+
+    log_info("correctness - ok");
+  }
+
+  log_zone_end();
+}
+
+typedef struct Test_Fiber {
+  U32  id;
+  U32  steps;
+  U32 *log;
+  U32 *log_count;
+} Test_Fiber;
+
+fn_internal void test_fiber_proc(void *user_data) {
+  Test_Fiber *data = (Test_Fiber *)user_data;
+
+  // NOTE(cmat): Locals have to survive the yields, and recursion has to fit on the fiber stack.
+  U32 local = data->id * 1000;
+  For_U32(it, data->steps) {
+    data->log[(*data->log_count)++] = local + it;
+    Assert(fiber_current() && fiber_current()->context.user_data == data, "current fiber");
+    fiber_yield();
+  }
+
+  U08 stack_use[16 * 1024];
+  memory_fill(stack_use, (U08)data->id, sizeof(stack_use));
+  Assert(stack_use[sizeof(stack_use) - 1] == (U08)data->id, "fiber stack usable");
+}
+
+fn_internal void test_fiber_spawn_proc(void *user_data) {
+  Test_Fiber *data = (Test_Fiber *)user_data;
+  data->steps += 1;
+  fiber_yield();
+  data->steps += 1;
+}
+
+fn_internal void test_fiber_yield_proc(void *user_data) {
+  Test_Fiber *data = (Test_Fiber *)user_data;
+  For_U32(it, data->steps) {
+    fiber_yield();
+  }
+}
+
+fn_internal void test_base_fibers(void) {
+  log_zone_start("fiber testing");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    enum { Fiber_Count = 4 };
+
+    Fiber_Scheduler scheduler = { };
+    fiber_scheduler_init(&scheduler, scratch.arena, Fiber_Count, 0);
+
+    U32        log[64]           = { };
+    U32        log_count         = 0;
+    Test_Fiber data[Fiber_Count] = { };
+    For_U32(it, Fiber_Count) {
+      data[it] = (Test_Fiber) { .id = it + 1, .steps = it, .log = log, .log_count = &log_count };
+      fiber_spawn(&scheduler, str_lit("test fiber"), test_fiber_proc, &data[it]);
+    }
+
+    // NOTE(cmat): Round robin, fiber i yields i times, so it finishes on run i + 1.
+    U32 runs = 0;
+    while (fiber_scheduler_run(&scheduler)) {
+      runs += 1;
+      Assert(scheduler.live_count == Fiber_Count - runs, "one fiber finishes per run");
+    }
+
+    Assert(runs + 1 == Fiber_Count, "run count");
+    Assert(!fiber_current(), "no current fiber outside of run");
+
+    U32 expect = 0;
+    For_U32(step, Fiber_Count) {
+      For_U32(it, Fiber_Count) {
+        if (step < data[it].steps) {
+          Assert(log[expect] == data[it].id * 1000 + step, "fiber interleaving order");
+          expect += 1;
+        }
+      }
+    }
+
+    Assert(expect == log_count, "fiber log count");
+
+    // NOTE(cmat): Finished slots are recycled, more fibers than capacity over time.
+    For_U32(round, 3) {
+      Test_Fiber counters[Fiber_Count] = { };
+      For_U32(it, Fiber_Count) {
+        fiber_spawn(&scheduler, str_lit("recycled fiber"), test_fiber_spawn_proc, &counters[it]);
+      }
+
+      fiber_scheduler_run(&scheduler);
+      For_U32(it, Fiber_Count) Assert(counters[it].steps == 1, "fiber yielded");
+
+      fiber_scheduler_run(&scheduler);
+      For_U32(it, Fiber_Count) Assert(counters[it].steps == 2, "fiber finished");
+      Assert(scheduler.live_count == 0 && scheduler.first == 0, "scheduler empty");
+    }
+
+    fiber_scheduler_destroy(&scheduler);
+
+    // NOTE(cmat): Switch cost, one run is a switch into the fiber and a yield back out.
+    fiber_scheduler_init(&scheduler, scratch.arena, 1, 0);
+
+    enum { Yield_Count = 100000 };
+    Test_Fiber bench = { .steps = Yield_Count };
+    fiber_spawn(&scheduler, str_lit("bench fiber"), test_fiber_yield_proc, &bench);
+
+    U64 begin = co_timer_nanoseconds();
+    while (fiber_scheduler_run(&scheduler));
+    U64 end = co_timer_nanoseconds();
+
+    log_info("switch round trip - %.1f ns", (F64)(end - begin) / (F64)Yield_Count);
+
+    fiber_scheduler_destroy(&scheduler);
+    log_info("correctness - ok");
+  }
+
+  log_zone_end();
+}
+
+// NOTE(cmat): h is the nearest F16 / BF16 to x when no neighbour of h is closer, and ties
+// - land on an even mantissa. Checked in F64, where every value involved is exact.
+fn_internal B32 test_half_is_nearest(F64 x, U16 h, F32 (*to_f32)(U16)) {
+  F64 y    = to_f32(h);
+  F64 err  = f64_abs(x - y);
+  U16 down = (h & 0x7FFF) ? (U16)(h - 1) : h;
+  F64 next = f64_abs(x - (F64)to_f32((U16)(h + 1)));
+  F64 prev = f64_abs(x - (F64)to_f32(down));
+
+  B32 nearest = err <= next && err <= prev;
+  B32 tie     = err == next || (down != h && err == prev);
+  return nearest && (!tie || !(h & 1));
+}
+
+fn_internal F32 test_f32_from_f16  (U16 x) { return f32_from_f16(x);  }
+fn_internal F32 test_f32_from_bf16 (U16 x) { return f32_from_bf16(x); }
+
+fn_internal void test_base_half(void) {
+  log_zone_start("half precision testing");
+
+  Assert(f16_from_f32(1.f) == 0x3C00 && f32_from_f16(0x3C00) == 1.f, "f16 one");
+  Assert(f16_from_f32(-2.f) == 0xC000, "f16 sign");
+  Assert(f16_from_f32(65504.f) == 0x7BFF && f16_from_f32(65519.f) == 0x7BFF, "f16 largest finite");
+  Assert(f16_from_f32(65520.f) == 0x7C00 && f16_from_f32(1e10f) == 0x7C00, "f16 overflow to infinity");
+  Assert(f16_from_f32(-1.f / 0.f) == 0xFC00, "f16 negative infinity");
+  Assert((f16_from_f32(0.f / 0.f) & 0x7E00) == 0x7E00, "f16 quiet nan");
+  Assert(f16_from_f32(1.f + 1.f / 2048.f) == 0x3C00 && f16_from_f32(1.f + 3.f / 2048.f) == 0x3C02, "f16 ties to even");
+  Assert(f32_from_f16(0x0001) == 1.f / 16777216.f && f16_from_f32(1.f / 16777216.f) == 0x0001, "f16 smallest denormal");
+  Assert(f16_from_f32(1.f / 33554432.f) == 0 && f16_from_f32(3.f / 33554432.f) == 0x0002, "f16 denormal ties to even");
+  Assert(f16_from_f32(1e-30f) == 0 && f16_from_f32(-1e-30f) == 0x8000, "f16 underflow keeps the sign");
+  Assert(bf16_from_f32(1.f) == 0x3F80 && f32_from_bf16(0x3F80) == 1.f, "bf16 one");
+  Assert(bf16_from_f32(f32_largest_positive) == 0x7F80, "bf16 overflow to infinity");
+
+  // NOTE(cmat): Every F16 survives the trip through F32, NaNs come back quiet.
+  For_U32(it, 1 << 16) {
+    U16 half     = (U16)it;
+    B32 nan      = (half & 0x7C00) == 0x7C00 && (half & 0x3FF);
+    U16 expected = nan ? (half | 0x200) : half;
+    Assert(f16_from_f32(f32_from_f16(half)) == expected, "f16 round trip");
+    Assert(bf16_from_f32(f32_from_bf16(half)) == (U16)((half & 0x7F80) == 0x7F80 && (half & 0x7F) ? half | 0x40 : half), "bf16 round trip");
+  }
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    enum { Value_Count = 1 << 20 };
+
+    F32  *values = arena_push_count(scratch.arena, F32,  Value_Count + 3, .flags = 0);
+    F32  *wide   = arena_push_count(scratch.arena, F32,  Value_Count + 3, .flags = 0);
+    F16  *half   = arena_push_count(scratch.arena, F16,  Value_Count + 3, .flags = 0);
+    BF16 *brain  = arena_push_count(scratch.arena, BF16, Value_Count + 3, .flags = 0);
+
+    // NOTE(cmat): Random bit patterns (every exponent, denormals, infinities and NaNs),
+    // - then random values in and around the F16 range.
+    Random_Seed rng = 0x16;
+    For_U32(it, Value_Count) {
+      U32 bits = (U32)random_next(&rng);
+      if (it & 1) {
+        bits = (bits & 0x80FFFFFF) | ((U32)u64_random(&rng, 100, 145) << 23);
+      }
+
+      memory_copy(values + it, &bits, sizeof(bits));
+    }
+
+    For_U32(it, Value_Count) {
+      F32 x = values[it];
+      if (x != x) continue;
+
+      if (f32_abs(x) <= 65504.f) {
+        Assert(test_half_is_nearest(x, f16_from_f32(x), test_f32_from_f16), "f16 rounding");
+      }
+
+      if (f32_abs(x) <= f32_from_bf16(0x7F7F)) {
+        Assert(test_half_is_nearest(x, bf16_from_f32(x), test_f32_from_bf16), "bf16 rounding");
+      }
+    }
+
+    // NOTE(cmat): Arrays against the scalar functions, with a count that leaves a scalar tail.
+    U64 count = Value_Count + 3;
+    For_U64_Range(it, Value_Count, count) values[it] = (F32)it;
+
+    f16_from_f32_array(count, values, half);
+    f32_from_f16_array(count, half, wide);
+    For_U64(it, count) {
+      Assert(half[it] == f16_from_f32(values[it]), "f16 array conversion");
+      U32 lhs, rhs; F32 expected = f32_from_f16(half[it]);
+      memory_copy(&lhs, wide + it, sizeof(lhs));
+      memory_copy(&rhs, &expected, sizeof(rhs));
+      Assert(lhs == rhs, "f16 array widening");
+    }
+
+    bf16_from_f32_array(count, values, brain);
+    f32_from_bf16_array(count, brain, wide);
+    For_U64(it, count) {
+      Assert(brain[it] == bf16_from_f32(values[it]), "bf16 array conversion");
+      Assert(f32_from_bf16(brain[it]) == wide[it] || wide[it] != wide[it], "bf16 array widening");
+    }
+
+    // NOTE(cmat): In place, the F16 values end up packed in the front of the F32 buffer.
+    memory_copy(wide, values, count * sizeof(F32));
+    f16_from_f32_array(count, wide, (F16 *)wide);
+    Assert(memory_compare(wide, half, count * sizeof(F16)), "f16 in place conversion");
+
+    memory_copy(wide, values, count * sizeof(F32));
+    bf16_from_f32_array(count, wide, (BF16 *)wide);
+    Assert(memory_compare(wide, brain, count * sizeof(BF16)), "bf16 in place conversion");
+
+    log_info("correctness - ok");
+
+    U64 start = co_timer_nanoseconds();
+    f16_from_f32_array(count, values, half);
+    U64 narrow_ns = co_timer_nanoseconds() - start;
+
+    start = co_timer_nanoseconds();
+    f32_from_f16_array(count, half, wide);
+    U64 widen_ns = co_timer_nanoseconds() - start;
+
+    log_info("f32 -> f16: %.2f GB/s, f16 -> f32: %.2f GB/s", (F64)(count * sizeof(F32)) / (F64)narrow_ns, (F64)(count * sizeof(F32)) / (F64)widen_ns);
+    log_info("benchmark - ok");
+  }
+
+  log_zone_end();
+}
+
+fn_internal B32 test_color_close(V3F lhs, V3F rhs, F32 tolerance) {
+  return f32_abs(lhs.x - rhs.x) <= tolerance && f32_abs(lhs.y - rhs.y) <= tolerance && f32_abs(lhs.z - rhs.z) <= tolerance;
+}
+
+fn_internal void test_base_colors(void) {
+  log_zone_start("color space testing");
+
+  Assert(test_color_close(hsv_from_rgb(v3f(1, 0, 0)), v3f(0,        1, 1),  1e-6f), "hsv red");
+  Assert(test_color_close(hsv_from_rgb(v3f(0, 1, 0)), v3f(1.f / 3,  1, 1),  1e-6f), "hsv green");
+  Assert(test_color_close(hsv_from_rgb(v3f(0, 0, 1)), v3f(2.f / 3,  1, 1),  1e-6f), "hsv blue");
+  Assert(test_color_close(hsv_from_rgb(v3f(1, 0, 1)), v3f(5.f / 6,  1, 1),  1e-6f), "hsv magenta");
+  Assert(test_color_close(hsv_from_rgb(v3f(.5f, .5f, .5f)), v3f(0, 0, .5f), 1e-6f), "hsv gray");
+  Assert(test_color_close(hsv_from_rgb(v3f(0, 0, 0)), v3f(0, 0, 0),         1e-6f), "hsv black");
+
+  Assert(f32_abs(f32_linear_from_srgb(0.5f) - 0.21404114f) < 1e-6f, "srgb decode");
+  Assert(f32_abs(f32_srgb_from_linear(0.21404114f) - 0.5f) < 1e-6f, "srgb encode");
+  Assert(f32_linear_from_srgb(0.f) == 0.f && f32_abs(f32_linear_from_srgb(1.f) - 1.f) < 1e-6f, "srgb end points");
+
+  Assert(abgr_u32_from_rgba(v4f(1.f, .5f, 0.f, 1.f)) == 0xFF0080FF, "abgr packing rounds");
+  Assert(rgba_u32_from_rgba(v4f(1.f, .5f, 0.f, 1.f)) == 0xFF8000FF, "rgba packing");
+  Assert(abgr_u32_from_rgba(v4f(2.f, -1.f, 0.f, 1.f)) == 0xFF0000FF, "packing saturates");
+  Assert(abgr_u32_from_rgba(rgba_from_abgr_u32(0x80402010)) == 0x80402010, "abgr unpack");
+  Assert(rgba_u32_from_rgba(rgba_from_rgba_u32(0x80402010)) == 0x80402010, "rgba unpack");
+  Assert(abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, .5f)) == 0x80808080, "premultiplied packing");
+
+  RGBA straight = rgba_from_rgba_premul(rgba_premul_from_rgba(v4f(.2f, .4f, .6f, .5f)));
+  Assert(test_color_close(straight.rgb, v3f(.2f, .4f, .6f), 1e-6f), "premultiply round trip");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    enum { Color_Count = 4099 };
+
+    RGB      *rgb     = arena_push_count(scratch.arena, RGB,      Color_Count);
+    HSV      *hsv     = arena_push_count(scratch.arena, HSV,      Color_Count);
+    RGB      *result  = arena_push_count(scratch.arena, RGB,      Color_Count);
+    RGBA     *rgba    = arena_push_count(scratch.arena, RGBA,     Color_Count);
+    RGBA     *premul  = arena_push_count(scratch.arena, RGBA,     Color_Count);
+    RGBA_U32 *packed  = arena_push_count(scratch.arena, RGBA_U32, Color_Count);
+
+    Random_Seed rng = 0xC010;
+    For_U32(it, Color_Count) {
+      rgb[it]  = v3f(f32_random_unilateral(&rng), f32_random_unilateral(&rng), f32_random_unilateral(&rng));
+      rgba[it] = v4f(rgb[it].r, rgb[it].g, rgb[it].b, f32_random_unilateral(&rng));
+    }
+
+    // NOTE(cmat): Grays, primaries and the edges of the unit cube.
+    For_U32(it, 64) {
+      rgb[it] = v3f((it & 3) / 3.f, ((it >> 2) & 3) / 3.f, ((it >> 4) & 3) / 3.f);
+    }
+
+    hsv_from_rgb_array(Color_Count, rgb, hsv);
+    For_U32(it, Color_Count) {
+      Assert(test_color_close(hsv[it], hsv_from_rgb(rgb[it]), 1e-6f), "hsv_from_rgb_array");
+      Assert(test_color_close(rgb_from_hsv(hsv[it]), rgb[it], 1e-5f), "hsv round trip");
+    }
+
+    rgb_from_hsv_array(Color_Count, hsv, result);
+    For_U32(it, Color_Count) Assert(test_color_close(result[it], rgb_from_hsv(hsv[it]), 1e-6f), "rgb_from_hsv_array");
+
+    linear_from_srgb_array(Color_Count, rgb, result);
+    For_U32(it, Color_Count) Assert(test_color_close(result[it], linear_from_srgb(rgb[it]), 2e-6f), "linear_from_srgb_array");
+
+    srgb_from_linear_array(Color_Count, result, result);
+    For_U32(it, Color_Count) Assert(test_color_close(result[it], rgb[it], 4e-6f), "srgb round trip");
+
+    rgba_premul_from_rgba_array(Color_Count, rgba, premul);
+    For_U32(it, Color_Count) {
+      RGBA expected = rgba_premul_from_rgba(rgba[it]);
+      Assert(memory_compare(&premul[it], &expected, sizeof(RGBA)), "rgba_premul_from_rgba_array");
+    }
+
+    abgr_u32_from_rgba_array(Color_Count, rgba, packed);
+    For_U32(it, Color_Count) Assert(packed[it] == abgr_u32_from_rgba(rgba[it]), "abgr_u32_from_rgba_array");
+
+    abgr_u32_from_rgba_premul_array(Color_Count, rgba, packed);
+    For_U32(it, Color_Count) Assert(packed[it] == abgr_u32_from_rgba_premul(rgba[it]), "abgr_u32_from_rgba_premul_array");
+
+    log_info("correctness - ok");
+
+    U64 start = co_timer_nanoseconds();
+    For_U32(it, Color_Count) result[it] = rgb_from_hsv(hsv[it]);
+    U64 scalar_ns = co_timer_nanoseconds() - start;
+
+    start = co_timer_nanoseconds();
+    rgb_from_hsv_array(Color_Count, hsv, result);
+    U64 array_ns = co_timer_nanoseconds() - start;
+
+    log_info("rgb_from_hsv x %u - scalar %.2f us, array %.2f us", Color_Count, (F64)scalar_ns / 1e3, (F64)array_ns / 1e3);
+
+    start = co_timer_nanoseconds();
+    For_U32(it, Color_Count) result[it] = linear_from_srgb(rgb[it]);
+    scalar_ns = co_timer_nanoseconds() - start;
+
+    start = co_timer_nanoseconds();
+    linear_from_srgb_array(Color_Count, rgb, result);
+    array_ns = co_timer_nanoseconds() - start;
+
+    log_info("linear_from_srgb x %u - scalar %.2f us, array %.2f us", Color_Count, (F64)scalar_ns / 1e3, (F64)array_ns / 1e3);
+    log_info("benchmark - ok");
+  }
+
+  log_zone_end();
+}
+
 fn_internal void test_base_all(void) {
   Log_Zone_Scope("testing base subsystem") {
     test_base_allocation();
+    test_base_hash();
+    test_base_crc32();
+    test_base_half();
+    test_base_colors();
+    test_base_strings();
+    test_base_parse();
+    test_base_atoms();
+    test_base_sync();
+    test_base_threads();
+    test_base_queues();
+    test_base_ring();
+    test_base_parallel();
+    test_base_sort();
+    test_base_task_graph();
+    test_base_fibers();
   }
 }
@@ -4,12 +4,35 @@
 // ------------------------------------------------------------
 // #-- String Operations.
 fn_internal U64 cstring_len(char *cstring) {
+#if U08_X16_Available && !ASAN_ENABLED
+
+  // NOTE(cmat): Aligned 16-byte loads never cross a page boundary, so reading
+  // - past the terminator (or before the start, in the first block) can't fault.
+  U08    *block   = (U08 *)((UAddr)cstring & ~(UAddr)15);
+  U08_X16 zero    = u08_x16_splat(0);
+  U64     skip    = (U64)((U08 *)cstring - block);
+  U64     mask    = u08_x16_mask(u08_x16_equal(u08_x16_load(block), zero)) >> (skip * U08_X16_Mask_Stride);
+
+  if (mask) {
+    return u64_count_trailing_zeros(mask) / U08_X16_Mask_Stride;
+  }
+
+  for (;;) {
+    block += 16;
+    mask   = u08_x16_mask(u08_x16_equal(u08_x16_load(block), zero));
+    if (mask) {
+      return (U64)(block - (U08 *)cstring) + u64_count_trailing_zeros(mask) / U08_X16_Mask_Stride;
+    }
+  }
+
+#else
   U64 len = 0;
   while(*cstring++) {
     len++;
   }
   
   return len;
+#endif
 }
 
 fn_internal Str str_slice(Str base, U64 start, U64 len) {
@@ -38,7 +61,7 @@ fn_internal Str str_trim(Str string) {
 
   U64 end = string.len;
   For_U64_Reverse(it, string.len) {
-    if (char_is_whitespace(string.txt[it])) {
+    if (it >= start && char_is_whitespace(string.txt[it])) {
       end--;
     } else {
       break;
@@ -48,15 +71,42 @@ fn_internal Str str_trim(Str string) {
   return str_slice(string, start, end - start);
 }
 
+// NOTE(cmat): Compares 16 bytes at a time, then the tail one by one.
+fn_internal B32 str_bytes_equal(U08 *lhs, U08 *rhs, U64 bytes, B32 any_case) {
+  U64 it = 0;
+
+#if U08_X16_Available
+  for (; it + 16 <= bytes; it += 16) {
+    U08_X16 a = u08_x16_load(lhs + it);
+    U08_X16 b = u08_x16_load(rhs + it);
+    if (any_case) {
+      a = u08_x16_to_lower(a);
+      b = u08_x16_to_lower(b);
+    }
+
+    if (u08_x16_mask(u08_x16_equal(a, b)) != U08_X16_Mask_All) {
+      return 0;
+    }
+  }
+#endif
+
+  if (any_case) {
+    for (; it < bytes; ++it) {
+      if (char_to_lower(lhs[it]) != char_to_lower(rhs[it])) return 0;
+    }
+  } else {
+    for (; it < bytes; ++it) {
+      if (lhs[it] != rhs[it]) return 0;
+    }
+  }
+
+  return 1;
+}
+
 fn_internal B32 str_equals(Str lhs, Str rhs) {
   B32 result = lhs.len == rhs.len;
   if (result) {
-    For_U64(it, lhs.len) {
-      if (lhs.txt[it] != rhs.txt[it]) {
-        result = 0;
-        break;
-      }
-    }
+    result = str_bytes_equal(lhs.txt, rhs.txt, lhs.len, 0);
   }
 
   return result;
@@ -65,12 +115,7 @@ fn_internal B32 str_equals(Str lhs, Str rhs) {
 fn_internal B32 str_equals_any_case(Str lhs, Str rhs) {
   B32 result = lhs.len == rhs.len;
   if (result) {
-    For_U64(it, lhs.len) {
-      if (char_to_lower(lhs.txt[it]) != char_to_lower(rhs.txt[it])) {
-        result = 0;
-        break;
-      }
-    }
+    result = str_bytes_equal(lhs.txt, rhs.txt, lhs.len, 1);
   }
 
   return result;
@@ -94,53 +139,90 @@ fn_internal B32 str_starts_with_any_case(Str base, Str start) {
   return result;
 }
 
-fn_internal B32 str_contains(Str base, Str sub) {
-  B32 result = 0;
-  if (sub.len <= base.len) {
-    For_U64(it, base.len - sub.len) {
-      result = (str_equals(str_slice(base, it, sub.len), sub));
-      if (result) break;
-    }
+// NOTE(cmat): SIMD first/last byte filter, Wojciech Mula, "SIMD-friendly algorithms for substring searching".
+// - For 16 candidate positions at once, compare the first byte of sub against base[i..i+16]
+// - and the last byte of sub against base[i+m-1..i+m-1+16]. Only positions where both match
+// - get a full compare, which for text is rare enough that the search runs close to load speed.
+fn_internal U64 str_find_ext(Str base, Str sub, B32 any_case) {
+  if (sub.len == 0)       return 0;
+  if (sub.len > base.len) return str_find_none;
+
+  U64 last_start = base.len - sub.len;
+  U64 it         = 0;
+
+#if U08_X16_Available
+  U08 first_char = sub.txt[0];
+  U08 last_char  = sub.txt[sub.len - 1];
+  if (any_case) {
+    first_char = (U08)char_to_lower(first_char);
+    last_char  = (U08)char_to_lower(last_char);
   }
 
-  return result;
-}
+  U08_X16 first = u08_x16_splat(first_char);
+  U08_X16 last  = u08_x16_splat(last_char);
 
-fn_internal B32 str_contains_any_case(Str base, Str sub) {
-  B32 result = 0;
-  if (sub.len <= base.len) {
-    For_U64(it, base.len - sub.len) {
-      result = (str_equals_any_case(str_slice(base, it, sub.len), sub));
-      if (result) break;
+  for (; it + 15 <= last_start; it += 16) {
+    U08_X16 block_first = u08_x16_load(base.txt + it);
+    U08_X16 block_last  = u08_x16_load(base.txt + it + sub.len - 1);
+    if (any_case) {
+      block_first = u08_x16_to_lower(block_first);
+      block_last  = u08_x16_to_lower(block_last);
+    }
+
+    U64 mask = u08_x16_mask(u08_x16_and(u08_x16_equal(block_first, first), u08_x16_equal(block_last, last)));
+    while (mask) {
+      U32 lane = u64_count_trailing_zeros(mask) / U08_X16_Mask_Stride;
+      if (str_bytes_equal(base.txt + it + lane, sub.txt, sub.len, any_case)) {
+        return it + lane;
+      }
+
+      mask &= ~(U08_X16_Mask_Lane << (lane * U08_X16_Mask_Stride));
     }
   }
+#endif
 
-  return result;
+  for (; it <= last_start; ++it) {
+    if (str_bytes_equal(base.txt + it, sub.txt, sub.len, any_case)) {
+      return it;
+    }
+  }
+
+  return str_find_none;
 }
 
-// NOTE(cmat): djb2, Dan Bernstein
-fn_internal U64 str_hash(Str string) {
-  U64 hash = 5381;
-  For_U64(it, string.len) {
-    hash = ((hash << 5) + hash) + string.txt[it];
-  }
+fn_internal U64 str_find(Str base, Str sub) {
+  return str_find_ext(base, sub, 0);
+}
 
-  return hash;
+fn_internal U64 str_find_any_case(Str base, Str sub) {
+  return str_find_ext(base, sub, 1);
 }
 
-fn_internal I64 i64_from_str(Str value) {
-  Not_Implemented;
-  return 0;
+fn_internal B32 str_contains(Str base, Str sub) {
+  return str_find_ext(base, sub, 0) != str_find_none;
 }
 
-fn_internal F64 f64_from_str(Str value) {
-  Not_Implemented;
-  return 0;
+fn_internal B32 str_contains_any_case(Str base, Str sub) {
+  return str_find_ext(base, sub, 1) != str_find_none;
 }
 
-fn_internal B32 b32_from_str(Str value) {
-  Not_Implemented;
-  return 0;
+fn_internal U64 str_hash(Str string) {
+  return hash_bytes(string.len, string.txt);
+}
+
+fn_internal U64 str_hash_seeded(Str string, U64 seed) {
+  return hash_bytes_seeded(string.len, string.txt, seed);
+}
+
+// NOTE(cmat): djb2, Dan Bernstein.
+// - Kept around as a baseline for benchmarks, use str_hash instead.
+fn_internal U64 str_hash_djb2(Str string) {
+  U64 hash = 5381;
+  For_U64(it, string.len) {
+    hash = ((hash << 5) + hash) + string.txt[it];
+  }
+
+  return hash;
 }
 
 fn_internal Codepoint codepoint_from_utf8(Str str_utf8, I32 *advance) {
@@ -196,6 +278,1078 @@ fn_internal Codepoint codepoint_from_utf8(Str str_utf8, I32 *advance) {
   return result;
 }
 
+// ------------------------------------------------------------
+// #-- Hashing
+
+var_global U64 Hash_Secret[4] = {
+  0x2d358dccaa6c78a5ull,
+  0x8bb84b93962eacc9ull,
+  0x4b33a62ed433d4a3ull,
+  0x4d5a2da51de1aa47ull,
+};
+
+// NOTE(cmat): 64x64 -> 128 bit multiply, lo in *a, hi in *b.
+// - On wasm32 a 128-bit multiply lowers to a __multi3 libcall, which we don't link against,
+// - so we split into 32-bit partial products there (4 native i64 multiplies).
+force_inline fn_internal void hash_mul_128(U64 *a, U64 *b) {
+#if (COMPILER_CLANG || COMPILER_GCC) && !ARCH_WASM
+  __uint128_t r = *a;
+  r *= *b;
+  *a = (U64)r;
+  *b = (U64)(r >> 64);
+#else
+  U64 ha = *a >> 32, hb = *b >> 32, la = (U32)*a, lb = (U32)*b;
+  U64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  U64 t  = rl + (rm0 << 32);
+  U64 c  = t < rl;
+  U64 lo = t + (rm1 << 32);
+  c += lo < t;
+  U64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+force_inline fn_internal U64 hash_mix(U64 a, U64 b) {
+  hash_mul_128(&a, &b);
+  return a ^ b;
+}
+
+force_inline fn_internal U64 hash_read_u64(U08 *p) { U64 v; memory_copy(&v, p, sizeof(v)); return v; }
+force_inline fn_internal U64 hash_read_u32(U08 *p) { U32 v; memory_copy(&v, p, sizeof(v)); return v; }
+
+// NOTE(cmat): Reads 1-3 bytes without branching on the length.
+force_inline fn_internal U64 hash_read_small(U08 *p, U64 bytes) {
+  return (((U64)p[0]) << 16) | (((U64)p[bytes >> 1]) << 8) | p[bytes - 1];
+}
+
+fn_internal U64 hash_bytes_seeded(U64 bytes, void *data, U64 seed) {
+  U08 *p = (U08 *)data;
+  U64  a = 0;
+  U64  b = 0;
+
+  seed ^= hash_mix(seed ^ Hash_Secret[0], Hash_Secret[1]);
+
+  If_Likely (bytes <= 16) {
+    if (bytes >= 4) {
+      // NOTE(cmat): Two overlapping pairs of 4-byte reads cover everything in [4, 16].
+      U64 mid = (bytes >> 3) << 2;
+      a = (hash_read_u32(p) << 32)             | hash_read_u32(p + mid);
+      b = (hash_read_u32(p + bytes - 4) << 32) | hash_read_u32(p + bytes - 4 - mid);
+    } else if (bytes > 0) {
+      a = hash_read_small(p, bytes);
+    }
+  } else {
+    U64 left = bytes;
+
+    // NOTE(cmat): Bulk path, three independent lanes of 16 bytes each.
+    if (left >= 48) {
+      U64 seed_1 = seed;
+      U64 seed_2 = seed;
+      do {
+        seed   = hash_mix(hash_read_u64(p +  0) ^ Hash_Secret[1], hash_read_u64(p +  8) ^ seed);
+        seed_1 = hash_mix(hash_read_u64(p + 16) ^ Hash_Secret[2], hash_read_u64(p + 24) ^ seed_1);
+        seed_2 = hash_mix(hash_read_u64(p + 32) ^ Hash_Secret[3], hash_read_u64(p + 40) ^ seed_2);
+        p    += 48;
+        left -= 48;
+      } while (left >= 48);
+
+      seed ^= seed_1 ^ seed_2;
+    }
+
+    while (left > 16) {
+      seed  = hash_mix(hash_read_u64(p) ^ Hash_Secret[1], hash_read_u64(p + 8) ^ seed);
+      p    += 16;
+      left -= 16;
+    }
+
+    // NOTE(cmat): Last 16 bytes, possibly overlapping what was already consumed.
+    a = hash_read_u64(p + left - 16);
+    b = hash_read_u64(p + left - 8);
+  }
+
+  a ^= Hash_Secret[1];
+  b ^= seed;
+  hash_mul_128(&a, &b);
+
+  return hash_mix(a ^ Hash_Secret[0] ^ bytes, b ^ Hash_Secret[1]);
+}
+
+fn_internal U64 hash_bytes(U64 bytes, void *data) {
+  return hash_bytes_seeded(bytes, data, 0);
+}
+
+// NOTE(cmat): wyhash64, for integer keys (IDs, pointers).
+fn_internal U64 hash_u64(U64 value) {
+  U64 a = value ^ Hash_Secret[0];
+  U64 b = Hash_Secret[1];
+  hash_mul_128(&a, &b);
+  return hash_mix(a ^ Hash_Secret[0], b ^ Hash_Secret[1]);
+}
+
+// ------------------------------------------------------------
+// #-- Number Parsing
+
+// NOTE(cmat): Floats are parsed in three tiers, fastest first:
+// - 1. Clinger's fast path: the mantissa and the power of ten are both exact in the
+// -    target type, so a single multiply or divide is correctly rounded.
+// - 2. Eisel-Lemire: multiply the mantissa by a 128-bit approximation of 5^q (core_pow5.c)
+// -    and read the result off the high bits. Always correct for up to 19 digits.
+// - 3. Above 19 digits we only kept a truncated mantissa w. If w and w + 1 round to the same
+// -    float we're done, otherwise fall back to big decimal arithmetic (Nigel Tao's
+// -    "simple decimal conversion", same as Go's strconv). Practically never taken.
+// - Reference: Daniel Lemire, "Number Parsing at a Gigabyte per Second" (2021).
+
+typedef struct Float_Format {
+  I32 mantissa_bits;
+  I32 exponent_bias;
+  I32 infinite_power;
+  I32 power10_min;
+  I32 power10_max;
+  I32 round_to_even_min;
+  I32 round_to_even_max;
+} Float_Format;
+
+var_global Float_Format F64_Format = { .mantissa_bits = 52, .exponent_bias = -1023, .infinite_power = 0x7FF, .power10_min = -342, .power10_max = 308, .round_to_even_min = -4,  .round_to_even_max = 23 };
+var_global Float_Format F32_Format = { .mantissa_bits = 23, .exponent_bias = -127,  .infinite_power = 0xFF,  .power10_min = -65,  .power10_max = 38,  .round_to_even_min = -17, .round_to_even_max = 10 };
+
+var_global F64 F64_Exact_Power10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+var_global F32 F32_Exact_Power10[] = {
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+typedef U32 Float_Special;
+enum {
+  Float_Special_None,
+  Float_Special_Infinity,
+  Float_Special_NaN,
+};
+
+typedef struct Float_Decimal {
+  B32           negative;
+  Float_Special special;
+
+  // NOTE(cmat): value = mantissa * 10^exponent. If truncated is set, more than 19
+  // - significant digits were present and mantissa only holds the leading ones.
+  U64           mantissa;
+  I64           exponent;
+  B32           truncated;
+
+  // NOTE(cmat): The raw digits, only needed by the big decimal fallback.
+  Str           integer;
+  Str           fraction;
+  I64           exponent_explicit;
+} Float_Decimal;
+
+// NOTE(cmat): SWAR digit parsing, 8 ASCII digits per step (little endian loads).
+force_inline fn_internal B32 digits_x8_valid(U64 chunk) {
+  return !(((chunk + 0x4646464646464646ull) | (chunk - 0x3030303030303030ull)) & 0x8080808080808080ull);
+}
+
+force_inline fn_internal U32 digits_x8_parse(U64 chunk) {
+  chunk -= 0x3030303030303030ull;
+  chunk  = (chunk * 10) + (chunk >> 8);
+  chunk  = (((chunk & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+            (((chunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+  return (U32)chunk;
+}
+
+// NOTE(cmat): Accumulates digits into *value, wrapping on overflow (callers count digits).
+fn_internal U08 *digits_accumulate(U08 *at, U08 *end, U64 *value) {
+  U64 result = *value;
+
+  while (end - at >= 8) {
+    U64 chunk = 0;
+    memory_copy(&chunk, at, sizeof(chunk));
+    if (!digits_x8_valid(chunk)) {
+      break;
+    }
+
+    result = result * 100000000ull + digits_x8_parse(chunk);
+    at += 8;
+  }
+
+  while (at < end && char_is_number(*at)) {
+    result = result * 10 + (U64)(*at - '0');
+    at += 1;
+  }
+
+  *value = result;
+  return at;
+}
+
+fn_internal U64 float_special_parse(U08 *at, U08 *end, Float_Special *special) {
+  Str rest = { .len = (U64)(end - at), .txt = at };
+  U64 result = 0;
+
+  if (str_starts_with_any_case(rest, str_lit("infinity"))) {
+    *special = Float_Special_Infinity;
+    result   = 8;
+  } else if (str_starts_with_any_case(rest, str_lit("inf"))) {
+    *special = Float_Special_Infinity;
+    result   = 3;
+  } else if (str_starts_with_any_case(rest, str_lit("nan"))) {
+    *special = Float_Special_NaN;
+    result   = 3;
+  }
+
+  return result;
+}
+
+fn_internal U64 float_decimal_parse(Str string, Float_Decimal *decimal) {
+  *decimal = (Float_Decimal) { };
+
+  U08 *start = string.txt;
+  U08 *end   = string.txt + string.len;
+  U08 *at    = start;
+
+  if (at < end && (*at == '-' || *at == '+')) {
+    decimal->negative = *at == '-';
+    at += 1;
+  }
+
+  U64 mantissa = 0;
+  I64 exponent = 0;
+
+  U08 *integer_start = at;
+  at = digits_accumulate(at, end, &mantissa);
+  U08 *integer_end = at;
+
+  U08 *fraction_start = at;
+  U08 *fraction_end   = at;
+  if (at < end && *at == '.') {
+    fraction_start = at + 1;
+    at = digits_accumulate(fraction_start, end, &mantissa);
+    fraction_end = at;
+    exponent = -(I64)(fraction_end - fraction_start);
+  }
+
+  U64 digit_count = (U64)(integer_end - integer_start) + (U64)(fraction_end - fraction_start);
+  if (!digit_count) {
+    U64 special_bytes = float_special_parse(integer_start, end, &decimal->special);
+    return special_bytes ? (U64)(integer_start - start) + special_bytes : 0;
+  }
+
+  // NOTE(cmat): A dangling exponent ("1e", "1e+") isn't consumed, same as strtod.
+  I64 exponent_explicit = 0;
+  if (at < end && (*at == 'e' || *at == 'E')) {
+    U08 *exponent_at       = at + 1;
+    B32  exponent_negative = 0;
+    if (exponent_at < end && (*exponent_at == '-' || *exponent_at == '+')) {
+      exponent_negative = *exponent_at == '-';
+      exponent_at += 1;
+    }
+
+    if (exponent_at < end && char_is_number(*exponent_at)) {
+      while (exponent_at < end && char_is_number(*exponent_at)) {
+        if (exponent_explicit < 0x10000) {
+          exponent_explicit = exponent_explicit * 10 + (*exponent_at - '0');
+        }
+
+        exponent_at += 1;
+      }
+
+      exponent_explicit = exponent_negative ? -exponent_explicit : exponent_explicit;
+      exponent += exponent_explicit;
+      at = exponent_at;
+    }
+  }
+
+  if (digit_count > 19) {
+
+    // NOTE(cmat): Leading zeros aren't significant, recount without them.
+    for (U08 *it = integer_start; it < fraction_end && (*it == '0' || *it == '.'); ++it) {
+      digit_count -= *it == '0';
+    }
+
+    if (digit_count > 19) {
+      U64 const Min_19_Digits = 1000000000000000000ull;
+
+      decimal->truncated = 1;
+      mantissa = 0;
+
+      U08 *it = integer_start;
+      while (mantissa < Min_19_Digits && it < integer_end) {
+        mantissa = mantissa * 10 + (U64)(*it++ - '0');
+      }
+
+      if (mantissa >= Min_19_Digits) {
+        exponent = (I64)(integer_end - it) + exponent_explicit;
+      } else {
+        it = fraction_start;
+        while (mantissa < Min_19_Digits && it < fraction_end) {
+          mantissa = mantissa * 10 + (U64)(*it++ - '0');
+        }
+
+        exponent = (I64)(fraction_start - it) + exponent_explicit;
+      }
+    }
+  }
+
+  decimal->mantissa          = mantissa;
+  decimal->exponent          = exponent;
+  decimal->integer           = (Str) { .len = (U64)(integer_end - integer_start),   .txt = integer_start  };
+  decimal->fraction          = (Str) { .len = (U64)(fraction_end - fraction_start), .txt = fraction_start };
+  decimal->exponent_explicit = exponent_explicit;
+
+  return (U64)(at - start);
+}
+
+// NOTE(cmat): Returns the float bits (without sign) for mantissa * 10^q, mantissa != 0.
+fn_internal U64 float_bits_eisel_lemire(I64 q, U64 mantissa, Float_Format *format) {
+  If_Unlikely (q < format->power10_min) {
+    return 0;
+  }
+
+  If_Unlikely (q > format->power10_max) {
+    return (U64)format->infinite_power << format->mantissa_bits;
+  }
+
+  I32 leading_zeros = u64_count_leading_zeros(mantissa);
+  mantissa <<= leading_zeros;
+
+  // NOTE(cmat): We need mantissa_bits + 3 correct bits. The first product gets there
+  // - unless all the bits below that are ones, then the low half of 5^q can still carry in.
+  U64 *power5         = Pow5_128_Table[q - Pow5_128_Table_Min_Exponent];
+  U64  precision_mask = u64_limit_max >> (format->mantissa_bits + 3);
+
+  U64 product_lo = mantissa;
+  U64 product_hi = power5[0];
+  hash_mul_128(&product_lo, &product_hi);
+
+  if ((product_hi & precision_mask) == precision_mask) {
+    U64 second_lo = mantissa;
+    U64 second_hi = power5[1];
+    hash_mul_128(&second_lo, &second_hi);
+
+    product_lo += second_hi;
+    product_hi += second_hi > product_lo;
+  }
+
+  I32 upper_bit = (I32)(product_hi >> 63);
+  I32 shift     = upper_bit + 64 - format->mantissa_bits - 3;
+  U64 result    = product_hi >> shift;
+
+  // NOTE(cmat): floor(log2(10^q)) + 63, valid for |q| < 1233.
+  I32 power2 = (I32)((((152170 + 65536) * q) >> 16) + 63) + upper_bit - leading_zeros - format->exponent_bias;
+
+  if (power2 <= 0) {
+
+    // NOTE(cmat): Subnormal.
+    if (-power2 + 1 >= 64) {
+      return 0;
+    }
+
+    result >>= -power2 + 1;
+    result  += result & 1;
+    result >>= 1;
+
+    // NOTE(cmat): Rounding up can turn the largest subnormal into the smallest normal,
+    // - in which case the implicit bit lands exactly on the exponent field.
+    return result;
+  }
+
+  // NOTE(cmat): Exactly halfway between two floats, round to even instead of up.
+  // - Only possible for a small range of exponents, where 5^q is exact.
+  if (product_lo <= 1 && q >= format->round_to_even_min && q <= format->round_to_even_max && (result & 3) == 1) {
+    if ((result << shift) == product_hi) {
+      result &= ~1ull;
+    }
+  }
+
+  result  += result & 1;
+  result >>= 1;
+
+  if (result >= (2ull << format->mantissa_bits)) {
+    result  = 1ull << format->mantissa_bits;
+    power2 += 1;
+  }
+
+  result &= ~(1ull << format->mantissa_bits);
+
+  if (power2 >= format->infinite_power) {
+    power2 = format->infinite_power;
+    result = 0;
+  }
+
+  return result | ((U64)power2 << format->mantissa_bits);
+}
+
+// NOTE(cmat): Arbitrary precision decimal, value = 0.d[0]d[1]...d[digit_count-1] * 10^decimal_point.
+#define Big_Decimal_Max_Digits 800
+#define Big_Decimal_Max_Shift  60
+
+typedef struct Big_Decimal {
+  I32 digit_count;
+  I32 decimal_point;
+  B32 truncated;
+  U08 digits[Big_Decimal_Max_Digits];
+} Big_Decimal;
+
+fn_internal void big_decimal_trim(Big_Decimal *decimal) {
+  while (decimal->digit_count > 0 && decimal->digits[decimal->digit_count - 1] == 0) {
+    decimal->digit_count -= 1;
+  }
+
+  if (!decimal->digit_count) {
+    decimal->decimal_point = 0;
+  }
+}
+
+fn_internal void big_decimal_append(Big_Decimal *decimal, Str digits, B32 *seen_non_zero) {
+  For_U64(it, digits.len) {
+    U08 digit = (U08)(digits.txt[it] - '0');
+    if (!digit && !*seen_non_zero) {
+      decimal->decimal_point -= 1;
+      continue;
+    }
+
+    *seen_non_zero = 1;
+    if (decimal->digit_count < Big_Decimal_Max_Digits) {
+      decimal->digits[decimal->digit_count++] = digit;
+    } else if (digit) {
+      decimal->truncated = 1;
+    }
+  }
+}
+
+fn_internal void big_decimal_from_float_decimal(Big_Decimal *decimal, Float_Decimal *source) {
+  decimal->digit_count   = 0;
+  decimal->decimal_point = 0;
+  decimal->truncated     = 0;
+
+  B32 seen_non_zero = 0;
+  big_decimal_append(decimal, source->integer, &seen_non_zero);
+  decimal->decimal_point = decimal->digit_count;
+  big_decimal_append(decimal, source->fraction, &seen_non_zero);
+
+  decimal->decimal_point += (I32)source->exponent_explicit;
+  big_decimal_trim(decimal);
+}
+
+// NOTE(cmat): Multiply by 2^shift, shift <= Big_Decimal_Max_Shift.
+// - Goes right to left, the leftover carry becomes the new leading digits.
+fn_internal void big_decimal_shift_left(Big_Decimal *decimal, U32 shift) {
+  U64 carry = 0;
+  for (I32 it = decimal->digit_count - 1; it >= 0; --it) {
+    U64 value = ((U64)decimal->digits[it] << shift) + carry;
+    decimal->digits[it] = (U08)(value % 10);
+    carry = value / 10;
+  }
+
+  U08 head[20] = { };
+  I32 head_count = 0;
+  for (; carry; carry /= 10) {
+    head[head_count++] = (U08)(carry % 10);
+  }
+
+  if (head_count) {
+    I32 keep = decimal->digit_count;
+    if (keep + head_count > Big_Decimal_Max_Digits) {
+      keep = Big_Decimal_Max_Digits - head_count;
+      for (I32 it = keep; it < decimal->digit_count; ++it) {
+        decimal->truncated |= decimal->digits[it] != 0;
+      }
+    }
+
+    for (I32 it = keep - 1; it >= 0; --it) {
+      decimal->digits[it + head_count] = decimal->digits[it];
+    }
+
+    For_I32(it, head_count) {
+      decimal->digits[it] = head[head_count - 1 - it];
+    }
+
+    decimal->digit_count    = keep + head_count;
+    decimal->decimal_point += head_count;
+  }
+
+  big_decimal_trim(decimal);
+}
+
+// NOTE(cmat): Divide by 2^shift, shift <= Big_Decimal_Max_Shift.
+fn_internal void big_decimal_shift_right(Big_Decimal *decimal, U32 shift) {
+  I32 read  = 0;
+  I32 write = 0;
+  U64 value = 0;
+
+  for (; (value >> shift) == 0; ++read) {
+    if (read >= decimal->digit_count) {
+      if (value == 0) {
+        decimal->digit_count = 0;
+        return;
+      }
+
+      while ((value >> shift) == 0) {
+        value *= 10;
+        read  += 1;
+      }
+
+      break;
+    }
+
+    value = value * 10 + decimal->digits[read];
+  }
+
+  decimal->decimal_point -= read - 1;
+
+  U64 mask = (1ull << shift) - 1;
+  for (; read < decimal->digit_count; ++read) {
+    U64 digit = value >> shift;
+    value &= mask;
+    decimal->digits[write++] = (U08)digit;
+    value = value * 10 + decimal->digits[read];
+  }
+
+  while (value > 0) {
+    U64 digit = value >> shift;
+    value &= mask;
+    if (write < Big_Decimal_Max_Digits) {
+      decimal->digits[write++] = (U08)digit;
+    } else if (digit > 0) {
+      decimal->truncated = 1;
+    }
+
+    value *= 10;
+  }
+
+  decimal->digit_count = write;
+  big_decimal_trim(decimal);
+}
+
+fn_internal void big_decimal_shift(Big_Decimal *decimal, I32 shift) {
+  if (!decimal->digit_count) {
+    return;
+  }
+
+  for (; shift > Big_Decimal_Max_Shift; shift -= Big_Decimal_Max_Shift) {
+    big_decimal_shift_left(decimal, Big_Decimal_Max_Shift);
+  }
+
+  for (; shift < -Big_Decimal_Max_Shift; shift += Big_Decimal_Max_Shift) {
+    big_decimal_shift_right(decimal, Big_Decimal_Max_Shift);
+  }
+
+  if (shift > 0) {
+    big_decimal_shift_left(decimal, (U32)shift);
+  } else if (shift < 0) {
+    big_decimal_shift_right(decimal, (U32)-shift);
+  }
+}
+
+fn_internal U64 big_decimal_rounded_integer(Big_Decimal *decimal) {
+  if (decimal->decimal_point > 20) {
+    return u64_limit_max;
+  }
+
+  U64 result = 0;
+  I32 it     = 0;
+  for (; it < decimal->decimal_point && it < decimal->digit_count; ++it) {
+    result = result * 10 + decimal->digits[it];
+  }
+
+  for (; it < decimal->decimal_point; ++it) {
+    result *= 10;
+  }
+
+  // NOTE(cmat): Round half to even, unless digits were dropped (then we're above half).
+  I32 next = decimal->decimal_point;
+  if (next >= 0 && next < decimal->digit_count) {
+    B32 round_up = decimal->digits[next] >= 5;
+    if (decimal->digits[next] == 5 && next + 1 == decimal->digit_count) {
+      round_up = decimal->truncated || (next > 0 && (decimal->digits[next - 1] & 1));
+    }
+
+    result += round_up;
+  }
+
+  return result;
+}
+
+fn_internal U64 float_bits_big_decimal(Float_Decimal *source, Float_Format *format) {
+  var_local_persist I32 Power2_Steps[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+
+  Big_Decimal decimal;
+  big_decimal_from_float_decimal(&decimal, source);
+
+  if (!decimal.digit_count || decimal.decimal_point < -330) {
+    return 0;
+  }
+
+  if (decimal.decimal_point > 310) {
+    return (U64)format->infinite_power << format->mantissa_bits;
+  }
+
+  // NOTE(cmat): Scale by powers of two into [0.5, 1).
+  I32 power2 = 0;
+  while (decimal.decimal_point > 0) {
+    I32 step = decimal.decimal_point >= (I32)sarray_len(Power2_Steps) ? 27 : Power2_Steps[decimal.decimal_point];
+    big_decimal_shift(&decimal, -step);
+    power2 += step;
+  }
+
+  while (decimal.decimal_point < 0 || (decimal.decimal_point == 0 && decimal.digits[0] < 5)) {
+    I32 step = -decimal.decimal_point >= (I32)sarray_len(Power2_Steps) ? 27 : Power2_Steps[-decimal.decimal_point];
+    big_decimal_shift(&decimal, step);
+    power2 -= step;
+  }
+
+  // NOTE(cmat): [0.5, 1) to [1, 2), and clamp to the smallest exponent (subnormals).
+  power2 -= 1;
+  if (power2 < format->exponent_bias + 1) {
+    I32 step = format->exponent_bias + 1 - power2;
+    big_decimal_shift(&decimal, -step);
+    power2 += step;
+  }
+
+  if (power2 - format->exponent_bias >= format->infinite_power) {
+    return (U64)format->infinite_power << format->mantissa_bits;
+  }
+
+  big_decimal_shift(&decimal, 1 + format->mantissa_bits);
+  U64 mantissa = big_decimal_rounded_integer(&decimal);
+
+  if (mantissa == (2ull << format->mantissa_bits)) {
+    mantissa >>= 1;
+    power2   += 1;
+    if (power2 - format->exponent_bias >= format->infinite_power) {
+      return (U64)format->infinite_power << format->mantissa_bits;
+    }
+  }
+
+  if (!(mantissa & (1ull << format->mantissa_bits))) {
+    power2 = format->exponent_bias;
+  }
+
+  U64 result = mantissa & ((1ull << format->mantissa_bits) - 1);
+  result    |= (U64)(power2 - format->exponent_bias) << format->mantissa_bits;
+  return result;
+}
+
+fn_internal U64 float_bits_from_decimal(Float_Decimal *decimal, Float_Format *format) {
+  if (decimal->special == Float_Special_Infinity) {
+    return (U64)format->infinite_power << format->mantissa_bits;
+  }
+
+  if (decimal->special == Float_Special_NaN) {
+    return ((U64)format->infinite_power << format->mantissa_bits) | (1ull << (format->mantissa_bits - 1));
+  }
+
+  if (!decimal->mantissa) {
+    return 0;
+  }
+
+  U64 result = float_bits_eisel_lemire(decimal->exponent, decimal->mantissa, format);
+  if (decimal->truncated) {
+    If_Unlikely (result != float_bits_eisel_lemire(decimal->exponent, decimal->mantissa + 1, format)) {
+      result = float_bits_big_decimal(decimal, format);
+    }
+  }
+
+  return result;
+}
+
+fn_internal U64 f64_from_str_ext(Str string, F64 *value) {
+  Float_Decimal decimal;
+  U64 result = float_decimal_parse(string, &decimal);
+
+  F64 parsed = 0;
+  if (!decimal.special && !decimal.truncated && decimal.mantissa <= (1ull << 53) &&
+      decimal.exponent >= -22 && decimal.exponent <= 22) {
+
+    parsed = (F64)decimal.mantissa;
+    parsed = decimal.exponent < 0 ? parsed / F64_Exact_Power10[-decimal.exponent] : parsed * F64_Exact_Power10[decimal.exponent];
+
+  } else {
+    U64 bits = float_bits_from_decimal(&decimal, &F64_Format);
+    memory_copy(&parsed, &bits, sizeof(parsed));
+  }
+
+  *value = decimal.negative ? -parsed : parsed;
+  return result;
+}
+
+fn_internal U64 f32_from_str_ext(Str string, F32 *value) {
+  Float_Decimal decimal;
+  U64 result = float_decimal_parse(string, &decimal);
+
+  F32 parsed = 0;
+  if (!decimal.special && !decimal.truncated && decimal.mantissa <= (1ull << 24) &&
+      decimal.exponent >= -10 && decimal.exponent <= 10) {
+
+    parsed = (F32)decimal.mantissa;
+    parsed = decimal.exponent < 0 ? parsed / F32_Exact_Power10[-decimal.exponent] : parsed * F32_Exact_Power10[decimal.exponent];
+
+  } else {
+    U32 bits = (U32)float_bits_from_decimal(&decimal, &F32_Format);
+    memory_copy(&parsed, &bits, sizeof(parsed));
+  }
+
+  *value = decimal.negative ? -parsed : parsed;
+  return result;
+}
+
+fn_internal U64 i64_from_str_ext(Str string, I64 *value) {
+  U08 *start = string.txt;
+  U08 *end   = string.txt + string.len;
+  U08 *at    = start;
+
+  B32 negative = 0;
+  if (at < end && (*at == '-' || *at == '+')) {
+    negative = *at == '-';
+    at += 1;
+  }
+
+  U08 *digits_start = at;
+  U64  magnitude    = 0;
+  at = digits_accumulate(at, end, &magnitude);
+
+  if (at == digits_start) {
+    *value = 0;
+    return 0;
+  }
+
+  // NOTE(cmat): 19 digits always fit in a U64, anything longer saturates.
+  while (digits_start < at - 1 && *digits_start == '0') {
+    digits_start += 1;
+  }
+
+  U64 limit = negative ? (U64)i64_limit_max + 1 : (U64)i64_limit_max;
+  if (at - digits_start > 19 || magnitude > limit) {
+    magnitude = limit;
+  }
+
+  *value = negative ? (I64)(0 - magnitude) : (I64)magnitude;
+  return (U64)(at - start);
+}
+
+fn_internal I64 i64_from_str(Str string) {
+  I64 result = 0;
+  i64_from_str_ext(str_trim(string), &result);
+  return result;
+}
+
+fn_internal F64 f64_from_str(Str string) {
+  F64 result = 0;
+  f64_from_str_ext(str_trim(string), &result);
+  return result;
+}
+
+fn_internal F32 f32_from_str(Str string) {
+  F32 result = 0;
+  f32_from_str_ext(str_trim(string), &result);
+  return result;
+}
+
+fn_internal B32 b32_from_str(Str string) {
+  string = str_trim(string);
+  return str_equals_any_case(string, str_lit("true")) ||
+         str_equals_any_case(string, str_lit("yes"))  ||
+         str_equals_any_case(string, str_lit("on"))   ||
+         str_equals(string, str_lit("1"));
+}
+
+// ------------------------------------------------------------
+// #-- CPU Features
+
+fn_internal CO_CPU_Feature_Flag co_cpu_features_from_cpuid(void) {
+  CO_CPU_Feature_Flag result = 0;
+
+#if ARCH_X86
+  U32 eax, ebx, ecx, edx;
+
+  eax = 1; ecx = 0;
+  __asm__ volatile("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+
+  if (ecx & (1 << 20)) result |= CO_CPU_Feature_SSE42;
+  if (ecx & (1 <<  1)) result |= CO_CPU_Feature_CLMUL;
+  if (ecx & (1 << 29)) result |= CO_CPU_Feature_F16C;
+
+  // NOTE(cmat): FMA and AVX2 need the OS to save YMM state, check OSXSAVE + XCR0.
+  B32 ymm_enabled = 0;
+  if ((ecx & (1 << 27)) && (ecx & (1 << 28))) {
+    U32 xcr0_lo, xcr0_hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    ymm_enabled = (xcr0_lo & 0x6) == 0x6;
+  }
+
+  if (ymm_enabled && (ecx & (1 << 12))) result |= CO_CPU_Feature_FMA;
+
+  eax = 7; ecx = 0;
+  __asm__ volatile("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+  if (ymm_enabled && (ebx & (1 << 5))) result |= CO_CPU_Feature_AVX2;
+
+#elif ARCH_ARM
+  // NOTE(cmat): NEON is mandatory on AArch64, PMULL has to be queried from the OS.
+  result |= CO_CPU_Feature_NEON;
+
+#elif ARCH_WASM
+  // NOTE(cmat): We compile with -msimd128, the module wouldn't validate without it.
+  result |= CO_CPU_Feature_SIMD128;
+
+#endif
+
+  return result;
+}
+
+// ------------------------------------------------------------
+// #-- Synchronization
+
+fn_internal void cond_var_wait(Cond_Var *cond_var, Mutex *mutex) {
+  // NOTE(cmat): Sample the sequence before unlocking: a signal that lands between the
+  // - unlock and the futex wait bumps it, so the wait returns instead of missing it.
+  U32 sequence = atomic_read_u32(&cond_var->sequence);
+  mutex_end(mutex);
+  co_futex_wait(&cond_var->sequence, sequence);
+  mutex_start(mutex);
+}
+
+fn_internal void cond_var_signal(Cond_Var *cond_var) {
+  atomic_increment_u32(&cond_var->sequence);
+  co_futex_wake(&cond_var->sequence, 1);
+}
+
+fn_internal void cond_var_broadcast(Cond_Var *cond_var) {
+  atomic_increment_u32(&cond_var->sequence);
+  co_futex_wake(&cond_var->sequence, u32_limit_max);
+}
+
+fn_internal void semaphore_init(Semaphore *semaphore, U32 count) {
+  semaphore->count   = count;
+  semaphore->waiters = 0;
+}
+
+fn_internal B32 semaphore_try_wait(Semaphore *semaphore) {
+  U32 count = atomic_read_u32(&semaphore->count);
+  while (count) {
+    if (atomic_compare_exchange_u32(&semaphore->count, count, count - 1)) {
+      return 1;
+    }
+
+    count = atomic_read_u32(&semaphore->count);
+  }
+
+  return 0;
+}
+
+fn_internal void semaphore_wait(Semaphore *semaphore) {
+  while (!semaphore_try_wait(semaphore)) {
+
+    // NOTE(cmat): If a post lands after we registered, the futex sees count != 0 and returns.
+    atomic_increment_u32(&semaphore->waiters);
+    co_futex_wait(&semaphore->count, 0);
+    atomic_decrement_u32(&semaphore->waiters);
+  }
+}
+
+fn_internal void semaphore_post(Semaphore *semaphore, U32 count) {
+  atomic_add_u32(&semaphore->count, count);
+  if (atomic_read_u32(&semaphore->waiters)) {
+    co_futex_wake(&semaphore->count, count);
+  }
+}
+
+fn_internal void event_init(Event *event, Event_Mode mode) {
+  event->signaled = 0;
+  event->mode     = mode;
+}
+
+fn_internal void event_wait(Event *event) {
+  if (event->mode == Event_Mode_Manual_Reset) {
+    while (!atomic_read_u32(&event->signaled)) {
+      co_futex_wait(&event->signaled, 0);
+    }
+  } else {
+    while (!atomic_compare_exchange_u32(&event->signaled, 1, 0)) {
+      co_futex_wait(&event->signaled, 0);
+    }
+  }
+}
+
+fn_internal void event_signal(Event *event) {
+  atomic_write_u32(&event->signaled, 1);
+  co_futex_wake(&event->signaled, event->mode == Event_Mode_Manual_Reset ? u32_limit_max : 1);
+}
+
+fn_internal void event_reset(Event *event) {
+  atomic_write_u32(&event->signaled, 0);
+}
+
+fn_internal void barrier_init(Barrier *barrier, U32 thread_count) {
+  Assert(thread_count, "barrier needs at least one thread");
+  barrier->thread_count = thread_count;
+  barrier->arrived      = 0;
+  barrier->generation   = 0;
+}
+
+fn_internal B32 barrier_wait(Barrier *barrier) {
+  U32 generation = atomic_read_u32(&barrier->generation);
+
+  // NOTE(cmat): The last thread resets the count before bumping the generation,
+  // - nobody can leave (and re-arrive) until the generation changes.
+  if (atomic_increment_u32(&barrier->arrived) == barrier->thread_count) {
+    atomic_write_u32(&barrier->arrived, 0);
+    atomic_increment_u32(&barrier->generation);
+    co_futex_wake(&barrier->generation, u32_limit_max);
+    return 1;
+  }
+
+  while (atomic_read_u32(&barrier->generation) == generation) {
+    co_futex_wait(&barrier->generation, generation);
+  }
+
+  return 0;
+}
+
+// ------------------------------------------------------------
+// #-- Fibers
+
+fn_internal void co_fiber_main(CO_Fiber *fiber) {
+  fiber->proc(fiber->user_data);
+  fiber->done = 1;
+
+  co_fiber_switch(fiber, fiber->caller);
+  co_panic(str_lit("resumed a finished fiber"));
+}
+
+#if ARCH_X86 && (COMPILER_CLANG || COMPILER_GCC)
+
+// NOTE(cmat): System V x64. Pushes the callee-saved registers and the SSE / x87 control words,
+// - swaps stacks, pops. rdi = &from->stack_pointer, rsi = to->stack_pointer. r12 is moved
+// - into rdi on the way out, so a fresh stack "returns" into co_fiber_main(fiber).
+__attribute__((naked, noinline)) fn_internal void co_fiber_switch_stack(void **save, void *load) {
+  __asm__ volatile (
+    "pushq %rbp\n"
+    "pushq %rbx\n"
+    "pushq %r12\n"
+    "pushq %r13\n"
+    "pushq %r14\n"
+    "pushq %r15\n"
+    "subq $8, %rsp\n"
+    "stmxcsr (%rsp)\n"
+    "fnstcw 4(%rsp)\n"
+    "movq %rsp, (%rdi)\n"
+    "movq %rsi, %rsp\n"
+    "ldmxcsr (%rsp)\n"
+    "fldcw 4(%rsp)\n"
+    "addq $8, %rsp\n"
+    "popq %r15\n"
+    "popq %r14\n"
+    "popq %r13\n"
+    "popq %r12\n"
+    "popq %rbx\n"
+    "popq %rbp\n"
+    "movq %r12, %rdi\n"
+    "ret\n"
+  );
+}
+
+fn_internal void co_fiber_init(CO_Fiber *fiber, void *stack_base, U64 stack_bytes, CO_Fiber_Proc *proc, void *user_data) {
+  zero_fill(fiber);
+  fiber->stack_base  = (U08 *)stack_base;
+  fiber->stack_bytes = stack_bytes;
+  fiber->proc        = proc;
+  fiber->user_data   = user_data;
+
+  // NOTE(cmat): The return slot sits 16-byte aligned, so co_fiber_main starts with rsp = 8 mod 16,
+  // - as if it had been called. The zero above it stops unwinders.
+  U64  top   = ((U64)stack_base + stack_bytes) & ~(U64)15;
+  U64 *frame = (U64 *)(top - 16) - 7;
+
+  frame[0] = 0x037F00001F80ull;   // NOTE(cmat): mxcsr, x87 control word defaults.
+  frame[1] = 0;                   // r15
+  frame[2] = 0;                   // r14
+  frame[3] = 0;                   // r13
+  frame[4] = (U64)fiber;          // r12
+  frame[5] = 0;                   // rbx
+  frame[6] = 0;                   // rbp
+  frame[7] = (U64)co_fiber_main;  // return address
+  frame[8] = 0;
+
+  fiber->stack_pointer = frame;
+}
+
+fn_internal void co_fiber_switch(CO_Fiber *from, CO_Fiber *to) {
+  Assert(!to->done, "switching to a finished fiber");
+  to->caller = from;
+  co_fiber_switch_stack(&from->stack_pointer, to->stack_pointer);
+}
+
+#elif ARCH_ARM && (COMPILER_CLANG || COMPILER_GCC)
+
+// NOTE(cmat): AAPCS64. Saves x19-x30 and d8-d15, swaps stacks, restores, returns through x30.
+// - x0 = &from->stack_pointer, x1 = to->stack_pointer. x19 is moved into x0 on the way out,
+// - so a fresh stack "returns" into co_fiber_main(fiber).
+__attribute__((naked, noinline)) fn_internal void co_fiber_switch_stack(void **save, void *load) {
+  __asm__ volatile (
+    "sub sp, sp, #160\n"
+    "stp x19, x20, [sp, #0]\n"
+    "stp x21, x22, [sp, #16]\n"
+    "stp x23, x24, [sp, #32]\n"
+    "stp x25, x26, [sp, #48]\n"
+    "stp x27, x28, [sp, #64]\n"
+    "stp x29, x30, [sp, #80]\n"
+    "stp d8,  d9,  [sp, #96]\n"
+    "stp d10, d11, [sp, #112]\n"
+    "stp d12, d13, [sp, #128]\n"
+    "stp d14, d15, [sp, #144]\n"
+    "mov x2, sp\n"
+    "str x2, [x0]\n"
+    "mov sp, x1\n"
+    "ldp x19, x20, [sp, #0]\n"
+    "ldp x21, x22, [sp, #16]\n"
+    "ldp x23, x24, [sp, #32]\n"
+    "ldp x25, x26, [sp, #48]\n"
+    "ldp x27, x28, [sp, #64]\n"
+    "ldp x29, x30, [sp, #80]\n"
+    "ldp d8,  d9,  [sp, #96]\n"
+    "ldp d10, d11, [sp, #112]\n"
+    "ldp d12, d13, [sp, #128]\n"
+    "ldp d14, d15, [sp, #144]\n"
+    "add sp, sp, #160\n"
+    "mov x0, x19\n"
+    "ret\n"
+  );
+}
+
+fn_internal void co_fiber_init(CO_Fiber *fiber, void *stack_base, U64 stack_bytes, CO_Fiber_Proc *proc, void *user_data) {
+  zero_fill(fiber);
+  fiber->stack_base  = (U08 *)stack_base;
+  fiber->stack_bytes = stack_bytes;
+  fiber->proc        = proc;
+  fiber->user_data   = user_data;
+
+  U64  top   = ((U64)stack_base + stack_bytes) & ~(U64)15;
+  U64 *frame = (U64 *)top - 20;
+  memory_fill(frame, 0, 20 * sizeof(U64));
+
+  frame[0]  = (U64)fiber;          // x19
+  frame[11] = (U64)co_fiber_main;  // x30
+
+  fiber->stack_pointer = frame;
+}
+
+fn_internal void co_fiber_switch(CO_Fiber *from, CO_Fiber *to) {
+  Assert(!to->done, "switching to a finished fiber");
+  to->caller = from;
+  co_fiber_switch_stack(&from->stack_pointer, to->stack_pointer);
+}
+
+#elif !ARCH_WASM
+
+fn_internal void co_fiber_init(CO_Fiber *fiber, void *stack_base, U64 stack_bytes, CO_Fiber_Proc *proc, void *user_data) {
+  co_panic(str_lit("co_fiber_init: fibers not supported on this architecture / compiler"));
+}
+
+fn_internal void co_fiber_switch(CO_Fiber *from, CO_Fiber *to) {
+  co_panic(str_lit("co_fiber_switch: fibers not supported on this architecture / compiler"));
+}
+
+#endif
 
 // ------------------------------------------------------------
 // #-- F32 Base Operations
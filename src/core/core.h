@@ -258,6 +258,9 @@ force_inline fn_internal Str str(U64 len, U08 *txt) { return (Str) { .len = len,
 
 fn_internal U64 cstring_len               (char *cstring);
 
+// NOTE(cmat): str_find returns the index of the first match, or str_find_none.
+#define str_find_none u64_limit_max
+
 fn_internal Str str_slice                 (Str base, U64 start, U64 len);
 fn_internal Str str_from_cstr             (char *cstring);
 fn_internal Str str_trim                  (Str string);
@@ -267,15 +270,39 @@ fn_internal B32 str_contains              (Str base, Str sub);
 fn_internal B32 str_equals_any_case       (Str lhs, Str rhs);
 fn_internal B32 str_starts_with_any_case  (Str base, Str start);
 fn_internal B32 str_contains_any_case     (Str base, Str sub);
+fn_internal U64 str_find                  (Str base, Str sub);
+fn_internal U64 str_find_any_case         (Str base, Str sub);
 fn_internal U64 str_hash                  (Str string);
-
+fn_internal U64 str_hash_seeded           (Str string, U64 seed);
+fn_internal U64 str_hash_djb2             (Str string);
+
+// NOTE(cmat): *_from_str ignore surrounding whitespace and return 0 if there's no number.
+// - *_from_str_ext parse the number at the start of the string into value, and return the
+// - bytes consumed (0 if there was none), for tokenizers. Floats are correctly rounded,
+// - accept "inf", "infinity" and "nan", and integers saturate instead of wrapping.
+fn_internal U64 i64_from_str_ext          (Str string, I64 *value);
+fn_internal U64 f64_from_str_ext          (Str string, F64 *value);
+fn_internal U64 f32_from_str_ext          (Str string, F32 *value);
 fn_internal I64 i64_from_str              (Str string);
 fn_internal F64 f64_from_str              (Str string);
+fn_internal F32 f32_from_str              (Str string);
 fn_internal B32 b32_from_str              (Str string);
 
 typedef U32 Codepoint;
 fn_internal Codepoint codepoint_from_utf8(Str str_utf8, I32 *advance);
 
+// ------------------------------------------------------------
+// #-- Hashing
+
+// NOTE(cmat): wyhash (Wang Yi, public domain), final version 4.
+// - Non-cryptographic, 64-bit output. Reads 8 and 16 bytes at a time, and above 48 bytes
+// - runs three independent multiply lanes so the bulk loop isn't latency-bound on a single mul.
+// - The seeded variant is what hash tables should use when keys can come from outside.
+
+fn_internal U64 hash_bytes                (U64 bytes, void *data);
+fn_internal U64 hash_bytes_seeded         (U64 bytes, void *data, U64 seed);
+fn_internal U64 hash_u64                  (U64 value);
+
 // ------------------------------------------------------------
 // #-- Meta-Data Collection
 
@@ -303,8 +330,8 @@ typedef struct {
 #define For_I32_Range(it_, min_, max_)  for (I32 it_ = (min_); (it_) < (max_); ++(it_))
 #define For_U32_Range(it_, min_, max_)  for (U32 it_ = (min_); (it_) < (max_); ++(it_))
 
-#define For_I32_Reverse(it_, max_)      for (I32 it_ = (max_ - 1); (it_) != 0; ++(it_))
-#define For_U32_Reverse(it_, max_)      for (U32 it_ = (max_ - 1); (it_) != 0; ++(it_))
+#define For_I32_Reverse(it_, max_)      for (I32 it_ = (max_); (it_)-- > 0; )
+#define For_U32_Reverse(it_, max_)      for (U32 it_ = (max_); (it_)-- > 0; )
 
 #define For_I64(it_, max_)              for (I64 it_ = 0; (it_) < (max_); ++(it_))
 #define For_U64(it_, max_)              for (U64 it_ = 0; (it_) < (max_); ++(it_))
@@ -312,8 +339,8 @@ typedef struct {
 #define For_I64_Range(it_, min_, max_)  for (I64 it_ = (min_); (it_) < (max_); ++(it_))
 #define For_U64_Range(it_, min_, max_)  for (U64 it_ = (min_); (it_) < (max_); ++(it_))
 
-#define For_I64_Reverse(it_, max_)      for (I64 it_ = (max_ - 1); (it_) != 0; ++(it_))
-#define For_U64_Reverse(it_, max_)      for (U64 it_ = (max_ - 1); (it_) != 0; ++(it_))
+#define For_I64_Reverse(it_, max_)      for (I64 it_ = (max_); (it_)-- > 0; )
+#define For_U64_Reverse(it_, max_)      for (U64 it_ = (max_); (it_)-- > 0; )
 
 #define For_LL(it_, type_, first_)      for (type_ * it_ = (first_); it_ = it_->next; it)
 
@@ -367,22 +394,34 @@ inline fn_internal B32 memory_compare (void *lhs, void *rhs, U64 bytes) {
 #if COMPILER_GCC || COMPILER_CLANG
 force_inline fn_internal U32   atomic_read_u32       (volatile U32 *x)             { return __atomic_load_n(x, __ATOMIC_SEQ_CST);              }
 force_inline fn_internal I32   atomic_read_i32       (volatile I32 *x)             { return __atomic_load_n(x, __ATOMIC_SEQ_CST);              }
+force_inline fn_internal U64   atomic_read_u64       (volatile U64 *x)             { return __atomic_load_n(x, __ATOMIC_SEQ_CST);              }
 force_inline fn_internal U32   atomic_write_u32      (volatile U32 *x, U32 value)  { return __atomic_exchange_n(x, value, __ATOMIC_SEQ_CST);   }
 force_inline fn_internal I32   atomic_write_i32      (volatile I32 *x, I32 value)  { return __atomic_exchange_n(x, value, __ATOMIC_SEQ_CST);   }
+force_inline fn_internal U64   atomic_write_u64      (volatile U64 *x, U64 value)  { return __atomic_exchange_n(x, value, __ATOMIC_SEQ_CST);   }
 force_inline fn_internal U32   atomic_increment_u32  (volatile U32 *x)             { return __atomic_fetch_add(x, 1, __ATOMIC_SEQ_CST) + 1;    }
 force_inline fn_internal I32   atomic_increment_i32  (volatile I32 *x)             { return __atomic_fetch_add(x, 1, __ATOMIC_SEQ_CST) + 1;    }
 force_inline fn_internal U32   atomic_decrement_u32  (volatile U32 *x)             { return __atomic_fetch_sub(x, 1, __ATOMIC_SEQ_CST) - 1;    }
 force_inline fn_internal I32   atomic_decrement_i32  (volatile I32 *x)             { return __atomic_fetch_sub(x, 1, __ATOMIC_SEQ_CST) - 1;    }
+force_inline fn_internal U32   atomic_add_u32        (volatile U32 *x, U32 value)  { return __atomic_fetch_add(x, value, __ATOMIC_SEQ_CST) + value; }
+force_inline fn_internal B32   atomic_compare_exchange_u32 (volatile U32 *x, U32 expected, U32 desired) { return __atomic_compare_exchange_n(x, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); }
+force_inline fn_internal void *atomic_read_ptr       (void * volatile *x)          { return __atomic_load_n(x, __ATOMIC_SEQ_CST);              }
+force_inline fn_internal void *atomic_write_ptr      (void * volatile *x, void *v) { return __atomic_exchange_n(x, v, __ATOMIC_SEQ_CST);       }
 
 #elif COMPILER_MSVC
 force_inline fn_internal U32   atomic_read_u32       (volatile U32 *x)             { return *x;                                                }
 force_inline fn_internal I32   atomic_read_i32       (volatile I32 *x)             { return *x;                                                }
+force_inline fn_internal U64   atomic_read_u64       (volatile U64 *x)             { return *x;                                                }
 force_inline fn_internal U32   atomic_write_u32      (volatile U32 *x, U32 value)  { InterlockedExchange((I32 *)x, (I32)value);                }
 force_inline fn_internal I32   atomic_write_i32      (volatile I32 *x, I32 value)  { InterlockedExchange(x, value);                            }
+force_inline fn_internal U64   atomic_write_u64      (volatile U64 *x, U64 value)  { return (U64)InterlockedExchange64((volatile LONG64 *)x, (LONG64)value); }
 force_inline fn_internal U32   atomic_increment_u32  (volatile U32 *x)             { return InterlockedIncrement((I32 *)x);                    }
 force_inline fn_internal I32   atomic_increment_i32  (volatile I32 *x)             { return InterlockedIncrement(x);                           }
 force_inline fn_internal U32   atomic_decrement_u32  (volatile U32 *x)             { return InterlockedDecrement((I32 *)x);                    }
 force_inline fn_internal I32   atomic_decrement_i32  (volatile I32 *x)             { return InterlockedDecrement(x);                           }
+force_inline fn_internal U32   atomic_add_u32        (volatile U32 *x, U32 value)  { return (U32)InterlockedExchangeAdd((volatile LONG *)x, (LONG)value) + value; }
+force_inline fn_internal B32   atomic_compare_exchange_u32 (volatile U32 *x, U32 expected, U32 desired) { return (U32)InterlockedCompareExchange((volatile LONG *)x, (LONG)desired, (LONG)expected) == expected; }
+force_inline fn_internal void *atomic_read_ptr       (void * volatile *x)          { return *x;                                                }
+force_inline fn_internal void *atomic_write_ptr      (void * volatile *x, void *v) { return InterlockedExchangePointer(x, v);                  }
 #endif
 
 #if ARCH_X86
@@ -416,6 +455,58 @@ inline fn_internal void mutex_end(Mutex *ticket) {
 
 #define Mutex_Scope(mutex) Defer_Scope(mutex_start(mutex), mutex_end(mutex))
 
+// NOTE(cmat): Blocking primitives, built on co_futex_wait / co_futex_wake so waiting
+// - threads sleep in the kernel instead of spinning. All of them are zero-initializable
+// - except Semaphore (initial count) and Barrier (thread count), which have an init.
+// - Cond_Var pairs with a Mutex, but the Mutex spins, so keep those critical sections short.
+
+typedef struct Cond_Var {
+  volatile U32 sequence;
+} Cond_Var;
+
+fn_internal void cond_var_wait      (Cond_Var *cond_var, Mutex *mutex);
+fn_internal void cond_var_signal    (Cond_Var *cond_var);
+fn_internal void cond_var_broadcast (Cond_Var *cond_var);
+
+typedef struct Semaphore {
+  volatile U32 count;
+  volatile U32 waiters;
+} Semaphore;
+
+fn_internal void semaphore_init     (Semaphore *semaphore, U32 count);
+fn_internal void semaphore_wait     (Semaphore *semaphore);
+fn_internal B32  semaphore_try_wait (Semaphore *semaphore);
+fn_internal void semaphore_post     (Semaphore *semaphore, U32 count);
+
+// NOTE(cmat): An auto-reset event releases a single waiter and resets itself,
+// - a manual-reset event stays signaled (releasing everyone) until event_reset.
+typedef U32 Event_Mode;
+enum {
+  Event_Mode_Auto_Reset,
+  Event_Mode_Manual_Reset,
+};
+
+typedef struct Event {
+  volatile U32 signaled;
+  Event_Mode   mode;
+} Event;
+
+fn_internal void event_init         (Event *event, Event_Mode mode);
+fn_internal void event_wait         (Event *event);
+fn_internal void event_signal       (Event *event);
+fn_internal void event_reset        (Event *event);
+
+// NOTE(cmat): barrier_wait returns 1 on exactly one of the threads (the last to arrive),
+// - handy for serial work between parallel phases. Barriers are reusable.
+typedef struct Barrier {
+  U32          thread_count;
+  volatile U32 arrived;
+  volatile U32 generation;
+} Barrier;
+
+fn_internal void barrier_init       (Barrier *barrier, U32 thread_count);
+fn_internal B32  barrier_wait       (Barrier *barrier);
+
 // ------------------------------------------------------------
 // #-- Primitive Type Constants
 
@@ -490,6 +581,23 @@ force_inline fn_internal U64 u64_min     (U64 lhs, U64 rhs)      { return lhs <
 force_inline fn_internal U64 u64_max     (U64 lhs, U64 rhs)      { return lhs > rhs ? lhs : rhs;         }
 force_inline fn_internal U64 u64_clamp   (U64 x, U64 a, U64 b)   { return u64_min(u64_max(x, a), b);     }
 
+// NOTE(cmat): Bit scans, undefined for x == 0.
+#if COMPILER_CLANG || COMPILER_GCC
+force_inline fn_internal U32 u32_count_trailing_zeros (U32 x) { return (U32)__builtin_ctz(x);   }
+force_inline fn_internal U32 u64_count_trailing_zeros (U64 x) { return (U32)__builtin_ctzll(x); }
+force_inline fn_internal U32 u32_count_leading_zeros  (U32 x) { return (U32)__builtin_clz(x);   }
+force_inline fn_internal U32 u64_count_leading_zeros  (U64 x) { return (U32)__builtin_clzll(x); }
+force_inline fn_internal U32 u32_count_set_bits       (U32 x) { return (U32)__builtin_popcount(x);   }
+force_inline fn_internal U32 u64_count_set_bits       (U64 x) { return (U32)__builtin_popcountll(x); }
+#elif COMPILER_MSVC
+force_inline fn_internal U32 u32_count_trailing_zeros (U32 x) { unsigned long r; _BitScanForward(&r, x);   return (U32)r;       }
+force_inline fn_internal U32 u64_count_trailing_zeros (U64 x) { unsigned long r; _BitScanForward64(&r, x); return (U32)r;       }
+force_inline fn_internal U32 u32_count_leading_zeros  (U32 x) { unsigned long r; _BitScanReverse(&r, x);   return 31 - (U32)r;  }
+force_inline fn_internal U32 u64_count_leading_zeros  (U64 x) { unsigned long r; _BitScanReverse64(&r, x); return 63 - (U32)r;  }
+force_inline fn_internal U32 u32_count_set_bits       (U32 x) { return (U32)__popcnt(x);                                      }
+force_inline fn_internal U32 u64_count_set_bits       (U64 x) { return (U32)__popcnt64(x);                                    }
+#endif
+
 force_inline fn_internal I08 i08_min     (I08 lhs, I08 rhs)      { return lhs < rhs ? lhs : rhs;         }
 force_inline fn_internal I08 i08_max     (I08 lhs, I08 rhs)      { return lhs > rhs ? lhs : rhs;         }
 force_inline fn_internal I08 i08_clamp   (I08 x, I08 a, I08 b)   { return i08_min(i08_max(x, a), b);     }
@@ -531,15 +639,87 @@ force_inline fn_internal F64 f64_div_safe (F64 a, F64 b)          { return b ==
 // ------------------------------------------------------------
 // #-- Character Operations
 
-inline fn_internal B32 char_is_alpha      (I08 c) { return c >= 'A' && c <= 'z'; }
-inline fn_internal B32 char_is_number     (I08 c) { return c >= '0' && c <= '9'; }
 inline fn_internal B32 char_is_upper      (I08 c) { return c >= 'A' && c <= 'Z'; }
 inline fn_internal B32 char_is_lower      (I08 c) { return c >= 'a' && c <= 'z'; }
-inline fn_internal B32 char_is_whitespace (I08 c) { return c == ' ' || c == 't' || c == 'r' || c == 'n'; }
+inline fn_internal B32 char_is_alpha      (I08 c) { return char_is_upper(c) || char_is_lower(c); }
+inline fn_internal B32 char_is_number     (I08 c) { return c >= '0' && c <= '9'; }
+inline fn_internal B32 char_is_whitespace (I08 c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
 inline fn_internal B32 char_is_visible    (I08 c) { return c >= '!' && c <= '~'; }
-inline fn_internal B32 char_is_linefeed   (I08 c) { return c == 'r' || c == 'n'; }
-inline fn_internal I08 char_to_upper      (I08 c) { return !char_is_alpha(c) ? c : (c >  'Z' ? c - ('A' - 'a') : c); }
-inline fn_internal I08 char_to_lower      (I08 c) { return !char_is_alpha(c) ? c : (c <= 'Z' ? c + ('A' - 'a') : c); }
+inline fn_internal B32 char_is_linefeed   (I08 c) { return c == '\r' || c == '\n'; }
+inline fn_internal I08 char_to_upper      (I08 c) { return char_is_lower(c) ? c - ('a' - 'A') : c; }
+inline fn_internal I08 char_to_lower      (I08 c) { return char_is_upper(c) ? c + ('a' - 'A') : c; }
+
+// ------------------------------------------------------------
+// #-- SIMD Byte Operations
+
+// NOTE(cmat): 16-wide byte compares, used by the string routines.
+// - u08_x16_mask packs a compare result into an integer with U08_X16_Mask_Stride bits per byte:
+// - SSE2 and simd128 have a movemask (1 bit per byte), NEON doesn't, so we narrow
+// - with a shift instead and get 4 bits per byte.
+
+#if ARCH_X86
+# define U08_X16_Available 1
+# define U08_X16_Mask_Stride 1
+# define U08_X16_Mask_All 0xFFFFull
+
+typedef __m128i U08_X16;
+
+force_inline fn_internal U08_X16 u08_x16_load         (U08 *ptr)                  { return _mm_loadu_si128((__m128i *)ptr); }
+force_inline fn_internal U08_X16 u08_x16_splat        (U08 x)                     { return _mm_set1_epi8((char)x);          }
+force_inline fn_internal U08_X16 u08_x16_equal        (U08_X16 lhs, U08_X16 rhs)  { return _mm_cmpeq_epi8(lhs, rhs);        }
+force_inline fn_internal U08_X16 u08_x16_and          (U08_X16 lhs, U08_X16 rhs)  { return _mm_and_si128(lhs, rhs);         }
+force_inline fn_internal U64     u08_x16_mask         (U08_X16 x)                 { return (U32)_mm_movemask_epi8(x);       }
+
+force_inline fn_internal U08_X16 u08_x16_to_lower(U08_X16 x) {
+  // NOTE(cmat): No unsigned byte compare on SSE2, bias 'A'..'Z' down to the bottom of the signed range.
+  U08_X16 biased = _mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - 'A')));
+  U08_X16 upper  = _mm_cmplt_epi8(biased, _mm_set1_epi8((char)(0x80 + 26)));
+  return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+#elif ARCH_ARM
+# include <arm_neon.h>
+# define U08_X16_Available 1
+# define U08_X16_Mask_Stride 4
+# define U08_X16_Mask_All 0xFFFFFFFFFFFFFFFFull
+
+typedef uint8x16_t U08_X16;
+
+force_inline fn_internal U08_X16 u08_x16_load         (U08 *ptr)                  { return vld1q_u8(ptr);                   }
+force_inline fn_internal U08_X16 u08_x16_splat        (U08 x)                     { return vdupq_n_u8(x);                   }
+force_inline fn_internal U08_X16 u08_x16_equal        (U08_X16 lhs, U08_X16 rhs)  { return vceqq_u8(lhs, rhs);              }
+force_inline fn_internal U08_X16 u08_x16_and          (U08_X16 lhs, U08_X16 rhs)  { return vandq_u8(lhs, rhs);              }
+force_inline fn_internal U64     u08_x16_mask         (U08_X16 x)                 { return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(x), 4)), 0); }
+
+force_inline fn_internal U08_X16 u08_x16_to_lower(U08_X16 x) {
+  U08_X16 upper = vcltq_u8(vsubq_u8(x, vdupq_n_u8('A')), vdupq_n_u8(26));
+  return vorrq_u8(x, vandq_u8(upper, vdupq_n_u8(0x20)));
+}
+
+#elif ARCH_WASM
+# include <wasm_simd128.h>
+# define U08_X16_Available 1
+# define U08_X16_Mask_Stride 1
+# define U08_X16_Mask_All 0xFFFFull
+
+typedef v128_t U08_X16;
+
+force_inline fn_internal U08_X16 u08_x16_load         (U08 *ptr)                  { return wasm_v128_load(ptr);             }
+force_inline fn_internal U08_X16 u08_x16_splat        (U08 x)                     { return wasm_u8x16_splat(x);             }
+force_inline fn_internal U08_X16 u08_x16_equal        (U08_X16 lhs, U08_X16 rhs)  { return wasm_i8x16_eq(lhs, rhs);         }
+force_inline fn_internal U08_X16 u08_x16_and          (U08_X16 lhs, U08_X16 rhs)  { return wasm_v128_and(lhs, rhs);         }
+force_inline fn_internal U64     u08_x16_mask         (U08_X16 x)                 { return wasm_i8x16_bitmask(x);           }
+
+force_inline fn_internal U08_X16 u08_x16_to_lower(U08_X16 x) {
+  U08_X16 upper = wasm_u8x16_lt(wasm_i8x16_sub(x, wasm_u8x16_splat('A')), wasm_u8x16_splat(26));
+  return wasm_v128_or(x, wasm_v128_and(upper, wasm_u8x16_splat(0x20)));
+}
+
+#else
+# define U08_X16_Available 0
+#endif
+
+#define U08_X16_Mask_Lane ((1ull << U08_X16_Mask_Stride) - 1)
 
 // ------------------------------------------------------------
 // #-- F32 Core Math
@@ -617,13 +797,64 @@ fn_internal Local_Time local_time_from_unix_time(U64 unix_seconds, U64 unix_micr
 // ------------------------------------------------------------
 // #-- Core Operating System Features
 
+typedef U32 CO_CPU_Feature_Flag;
+enum {
+  CO_CPU_Feature_SSE42    = 1 << 0,
+  CO_CPU_Feature_AVX2     = 1 << 1,
+  CO_CPU_Feature_FMA      = 1 << 2,
+  CO_CPU_Feature_F16C     = 1 << 3,
+
+  // NOTE(cmat): Carry-less multiply. PCLMULQDQ on x86, PMULL on ARM.
+  CO_CPU_Feature_CLMUL    = 1 << 4,
+
+  CO_CPU_Feature_NEON     = 1 << 5,
+  CO_CPU_Feature_SIMD128  = 1 << 6,
+};
+
 typedef struct CO_Context {
-  Str cpu_name;
-  U64 cpu_logical_cores;
-  U64 mmu_page_bytes;
-  U64 ram_capacity_bytes;
+  Str                 cpu_name;
+  U64                 cpu_logical_cores;
+  U64                 mmu_page_bytes;
+  U64                 ram_capacity_bytes;
+  CO_CPU_Feature_Flag cpu_features;
 } CO_Context;
 
+fn_internal CO_CPU_Feature_Flag co_cpu_features_from_cpuid(void);
+
+// NOTE(cmat): Threads are joinable only, and every created thread must be joined.
+// - set_name and set_affinity apply to the calling thread (that's all macOS supports),
+// - so call them from inside the thread proc. Affinity is a bitmask of logical cores.
+enum {
+  CO_Thread_Max = 256,
+};
+
+typedef void CO_Thread_Proc(void *user_data);
+typedef struct CO_Thread {
+  U32 slot;
+} CO_Thread;
+
+// NOTE(cmat): Fibers are stacks switched cooperatively on one thread. co_fiber_init prepares
+// - a fiber to run proc on the given stack, co_fiber_switch saves the running context into from
+// - and resumes to. A zeroed CO_Fiber stands for the thread's own stack when used as from.
+// - Once proc returns, the fiber is marked done and switches back to whoever resumed it last.
+// - x64 and AArch64 switch callee-saved registers directly. WASM has no stack switching, it
+// - unwinds and rewinds through Binaryen's asyncify pass (build.sh) and alice_canvas.js.
+typedef void CO_Fiber_Proc(void *user_data);
+typedef struct CO_Fiber {
+  // NOTE(cmat): alice_canvas.js reads these first four fields on WASM, keep them in place.
+  void            *stack_pointer;
+  U08             *asyncify_data;
+  U08             *asyncify_end;
+  B32              started;
+
+  U08             *stack_base;
+  U64              stack_bytes;
+  CO_Fiber_Proc   *proc;
+  void            *user_data;
+  struct CO_Fiber *caller;
+  B32              done;
+} CO_Fiber;
+
 typedef U32 CO_Stream;
 enum {
   CO_Stream_Standard_Output,
@@ -659,12 +890,34 @@ fn_internal CO_Context *              co_context              (void);
 fn_internal void                      co_stream_write         (Str buffer, CO_Stream stream);
 fn_internal void                      co_panic                (Str reason);
 fn_internal Local_Time                co_local_time           (void);
+fn_internal U64                       co_timer_nanoseconds    (void);
+
+fn_internal CO_Thread                 co_thread_create        (CO_Thread_Proc *proc, void *user_data);
+fn_internal void                      co_thread_join          (CO_Thread *thread);
+fn_internal void                      co_thread_set_name      (Str name);
+fn_internal void                      co_thread_set_affinity  (U64 core_mask);
+fn_internal void                      co_thread_yield         (void);
+
+fn_internal void                      co_fiber_init           (CO_Fiber *fiber, void *stack_base, U64 stack_bytes, CO_Fiber_Proc *proc, void *user_data);
+fn_internal void                      co_fiber_switch         (CO_Fiber *from, CO_Fiber *to);
+
+// NOTE(cmat): co_futex_wait sleeps while *address == expected, until a co_futex_wake on the
+// - same address. It can return spuriously, so always re-check the condition in a loop.
+// - co_futex_wake wakes up to count waiters (u32_limit_max for all).
+fn_internal void                      co_futex_wait           (volatile U32 *address, U32 expected);
+fn_internal void                      co_futex_wake           (volatile U32 *address, U32 count);
 
 fn_internal U08 *                     co_memory_reserve       (U64 bytes);
 fn_internal void                      co_memory_unreserve     (void *virtual_base, U64 bytes);
 fn_internal void                      co_memory_commit        (void *virtual_base, U64 bytes, CO_Commit_Flag mode);
 fn_internal void                      co_memory_uncommit      (void *virtual_base, U64 bytes);
 
+// NOTE(cmat): Maps the same bytes of physical memory twice, back to back, so base[i] and
+// - base[i + bytes] alias. bytes must be a multiple of mmu_page_bytes. Returns 0 where the
+// - OS can't alias pages (WASM), callers are expected to fall back.
+fn_internal U08 *                     co_memory_map_mirrored  (U64 bytes);
+fn_internal void                      co_memory_unmap_mirrored(void *base, U64 bytes);
+
 fn_internal void                      co_entry_point          (I32 arg_count, char **arg_values);
 
 fn_internal B32                       co_directory_create     (Str folder_path);
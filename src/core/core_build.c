@@ -1,6 +1,7 @@
 // (C) Copyright 2025 Matyas Constans
 // Licensed under the MIT License (https://opensource.org/license/mit/)
 
+#include "core_pow5.c"
 #include "core.c"
 
 #if OS_MACOS
@@ -12,22 +13,31 @@
 # include <unistd.h>
 # include <sys/syscall.h>
 # include <sys/sysctl.h>
+# include <pthread.h>
+# include <sched.h>
 
-# include "co_macos.m"
+# include "core_macos.m"
 
 #elif OS_LINUX
 # include <unistd.h>
 # include <fcntl.h>
+# include <pthread.h>
+# include <sched.h>
 
 # include <sys/syscall.h>
 # include <sys/time.h>
+# include <time.h>
 # include <sys/sysinfo.h>
 # include <sys/stat.h>
 # include <sys/mman.h>
+# include <sys/auxv.h>
+# include <sys/prctl.h>
 
 # include <linux/io_uring.h>
+# include <linux/futex.h>
+# include <linux/memfd.h>
 
-# include "co_linux.c"
+# include "core_linux.c"
 
 #elif OS_WASM
 
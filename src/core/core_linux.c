@@ -33,6 +33,84 @@ fn_internal Local_Time co_local_time(void) {
   return result;
 }
 
+fn_internal U64 co_timer_nanoseconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (U64)ts.tv_sec * 1000000000ull + (U64)ts.tv_nsec;
+}
+
+// NOTE(cmat): Thread slots hold the proc and its argument until the thread starts,
+// - so we don't need to allocate anything. A slot is released on join.
+typedef struct Linux_Thread {
+  volatile U32    used;
+  pthread_t       handle;
+  CO_Thread_Proc *proc;
+  void           *user_data;
+} Linux_Thread;
+
+var_global Linux_Thread linux_threads[CO_Thread_Max] = { };
+
+fn_internal void *linux_thread_entry(void *parameter) {
+  Linux_Thread *thread = (Linux_Thread *)parameter;
+  thread->proc(thread->user_data);
+  return 0;
+}
+
+fn_internal CO_Thread co_thread_create(CO_Thread_Proc *proc, void *user_data) {
+  CO_Thread result = { };
+  For_U32(it, CO_Thread_Max) {
+    if (atomic_compare_exchange_u32(&linux_threads[it].used, 0, 1)) {
+      Linux_Thread *thread = linux_threads + it;
+      thread->proc         = proc;
+      thread->user_data    = user_data;
+
+      if (pthread_create(&thread->handle, 0, linux_thread_entry, thread) != 0) {
+        co_panic(str_lit("pthread_create failed"));
+      }
+
+      result.slot = it + 1;
+      break;
+    }
+  }
+
+  Assert(result.slot, "exceeded CO_Thread_Max threads");
+  return result;
+}
+
+fn_internal void co_thread_join(CO_Thread *thread) {
+  Assert(thread->slot, "joining an invalid thread");
+  if (thread->slot) {
+    Linux_Thread *entry = linux_threads + thread->slot - 1;
+    pthread_join(entry->handle, 0);
+    atomic_write_u32(&entry->used, 0);
+    thread->slot = 0;
+  }
+}
+
+fn_internal void co_thread_set_name(Str name) {
+  // NOTE(cmat): The kernel truncates to 15 bytes + terminator.
+  char buffer[16] = { };
+  memory_copy(buffer, name.txt, u64_min(name.len, sizeof(buffer) - 1));
+  prctl(PR_SET_NAME, buffer, 0, 0, 0);
+}
+
+fn_internal void co_thread_set_affinity(U64 core_mask) {
+  syscall(SYS_sched_setaffinity, 0, sizeof(core_mask), &core_mask);
+}
+
+fn_internal void co_thread_yield(void) {
+  sched_yield();
+}
+
+fn_internal void co_futex_wait(volatile U32 *address, U32 expected) {
+  syscall(SYS_futex, (U32 *)address, FUTEX_WAIT_PRIVATE, expected, 0, 0, 0);
+}
+
+fn_internal void co_futex_wake(volatile U32 *address, U32 count) {
+  I32 wake_count = count > (U32)i32_limit_max ? i32_limit_max : (I32)count;
+  syscall(SYS_futex, (U32 *)address, FUTEX_WAKE_PRIVATE, wake_count, 0, 0, 0);
+}
+
 fn_internal U08 *co_memory_reserve(U64 bytes) {
   void *address = mmap(0, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
   if (address == (void*)-1) {
@@ -65,6 +143,37 @@ fn_internal void co_memory_uncommit(void *virtual_base, U64 bytes) {
   }
 }
 
+fn_internal U08 *co_memory_map_mirrored(U64 bytes) {
+  I32 fd = (I32)syscall(SYS_memfd_create, "co_mirrored", MFD_CLOEXEC);
+  if (fd < 0) {
+    return 0;
+  }
+
+  U08 *result = 0;
+  if (!ftruncate(fd, (off_t)bytes)) {
+    U08 *base = (U08 *)mmap(0, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base != (void *)-1) {
+      void *lo = mmap(base,         bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+      void *hi = mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+      if (lo == base && hi == base + bytes) {
+        result = base;
+      } else {
+        munmap(base, 2 * bytes);
+      }
+    }
+  }
+
+  // NOTE(cmat): The mappings keep the memory alive, the descriptor isn't needed anymore.
+  close(fd);
+  return result;
+}
+
+fn_internal void co_memory_unmap_mirrored(void *base, U64 bytes) {
+  if (munmap(base, 2 * bytes)) {
+    co_panic(str_lit("mirrored memory unmap failed"));
+  }
+}
+
 fn_internal B32 co_directory_create(Str folder_path) {
   // TODO(cmat): Handle this better.
   I08 buffer[4096 + 1];
@@ -177,6 +286,13 @@ int main(int argc, char **argv) {
   }
 
   linux_context.mmu_page_bytes = (U64)sysconf(_SC_PAGESIZE);
+  linux_context.cpu_features   = co_cpu_features_from_cpuid();
+
+#if ARCH_ARM
+  if (getauxval(AT_HWCAP) & HWCAP_PMULL) {
+    linux_context.cpu_features |= CO_CPU_Feature_CLMUL;
+  }
+#endif
 
   co_entry_point((I32)argc, argv);
 }
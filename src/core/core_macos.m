@@ -42,6 +42,102 @@ fn_internal Local_Time co_local_time(void) {
   return local_time;  
 }
 
+fn_internal U64 co_timer_nanoseconds(void) {
+  var_local_persist mach_timebase_info_data_t timebase = { };
+  if (!timebase.denom) {
+    mach_timebase_info(&timebase);
+  }
+
+  U64 ticks = mach_absolute_time();
+  return ticks * timebase.numer / timebase.denom;
+}
+
+// NOTE(cmat): Thread slots hold the proc and its argument until the thread starts,
+// - so we don't need to allocate anything. A slot is released on join.
+typedef struct MacOS_Thread {
+  volatile U32    used;
+  pthread_t       handle;
+  CO_Thread_Proc *proc;
+  void           *user_data;
+} MacOS_Thread;
+
+var_global MacOS_Thread macos_threads[CO_Thread_Max] = { };
+
+fn_internal void *macos_thread_entry(void *parameter) {
+  MacOS_Thread *thread = (MacOS_Thread *)parameter;
+  thread->proc(thread->user_data);
+  return 0;
+}
+
+fn_internal CO_Thread co_thread_create(CO_Thread_Proc *proc, void *user_data) {
+  CO_Thread result = { };
+  For_U32(it, CO_Thread_Max) {
+    if (atomic_compare_exchange_u32(&macos_threads[it].used, 0, 1)) {
+      MacOS_Thread *thread = macos_threads + it;
+      thread->proc         = proc;
+      thread->user_data    = user_data;
+
+      if (pthread_create(&thread->handle, 0, macos_thread_entry, thread) != 0) {
+        co_panic(str_lit("pthread_create failed"));
+      }
+
+      result.slot = it + 1;
+      break;
+    }
+  }
+
+  Assert(result.slot, "exceeded CO_Thread_Max threads");
+  return result;
+}
+
+fn_internal void co_thread_join(CO_Thread *thread) {
+  Assert(thread->slot, "joining an invalid thread");
+  if (thread->slot) {
+    MacOS_Thread *entry = macos_threads + thread->slot - 1;
+    pthread_join(entry->handle, 0);
+    atomic_write_u32(&entry->used, 0);
+    thread->slot = 0;
+  }
+}
+
+fn_internal void co_thread_set_name(Str name) {
+  char buffer[64] = { };
+  memory_copy(buffer, name.txt, u64_min(name.len, sizeof(buffer) - 1));
+  pthread_setname_np(buffer);
+}
+
+fn_internal void co_thread_set_affinity(U64 core_mask) {
+  // NOTE(cmat): macOS has no way to pin a thread to a core, only affinity tags
+  // - (threads sharing a tag prefer sharing an L2), and Apple Silicon ignores those too.
+  // - Use QoS classes instead if we ever need P-core vs E-core placement.
+}
+
+fn_internal void co_thread_yield(void) {
+  sched_yield();
+}
+
+// NOTE(cmat): __ulock_wait / __ulock_wake are what libc++ uses for std::atomic::wait.
+// - Private, but stable since 10.12. os_sync_wait_on_address is the public one, but 14.4+ only.
+extern int __ulock_wait(uint32_t operation, void *address, uint64_t value, uint32_t timeout_us);
+extern int __ulock_wake(uint32_t operation, void *address, uint64_t wake_value);
+
+#define MacOS_UL_Compare_And_Wait 1
+#define MacOS_ULF_Wake_All        0x00000100
+#define MacOS_ULF_No_Errno        0x01000000
+
+fn_internal void co_futex_wait(volatile U32 *address, U32 expected) {
+  __ulock_wait(MacOS_UL_Compare_And_Wait | MacOS_ULF_No_Errno, (void *)address, expected, 0);
+}
+
+fn_internal void co_futex_wake(volatile U32 *address, U32 count) {
+  U32 operation = MacOS_UL_Compare_And_Wait | MacOS_ULF_No_Errno;
+  if (count > 1) {
+    operation |= MacOS_ULF_Wake_All;
+  }
+
+  __ulock_wake(operation, (void *)address, 0);
+}
+
 fn_internal U08 *co_memory_reserve(U64 bytes) {
   mach_port_t   task    = mach_task_self();
   vm_address_t  address = 0;
@@ -82,6 +178,34 @@ fn_internal void co_memory_uncommit(void *virtual_base, U64 bytes) {
   }
 }
 
+fn_internal U08 *co_memory_map_mirrored(U64 bytes) {
+  mach_port_t   task    = mach_task_self();
+  vm_address_t  address = 0;
+  kern_return_t error   = vm_allocate(task, &address, (size_t)(2 * bytes), VM_FLAGS_ANYWHERE);
+  if (error != KERN_SUCCESS) {
+    return 0;
+  }
+
+  // NOTE(cmat): Replace the upper half with a shared (non-copy) view of the lower half.
+  vm_address_t mirror  = address + bytes;
+  vm_prot_t    current = 0;
+  vm_prot_t    maximum = 0;
+  error = vm_remap(task, &mirror, (vm_size_t)bytes, 0, VM_FLAGS_FIXED | VM_FLAGS_OVERWRITE,
+                   task, address, 0, &current, &maximum, VM_INHERIT_SHARE);
+
+  if (error != KERN_SUCCESS || mirror != address + bytes) {
+    vm_deallocate(task, address, (vm_size_t)(2 * bytes));
+    return 0;
+  }
+
+  return (U08 *)address;
+}
+
+fn_internal void co_memory_unmap_mirrored(void *base, U64 bytes) {
+  mach_port_t task = mach_task_self();
+  vm_deallocate(task, (vm_address_t)base, (vm_size_t)(2 * bytes));
+}
+
 // NOTE(cmat): MacOS entry point.
 int main(int argc, char **argv) {
   size_t cpu_name_len = 0;
@@ -98,7 +222,13 @@ int main(int argc, char **argv) {
     macos_context.cpu_logical_cores    = (U64)[[NSProcessInfo processInfo] processorCount];
     macos_context.ram_capacity_bytes   = (U64)[[NSProcessInfo processInfo] physicalMemory];
     macos_context.mmu_page_bytes       = (U64)getpagesize();
+    macos_context.cpu_features         = co_cpu_features_from_cpuid();
   }
 
+#if ARCH_ARM
+  // NOTE(cmat): Every Apple Silicon core has the crypto extensions.
+  macos_context.cpu_features |= CO_CPU_Feature_CLMUL;
+#endif
+
   co_entry_point((I32)argc, argv);
 }
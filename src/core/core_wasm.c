@@ -6,6 +6,15 @@
 
 #define WASM_Not_Supported(proc_) co_panic(str_lit(Macro_Stringize(proc_) ": not supported on WASM backend."));
 
+// NOTE(cmat): Threads on the web are workers sharing one WebAssembly.Memory. That needs a
+// - shared-memory build (-matomics, --shared-memory, per-thread stack and TLS setup) and
+// - cross-origin isolation on the page. Until then, this backend is single-threaded.
+fn_internal CO_Thread co_thread_create    (CO_Thread_Proc *proc, void *user_data)             { WASM_Not_Supported(co_thread_create); return (CO_Thread) { }; }
+fn_internal void      co_thread_join      (CO_Thread *thread)                                 { WASM_Not_Supported(co_thread_join);                           }
+fn_internal void      co_thread_set_name  (Str name)                                          { }
+fn_internal void      co_thread_set_affinity (U64 core_mask)                                  { }
+fn_internal void      co_thread_yield     (void)                                              { }
+
 fn_internal B32       co_directory_create (Str folder_path)                                     { WASM_Not_Supported(co_directory_create); return 0;            }
 fn_internal B32       co_directory_delete (Str folder_path)                                     { WASM_Not_Supported(co_directory_delete); return 0;            }
 fn_internal CO_File co_file_open        (Str file_path, CO_File_Access_Flag flags)          { WASM_Not_Supported(co_file_open); return (CO_File) { };     }
@@ -18,6 +27,7 @@ fn_internal void      co_file_close       (CO_File *file)
 // #-- JS - WASM core API.
 fn_external void js_co_stream_write  (U32 stream_mode, U32 string_len, char *string_txt);
 fn_external F64  js_co_unix_time     (void);
+fn_external F64  js_co_timer         (void);
 fn_external void js_co_panic         (U32 string_len, char *string_txt);
 
 var_global CO_Context wasm_context = { };
@@ -50,6 +60,75 @@ fn_internal Local_Time co_local_time(void) {
   return local_time;
 }
 
+// NOTE(cmat): The WASM build is single-threaded (see co_thread_create), so a wait could only
+// - ever be on a value nobody else can change, and there is nobody to wake. Blocking with
+// - memory.atomic.wait32 comes with the shared-memory build, together with worker threads.
+fn_internal void co_futex_wait(volatile U32 *address, U32 expected) {
+  Assert(atomic_read_u32(address) != expected, "co_futex_wait would deadlock, no other threads");
+}
+
+fn_internal void co_futex_wake(volatile U32 *address, U32 count) {
+}
+
+// NOTE(cmat): Fibers through asyncify. js_co_fiber_switch starts an unwind into from->asyncify_data,
+// - which returns all the way out to the JS export call that is running. The JS glue then either
+// - calls wasm_fiber_entry for a fiber that hasn't started, or rewinds to by calling its root
+// - export again, and points __stack_pointer at the fiber's own (shadow) stack first.
+// - The top of every fiber stack holds its asyncify buffer, so the stack grows away from it and an
+// - overflow runs into the scheduler's guard first. The thread's own context (a zeroed CO_Fiber)
+// - needs a buffer too, see wasm_fiber_root_asyncify.
+// - started tells alice_canvas.js whether the fiber has a suspended stack to rewind. A finished
+// - fiber clears it on its last switch, so the JS side drops its root instead of keeping it.
+fn_external void js_co_fiber_switch(CO_Fiber *from, CO_Fiber *to);
+
+enum {
+  WASM_Fiber_Asyncify_Bytes = 16 * 1024,
+};
+
+var_global U08 wasm_fiber_root_asyncify[WASM_Fiber_Asyncify_Bytes] = { };
+
+__attribute__((export_name("wasm_fiber_entry")))
+fn_entry void wasm_fiber_entry(CO_Fiber *fiber) {
+  co_fiber_main(fiber);
+}
+
+fn_internal void co_fiber_init(CO_Fiber *fiber, void *stack_base, U64 stack_bytes, CO_Fiber_Proc *proc, void *user_data) {
+  Assert(stack_bytes > 2 * WASM_Fiber_Asyncify_Bytes, "fiber stack too small");
+
+  zero_fill(fiber);
+  fiber->stack_base    = (U08 *)stack_base;
+  fiber->stack_bytes   = stack_bytes;
+  fiber->proc          = proc;
+  fiber->user_data     = user_data;
+  fiber->asyncify_end  = (U08 *)stack_base + stack_bytes;
+  fiber->asyncify_data = fiber->asyncify_end - WASM_Fiber_Asyncify_Bytes;
+  fiber->stack_pointer = (void *)((UAddr)fiber->asyncify_data & ~(UAddr)15);
+}
+
+fn_internal void co_fiber_switch(CO_Fiber *from, CO_Fiber *to) {
+  Assert(!to->done, "switching to a finished fiber");
+  to->caller = from;
+
+  if (!from->asyncify_data) {
+    from->asyncify_data = wasm_fiber_root_asyncify;
+    from->asyncify_end  = wasm_fiber_root_asyncify + WASM_Fiber_Asyncify_Bytes;
+    from->started       = 1;
+  }
+
+  if (from->done) {
+    from->started = 0;
+  }
+
+  js_co_fiber_switch(from, to);
+}
+
+fn_internal U64 co_timer_nanoseconds(void) {
+  // NOTE(cmat): performance.now(), in milliseconds. Browsers clamp the resolution
+  // - (5us - 100us depending on isolation), so only time batches, not single calls.
+  F64 milliseconds = js_co_timer();
+  return (U64)(milliseconds * 1000000.0);
+}
+
 // TODO(cmat): Implement our custom WASM allocator, instead of relying on 'walloc.c'
 void *malloc(__SIZE_TYPE__ size);
 void  free  (void *ptr);
@@ -79,6 +158,10 @@ fn_internal void co_memory_unreserve  (void *virtual_base, U64 bytes) {
 fn_internal void co_memory_commit   (void *virtual_base, U64 bytes, CO_Commit_Flag mode)  { }
 fn_internal void co_memory_uncommit (void *virtual_base, U64 bytes)                         { }
 
+// NOTE(cmat): Linear memory has no page tables to alias, see Ring_Buffer for the fallback.
+fn_internal U08 *co_memory_map_mirrored   (U64 bytes)             { return 0; }
+fn_internal void co_memory_unmap_mirrored (void *base, U64 bytes) { }
+
 // ------------------------------------------------------------
 // #-- WASM entry point.
 
@@ -88,6 +171,7 @@ fn_entry void wasm_entry_point(U32 cpu_logical_cores) {
   wasm_context.cpu_logical_cores  = cpu_logical_cores;
   wasm_context.mmu_page_bytes     = u64_kilobytes(64);
   wasm_context.ram_capacity_bytes = u64_gigabytes(4);
+  wasm_context.cpu_features       = co_cpu_features_from_cpuid();
 
   co_entry_point(0, 0);
 }
@@ -13,6 +13,7 @@
 
 #include "render/render_build.h"
 #include "render/render_build.c"
+#include "render/render_test.c"
 
 #include "geometry/geometry_build.h"
 #include "geometry/geometry_build.c"
@@ -26,7 +27,11 @@
 #include "ui/ui_build.h"
 #include "ui/ui_build.c"
 
-#include "http/http_wasm.c"
+#if OS_WASM
+# include "http/http_wasm.c"
+#else
+# include "http/http_linux.c"
+#endif
 
 #include "stl.h"
 
@@ -63,7 +68,6 @@ HTTP_Request request        = { };
 
 R_Buffer    index_buffer;
 R_Buffer    vertex_buffer;
-R_Buffer    world_buffer;
 R_Pipeline  pipeline;
 
 B32         loaded_model;
@@ -136,8 +140,10 @@ var_global Str files[] = {
 #endif
 
 I32          volume_at                          = 0;
+Str_Atom     volume_paths[sarray_len(files)]    = { };
 Arena        volume_arenas[sarray_len(files)]   = { };
 U32          volume_loaded[sarray_len(files)]   = { };
+U32          volume_uploading[sarray_len(files)] = { };
 R_Texture_3D volume_textures[sarray_len(files)] = { };
 HTTP_Request volume_requests[sarray_len(files)] = { };
 
@@ -242,15 +248,15 @@ fn_internal void draw_viewport(UI_Response *response, R2F draw_region, void *use
     .Eye_Position          = camera.computed_position_m,
   };
 
-  world_buffer = r_buffer_allocate(sizeof(R_Constant_Buffer_World_3D), R_Buffer_Mode_Static);
-  r_buffer_download(world_buffer, 0, sizeof(test_world), &test_world);
+  R_Uniform_Slice world_slice = r_uniform_push_type(&test_world);
 
 #if 1
 
   R2I pixel_draw_region = r2i(draw_region.x0, draw_region.y0, draw_region.x1, draw_region.y1);
  
   R_Command_Draw draw_grid = {
-    .constant_buffer  = world_buffer,
+    .constant_buffer  = world_slice.buffer,
+    .constant_offset  = world_slice.offset,
     .vertex_buffer    = vertex_buffer,
     .index_buffer     = index_buffer,
     .pipeline         = pipeline,
@@ -266,14 +272,18 @@ fn_internal void draw_viewport(UI_Response *response, R2F draw_region, void *use
     .clip_region       = pixel_draw_region,
   };
 
+  // NOTE(cmat): The viewport is painted inside the UI, after its background rect and panel and
+  // - before whatever is drawn over it, so its 3D draws stay in the overlay pass, layered over
+  // - the draw region. An earlier pass would flush them under the background.
   if (!slice_mode) {
-    r_command_push_draw(&draw_grid);
+    r_command_push_draw_keyed(&draw_grid, r_draw_key_layered(R_Pass_Overlay, &draw_grid, pixel_draw_region));
   }
 
   if (!slice_mode) {
     if (loaded_model && volume_loaded[volume_at]) {
       R_Command_Draw draw_model = {
-        .constant_buffer  = world_buffer,
+        .constant_buffer  = world_slice.buffer,
+        .constant_offset  = world_slice.offset,
         .vertex_buffer    = model_vertex_buffer,
         .index_buffer     = model_index_buffer,
         .pipeline         = model_pipeline,
@@ -289,12 +299,13 @@ fn_internal void draw_viewport(UI_Response *response, R2F draw_region, void *use
         .clip_region       = pixel_draw_region,
       };
 
-      r_command_push_draw(&draw_model);
+      r_command_push_draw_keyed(&draw_model, r_draw_key_layered(R_Pass_Overlay, &draw_model, pixel_draw_region));
     }
   } else {
     if (volume_loaded[volume_at]) {
       R_Command_Draw draw_model = {
-        .constant_buffer   = world_buffer,
+        .constant_buffer   = world_slice.buffer,
+        .constant_offset   = world_slice.offset,
         .vertex_buffer     = slice_vertex_buffer,
         .index_buffer      = slice_index_buffer,
         .pipeline          = slice_pipeline,
@@ -310,7 +321,7 @@ fn_internal void draw_viewport(UI_Response *response, R2F draw_region, void *use
         .clip_region       = pixel_draw_region,
       };
 
-      r_command_push_draw(&draw_model);
+      r_command_push_draw_keyed(&draw_model, r_draw_key_layered(R_Pass_Overlay, &draw_model, pixel_draw_region));
     }
   }
 
@@ -318,97 +329,111 @@ fn_internal void draw_viewport(UI_Response *response, R2F draw_region, void *use
 #endif
 }
 
-fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context) {
-  If_Unlikely(first_frame) {
-    r_init(render_context);
-    g2_init();
+typedef struct Volume_Range {
+  F32 min;
+  F32 max;
+} Volume_Range;
+
+typedef struct Volume_Normalize {
+  F32          *data;
+  F16          *half;
+  Volume_Range  range;
+} Volume_Normalize;
+
+fn_internal void volume_range_proc(void *user_data, Range_U64 range, void *partial) {
+  F32          *data   = ((Volume_Normalize *)user_data)->data;
+  Volume_Range *result = (Volume_Range *)partial;
+  For_U64_Range(it, range.min, range.max) {
+    result->min = f32_min(result->min, data[it]);
+    result->max = f32_max(result->max, data[it]);
+  }
+}
 
-    Codepoint icon_codepoints[] = {
-      codepoint_from_utf8(str_lit(ICON_FA_FILE), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_PAUSE), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_PLAY), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_CUBE), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_FORWARD), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_FORWARD_FAST), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_FORWARD_STEP), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_FONT), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_EYE), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_EYE_SLASH), 0),
-      codepoint_from_utf8(str_lit(ICON_FA_CAMERA_RETRO), 0),
-    };
+fn_internal void volume_range_combine(void *user_data, void *result, void *partial) {
+  Volume_Range *lhs = (Volume_Range *)result;
+  Volume_Range *rhs = (Volume_Range *)partial;
+  lhs->min = f32_min(lhs->min, rhs->min);
+  lhs->max = f32_max(lhs->max, rhs->max);
+}
 
-    // TODO(cmat): Should update dynamically with display resize.
-    U32 font_size = 0;
-    if (pl_display()->resolution.y <= 1080) {
-      font_size = 20;
-    } else if (pl_display()->resolution.y <= 1400) {
-      font_size = 26;
+fn_internal void volume_normalize_proc(void *user_data, Range_U64 range) {
+  Volume_Normalize *normalize = (Volume_Normalize *)user_data;
+  F32 min_range = normalize->range.min;
+  F32 max_range = normalize->range.max;
+  For_U64_Range(it, range.min, range.max) {
+    if (min_range == max_range) {
+      normalize->data[it] = 1.0f;
     } else {
-      font_size = 32;
+      normalize->data[it] = (normalize->data[it] - min_range) / (max_range - min_range);
     }
+  }
 
-    fo_font_init(&UI_Font_Text, &Permanent_Storage,
-                 str(figtree_regular_ttf_len, figtree_regular_ttf),
-                 font_size, v2_u16(512, 512), Codepoints_ASCII);
-
-    fo_font_init(&UI_Font_Icon, &Permanent_Storage,
-                 str(Font_Awesome_7_Free_Solid_900_otf_len, Font_Awesome_7_Free_Solid_900_otf),
-                 font_size, v2_u16(512, 512), array_from_sarray(Array_Codepoint, icon_codepoints));
-
-    ui_init(&UI_Font_Text);
-
-    arena_init(&request_arena);
-    http_request_send(&request,        &request_arena, str_lit("cube.stl"));
+  // NOTE(cmat): Normalized voxels are in [0, 1], half precision is plenty for the texture.
+  f16_from_f32_array(range.max - range.min, normalize->data + range.min, normalize->half + range.min);
+}
 
-    For_U32(it, sarray_len(volume_requests)) {
-      arena_init(&volume_arenas[it]);
-      http_request_send(volume_requests + it, &volume_arenas[it], files[it]);
+typedef struct Transfer_Map {
+  U08 *texture_data;
+  U32  texture_width;
+  B32  hsv;
+} Transfer_Map;
+
+fn_internal void transfer_map_proc(void *user_data, Range_U64 range) {
+  Transfer_Map *map   = (Transfer_Map *)user_data;
+  U64           count = range.max - range.min;
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    HSV *hsv = arena_push_count(scratch.arena, HSV, count);
+    RGB *rgb = arena_push_count(scratch.arena, RGB, count);
+
+    For_U64(it, count) {
+      F32 t = (F32)(range.min + it) / (map->texture_width - 1);
+      hsv[it] = v3f(t, 1.0f, 1.0f);
+      rgb[it] = v3f(t, t, t);
     }
 
-    F32 scale = 1000.0f;
-    F32 vmin = -1.f * scale;
-    F32 vmax = +1.f * scale;
-
-    R_Vertex_XUC_3D test_vertices[] = {
-      { .X = v3f(vmin, 0, vmin), .U = v2f(0.f, 0.f),      .C = abgr_u32_from_rgba_premul(v4f(1.f, 0.f, 0.f, 1.f)), },
-      { .X = v3f(vmax, 0, vmin), .U = v2f(scale, 0.f),    .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 0.f, 1.f)), },
-      { .X = v3f(vmax, 0, vmax), .U = v2f(scale, scale),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 0.f, 1.f, 1.f)), },
-      { .X = v3f(vmin, 0, vmax), .U = v2f(0.f, scale),    .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
-    };
-
-    U32 test_indices[] = { 0, 2, 1, 0, 3, 2 };
-
-    pipeline       = r_pipeline_create(R_Shader_Grid_3D, &R_Vertex_Format_XUC_3D, 0);
-    model_pipeline = r_pipeline_create(R_Shader_DVR_3D,  &R_Vertex_Format_XUC_3D, 1);
-    slice_pipeline = r_pipeline_create(R_Shader_SLI_3D,  &R_Vertex_Format_XUC_3D, 1);
-
-    vertex_buffer = r_buffer_allocate(sizeof(test_vertices), R_Buffer_Mode_Static);
-    r_buffer_download(vertex_buffer, 0, sizeof(test_vertices), test_vertices);
+    if (map->hsv) {
+      rgb_from_hsv_array(count, hsv, rgb);
+    }
 
-    index_buffer = r_buffer_allocate(sizeof(test_indices), R_Buffer_Mode_Static);
-    r_buffer_download(index_buffer, 0, sizeof(test_indices), test_indices);
+    For_U64(it, count) {
+      U64 texel = range.min + it;
+      map->texture_data[4 * texel + 0] = 255 * rgb[it].r;
+      map->texture_data[4 * texel + 1] = 255 * rgb[it].g;
+      map->texture_data[4 * texel + 2] = 255 * rgb[it].b;
+      map->texture_data[4 * texel + 3] = hsv[it].h;
+    }
+  }
+}
 
-    transfer_texture = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 1024, 1);
-    hsv_map_update = 1;
+// ------------------------------------------------------------
+// #-- Frame Tasks
+
+// NOTE(cmat): Every frame is a task graph, see next_frame. Tasks that call into the renderer
+// - or g2 write Frame_Resource_Render and are pinned to the calling thread, the rest (volume
+// - normalization, UI build) can run on workers and overlap with each other.
+enum {
+  Frame_Resource_Render,
+  Frame_Resource_UI,
+  Frame_Resource_Volume,
+  Frame_Resource_Transfer,
+};
 
+var_global Arena      Frame_Arena      = { };
+var_global Task_Graph Frame_Graph      = { };
+var_global B32        Frame_Graph_Dump = 0;
 
-    slice_index_count = 6;
- 
-    U32 slice_indices[] = { 0, 2, 1, 0, 3, 2 };
-    R_Vertex_XUC_3D slice_vertices[] = {
-      { .X = v3f(-5, 0, -1), .U = v2f(0.f, 0.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
-      { .X = v3f(+5, 0, -1), .U = v2f(1.f, 0.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
-      { .X = v3f(+5, 0, +1), .U = v2f(1.f, 1.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
-      { .X = v3f(-5, 0, +1), .U = v2f(0.f, 1.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
-    };
- 
-    slice_vertex_buffer = r_buffer_allocate(sizeof(slice_vertices), R_Buffer_Mode_Static);
-    r_buffer_download(slice_vertex_buffer, 0, sizeof(slice_vertices), slice_vertices);
+var_global Fiber_Scheduler Loader_Fibers = { };
 
-    slice_index_buffer = r_buffer_allocate(sizeof(slice_indices), R_Buffer_Mode_Static);
-    r_buffer_download(slice_index_buffer, 0, sizeof(slice_indices), slice_indices);
-  }
+typedef struct Frame_Volume {
+  B32  ready;
+  U32  index;
+  U32  X, Y, Z;
+  U08 *data;
+} Frame_Volume;
 
+fn_internal void frame_slice_update(void *user_data) {
   slice_timer += 2.f * pl_display()->frame_delta;
   F32 slice_height = f32_sin(slice_timer);
   R_Vertex_XUC_3D slice_vertices[] = {
@@ -419,66 +444,99 @@ fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context)
   };
 
   r_buffer_download(slice_vertex_buffer, 0, sizeof(slice_vertices), slice_vertices);
+}
 
-  if (!loaded_model && request.status == HTTP_Status_Done) {
-    loaded_model = 1;
-
-    U32 tri_count = 0;
-    R_Vertex_XUC_3D *vertices = stl_parse_binary(&request_arena, request.bytes_total, request.bytes_data, &tri_count);
-    log_info("Loaded STL: %u triangles", tri_count);
+// NOTE(cmat): The model loader is straight-line code on a fiber: it sends the request, yields
+// - once per frame while the download is in flight, then parses and uploads. The loader fibers
+// - are resumed by the "loaders" task, which is pinned to the calling thread since uploads
+// - touch the renderer.
+fn_internal void model_loader_fiber(void *user_data) {
+  http_request_send(&request, &request_arena, str_lit("cube.stl"));
+  while (request.status == HTTP_Status_In_Progress) {
+    fiber_yield();
+  }
 
-    model_vertex_buffer = r_buffer_allocate(3 * sizeof(R_Vertex_XUC_3D) * tri_count, R_Buffer_Mode_Static);
-    r_buffer_download(model_vertex_buffer, 0, 3 * sizeof(R_Vertex_XUC_3D) * tri_count, vertices);
+  if (request.status != HTTP_Status_Done) {
+    log_info("Failed to load STL");
+    return;
+  }
 
-    U32 *indices = (U32 *)arena_push_size(&request_arena, 3 * sizeof(U32) * tri_count);
-    For_U32 (it, 3 * tri_count) {
-      indices[it] = it;
-    }
+  U32              tri_count = 0;
+  R_Vertex_XUC_3D *vertices  = stl_parse_binary(&request_arena, request.bytes_total, request.bytes_data, &tri_count);
+  log_info("Loaded STL: %u triangles", tri_count);
 
-    model_index_buffer = r_buffer_allocate(3 * sizeof(U32) * tri_count, R_Buffer_Mode_Static);
-    model_index_count  = 3 * tri_count;
-    r_buffer_download(model_index_buffer, 0, 3 * sizeof(U32) * tri_count, indices);
+  U32 *indices = (U32 *)arena_push_size(&request_arena, 3 * sizeof(U32) * tri_count);
+  For_U32 (it, 3 * tri_count) {
+    indices[it] = it;
   }
 
-  if (!volume_loaded[volume_at] && volume_requests[volume_at].status == HTTP_Status_Done) {
-    volume_loaded[volume_at] = 1;
-
-    Scratch scratch = { };
-    Scratch_Scope(&scratch, 0) {
-      U08 *data_view = volume_requests[volume_at].bytes_data;
+  model_vertex_buffer = r_buffer_allocate(3 * sizeof(R_Vertex_XUC_3D) * tri_count, R_Buffer_Mode_Static);
+  r_buffer_download(model_vertex_buffer, 0, 3 * sizeof(R_Vertex_XUC_3D) * tri_count, vertices);
 
-      U32 X = *(U32 *)(data_view); data_view += sizeof(U32);
-      U32 Y = *(U32 *)(data_view); data_view += sizeof(U32);
-      U32 Z = *(U32 *)(data_view); data_view += sizeof(U32);
+  model_index_buffer = r_buffer_allocate(3 * sizeof(U32) * tri_count, R_Buffer_Mode_Static);
+  model_index_count  = 3 * tri_count;
+  r_buffer_download(model_index_buffer, 0, 3 * sizeof(U32) * tri_count, indices);
 
-      log_info("Voxel Dimensions: %u %u %u", X, Y, Z);
-      U32 bytes_total = X * Y * Z * sizeof(F32);
-      log_info("Expected: %u, Got: %u", bytes_total + sizeof(U32) * 3, volume_requests[volume_at].bytes_total);
+  loaded_model = 1;
+}
 
-      F32 min_range = f32_largest_positive;
-      F32 max_range = f32_largest_negative;
+fn_internal void frame_loaders(void *user_data) {
+  fiber_scheduler_run(&Loader_Fibers);
+}
 
-      F32 *data = (F32 *)data_view;
-      For_U32(it, X * Y * Z) {
-        min_range = f32_min(min_range, data[it]);
-        max_range = f32_max(max_range, data[it]);
-      }
+fn_internal void frame_volume_prepare(void *user_data) {
+  Frame_Volume *volume = (Frame_Volume *)user_data;
+  U32           index  = volume->index;
+  if (!volume_loaded[index] && !volume_uploading[index] && volume_requests[index].status == HTTP_Status_Done) {
+    U08 *data_view = volume_requests[index].bytes_data;
+
+    U32 X = *(U32 *)(data_view); data_view += sizeof(U32);
+    U32 Y = *(U32 *)(data_view); data_view += sizeof(U32);
+    U32 Z = *(U32 *)(data_view); data_view += sizeof(U32);
+
+    log_info("Volume '%.*s'", str_expand(str_from_atom(volume_paths[index])));
+    log_info("Voxel Dimensions: %u %u %u", X, Y, Z);
+    U32 bytes_total = X * Y * Z * sizeof(F32);
+    log_info("Expected: %u, Got: %u", bytes_total + sizeof(U32) * 3, volume_requests[index].bytes_total);
+
+    Volume_Normalize normalize = { };
+    normalize.data      = (F32 *)data_view;
+    normalize.range.min = f32_largest_positive;
+    normalize.range.max = f32_largest_negative;
+
+    Range_U64 voxels = range_u64(0, (U64)X * Y * Z);
+    normalize.half   = arena_push_count(&volume_arenas[index], F16, voxels.max, .flags = 0);
+    parallel_reduce(voxels, 64 * 1024, volume_range_proc, volume_range_combine, &normalize, &normalize.range, sizeof(normalize.range));
+
+    log_info("min: %f, max: %f", normalize.range.min, normalize.range.max);
+    parallel_for(voxels, 64 * 1024, volume_normalize_proc, &normalize);
+
+    volume->X     = X;
+    volume->Y     = Y;
+    volume->Z     = Z;
+    volume->data  = (U08 *)normalize.half;
+    volume->ready = 1;
+  }
+}
 
-      log_info("min: %f, max: %f", min_range, max_range);
-      For_U32(it, X * Y * Z) {
-        if (min_range == max_range) {
-          data[it] = 1.0f;
-        } else {
-          data[it] = (data[it] - min_range) / (max_range - min_range);
-        }
-      }
+fn_internal void volume_upload_done(void *user_data) {
+  U32 *loaded = (U32 *)user_data;
+  *loaded     = 1;
+}
 
+// NOTE(cmat): The volume goes through the staging belt, a few slices per frame, and is only
+// - drawn once the last slice is in (the half-float data lives in volume_arenas until then).
+fn_internal void frame_volume_upload(void *user_data) {
+  Frame_Volume *volume = (Frame_Volume *)user_data;
+  if (volume->ready) {
+    volume_uploading[volume->index] = 1;
 
-      volume_textures[volume_at] = r_texture_3D_allocate(R_Texture_Format_F32, X, Y, Z);
-      r_texture_3D_download(volume_textures[volume_at], R_Texture_Format_F32, r3i(0, 0, 0, X, Y, Z), data_view);
-    }
+    volume_textures[volume->index] = r_texture_3D_allocate(R_Texture_Format_F16, volume->X, volume->Y, volume->Z);
+    r_upload_texture_3D(volume_textures[volume->index], R_Texture_Format_F16, r3i(0, 0, 0, volume->X, volume->Y, volume->Z), volume->data, volume_upload_done, &volume_loaded[volume->index]);
   }
+}
 
+fn_internal void frame_ui_build(void *user_data) {
   ui_frame_begin();
 
   if (pl_input()->mouse.right.down_first_frame) {
@@ -550,6 +608,9 @@ fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context)
           volume_at = i32_min(volume_at + 1, sarray_len(volume_requests) - 1);
         }
 
+        // NOTE(cmat): Already interned, the label's node is found by atom.
+        ui_label(str_from_atom(volume_paths[volume_at]));
+
         // ui_dropdown(str_lit("View"));
 
         // ui_button(str_lit("Render"));
@@ -564,33 +625,29 @@ fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context)
       }
     }
   }
+}
 
+fn_internal void frame_transfer_update(void *user_data) {
   if (hsv_map_update) {
     Scratch scratch = { };
     Scratch_Scope(&scratch, 0) {
-      U32 texture_width = 1024;
-      U08 *texture_data = arena_push_size(scratch.arena, 4 * texture_width);
-
-      For_U32 (it, texture_width) {
-        F32 t = (F32)it / (texture_width - 1);
-        V3F c = { };
-        if (hsv_map) {
-          c = rgb_from_hsv(v3f(t, 1.0f, 1.0f));
-        } else {
-          c = v3f_lerp(t, v3f(0, 0, 0), v3f(1, 1, 1));
-        }
+      Transfer_Map map = { };
+      map.texture_width = 1024;
+      map.texture_data  = arena_push_size(scratch.arena, 4 * map.texture_width);
+      map.hsv           = hsv_map;
 
-        texture_data[4 * it + 0] = 255 * c.r;
-        texture_data[4 * it + 1] = 255 * c.g;
-        texture_data[4 * it + 2] = 255 * c.b;
-        texture_data[4 * it + 3] = t;
-      }
+      parallel_for(range_u64(0, map.texture_width), 256, transfer_map_proc, &map);
 
-      r_texture_2D_download(transfer_texture, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 1024, 1), texture_data);
+      r_texture_2D_download(transfer_texture, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 1024, 1), map.texture_data);
     }
   }
+}
 
+fn_internal void frame_ui_draw(void *user_data) {
   ui_frame_end();
+}
+
+fn_internal void frame_overlay(void *user_data) {
 
   if (pl_input()->keyboard.state[PL_KB_F]) {
     g2_clip_region(G2_Clip_None);
@@ -618,12 +675,203 @@ fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context)
     stbsp_snprintf(buffer, 512, "%.2f", fps_avg);
 
     g2_draw_text(str_from_cstr(buffer), &UI_Font_Text, v2f(10, 300));
+
+    R_Command_Stats command_stats = r_command_stats();
+    stbsp_snprintf(buffer, 512, "%u draws, %u state changes (%d saved by sorting)",
+                   command_stats.draw_count, command_stats.state_changes_sorted,
+                   (I32)command_stats.state_changes_submitted - (I32)command_stats.state_changes_sorted);
+
+    g2_draw_text(str_from_cstr(buffer), &UI_Font_Text, v2f(10, 330));
+
+    R_Upload_Stats upload_stats = r_upload_stats();
+    stbsp_snprintf(buffer, 512, "%$$llu uploaded, %$$llu pending (%llu uploads)",
+                   upload_stats.frame_bytes, upload_stats.pending_bytes, upload_stats.pending_count);
+
+    g2_draw_text(str_from_cstr(buffer), &UI_Font_Text, v2f(10, 360));
   }
+}
 
+fn_internal void frame_flush(void *user_data) {
   g2_frame_flush();
   r_frame_flush();
 }
 
+// ------------------------------------------------------------
+// #-- Capture Replay
+
+// NOTE(cmat): --replay <file> re-issues a render capture (see BUILD_RENDER_RECORD), one captured
+// - frame per frame, instead of running the viewer. Stats are logged once the capture runs out.
+var_global Str              Replay_Path = { };
+var_global R_Capture_Replay Replay      = { };
+var_global B32              Replay_Done = 0;
+
+fn_internal void replay_next_frame(B32 first_frame, PL_Render_Context *render_context) {
+  If_Unlikely(first_frame) {
+    r_init(render_context);
+
+    Str     capture = { };
+    CO_File file    = { };
+    File_IO_Scope(&file, Replay_Path, CO_File_Access_Flag_Read) {
+      capture.len = co_file_size(&file);
+      capture.txt = arena_push_size(&Permanent_Storage, capture.len, .flags = 0);
+      co_file_read(&file, 0, capture.len, capture.txt);
+    }
+
+    if (!r_capture_replay_init(&Replay, &Permanent_Storage, capture)) {
+      log_warning("'%.*s' is not a render capture", str_expand(Replay_Path));
+      Replay_Done = 1;
+    }
+  }
+
+  if (!Replay_Done && !r_capture_replay_frame(&Replay)) {
+    Replay_Done = 1;
+    r_capture_stats_log(Replay_Path, &Replay.total);
+  }
+}
+
+fn_internal void next_frame(B32 first_frame, PL_Render_Context *render_context) {
+  if (Replay_Path.len) {
+    replay_next_frame(first_frame, render_context);
+    return;
+  }
+
+  If_Unlikely(first_frame) {
+    r_init(render_context);
+    g2_init();
+
+    Codepoint icon_codepoints[] = {
+      codepoint_from_utf8(str_lit(ICON_FA_FILE), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_PAUSE), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_PLAY), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_CUBE), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_FORWARD), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_FORWARD_FAST), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_FORWARD_STEP), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_FONT), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_EYE), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_EYE_SLASH), 0),
+      codepoint_from_utf8(str_lit(ICON_FA_CAMERA_RETRO), 0),
+    };
+
+    // TODO(cmat): Should update dynamically with display resize.
+    U32 font_size = 0;
+    if (pl_display()->resolution.y <= 1080) {
+      font_size = 20;
+    } else if (pl_display()->resolution.y <= 1400) {
+      font_size = 26;
+    } else {
+      font_size = 32;
+    }
+
+    fo_font_init(&UI_Font_Text, &Permanent_Storage,
+                 str(figtree_regular_ttf_len, figtree_regular_ttf),
+                 font_size, v2_u16(512, 512), Codepoints_ASCII);
+
+    fo_font_init(&UI_Font_Icon, &Permanent_Storage,
+                 str(Font_Awesome_7_Free_Solid_900_otf_len, Font_Awesome_7_Free_Solid_900_otf),
+                 font_size, v2_u16(512, 512), array_from_sarray(Array_Codepoint, icon_codepoints));
+
+    ui_init(&UI_Font_Text);
+    arena_init(&Frame_Arena);
+
+    arena_init(&request_arena);
+    fiber_scheduler_init(&Loader_Fibers, &Permanent_Storage, 4, 0);
+    fiber_spawn(&Loader_Fibers, str_lit("model loader"), model_loader_fiber, 0);
+
+    For_U32(it, sarray_len(volume_requests)) {
+      volume_paths[it] = atom_from_str(files[it]);
+      arena_init(&volume_arenas[it]);
+      http_request_send(volume_requests + it, &volume_arenas[it], str_from_atom(volume_paths[it]));
+    }
+
+    F32 scale = 1000.0f;
+    F32 vmin = -1.f * scale;
+    F32 vmax = +1.f * scale;
+
+    R_Vertex_XUC_3D test_vertices[] = {
+      { .X = v3f(vmin, 0, vmin), .U = v2f(0.f, 0.f),      .C = abgr_u32_from_rgba_premul(v4f(1.f, 0.f, 0.f, 1.f)), },
+      { .X = v3f(vmax, 0, vmin), .U = v2f(scale, 0.f),    .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 0.f, 1.f)), },
+      { .X = v3f(vmax, 0, vmax), .U = v2f(scale, scale),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 0.f, 1.f, 1.f)), },
+      { .X = v3f(vmin, 0, vmax), .U = v2f(0.f, scale),    .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
+    };
+
+    U32 test_indices[] = { 0, 2, 1, 0, 3, 2 };
+
+    pipeline       = r_pipeline_create(R_Shader_Grid_3D, &R_Vertex_Format_XUC_3D, 0);
+    model_pipeline = r_pipeline_create(R_Shader_DVR_3D,  &R_Vertex_Format_XUC_3D, 1);
+    slice_pipeline = r_pipeline_create(R_Shader_SLI_3D,  &R_Vertex_Format_XUC_3D, 1);
+
+    vertex_buffer = r_buffer_allocate(sizeof(test_vertices), R_Buffer_Mode_Static);
+    r_buffer_download(vertex_buffer, 0, sizeof(test_vertices), test_vertices);
+
+    index_buffer = r_buffer_allocate(sizeof(test_indices), R_Buffer_Mode_Static);
+    r_buffer_download(index_buffer, 0, sizeof(test_indices), test_indices);
+
+    transfer_texture = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 1024, 1);
+    hsv_map_update = 1;
+
+
+    slice_index_count = 6;
+ 
+    U32 slice_indices[] = { 0, 2, 1, 0, 3, 2 };
+    R_Vertex_XUC_3D slice_vertices[] = {
+      { .X = v3f(-5, 0, -1), .U = v2f(0.f, 0.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
+      { .X = v3f(+5, 0, -1), .U = v2f(1.f, 0.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
+      { .X = v3f(+5, 0, +1), .U = v2f(1.f, 1.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
+      { .X = v3f(-5, 0, +1), .U = v2f(0.f, 1.f),  .C = abgr_u32_from_rgba_premul(v4f(1.f, 1.f, 1.f, 1.f)), },
+    };
+ 
+    slice_vertex_buffer = r_buffer_allocate(sizeof(slice_vertices), R_Buffer_Mode_Static);
+    r_buffer_download(slice_vertex_buffer, 0, sizeof(slice_vertices), slice_vertices);
+
+    slice_index_buffer = r_buffer_allocate(sizeof(slice_indices), R_Buffer_Mode_Static);
+    r_buffer_download(slice_index_buffer, 0, sizeof(slice_indices), slice_indices);
+  }
+
+  // NOTE(cmat): Build and run this frame's task graph.
+  // - F3 logs the next frame's timings and critical path, and its Chrome trace JSON.
+  arena_clear(&Frame_Arena);
+  task_graph_begin(&Frame_Graph, &Frame_Arena);
+
+  Frame_Volume *volume = arena_push_type(&Frame_Arena, Frame_Volume);
+  volume->index        = volume_at;
+
+  U64 render   = Task_Resource(Frame_Resource_Render);
+  U64 ui       = Task_Resource(Frame_Resource_UI);
+  U64 volumes  = Task_Resource(Frame_Resource_Volume);
+  U64 transfer = Task_Resource(Frame_Resource_Transfer);
+
+  task_graph_add(&Frame_Graph, str_lit("slice update"),    frame_slice_update,    0,      0,        render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("loaders"),         frame_loaders,         0,      0,        render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("volume prepare"),  frame_volume_prepare,  volume, 0,        volumes,       Task_Flag_None);
+  task_graph_add(&Frame_Graph, str_lit("volume upload"),   frame_volume_upload,   volume, volumes,  render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("ui build"),        frame_ui_build,        0,      0,        ui | transfer, Task_Flag_None);
+  task_graph_add(&Frame_Graph, str_lit("transfer update"), frame_transfer_update, 0,      transfer, render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("ui draw"),         frame_ui_draw,         0,      ui,       render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("overlay"),         frame_overlay,         0,      0,        render,        Task_Flag_Calling_Thread);
+  task_graph_add(&Frame_Graph, str_lit("flush"),           frame_flush,           0,      0,        render,        Task_Flag_Calling_Thread);
+
+  task_graph_execute(&Frame_Graph);
+
+  if (Frame_Graph_Dump) {
+    Frame_Graph_Dump = 0;
+    task_graph_log(&Frame_Graph);
+
+    Str trace      = task_graph_trace(&Frame_Graph, &Frame_Arena);
+    U64 line_start = 0;
+    For_U64(it, trace.len) {
+      if (trace.txt[it] == '\n') {
+        log_info("%.*s", (I32)(it - line_start), trace.txt + line_start);
+        line_start = it + 1;
+      }
+    }
+  }
+
+  if (pl_input()->keyboard.state[PL_KB_F3]) {
+    Frame_Graph_Dump = 1;
+  }
+}
+
 fn_internal void log_co_context(void) {
   Log_Zone_Scope("hardware info") {
     log_info("CPU: %.*s",            str_expand(co_context()->cpu_name));
@@ -639,5 +887,22 @@ fn_internal void pl_entry_point(Array_Str command_line, PL_Bootstrap *boot) {
 
   logger_push_hook(logger_write_entry_standard_stream, logger_format_entry_minimal);
   log_co_context();
+
+  for (U64 it = 0; it + 1 < command_line.len; ++it) {
+    if (str_equals(command_line.dat[it], str_lit("--replay"))) {
+      Replay_Path = command_line.dat[it + 1];
+    }
+
+    // NOTE(cmat): --upload-budget <MB> caps the upload bytes sent per frame, 0 for no cap.
+    if (str_equals(command_line.dat[it], str_lit("--upload-budget"))) {
+      r_upload_budget_set(u64_megabytes((U64)i64_from_str(command_line.dat[it + 1])));
+    }
+
+#if BUILD_RENDER_RECORD
+    if (str_equals(command_line.dat[it], str_lit("--capture"))) {
+      R_Capture_Path = command_line.dat[it + 1];
+    }
+#endif
+  }
 } 
 
@@ -4,25 +4,34 @@
 // ------------------------------------------------------------
 // #-- Graphics 2D Immediate Mode
 
-#define G2_Vertex_Array_Capacity u64_millions(1)
-#define G2_Index_Array_Capactiy  u64_millions(2)
+#define G2_Vertex_Array_Capacity   u64_millions(1)
+#define G2_Index_Array_Capactiy    u64_millions(2)
+#define G2_Instance_Array_Capacity u64_thousands(256)
 
 typedef struct G2_Buffer {
-  U64               vertex_at;
-  U64               vertex_capacity;
-  R_Vertex_XUC_2D  *vertex_array;
+  U64                 vertex_at;
+  U64                 vertex_capacity;
+  R_Vertex_XUC_2D    *vertex_array;
 
-  U64               index_at;
-  U64               index_capacity;
-  U32              *index_array;
+  U64                 index_at;
+  U64                 index_capacity;
+  U32                *index_array;
 
-  U32               draw_index_base;
-  U32               draw_index_count;
+  U64                 instance_at;
+  U64                 instance_capacity;
+  R_Instance_XUC_2D  *instance_array;
+
+  U32                 draw_index_base;
+  U32                 draw_index_count;
+  U32                 draw_instance_count;
 } G2_Buffer;
 
+// NOTE(cmat): Flat draws are expanded triangles. Quad draws are axis aligned textured quads
+// - (glyph runs), one R_Instance_XUC_2D each over a shared unit quad.
 typedef U32 G2_Draw_Mode;
 enum {
   G2_Draw_Mode_Flat,
+  G2_Draw_Mode_Quad,
 
   G2_Draw_Mode_Count,
 };
@@ -32,7 +41,9 @@ var_global struct {
   G2_Buffer           buffer;
   R_Buffer            vertex_buffer;
   R_Buffer            index_buffer;
-  R_Buffer            constant_viewport_2D;
+  R_Buffer            instance_buffer;
+  R_Buffer            quad_vertex_buffer;
+  R_Buffer            quad_index_buffer;
   R_Texture_2D        texture;
   R_Pipeline          pipelines[G2_Draw_Mode_Count];
   G2_Draw_Mode        draw_mode;
@@ -44,41 +55,82 @@ var_global struct {
 fn_internal void g2_init(void) {
   arena_init(&G2_State.arena);
   
-  G2_State.buffer.vertex_capacity = G2_Vertex_Array_Capacity;
-  G2_State.buffer.index_capacity  = G2_Index_Array_Capactiy;
+  G2_State.buffer.vertex_capacity   = G2_Vertex_Array_Capacity;
+  G2_State.buffer.index_capacity    = G2_Index_Array_Capactiy;
+  G2_State.buffer.instance_capacity = G2_Instance_Array_Capacity;
+
+  G2_State.buffer.vertex_array   = arena_push_count(&G2_State.arena, R_Vertex_XUC_2D,   G2_State.buffer.vertex_capacity   );
+  G2_State.buffer.index_array    = arena_push_count(&G2_State.arena, U32,               G2_State.buffer.index_capacity    );
+  G2_State.buffer.instance_array = arena_push_count(&G2_State.arena, R_Instance_XUC_2D, G2_State.buffer.instance_capacity );
+
+  G2_State.vertex_buffer   = r_buffer_allocate(G2_State.buffer.vertex_capacity   * sizeof(R_Vertex_XUC_2D),   R_Buffer_Mode_Dynamic);
+  G2_State.index_buffer    = r_buffer_allocate(G2_State.buffer.index_capacity    * sizeof(U32),               R_Buffer_Mode_Dynamic);
+  G2_State.instance_buffer = r_buffer_allocate(G2_State.buffer.instance_capacity * sizeof(R_Instance_XUC_2D), R_Buffer_Mode_Dynamic);
 
-  G2_State.buffer.vertex_array = arena_push_count(&G2_State.arena, R_Vertex_XUC_2D, G2_State.buffer.vertex_capacity );
-  G2_State.buffer.index_array  = arena_push_count(&G2_State.arena, U32,             G2_State.buffer.index_capacity  );
+  R_Vertex_K_2D quad_vertices[] = { { .K = v2f(0, 0) }, { .K = v2f(1, 0) }, { .K = v2f(1, 1) }, { .K = v2f(0, 1) } };
+  U32           quad_indices[]  = { 0, 1, 2, 0, 2, 3 };
 
-  G2_State.vertex_buffer = r_buffer_allocate(G2_State.buffer.vertex_capacity * sizeof(R_Vertex_XUC_2D), R_Buffer_Mode_Dynamic);
-  G2_State.index_buffer  = r_buffer_allocate(G2_State.buffer.index_capacity  * sizeof(U32),             R_Buffer_Mode_Dynamic);
+  G2_State.quad_vertex_buffer = r_buffer_allocate(sizeof(quad_vertices), R_Buffer_Mode_Static);
+  G2_State.quad_index_buffer  = r_buffer_allocate(sizeof(quad_indices),  R_Buffer_Mode_Static);
+  r_buffer_download(G2_State.quad_vertex_buffer, 0, sizeof(quad_vertices), quad_vertices);
+  r_buffer_download(G2_State.quad_index_buffer,  0, sizeof(quad_indices),  quad_indices);
 
-  G2_State.pipelines[G2_Draw_Mode_Flat] = r_pipeline_create(R_Shader_Flat_2D, &R_Vertex_Format_XUC_2D, 0);
+  G2_State.pipelines[G2_Draw_Mode_Flat] = r_pipeline_create(R_Shader_Flat_2D, &R_Vertex_Format_XUC_2D,  0);
+  G2_State.pipelines[G2_Draw_Mode_Quad] = r_pipeline_create(R_Shader_Quad_2D, &R_Vertex_Format_Quad_2D, 0);
   // G2_State.pipelines[G2_Draw_Mode_MTSDF]  = r_pipeline_create(R_Shader_MTSDF_2D,  &R_Vertex_Format_XUC_2D);
 
   G2_State.texture              = R_Texture_2D_White;
-  G2_State.constant_viewport_2D = r_buffer_allocate(sizeof(R_Constant_Buffer_Viewport_2D), R_Buffer_Mode_Dynamic);
   G2_State.last_clip_region     = r2i(0, 0, i32_limit_max, i32_limit_max);
   G2_State.active_clip_region   = G2_State.last_clip_region;
 }
 
+// NOTE(cmat): Pixel bounds of the pending batch, padded a pixel for coverage rounding. Batches that
+// - don't overlap can be reordered to group their state.
+fn_internal R2I g2_draw_bounds(void) {
+  R2F bounds = r2f(f32_largest_positive, f32_largest_positive, -f32_largest_positive, -f32_largest_positive);
+
+  if (G2_State.draw_mode == G2_Draw_Mode_Quad) {
+    R_Instance_XUC_2D *instances = G2_State.buffer.instance_array + G2_State.buffer.instance_at - G2_State.buffer.draw_instance_count;
+    For_U32 (it, G2_State.buffer.draw_instance_count) {
+      R2F quad  = instances[it].X;
+      bounds.x0 = f32_min(bounds.x0, f32_min(quad.x0, quad.x1));
+      bounds.y0 = f32_min(bounds.y0, f32_min(quad.y0, quad.y1));
+      bounds.x1 = f32_max(bounds.x1, f32_max(quad.x0, quad.x1));
+      bounds.y1 = f32_max(bounds.y1, f32_max(quad.y0, quad.y1));
+    }
+  } else {
+    U32 *indices = G2_State.buffer.index_array + G2_State.buffer.index_at - G2_State.buffer.draw_index_count;
+    For_U32 (it, G2_State.buffer.draw_index_count) {
+      V2F vertex = G2_State.buffer.vertex_array[indices[it]].X;
+      bounds.x0  = f32_min(bounds.x0, vertex.x);
+      bounds.y0  = f32_min(bounds.y0, vertex.y);
+      bounds.x1  = f32_max(bounds.x1, vertex.x);
+      bounds.y1  = f32_max(bounds.y1, vertex.y);
+    }
+  }
+
+  F32 limit = 1e9f;
+  return r2i((I32)f32_floor(f32_clamp(bounds.x0, -limit, limit)) - 1, (I32)f32_floor(f32_clamp(bounds.y0, -limit, limit)) - 1,
+             (I32)f32_ceil (f32_clamp(bounds.x1, -limit, limit)) + 1, (I32)f32_ceil (f32_clamp(bounds.y1, -limit, limit)) + 1);
+}
+
 fn_internal void g2_submit_draw(void) {
-  if (G2_State.buffer.draw_index_count) {
+  if (G2_State.buffer.draw_index_count || G2_State.buffer.draw_instance_count) {
 
     // TODO(cmat): Move out some parts.
     V2F display_size = pl_display()->resolution;
-    r_buffer_download(G2_State.constant_viewport_2D,
-                        0, sizeof(R_Constant_Buffer_Viewport_2D),
-                        &(R_Constant_Buffer_Viewport_2D) {
-                          .NDC_From_Screen = {
-                          .e11 = 2.f / display_size.width,
-                          .e22 = 2.f / display_size.height,
-                          .e33 = 0,
-                          .e44 = 1,
-                          .e14 = -1,
-                          .e24 = -1,
-                          .e34 =  0 }
-                        });
+    R_Constant_Buffer_Viewport_2D viewport_2D = {
+      .NDC_From_Screen = {
+        .e11 = 2.f / display_size.width,
+        .e22 = 2.f / display_size.height,
+        .e33 = 0,
+        .e44 = 1,
+        .e14 = -1,
+        .e24 = -1,
+        .e34 =  0 }
+    };
+
+    R_Uniform_Slice constant_viewport_2D = r_uniform_push_type(&viewport_2D);
 
     V2F resolution = pl_display()->resolution;
 
@@ -90,7 +142,8 @@ fn_internal void g2_submit_draw(void) {
     clip_region.y1 = i32_min((I32)pl_display()->resolution.y, clip_region.y1);
 
     R_Command_Draw draw = {
-        .constant_buffer       = G2_State.constant_viewport_2D,
+        .constant_buffer       = constant_viewport_2D.buffer,
+        .constant_offset       = constant_viewport_2D.offset,
         .vertex_buffer         = G2_State.vertex_buffer,
         .index_buffer          = G2_State.index_buffer,
         .pipeline              = G2_State.pipelines[G2_State.draw_mode],
@@ -107,9 +160,20 @@ fn_internal void g2_submit_draw(void) {
         .clip_region           = clip_region,
     };
 
-    r_command_push_draw(&draw);
-    G2_State.buffer.draw_index_count  = 0;
-    G2_State.last_clip_region         = G2_State.active_clip_region;
+    if (G2_State.draw_mode == G2_Draw_Mode_Quad) {
+      draw.vertex_buffer     = G2_State.quad_vertex_buffer;
+      draw.index_buffer      = G2_State.quad_index_buffer;
+      draw.instance_buffer   = G2_State.instance_buffer;
+      draw.draw_index_count  = 6;
+      draw.draw_index_offset = 0;
+      draw.instance_count    = G2_State.buffer.draw_instance_count;
+      draw.instance_offset   = G2_State.buffer.instance_at - G2_State.buffer.draw_instance_count;
+    }
+
+    r_command_push_draw_keyed(&draw, r_draw_key_layered(R_Pass_Overlay, &draw, g2_draw_bounds()));
+    G2_State.buffer.draw_index_count    = 0;
+    G2_State.buffer.draw_instance_count = 0;
+    G2_State.last_clip_region           = G2_State.active_clip_region;
   }
 }
 
@@ -119,12 +183,18 @@ fn_internal void g2_frame_flush(void) {
     r_buffer_download(G2_State.vertex_buffer,  0, G2_State.buffer.vertex_at * sizeof(R_Vertex_XUC_2D),  (U08 *)G2_State.buffer.vertex_array);
     r_buffer_download(G2_State.index_buffer,   0, G2_State.buffer.index_at *  sizeof(U32),              (U08 *)G2_State.buffer.index_array);
   }
+
+  if (G2_State.buffer.instance_at) {
+    r_buffer_download(G2_State.instance_buffer, 0, G2_State.buffer.instance_at * sizeof(R_Instance_XUC_2D), (U08 *)G2_State.buffer.instance_array);
+  }
   
-  G2_State.buffer.vertex_at         = 0;
-  G2_State.buffer.index_at          = 0;
-  G2_State.buffer.draw_index_base   = 0;
-  G2_State.buffer.draw_index_count  = 0;
-  G2_State.draw_mode                = 0;
+  G2_State.buffer.vertex_at           = 0;
+  G2_State.buffer.index_at            = 0;
+  G2_State.buffer.instance_at         = 0;
+  G2_State.buffer.draw_index_base     = 0;
+  G2_State.buffer.draw_index_count    = 0;
+  G2_State.buffer.draw_instance_count = 0;
+  G2_State.draw_mode                  = 0;
 
   G2_State.last_clip_region   = r2i(0, 0, i32_limit_max, i32_limit_max);
   G2_State.active_clip_region = G2_State.last_clip_region;
@@ -136,14 +206,11 @@ typedef struct {
   U32              base_index;
 } G2_Draw_Entry;
 
-fn_internal G2_Draw_Entry g2_push_draw(U32 vertex_count, U32 index_count, R_Texture_2D texture, G2_Draw_Mode mode) {
-  Assert(G2_State.buffer.vertex_at  + vertex_count  < G2_State.buffer.vertex_capacity,  "2D immediate vertex buffer overflow");
-  Assert(G2_State.buffer.index_at   + index_count   < G2_State.buffer.index_capacity,   "2D immediate index buffer overflow");
-
+fn_internal void g2_batch_begin(R_Texture_2D texture, G2_Draw_Mode mode) {
   // NOTE(cmat): If we need to change the draw mode, or we exceed the number of textures
   // - we can bind, we flush with a draw call.
   B32 submit_draw = 0;
-  if (G2_State.buffer.draw_index_count && G2_State.draw_mode != mode) {
+  if ((G2_State.buffer.draw_index_count || G2_State.buffer.draw_instance_count) && G2_State.draw_mode != mode) {
     submit_draw = 1;
   }
 
@@ -162,6 +229,16 @@ fn_internal G2_Draw_Entry g2_push_draw(U32 vertex_count, U32 index_count, R_Text
   if (submit_draw) {
     g2_submit_draw();
   }
+
+  G2_State.draw_mode = mode;
+  G2_State.texture   = texture;
+}
+
+fn_internal G2_Draw_Entry g2_push_draw(U32 vertex_count, U32 index_count, R_Texture_2D texture, G2_Draw_Mode mode) {
+  Assert(G2_State.buffer.vertex_at  + vertex_count  < G2_State.buffer.vertex_capacity,  "2D immediate vertex buffer overflow");
+  Assert(G2_State.buffer.index_at   + index_count   < G2_State.buffer.index_capacity,   "2D immediate index buffer overflow");
+
+  g2_batch_begin(texture, mode);
   
   G2_Draw_Entry entry = {
     .base_index   = G2_State.buffer.draw_index_base,
@@ -173,12 +250,21 @@ fn_internal G2_Draw_Entry g2_push_draw(U32 vertex_count, U32 index_count, R_Text
   G2_State.buffer.draw_index_count  += index_count;
   G2_State.buffer.vertex_at         += vertex_count;
   G2_State.buffer.index_at          += index_count;
-  G2_State.draw_mode                 = mode;
-  G2_State.texture                   = texture;
 
   return entry;
 }
 
+fn_internal R_Instance_XUC_2D *g2_push_quads(U32 quad_count, R_Texture_2D texture) {
+  Assert(G2_State.buffer.instance_at + quad_count < G2_State.buffer.instance_capacity, "2D immediate instance buffer overflow");
+
+  g2_batch_begin(texture, G2_Draw_Mode_Quad);
+
+  R_Instance_XUC_2D *result = G2_State.buffer.instance_array + G2_State.buffer.instance_at;
+  G2_State.buffer.draw_instance_count += quad_count;
+  G2_State.buffer.instance_at         += quad_count;
+  return result;
+}
+
 fn_internal void g2_draw_tri_ext(G2_Tri *tri) {
   G2_Draw_Entry entry = g2_push_draw(3, 3, tri->tex, G2_Draw_Mode_Flat);
   entry.indices[0]  = entry.base_index;
@@ -422,18 +508,27 @@ fn_internal void g2_draw_text_ext(G2_Text *text) {
     draw_glyph_count += !g->no_texture;
   }
 
-  G2_Draw_Entry entry = g2_push_draw(4 * draw_glyph_count, 6 * draw_glyph_count, text->font->glyph_atlas, G2_Draw_Mode_Flat);
-  U32 index_at = 0;
-  U32 vertex_at = 0;
-  
-  For_U32(it, draw_glyph_count) {
-    U32 base_index = entry.base_index + 4 * it;
-    entry.indices[index_at++] = base_index + 0;
-    entry.indices[index_at++] = base_index + 1;
-    entry.indices[index_at++] = base_index + 2;
-    entry.indices[index_at++] = base_index + 0;
-    entry.indices[index_at++] = base_index + 2;
-    entry.indices[index_at++] = base_index + 3;
+  // NOTE(cmat): Upright text is a run of instanced quads, rotated text is expanded.
+  B32                rotated   = text->rot_deg > 0.f;
+  G2_Draw_Entry      entry     = { };
+  R_Instance_XUC_2D *instances = 0;
+  U32 index_at    = 0;
+  U32 vertex_at   = 0;
+  U32 instance_at = 0;
+
+  if (rotated) {
+    entry = g2_push_draw(4 * draw_glyph_count, 6 * draw_glyph_count, text->font->glyph_atlas, G2_Draw_Mode_Flat);
+    For_U32(it, draw_glyph_count) {
+      U32 base_index = entry.base_index + 4 * it;
+      entry.indices[index_at++] = base_index + 0;
+      entry.indices[index_at++] = base_index + 1;
+      entry.indices[index_at++] = base_index + 2;
+      entry.indices[index_at++] = base_index + 0;
+      entry.indices[index_at++] = base_index + 2;
+      entry.indices[index_at++] = base_index + 3;
+    }
+  } else {
+    instances = g2_push_quads(draw_glyph_count, text->font->glyph_atlas);
   }
 
   U32 packed_color = abgr_u32_from_rgba_premul(text->color);
@@ -458,6 +553,18 @@ fn_internal void g2_draw_text_ext(G2_Text *text) {
 
       V2F offset = v2f(g->pen_offset.x, g->pen_offset.y);
 
+      if (!rotated) {
+        V2F x0 = v2f_add(draw_at, offset);
+        instances[instance_at++] = (R_Instance_XUC_2D) {
+          .X = r2f_v(x0, v2f_add(x0, v2f(g->bounds.x, g->bounds.y))),
+          .U = g->atlas_uv,
+          .C = packed_color,
+        };
+
+        draw_at.x += g->pen_advance;
+        continue;
+      }
+
       V2F x_array[] = {
         v2f_add(draw_at, offset),
         v2f_add(draw_at, v2f(offset.x + g->bounds.x, offset.y)),
@@ -465,16 +572,14 @@ fn_internal void g2_draw_text_ext(G2_Text *text) {
         v2f_add(draw_at, v2f(offset.x, offset.y + g->bounds.y)),
       };
 
-      if (text->rot_deg > 0.f) {
-        F32 angle_rad = f32_radians_from_degrees(text->rot_deg);
-        F32 c = f32_cos(angle_rad);
-        F32 s = f32_sin(angle_rad);
-        
-        For_U32(it, sarray_len(x_array)) {
-          V2F x = v2f_sub(x_array[it], text->pos);
-          x = v2f(c * x.x - s * x.y, s * x.x + c * x.y);
-          x_array[it] = v2f_add(x, text->pos);
-        }
+      F32 angle_rad = f32_radians_from_degrees(text->rot_deg);
+      F32 c = f32_cos(angle_rad);
+      F32 s = f32_sin(angle_rad);
+      
+      For_U32(it, sarray_len(x_array)) {
+        V2F x = v2f_sub(x_array[it], text->pos);
+        x = v2f(c * x.x - s * x.y, s * x.x + c * x.y);
+        x_array[it] = v2f_add(x, text->pos);
       }
 
       V2F U0 = g->atlas_uv.min;
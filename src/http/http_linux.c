@@ -0,0 +1,40 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+enum {
+  HTTP_Status_Failed        = 0,
+  HTTP_Status_Done          = 1,
+  HTTP_Status_In_Progress   = 2,
+};
+
+typedef struct HTTP_Request {
+  U32  status;
+  U32  bytes_downloaded;
+  U32  bytes_total;
+  U08 *bytes_data;
+} HTTP_Request;
+
+// NOTE(cmat): Native builds run next to their assets, the URL is read as a path relative to the
+// - working directory. Completes before returning, callers polling for In_Progress fall through.
+fn_internal void http_request_send(HTTP_Request *request, Arena *arena, Str url) {
+  zero_fill(request);
+  request->status = HTTP_Status_Failed;
+
+  CO_File file = co_file_open(url, CO_File_Access_Flag_Read);
+  if ((I64)file.os_handle_1 < 0) {
+    log_warning("http: failed to open '%.*s'", str_expand(url));
+    return;
+  }
+
+  U64 bytes = co_file_size(&file);
+  if (bytes <= u32_limit_max) {
+    request->bytes_data       = arena_push_size(arena, bytes);
+    co_file_read(&file, 0, bytes, request->bytes_data);
+
+    request->bytes_total      = (U32)bytes;
+    request->bytes_downloaded = (U32)bytes;
+    request->status           = HTTP_Status_Done;
+  }
+
+  co_file_close(&file);
+}
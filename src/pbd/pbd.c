@@ -25,17 +25,41 @@ fn_internal PBD_Springs pbd_reserve_springs(Arena *arena, U32 spring_count) {
   return result;
 }
 
+typedef struct PBD_Step {
+  PBD_Mass_Points *points;
+  F32              dt;
+} PBD_Step;
+
+fn_internal void pbd_integrate_positions(void *user_data, Range_U64 range) {
+  PBD_Step        *step   = (PBD_Step *)user_data;
+  PBD_Mass_Points *points = step->points;
+  For_U64_Range(it, range.min, range.max) {
+    points->positions_last[it] = points->positions[it];
+    points->positions[it]      = v3f_add(points->positions[it], v3f_mul(step->dt, points->velocities[it]));
+  }
+}
+
+fn_internal void pbd_update_velocities(void *user_data, Range_U64 range) {
+  PBD_Step        *step   = (PBD_Step *)user_data;
+  PBD_Mass_Points *points = step->points;
+  For_U64_Range(it, range.min, range.max) {
+    V3F step_diff           = v3f_sub(points->positions[it], points->positions_last[it]);
+    points->velocities[it]  = v3f_mul(1.f - 0.1f, v3f_div(step_diff, step->dt));
+  }
+}
+
 fn_internal void pbd_step(PBD_Mass_Points *points, PBD_Springs *springs, F32 dt, U32 substeps) {
 
+  PBD_Step step = { .points = points, .dt = dt };
+
   // NOTE(cmat): Update positions.
-  For_U32(it, points->count) {
-    points->positions_last[it] = points->positions[it];
-    points->positions[it]      = v3f_add(points->positions[it], v3f_mul(dt, points->velocities[it]));
-  }
+  parallel_for(range_u64(0, points->count), 4096, pbd_integrate_positions, &step);
 
   For_U32(it_substep, substeps) {
 
     // NOTE(cmat): Correct positions based on constraints.
+    // - Gauss-Seidel, each spring sees the corrections of the ones before it and springs
+    // - share points, so this pass stays serial.
     For_U32(it, springs->count) {
       V2U joint     = springs->joints[it];
       F32 rest_len  = springs->rest_lengths[it];
@@ -59,14 +83,7 @@ fn_internal void pbd_step(PBD_Mass_Points *points, PBD_Springs *springs, F32 dt,
     }
   }
 
-  // NOTE(cmat): Compute velocities.
-  For_U32(it, points->count) {
-    V3F step_diff           = v3f_sub(points->positions[it], points->positions_last[it]);
-    points->velocities[it]  = v3f_div(step_diff, dt);
-  }
-
-  For_U32(it, points->count) {
-    points->velocities[it]  = v3f_mul(1.f - 0.1f, points->velocities[it]);
-  }
+  // NOTE(cmat): Compute velocities, with damping.
+  parallel_for(range_u64(0, points->count), 4096, pbd_update_velocities, &step);
 }
 
@@ -8,16 +8,17 @@
 # include <CoreVideo/CoreVideo.h>
 # include <Metal/Metal.h>
 
-# include "pl_macos.m"
+# include "platform_macos.m"
 
 #elif OS_LINUX
 
 # include <X11/Xlib.h>
 # include <X11/Xatom.h>
+# include <X11/keysym.h>
 # include <GL/gl.h>
 # include <GL/glx.h>
 
-# include "pl_linux.c"
+# include "platform_linux.c"
 
 #elif OS_WASM
 
@@ -3,6 +3,81 @@
 
 var_global PL_Frame_State linux_frame_state;
 
+var_global struct {
+  V2F mouse_position;
+  V2F mouse_scroll_dt;
+  B32 mouse_buttons[3];
+  U08 keyboard_state[PL_KB_Count];
+} Linux_Input_State;
+
+// NOTE(cmat): Keysyms are read unshifted (XLookupKeysym index 0), so letters come in lower case.
+fn_internal PL_KB_Code linux_kb_code_from_keysym(KeySym keysym) {
+  if (keysym >= XK_a  && keysym <= XK_z)   return PL_KB_A  + (PL_KB_Code)(keysym - XK_a);
+  if (keysym >= XK_0  && keysym <= XK_9)   return PL_KB_0  + (PL_KB_Code)(keysym - XK_0);
+  if (keysym >= XK_F1 && keysym <= XK_F12) return PL_KB_F1 + (PL_KB_Code)(keysym - XK_F1);
+
+  switch (keysym) {
+    case XK_Shift_L:      return PL_KB_Shift_Left;
+    case XK_Shift_R:      return PL_KB_Shift_Right;
+    case XK_Control_L:    return PL_KB_Control_Left;
+    case XK_Control_R:    return PL_KB_Control_Right;
+    case XK_Alt_L:        return PL_KB_Alt_Left;
+    case XK_Alt_R:        return PL_KB_Alt_Right;
+    case XK_Super_L:      return PL_KB_Meta_Left;
+    case XK_Super_R:      return PL_KB_Meta_Right;
+    case XK_Caps_Lock:    return PL_KB_Caps_Lock;
+    case XK_Num_Lock:     return PL_KB_Num_Lock;
+    case XK_Scroll_Lock:  return PL_KB_Scroll_Lock;
+
+    case XK_Return:       return PL_KB_Enter;
+    case XK_Escape:       return PL_KB_Escape;
+    case XK_BackSpace:    return PL_KB_Backspace;
+    case XK_Tab:          return PL_KB_Tab;
+    case XK_space:        return PL_KB_Space;
+
+    case XK_minus:        return PL_KB_Minus;
+    case XK_equal:        return PL_KB_Equal;
+    case XK_bracketleft:  return PL_KB_Bracket_Left;
+    case XK_bracketright: return PL_KB_Bracket_Right;
+    case XK_backslash:    return PL_KB_Backslash;
+    case XK_semicolon:    return PL_KB_Semicolon;
+    case XK_apostrophe:   return PL_KB_Quote;
+    case XK_grave:        return PL_KB_Backquote;
+    case XK_comma:        return PL_KB_Comma;
+    case XK_period:       return PL_KB_Period;
+    case XK_slash:        return PL_KB_Slash;
+
+    case XK_Left:         return PL_KB_Arrow_Left;
+    case XK_Right:        return PL_KB_Arrow_Right;
+    case XK_Up:           return PL_KB_Arrow_Up;
+    case XK_Down:         return PL_KB_Arrow_Down;
+    case XK_Home:         return PL_KB_Home;
+    case XK_End:          return PL_KB_End;
+    case XK_Page_Up:      return PL_KB_Page_Up;
+    case XK_Page_Down:    return PL_KB_Page_Down;
+    case XK_Insert:       return PL_KB_Insert;
+    case XK_Delete:       return PL_KB_Delete;
+  }
+
+  return PL_KB_Count;
+}
+
+// NOTE(cmat): Same conventions as the WASM platform: mouse position is y up, in pixels, and
+// - scroll deltas are accumulated over the frame, a wheel notch counting 100 like a browser's deltaY.
+fn_internal void linux_update_input(PL_Input *input) {
+  input->mouse.position_dt  = v2f_sub(Linux_Input_State.mouse_position, input->mouse.position);
+  input->mouse.position     = Linux_Input_State.mouse_position;
+  input->mouse.scroll_dt    = Linux_Input_State.mouse_scroll_dt;
+  Linux_Input_State.mouse_scroll_dt = v2f(0, 0);
+
+  For_U32 (it, sarray_len(input->mouse.buttons)) {
+    input->mouse.buttons[it].down_first_frame = Linux_Input_State.mouse_buttons[it] && !input->mouse.buttons[it].down;
+    input->mouse.buttons[it].down             = Linux_Input_State.mouse_buttons[it];
+  }
+
+  input->keyboard.state = Linux_Input_State.keyboard_state;
+}
+
 fn_internal PL_Bootstrap linux_default_bootstrap(void) {
   PL_Bootstrap boot = {
     .title        = str_lit("Alice Engine"),
@@ -17,11 +92,12 @@ fn_internal PL_Bootstrap linux_default_bootstrap(void) {
 
 fn_internal PL_Frame_State *pl_frame_state(void) {
   return &linux_frame_state;
-} 
+}
 
 fn_internal void base_entry_point(Array_Str command_line) {
   PL_Bootstrap boot = linux_default_bootstrap();
   pl_entry_point(command_line, &boot);
+  Assert(boot.next_frame, "next_frame not provided");
 
   Display *display = XOpenDisplay(0);
   I32 screen = DefaultScreen(display);
@@ -47,7 +123,7 @@ fn_internal void base_entry_point(Array_Str command_line) {
   Colormap color_map = XCreateColormap(display, RootWindow(display, visual_info->screen), visual_info->visual, AllocNone);
   XSetWindowAttributes window_attributes = {
     .colormap = color_map,
-    .event_mask = ExposureMask | KeyPressMask | StructureNotifyMask,
+    .event_mask = ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask | StructureNotifyMask,
   };
 
   Window window = XCreateWindow(
@@ -73,6 +149,7 @@ fn_internal void base_entry_point(Array_Str command_line) {
 
   B32 running = 1;
   B32 first_frame = 1;
+  U64 frame_time_last = co_timer_nanoseconds();
   XEvent event = { };
 
   typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC) (Display *, GLXFBConfig, GLXContext, Bool, const int*);
@@ -83,7 +160,7 @@ fn_internal void base_entry_point(Array_Str command_line) {
     GLX_CONTEXT_MAJOR_VERSION_ARB , 4                                      ,
     GLX_CONTEXT_MINOR_VERSION_ARB , 5                                      ,
     GLX_CONTEXT_PROFILE_MASK_ARB  , GLX_CONTEXT_CORE_PROFILE_BIT_ARB       ,
-    GLX_CONTEXT_FLAGS_ARB         , GLX_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB ,
+    GLX_CONTEXT_FLAGS_ARB         , GLX_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB | (BUILD_DEBUG ? GLX_CONTEXT_DEBUG_BIT_ARB : 0),
     None
   };
 
@@ -110,7 +187,40 @@ fn_internal void base_entry_point(Array_Str command_line) {
       XNextEvent(display, &event);
 
       switch (event.type) {
-        case KeyPress: {
+        case KeyPress:
+        case KeyRelease: {
+          // NOTE(cmat): Auto-repeat sends a release immediately followed by a press, keep the key down.
+          if (event.type == KeyRelease && XPending(display)) {
+            XEvent next_event = { };
+            XPeekEvent(display, &next_event);
+            if (next_event.type == KeyPress && next_event.xkey.time == event.xkey.time && next_event.xkey.keycode == event.xkey.keycode) {
+              break;
+            }
+          }
+
+          PL_KB_Code code = linux_kb_code_from_keysym(XLookupKeysym(&event.xkey, 0));
+          if (code < PL_KB_Count) {
+            Linux_Input_State.keyboard_state[code] = event.type == KeyPress;
+          }
+        } break;
+
+        case MotionNotify: {
+          Linux_Input_State.mouse_position = v2f((F32)event.xmotion.x, linux_frame_state.display.resolution.y - (F32)event.xmotion.y);
+        } break;
+
+        case ButtonPress:
+        case ButtonRelease: {
+          B32 down = event.type == ButtonPress;
+          switch (event.xbutton.button) {
+            case Button1: Linux_Input_State.mouse_buttons[0] = down; break;
+            case Button2: Linux_Input_State.mouse_buttons[1] = down; break;
+            case Button3: Linux_Input_State.mouse_buttons[2] = down; break;
+
+            case Button4: if (down) Linux_Input_State.mouse_scroll_dt.y -= 100.f; break;
+            case Button5: if (down) Linux_Input_State.mouse_scroll_dt.y += 100.f; break;
+            case 6:       if (down) Linux_Input_State.mouse_scroll_dt.x -= 100.f; break;
+            case 7:       if (down) Linux_Input_State.mouse_scroll_dt.x += 100.f; break;
+          }
         } break;
 
         case ClientMessage: {
@@ -130,11 +240,14 @@ fn_internal void base_entry_point(Array_Str command_line) {
       }
     }
 
-    linux_frame_state.display.frame_index += 1;
-    linux_frame_state.display.frame_delta = 1.f / 200.f;
+    // NOTE(cmat): Clamped like the WASM platform, so a stall doesn't step simulations by seconds.
+    U64 frame_time_now = co_timer_nanoseconds();
+    linux_frame_state.display.frame_index  += 1;
+    linux_frame_state.display.frame_delta   = f32_min((F32)(frame_time_now - frame_time_last) / 1e9f, 1.f / 60.f);
+    linux_frame_state.display.aspect_ratio  = f32_div_safe(linux_frame_state.display.resolution.x, linux_frame_state.display.resolution.y);
+    frame_time_last = frame_time_now;
 
-    // glClearColor(.1f, .8f, .1f, 1.f);
-    // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    linux_update_input(&linux_frame_state.input);
 
     // NOTE(cmat) Call into user-code.
     boot.next_frame(first_frame, &render_context);
@@ -94,7 +94,7 @@ fn_internal CVReturn macos_display_link_hook( CVDisplayLinkRef    display_link,
     initialize_thread = 1;
     first_frame       = 1;
 
-    scratch_init_for_thread();
+    thread_context_init(str_lit("render"));
     atomic_write_i32(&MacOS_Frame_Started, 1);
   }
 
@@ -0,0 +1,142 @@
+layout(binding = 0) uniform sampler2D Texture;
+
+layout(std140, binding = 2) uniform World_3D_Type {
+  mat4 World_View_Projection;
+  vec3 Eye_Position;
+} World_3D;
+
+layout(binding = 3) uniform sampler3D Texture_Volume;
+
+vec4 vec4_unpack_u32(uint packed_color) {
+  float r = float((packed_color >> 0)  & 0xFFu) / 255.0;
+  float g = float((packed_color >> 8)  & 0xFFu) / 255.0;
+  float b = float((packed_color >> 16) & 0xFFu) / 255.0;
+  float a = float((packed_color >> 24) & 0xFFu) / 255.0;
+
+    return vec4(r, g, b, a);
+}
+
+#if defined(VERTEX_SHADER)
+
+layout(location = 0) in vec3 X;
+layout(location = 1) in vec2 U;
+layout(location = 2) in uint C;
+
+layout(location = 0) out VS_Out {
+  vec3 X;
+  vec4 C;
+  vec2 U;
+} Out;
+
+void main() {
+   gl_Position = transpose(World_3D.World_View_Projection) * vec4(X, 1.0);
+   Out.X       = X;
+   Out.C       = vec4_unpack_u32(C);
+   Out.U       = U;
+}
+
+#elif defined(PIXEL_SHADER)
+
+layout(location = 0) in VS_Out {
+  vec3 X;
+  vec4 C;
+  vec2 U;
+} In;
+
+layout(location = 0) out vec4 Color;
+
+const vec3  box_min       = vec3(-5.0, -1.0, -1.0);
+const vec3  box_max       = vec3( 5.0,  1.0,  1.0);
+const int   ray_steps     = 256;
+const float ray_step_size = 0.02;
+
+// const int   ray_steps     = 512;
+// const float ray_step_size = 0.01;
+
+vec2 intersect_ray_box(vec3 ray_origin, vec3 ray_direction) {
+  vec3 inv_direction = 1.0 / ray_direction;
+
+  vec3 t0      = (box_min - ray_origin) * inv_direction;
+  vec3 t1      = (box_max - ray_origin) * inv_direction;
+
+  vec3 t_min   = min(t0, t1);
+  vec3 t_max   = max(t0, t1);
+
+  float t_enter = max(max(t_min.x, t_min.y), t_min.z);
+  float t_exit  = min(min(t_max.x, t_max.y), t_max.z);
+
+  return vec2(t_enter, t_exit);
+}
+
+// NOTE(cmat): texelFetch is undefined out of bounds (textureLoad clamps), so the +1 neighbours
+// - are clamped to the last voxel.
+float sample_volume(vec3 position) {
+    vec3 p = clamp(
+        (position - box_min) / (box_max - box_min),
+        vec3(0.0),
+        vec3(1.0)
+    );
+
+    ivec3 voxels = textureSize(Texture_Volume, 0);
+    vec3 size = vec3(voxels);
+    vec3 coord = p * (size - 1.0);
+
+    ivec3 base = ivec3(floor(coord));
+    ivec3 last = voxels - 1;
+    vec3 frac = fract(coord);
+
+    float c000 = texelFetch(Texture_Volume, min(base + ivec3(0,0,0), last), 0).r;
+    float c100 = texelFetch(Texture_Volume, min(base + ivec3(1,0,0), last), 0).r;
+    float c010 = texelFetch(Texture_Volume, min(base + ivec3(0,1,0), last), 0).r;
+    float c110 = texelFetch(Texture_Volume, min(base + ivec3(1,1,0), last), 0).r;
+    float c001 = texelFetch(Texture_Volume, min(base + ivec3(0,0,1), last), 0).r;
+    float c101 = texelFetch(Texture_Volume, min(base + ivec3(1,0,1), last), 0).r;
+    float c011 = texelFetch(Texture_Volume, min(base + ivec3(0,1,1), last), 0).r;
+    float c111 = texelFetch(Texture_Volume, min(base + ivec3(1,1,1), last), 0).r;
+
+    float c00 = mix(c000, c100, frac.x);
+    float c10 = mix(c010, c110, frac.x);
+    float c01 = mix(c001, c101, frac.x);
+    float c11 = mix(c011, c111, frac.x);
+
+    float c0 = mix(c00, c10, frac.y);
+    float c1 = mix(c01, c11, frac.y);
+
+    return mix(c0, c1, frac.z);
+}
+
+vec4 transfer_function(float value) {
+  float alpha = 1.0 - exp(-value * ray_step_size);
+  vec4  color = textureLod(Texture, vec2(value, 0), 0.0);
+  return vec4(color.rgb, alpha);
+}
+
+void main() {
+  vec3  ray_origin    = World_3D.Eye_Position;
+  vec3  ray_direction = normalize(In.X - ray_origin);
+  vec2  t_hit         = intersect_ray_box(ray_origin, ray_direction);
+  float t_enter       = t_hit.x;
+  float t_exit        = t_hit.y;
+
+  if (t_exit < t_enter || t_exit < 0.0) {
+    discard;
+  }
+
+  vec4  accum_color = vec4(0.0);
+  float ray_t       = max(t_enter, 0.0);
+
+  // NOTE(cmat): The loop exits early here, so the transfer function samples with an explicit lod.
+  for (int it = 0; it < ray_steps; it++) {
+    if ((ray_t > t_exit) || accum_color.a >= 1.0) { break; }
+
+    vec3 sample_position = ray_origin + ray_t * ray_direction;
+    float value          = sample_volume(sample_position);
+    vec4 color           = transfer_function(value);
+    accum_color         += (1.0 - accum_color.a) * vec4(color.rgb * color.a, color.a);
+    ray_t               += ray_step_size;
+  }
+
+  Color = accum_color;
+}
+
+#endif
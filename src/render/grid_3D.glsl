@@ -0,0 +1,70 @@
+layout(binding = 0) uniform sampler2D Texture;
+
+layout(std140, binding = 2) uniform World_3D_Type {
+  mat4 World_View_Projection;
+  vec3 Eye_Position;
+} World_3D;
+
+layout(binding = 3) uniform sampler3D Texture_Volume;
+
+vec4 vec4_unpack_u32(uint packed_color) {
+  float r = float((packed_color >> 0)  & 0xFFu) / 255.0;
+  float g = float((packed_color >> 8)  & 0xFFu) / 255.0;
+  float b = float((packed_color >> 16) & 0xFFu) / 255.0;
+  float a = float((packed_color >> 24) & 0xFFu) / 255.0;
+
+    return vec4(r, g, b, a);
+}
+
+#if defined(VERTEX_SHADER)
+
+layout(location = 0) in vec3 X;
+layout(location = 1) in vec2 U;
+layout(location = 2) in uint C;
+
+layout(location = 0) out VS_Out {
+  vec4 C;
+  vec2 U;
+} Out;
+
+void main() {
+   gl_Position = transpose(World_3D.World_View_Projection) * vec4(X, 1.0);
+   Out.C       = vec4_unpack_u32(C);
+   Out.U       = U;
+}
+
+#elif defined(PIXEL_SHADER)
+
+layout(location = 0) in VS_Out {
+  vec4 C;
+  vec2 U;
+} In;
+
+layout(location = 0) out vec4 Color;
+
+// TODO(cmat): Temporary, based on https://github.com/toji/pristine-grid-webgpu.
+// TODO(cmat): Reimplement based on the original article, add major/minor grid rendering.
+float PristineGrid(vec2 uv, vec2 lineWidth) {
+    vec4 uvDDXY = vec4(dFdx(uv), dFdy(uv));
+    vec2 uvDeriv = vec2(length(uvDDXY.xz), length(uvDDXY.yw));
+    bvec2 invertLine = greaterThan(lineWidth, vec2(0.5));
+    vec2 targetWidth = mix(lineWidth, 1.0 - lineWidth, invertLine);
+    vec2 drawWidth = clamp(targetWidth, uvDeriv, vec2(0.5));
+    vec2 lineAA = uvDeriv * 1.5;
+    vec2 gridUV = abs(fract(uv) * 2.0 - 1.0);
+    gridUV = mix(1.0 - gridUV, gridUV, invertLine);
+    vec2 grid2 = smoothstep(drawWidth + lineAA, drawWidth - lineAA, gridUV);
+    grid2 *= clamp(targetWidth / drawWidth, 0.0, 1.0);
+    grid2 = mix(grid2, targetWidth, clamp(uvDeriv * 2.0 - 1.0, 0.0, 1.0));
+    grid2 = mix(grid2, 1.0 - grid2, invertLine);
+    return mix(grid2.x, 1.0, grid2.y);
+}
+
+const vec2 line_width = vec2(0.01, 0.01);
+
+void main() {
+  float grid = PristineGrid(In.U, line_width);
+  Color      = mix(vec4(0.0, 0.0, 0.0, 0.0), vec4(1.0, 1.0, 1.0, 1.0), grid);
+}
+
+#endif
@@ -0,0 +1,52 @@
+layout(binding = 0) uniform sampler2D Texture;
+
+layout(std140, binding = 2) uniform Viewport_2D_Type {
+  mat4 NDC_From_Screen;
+} Viewport_2D;
+
+layout(binding = 3) uniform sampler3D Texture_Volume;
+
+vec4 vec4_unpack_u32(uint packed_color) {
+  float r = float((packed_color >> 0)  & 0xFFu) / 255.0;
+  float g = float((packed_color >> 8)  & 0xFFu) / 255.0;
+  float b = float((packed_color >> 16) & 0xFFu) / 255.0;
+  float a = float((packed_color >> 24) & 0xFFu) / 255.0;
+
+    return vec4(r, g, b, a);
+}
+
+#if defined(VERTEX_SHADER)
+
+// NOTE(cmat): K is the unit quad corner (per vertex), X the rect (x0, y0, x1, y1) and U the
+// - UV rect (per instance), see R_Vertex_Format_Quad_2D.
+layout(location = 0) in vec2 K;
+layout(location = 1) in vec4 X;
+layout(location = 2) in vec4 U;
+layout(location = 3) in uint C;
+
+layout(location = 0) out VS_Out {
+  vec4 C;
+  vec2 U;
+} Out;
+
+void main() {
+   gl_Position = transpose(Viewport_2D.NDC_From_Screen) * vec4(mix(X.xy, X.zw, K), 0.0, 1.0);
+   Out.C       = vec4_unpack_u32(C);
+   Out.U       = mix(U.xy, U.zw, K);
+}
+
+#elif defined(PIXEL_SHADER)
+
+layout(location = 0) in VS_Out {
+  vec4 C;
+  vec2 U;
+} In;
+
+layout(location = 0) out vec4 Color;
+
+void main() {
+   vec4 color_texture = texture(Texture, In.U);
+   Color              = color_texture * In.C;
+}
+
+#endif
@@ -0,0 +1,56 @@
+@group(0) @binding(0)
+var Texture : texture_2d<f32>;
+  
+@group(0) @binding(1)
+var Sampler : sampler;
+
+struct Viewport_2D_Type {
+  @align(16) NDC_From_Screen : mat4x4<f32>,
+};
+
+@group(0) @binding(2)
+var<uniform> Viewport_2D : Viewport_2D_Type;
+
+@group(0) @binding(3)
+var Texture_Volume : texture_3d<f32>;
+
+fn vec4_unpack_u32(packed: u32) -> vec4<f32> {
+  let r = f32((packed >> 0)  & 0xFFu) / 255.0;
+  let g = f32((packed >> 8)  & 0xFFu) / 255.0;
+  let b = f32((packed >> 16) & 0xFFu) / 255.0;
+  let a = f32((packed >> 24) & 0xFFu) / 255.0;
+
+    return vec4<f32>(r, g, b, a);
+}
+
+struct VS_Out {
+    @builtin(position)  X : vec4<f32>,
+    @location(0)        C : vec4<f32>,
+    @location(1)        U : vec2<f32>,
+};
+
+// NOTE(cmat): K is the unit quad corner (per vertex), X the rect (x0, y0, x1, y1) and U the
+// - UV rect (per instance), see R_Vertex_Format_Quad_2D.
+@vertex
+fn vs_main(@location(0) K : vec2<f32>,
+           @location(1) X : vec4<f32>,
+           @location(2) U : vec4<f32>,
+           @location(3) C : u32) -> VS_Out {
+
+   var out : VS_Out;
+
+   out.X = transpose(Viewport_2D.NDC_From_Screen) * vec4<f32>(mix(X.xy, X.zw, K), 0.0, 1.0);
+   out.C = vec4_unpack_u32(C);
+   out.U = mix(U.xy, U.zw, K);
+
+   return out;
+}
+
+@fragment
+fn fs_main(@location(0) C : vec4<f32>,
+           @location(1) U : vec2<f32> ) -> @location(0) vec4<f32> {
+
+   let color_texture = textureSample(Texture, Sampler, U);
+   let color         = color_texture * C;
+   return color;
+}
@@ -11,14 +11,58 @@ R_Texture_3D  R_Texture_3D_Invalid = {};
 R_Sampler     R_Sampler_Invalid    = {};
 R_Pipeline    R_Pipeline_Invalid   = {};
 
+// ------------------------------------------------------------
+// #-- Resource Handles
+
+fn_internal void r_handle_pool_init(R_Handle_Pool *pool, Arena *arena, U32 capacity) {
+  Assert(capacity <= R_Handle_Index_Mask + 1, "handle pool capacity exceeds index bits");
+
+  zero_fill(pool);
+  pool->capacity    = capacity;
+  pool->slot_count  = 1;
+  pool->generations = arena_push_count(arena, U32, capacity);
+  pool->free_slots  = arena_push_count(arena, U32, capacity, .flags = 0);
+}
+
+fn_internal R_Resource r_handle_pool_alloc(R_Handle_Pool *pool) {
+  U32 index = 0;
+  if (pool->free_count) {
+    index = pool->free_slots[--pool->free_count];
+  } else {
+    Assert(pool->slot_count < pool->capacity, "out of render handles");
+    index = pool->slot_count++;
+  }
+
+  return r_handle_make(index, pool->generations[index]);
+}
+
+// NOTE(cmat): A stale or double free is ignored, pushing the slot twice would hand it out twice.
+fn_internal void r_handle_pool_free(R_Handle_Pool *pool, R_Resource handle) {
+  if (!r_handle_pool_valid(pool, handle)) {
+    return;
+  }
+
+  U32 index = r_handle_index(handle);
+  pool->generations[index]             = (pool->generations[index] + 1) & R_Handle_Generation_Mask;
+  pool->free_slots[pool->free_count++] = index;
+}
+
+fn_internal B32 r_handle_pool_valid(R_Handle_Pool *pool, R_Resource handle) {
+  U32 index = r_handle_index(handle);
+  return index && index < pool->slot_count && pool->generations[index] == r_handle_generation(handle);
+}
+
 // ------------------------------------------------------------
 // #-- Render Commands
 
 R_Command_Buffer R_Commands = {};
 
 fn_internal void r_command_reset(void) {
-  R_Commands.first  = 0;
-  R_Commands.last   = 0;
+  R_Commands.first       = 0;
+  R_Commands.last        = 0;
+  R_Commands.layer_floor = 0;
+  R_Commands.layer_top   = 0;
+  R_Commands.layer_count = 0;
   arena_clear(&R_Commands.arena);
 }
 
@@ -34,7 +78,364 @@ fn_internal U08 *r_command_push(R_Command_Type type, U64 bytes) {
   return ((U08 *)header) + sizeof(R_Command_Header);
 }
 
+fn_internal void r_command_push_draw_keyed(R_Command_Draw *draw, U64 sort_key) {
+  U08 *command = r_command_push(R_Command_Type_Draw, sizeof(R_Command_Draw));
+  memory_copy(command, draw, sizeof(R_Command_Draw));
+  R_Commands.last->sort_key = sort_key;
+}
+
 fn_internal void r_command_push_draw(R_Command_Draw *draw) {
-  memory_copy(r_command_push(R_Command_Type_Draw, sizeof(R_Command_Draw)), draw, sizeof(R_Command_Draw));
+  r_command_push_draw_keyed(draw, r_draw_key_ordered(R_Pass_Overlay));
+}
+
+// ------------------------------------------------------------
+// #-- Draw Sorting
+
+fn_internal U64 r_draw_key(R_Pass pass, R_Command_Draw *draw, F32 depth) {
+  U64 material = (U64)draw->texture         * 0x9E3779B97F4A7C15ull ^
+                 (U64)draw->texture_volume  * 0xC2B2AE3D27D4EB4Full ^
+                 (U64)draw->sampler         * 0x165667B19E3779F9ull ^
+                 (U64)draw->constant_buffer * 0x27D4EB2F165667C5ull;
+
+  U64 depth_bits = (U64)(f32_clamp(depth, 0.f, 1.f) * (F32)0xFFFFFF);
+  return ((U64)pass << 60) | (((U64)draw->pipeline & 0xFFFF) << 44) | ((material >> 44) << 24) | depth_bits;
+}
+
+fn_internal U64 r_draw_key_layered(R_Pass pass, R_Command_Draw *draw, R2I bounds) {
+  U64 material = (U64)draw->texture         * 0x9E3779B97F4A7C15ull ^
+                 (U64)draw->texture_volume  * 0xC2B2AE3D27D4EB4Full ^
+                 (U64)draw->sampler         * 0x165667B19E3779F9ull ^
+                 (U64)draw->constant_buffer * 0x27D4EB2F165667C5ull;
+
+  U64 state = (((U64)draw->pipeline & 0xFFFF) << 28) | (material >> 36);
+
+  if (R_Commands.layer_count == R_Draw_Layer_Capacity) {
+    R_Commands.layer_floor = R_Commands.layer_top + 1;
+    R_Commands.layer_count = 0;
+  }
+
+  U32 layer = R_Commands.layer_floor;
+  For_U32 (it, R_Commands.layer_count) {
+    R_Draw_Layer_Entry *entry = &R_Commands.layers[it];
+    if (entry->bounds.x0 < bounds.x1 && bounds.x0 < entry->bounds.x1 &&
+        entry->bounds.y0 < bounds.y1 && bounds.y0 < entry->bounds.y1) {
+      layer = u32_max(layer, entry->layer + (entry->state != state));
+    }
+  }
+
+  Assert(layer <= R_Draw_Layer_Max, "out of draw layers");
+  R_Commands.layers[R_Commands.layer_count++] = (R_Draw_Layer_Entry) { .bounds = bounds, .layer = layer, .state = state };
+  R_Commands.layer_top = u32_max(R_Commands.layer_top, layer);
+
+  return ((U64)pass << 60) | ((U64)layer << 44) | state;
+}
+
+fn_internal U64 r_draw_key_ordered(R_Pass pass) {
+  U32 layer = ++R_Commands.layer_top;
+  Assert(layer <= R_Draw_Layer_Max, "out of draw layers");
+
+  R_Commands.layer_floor = layer + 1;
+  R_Commands.layer_count = 0;
+  return ((U64)pass << 60) | ((U64)layer << 44);
+}
+
+fn_internal U32 r_draw_state_changes(R_Command_Draw *last, R_Command_Draw *draw) {
+  if (!last) {
+    return 4;
+  }
+
+  U32 result = 0;
+  result += last->pipeline      != draw->pipeline;
+  result += last->vertex_buffer   != draw->vertex_buffer ||
+            last->instance_buffer != draw->instance_buffer;
+  result += last->index_buffer  != draw->index_buffer;
+  result += last->texture         != draw->texture        ||
+            last->texture_volume  != draw->texture_volume ||
+            last->sampler         != draw->sampler        ||
+            last->constant_buffer != draw->constant_buffer;
+
+  return result;
+}
+
+fn_internal R_Command_Draw **r_command_sort(Arena *arena, U32 *draw_count) {
+  U32 count = 0;
+  for (R_Command_Header *it = R_Commands.first; it; it = it->next) {
+    count += it->type == R_Command_Type_Draw;
+  }
+
+  R_Command_Draw **draws  = arena_push_count(arena, R_Command_Draw *, count, .flags = 0);
+  Sort_Pair_U64   *pairs  = arena_push_count(arena, Sort_Pair_U64,    count, .flags = 0);
+  R_Command_Stats  stats  = { .draw_count = count };
+  R_Command_Draw  *last   = 0;
+  U32              at     = 0;
+
+  for (R_Command_Header *it = R_Commands.first; it; it = it->next) {
+    if (it->type == R_Command_Type_Draw) {
+      R_Command_Draw *draw = (R_Command_Draw *)pointer_offset_bytes(it, sizeof(R_Command_Header));
+      stats.state_changes_submitted += r_draw_state_changes(last, draw);
+
+      draws[at] = draw;
+      pairs[at] = (Sort_Pair_U64) { .key = it->sort_key, .index = at };
+      last      = draw;
+      at       += 1;
+    }
+  }
+
+  radix_sort_pairs_u64(arena, pairs, count);
+
+  R_Command_Draw **sorted = arena_push_count(arena, R_Command_Draw *, count, .flags = 0);
+  last = 0;
+  For_U32 (it, count) {
+    sorted[it] = draws[pairs[it].index];
+    stats.state_changes_sorted += r_draw_state_changes(last, sorted[it]);
+    last = sorted[it];
+  }
+
+  R_Commands.stats = stats;
+  *draw_count      = count;
+  return sorted;
+}
+
+fn_internal R_Command_Stats r_command_stats(void) {
+  return R_Commands.stats;
+}
+
+
+// ------------------------------------------------------------
+// #-- Uniform Ring
+
+R_Uniform_Ring R_Uniforms = { };
+
+fn_internal R_Uniform_Slice r_uniform_push(void *data, U64 bytes) {
+  Assert(bytes <= R_Uniform_Binding_Bytes, "uniform slice larger than its binding");
+
+  if (!R_Uniforms.initialized) {
+    R_Uniforms.initialized = 1;
+    arena_init(&R_Uniforms.arena);
+  }
+
+  R_Uniform_Frame *frame = &R_Uniforms.frames[R_Uniforms.frame_at];
+  R_Uniform_Block *block = frame->block_at < frame->block_count ? &frame->blocks[frame->block_at] : 0;
+
+  if (block && block->used + R_Uniform_Binding_Bytes > R_Uniform_Block_Bytes) {
+    frame->block_at += 1;
+    block = frame->block_at < frame->block_count ? &frame->blocks[frame->block_at] : 0;
+  }
+
+  // NOTE(cmat): Blocks are only ever added, steady state frames reuse the ones they have.
+  // - The ring already keeps R_Uniform_Frame_Count frames of blocks, so they are static: a
+  // - dynamic buffer is multi-buffered again by the backend (three regions on GL), nine copies
+  // - of every block, plus a carry-forward copy whenever a frame uses less than the last.
+  if (!block) {
+    Assert(frame->block_count < R_Uniform_Block_Max, "out of uniform blocks");
+
+    block         = &frame->blocks[frame->block_count++];
+    block->buffer = r_buffer_allocate(R_Uniform_Block_Bytes, R_Buffer_Mode_Static);
+    block->data   = arena_push_size(&R_Uniforms.arena, R_Uniform_Block_Bytes);
+    block->used   = 0;
+    frame->block_at = frame->block_count - 1;
+  }
+
+  R_Uniform_Slice result = { .buffer = block->buffer, .offset = block->used };
+  memory_copy(block->data + block->used, data, bytes);
+  block->used += R_Uniform_Alignment;
+  return result;
+}
+
+fn_internal void r_uniform_flush(void) {
+  R_Uniform_Frame *frame = &R_Uniforms.frames[R_Uniforms.frame_at];
+  For_U32 (it, frame->block_count) {
+    R_Uniform_Block *block = &frame->blocks[it];
+    if (block->used) {
+      r_buffer_download(block->buffer, 0, block->used, block->data);
+    }
+  }
+
+  R_Uniforms.frame_at = (R_Uniforms.frame_at + 1) % R_Uniform_Frame_Count;
+
+  frame = &R_Uniforms.frames[R_Uniforms.frame_at];
+  frame->block_at = 0;
+  For_U32 (it, frame->block_count) {
+    frame->blocks[it].used = 0;
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Staging Belt
+
+R_Upload_Belt R_Uploads = { .budget_bytes = R_Upload_Budget_Default };
+
+fn_internal void r_upload_push(R_Upload *upload) {
+  if (!R_Uploads.initialized) {
+    R_Uploads.initialized = 1;
+    arena_init(&R_Uploads.arena);
+  }
+
+  R_Upload *node = R_Uploads.free;
+  if (node) {
+    R_Uploads.free = node->next;
+  } else {
+    node = arena_push_type(&R_Uploads.arena, R_Upload);
+  }
+
+  *node = *upload;
+  node->next = 0;
+  queue_push(R_Uploads.first, R_Uploads.last, node);
+
+  R_Uploads.stats.pending_bytes += upload->bytes;
+  R_Uploads.stats.pending_count += 1;
+}
+
+fn_internal void r_upload_buffer(R_Buffer buffer, U64 offset, U64 bytes, void *data, R_Upload_Callback *callback, void *user_data) {
+  r_upload_push(&(R_Upload) {
+    .kind      = R_Upload_Kind_Buffer,
+    .resource  = buffer,
+    .offset    = offset,
+    .bytes     = bytes,
+    .data      = (U08 *)data,
+    .callback  = callback,
+    .user_data = user_data,
+  });
+}
+
+fn_internal void r_upload_texture_2D(R_Texture_2D texture, R_Texture_Format format, R2I region, void *data, R_Upload_Callback *callback, void *user_data) {
+  U64 bytes = r_texture_format_bytes(format) * (U64)(region.x1 - region.x0) * (U64)(region.y1 - region.y0);
+  r_upload_push(&(R_Upload) {
+    .kind      = R_Upload_Kind_Texture_2D,
+    .resource  = texture,
+    .format    = format,
+    .region    = r3i(region.x0, region.y0, 0, region.x1, region.y1, 1),
+    .bytes     = bytes,
+    .data      = (U08 *)data,
+    .callback  = callback,
+    .user_data = user_data,
+  });
+}
+
+fn_internal void r_upload_texture_3D(R_Texture_3D texture, R_Texture_Format format, R3I region, void *data, R_Upload_Callback *callback, void *user_data) {
+  U64 bytes = r_texture_format_bytes(format) * (U64)(region.x1 - region.x0) * (U64)(region.y1 - region.y0) * (U64)(region.z1 - region.z0);
+  r_upload_push(&(R_Upload) {
+    .kind      = R_Upload_Kind_Texture_3D,
+    .resource  = texture,
+    .format    = format,
+    .region    = region,
+    .bytes     = bytes,
+    .data      = (U08 *)data,
+    .callback  = callback,
+    .user_data = user_data,
+  });
 }
 
+fn_internal void r_upload_budget_set(U64 bytes_per_frame) {
+  R_Uploads.budget_bytes = bytes_per_frame;
+}
+
+fn_internal R_Upload_Stats r_upload_stats(void) {
+  return R_Uploads.stats;
+}
+
+// NOTE(cmat): Sends the next slice of a texture upload, at most budget bytes (but always at
+// - least one row). Progress is counted in rows across slices: finish a partial slice first,
+// - then whole slices, then the rows that fit of the next one.
+fn_internal U64 r_upload_texture_slice(R_Upload *upload, U64 budget) {
+  U64 row_bytes = r_texture_format_bytes(upload->format) * (U64)(upload->region.x1 - upload->region.x0);
+  U64 height    = (U64)(upload->region.y1 - upload->region.y0);
+  U64 depth     = (U64)(upload->region.z1 - upload->region.z0);
+  U64 row_at    = upload->bytes_done / row_bytes;
+  U64 rows      = u64_max(budget / row_bytes, 1);
+  U64 y         = row_at % height;
+  U64 z         = row_at / height;
+
+  R3I slice = upload->region;
+  if (y || rows < height) {
+    rows     = u64_min(rows, height - y);
+    slice.y0 = upload->region.y0 + (I32)y;
+    slice.y1 = slice.y0 + (I32)rows;
+    slice.z0 = upload->region.z0 + (I32)z;
+    slice.z1 = slice.z0 + 1;
+  } else {
+    U64 slices = u64_min(rows / height, depth - z);
+    rows       = slices * height;
+    slice.z0   = upload->region.z0 + (I32)z;
+    slice.z1   = slice.z0 + (I32)slices;
+  }
+
+  U08 *data = upload->data + upload->bytes_done;
+  if (upload->kind == R_Upload_Kind_Texture_2D) {
+    r_texture_2D_download(upload->resource, upload->format, r2i(slice.x0, slice.y0, slice.x1, slice.y1), data);
+  } else {
+    r_texture_3D_download(upload->resource, upload->format, slice, data);
+  }
+
+  return rows * row_bytes;
+}
+
+fn_internal void r_upload_flush(void) {
+  R_Uploads.stats.frame_bytes     = 0;
+  R_Uploads.stats.frame_slices    = 0;
+  R_Uploads.stats.frame_completed = 0;
+
+  U64 budget = R_Uploads.budget_bytes ? R_Uploads.budget_bytes : u64_limit_max;
+  U64 spent  = 0;
+
+  while (R_Uploads.first && spent < budget) {
+    R_Upload *upload    = R_Uploads.first;
+    U64       available = budget - spent;
+    U64       sent      = 0;
+
+    // NOTE(cmat): Empty uploads (a zero extent) send nothing, they complete right away.
+    if (upload->bytes) {
+      if (upload->kind == R_Upload_Kind_Buffer) {
+        sent = u64_min(available, upload->bytes - upload->bytes_done);
+        r_buffer_download(upload->resource, upload->offset + upload->bytes_done, sent, upload->data + upload->bytes_done);
+      } else {
+        // NOTE(cmat): A row that doesn't fit waits for the next frame, unless nothing was sent yet.
+        U64 row_bytes = r_texture_format_bytes(upload->format) * (U64)(upload->region.x1 - upload->region.x0);
+        if (row_bytes > available && spent) {
+          break;
+        }
+
+        sent = r_upload_texture_slice(upload, available);
+      }
+
+      upload->bytes_done += sent;
+      spent              += sent;
+
+      R_Uploads.stats.frame_slices  += 1;
+      R_Uploads.stats.pending_bytes -= sent;
+    }
+
+    if (upload->bytes_done == upload->bytes) {
+      queue_pop(R_Uploads.first, R_Uploads.last);
+      upload->next   = R_Uploads.free;
+      R_Uploads.free = upload;
+
+      R_Uploads.stats.pending_count   -= 1;
+      R_Uploads.stats.frame_completed += 1;
+
+      if (upload->callback) {
+        upload->callback(upload->user_data);
+      }
+    }
+  }
+
+  R_Uploads.stats.frame_bytes = spent;
+}
+
+// ------------------------------------------------------------
+// #-- Texture Formats
+
+fn_internal U64 r_texture_format_bytes(R_Texture_Format format) {
+  U64 result = 0;
+  switch (format) {
+    case R_Texture_Format_RGBA_U08_Normalized: { result = 4; } break;
+    case R_Texture_Format_RGBA_I08_Normalized: { result = 4; } break;
+    case R_Texture_Format_R_U08_Normalized:    { result = 1; } break;
+    case R_Texture_Format_R_I08_Normalized:    { result = 1; } break;
+    case R_Texture_Format_F32:                 { result = 4; } break;
+    case R_Texture_Format_F16:                 { result = 2; } break;
+    Invalid_Default;
+  }
+
+  return result;
+}
@@ -23,6 +23,39 @@ var_external R_Texture_3D   R_Texture_2D_Invalid;
 var_external R_Sampler      R_Sampler_Invalid;
 var_external R_Pipeline     R_Pipeline_Invalid;
 
+// ------------------------------------------------------------
+// #-- Resource Handles
+
+// NOTE(cmat): Handles are generational, the low bits index a slot in the backend's dense
+// - resource arrays and the high bits hold the generation of that slot. Freeing a slot bumps its
+// - generation, so a handle to a destroyed resource stops matching instead of silently aliasing
+// - whatever reuses the slot. Slot 0 is never handed out, so R_Resource_None stays invalid.
+// - Backends check handles on every use with r_handle_check, which compiles out with Assert.
+// - Freeing a stale handle (or freeing twice) does nothing.
+
+#define R_Handle_Index_Bits      20
+#define R_Handle_Index_Mask      ((1u << R_Handle_Index_Bits) - 1)
+#define R_Handle_Generation_Mask ((1u << (32 - R_Handle_Index_Bits)) - 1)
+
+force_inline fn_internal R_Resource r_handle_make       (U32 index, U32 generation) { return ((generation & R_Handle_Generation_Mask) << R_Handle_Index_Bits) | index; }
+force_inline fn_internal U32        r_handle_index      (R_Resource handle)         { return handle & R_Handle_Index_Mask;  }
+force_inline fn_internal U32        r_handle_generation (R_Resource handle)         { return handle >> R_Handle_Index_Bits; }
+
+typedef struct R_Handle_Pool {
+  U32  capacity;
+  U32  slot_count;
+  U32  free_count;
+  U32 *generations;
+  U32 *free_slots;
+} R_Handle_Pool;
+
+fn_internal void        r_handle_pool_init  (R_Handle_Pool *pool, Arena *arena, U32 capacity);
+fn_internal R_Resource  r_handle_pool_alloc (R_Handle_Pool *pool);
+fn_internal void        r_handle_pool_free  (R_Handle_Pool *pool, R_Resource handle);
+fn_internal B32         r_handle_pool_valid (R_Handle_Pool *pool, R_Resource handle);
+
+#define r_handle_check(pool_, handle_) Assert(r_handle_pool_valid((pool_), (handle_)), "stale or invalid render handle")
+
 typedef U32 R_Buffer_Mode;
 enum {
   R_Buffer_Mode_Static,
@@ -47,6 +80,7 @@ enum {
   R_Texture_Format_R_I08_Normalized,
 
   R_Texture_Format_F32,
+  R_Texture_Format_F16,
 };
 
 typedef struct {
@@ -96,14 +130,25 @@ enum {
   R_Vertex_Attribute_Format_V4_U08_Normalized
 };
 
+// NOTE(cmat): Attributes stepped per instance are read from the draw's instance_buffer (offsets
+// - within instance_stride), the rest from its vertex_buffer. Shader locations follow entry_array
+// - order across both streams.
+typedef U16 R_Vertex_Step;
+enum {
+  R_Vertex_Step_Vertex,
+  R_Vertex_Step_Instance,
+};
+
 #pragma pack(push, 1)
 typedef struct {
   U16                       offset;
   R_Vertex_Attribute_Format format;
+  R_Vertex_Step             step;
 } R_Vertex_Attribute;
 
 typedef struct {
   U16                 stride;
+  U16                 instance_stride;
   U16                 entry_count;
   R_Vertex_Attribute  entry_array[R_Vertex_Max_Attribute_Count];
 } R_Vertex_Format;
@@ -174,6 +219,31 @@ var_global R_Vertex_Format R_Vertex_Format_XUC_3D = {
   },
 };
 
+// NOTE(cmat): Instanced screen space quads, for R_Shader_Quad_2D. The vertex stream is the unit
+// - quad (corner K in [0, 1]), every instance a rect X, its UV rect U and a packed color C, so a
+// - glyph costs one instance instead of 4 vertices and 6 indices.
+typedef struct {
+  R_Declare_Vertex_Attribute(V2F, K);
+} R_Vertex_K_2D;
+
+typedef struct {
+  R_Declare_Vertex_Attribute(R2F, X);
+  R_Declare_Vertex_Attribute(R2F, U);
+  R_Declare_Vertex_Attribute(U32, C);
+} R_Instance_XUC_2D;
+
+var_global R_Vertex_Format R_Vertex_Format_Quad_2D = {
+  .stride           = sizeof(R_Vertex_K_2D),
+  .instance_stride  = sizeof(R_Instance_XUC_2D),
+  .entry_count      = 4,
+  .entry_array      = {
+    { .offset   = offsetof(R_Vertex_K_2D,     K), .format = R_Vertex_Attribute_Format_V2_F32                                       },
+    { .offset   = offsetof(R_Instance_XUC_2D, X), .format = R_Vertex_Attribute_Format_V4_F32,            .step = R_Vertex_Step_Instance },
+    { .offset   = offsetof(R_Instance_XUC_2D, U), .format = R_Vertex_Attribute_Format_V4_F32,            .step = R_Vertex_Step_Instance },
+    { .offset   = offsetof(R_Instance_XUC_2D, C), .format = R_Vertex_Attribute_Format_V4_U08_Normalized, .step = R_Vertex_Step_Instance },
+  },
+};
+
 // ------------------------------------------------------------
 // #-- Render Commands
 
@@ -185,13 +255,40 @@ enum {
 typedef struct R_Command_Header {
   R_Command_Type type;
   U64 bytes;
+  U64 sort_key;
   struct R_Command_Header *next;
 } R_Command_Header;
 
+// NOTE(cmat): State changes a backend has to make between two consecutive draws, counted in
+// - submission order and in sorted order. Pipeline, vertex buffers, index buffer and the
+// - binding set (texture, volume, sampler, constant buffer) each count as one.
+typedef struct R_Command_Stats {
+  U32 draw_count;
+  U32 state_changes_submitted;
+  U32 state_changes_sorted;
+} R_Command_Stats;
+
+// NOTE(cmat): Bounds and state of a layered draw, kept so later draws know what they cover.
+// - A full table starts a new layer above everything, like an ordered draw.
+#define R_Draw_Layer_Capacity 1024
+#define R_Draw_Layer_Max      0xFFFF
+
+typedef struct R_Draw_Layer_Entry {
+  R2I bounds;
+  U32 layer;
+  U64 state;
+} R_Draw_Layer_Entry;
+
 typedef struct {
   Arena arena;
   R_Command_Header *first;
   R_Command_Header *last;
+  R_Command_Stats   stats;
+
+  U32                 layer_floor;
+  U32                 layer_top;
+  U32                 layer_count;
+  R_Draw_Layer_Entry  layers[R_Draw_Layer_Capacity];
 } R_Command_Buffer;
 
 var_external R_Command_Buffer R_Commands;
@@ -201,8 +298,10 @@ var_external R_Command_Buffer R_Commands;
 typedef struct R_Command_Draw {
 
   R_Buffer      constant_buffer;
+  U32           constant_offset;
   R_Buffer      vertex_buffer;
   R_Buffer      index_buffer;
+  R_Buffer      instance_buffer;
   R_Pipeline    pipeline;
   R_Texture_2D  texture;
   R_Texture_3D  texture_volume;
@@ -211,6 +310,11 @@ typedef struct R_Command_Draw {
   U32           draw_index_count;
   U32           draw_index_offset;
 
+  // NOTE(cmat): 0 draws once, without reading instance_buffer. instance_offset is the first
+  // - instance read (in instance_stride units).
+  U32           instance_count;
+  U32           instance_offset;
+
   B32           depth_test;
 
   R2I           draw_region;
@@ -220,13 +324,156 @@ typedef struct R_Command_Draw {
 
 #pragma pack(pop)
 
+// NOTE(cmat): Draws are sorted by a 64-bit key before a backend flushes them:
+// - [63..60] pass, [59..44] pipeline, [43..24] material (hash of the bindings), [23..0] depth.
+// - Passes flush in enum order. The sort is stable. 3D drawn inside 2D (a viewport in a UI
+// - panel) has to stay in that pass, earlier passes flush under the panel.
+// - Blended passes can't be sorted on state alone. r_draw_key_layered keys on
+// - [63..60] pass, [59..44] layer, [43..28] pipeline, [27..0] material instead. A draw lands one
+// - layer above every earlier draw it overlaps with different state, and in the same layer as
+// - one with the same state (equal keys, kept in order), so only draws that don't overlap
+// - trade places. r_draw_key_ordered gives a draw a layer of its own above everything so far.
+// - r_command_push_draw uses it in R_Pass_Overlay, untouched callers flush as submitted.
+typedef U32 R_Pass;
+enum {
+  R_Pass_Opaque,
+  R_Pass_Volume,
+  R_Pass_Overlay,
+
+  R_Pass_Count
+};
+
+fn_internal U64 r_draw_key          (R_Pass pass, R_Command_Draw *draw, F32 depth);
+fn_internal U64 r_draw_key_layered  (R_Pass pass, R_Command_Draw *draw, R2I bounds);
+fn_internal U64 r_draw_key_ordered  (R_Pass pass);
+
 // TODO(cmat): shouldn't be exposed in userland.
 fn_internal void r_command_reset      (void);
 fn_internal void r_command_push_draw  (R_Command_Draw *draw);
+fn_internal void r_command_push_draw_keyed (R_Command_Draw *draw, U64 sort_key);
+
+// NOTE(cmat): For backends. Returns the frame's draws in key order (array on arena), and
+// - updates the stats r_command_stats reports for the frame.
+fn_internal R_Command_Draw **r_command_sort  (Arena *arena, U32 *draw_count);
+fn_internal R_Command_Stats  r_command_stats (void);
 
 fn_internal void r_init               (PL_Render_Context *render_context);
 fn_internal void r_frame_flush        (void);
 
+// ------------------------------------------------------------
+// #-- Uniform Ring
+
+// NOTE(cmat): Per-frame constants. r_uniform_push bumps a pointer into a CPU copy of one of a
+// - few large persistent buffers, and returns the buffer + offset to put in the draw
+// - (constant_buffer, constant_offset). Backends call r_uniform_flush once per frame, before
+// - submitting: it uploads what the frame pushed (one download per block used) and moves on
+// - to the next frame's blocks. Blocks are reused R_Uniform_Frame_Count frames later, once
+// - the frame that used them has retired, so they are static buffers, the ring is their
+// - multi-buffering.
+// - Offsets are R_Uniform_Alignment aligned (WebGPU's minUniformBufferOffsetAlignment) and
+// - every slice can be bound with R_Uniform_Binding_Bytes.
+
+#define R_Uniform_Frame_Count    3
+#define R_Uniform_Block_Bytes    u64_kilobytes(64)
+#define R_Uniform_Block_Max      16
+#define R_Uniform_Alignment      256
+#define R_Uniform_Binding_Bytes  256
+
+typedef struct R_Uniform_Slice {
+  R_Buffer buffer;
+  U32      offset;
+} R_Uniform_Slice;
+
+typedef struct R_Uniform_Block {
+  R_Buffer  buffer;
+  U08      *data;
+  U32       used;
+} R_Uniform_Block;
+
+typedef struct R_Uniform_Frame {
+  U32             block_count;
+  U32             block_at;
+  R_Uniform_Block blocks[R_Uniform_Block_Max];
+} R_Uniform_Frame;
+
+typedef struct R_Uniform_Ring {
+  Arena           arena;
+  B32             initialized;
+  U32             frame_at;
+  R_Uniform_Frame frames[R_Uniform_Frame_Count];
+} R_Uniform_Ring;
+
+var_external R_Uniform_Ring R_Uniforms;
+
+fn_internal R_Uniform_Slice r_uniform_push  (void *data, U64 bytes);
+fn_internal void            r_uniform_flush (void);
+
+#define r_uniform_push_type(data_) r_uniform_push((data_), sizeof(*(data_)))
+
+// ------------------------------------------------------------
+// #-- Staging Belt
+
+// NOTE(cmat): Large uploads are queued and fed to the backend in bounded slices, at most
+// - budget bytes per frame (r_upload_budget_set, 0 means unlimited). Buffers go in byte ranges,
+// - textures in slabs of whole slices (3D) or rows, so a volume spreads across frames instead
+// - of stalling one. The backend's own download path stages the copy (writeTexture on WebGPU),
+// - so the belt never copies: data must stay valid until the callback. Callbacks fire from
+// - r_upload_flush once the last slice has been handed to the backend, before that frame's
+// - draws are submitted. Uploads complete in the order they were queued.
+// - Backends call r_upload_flush once per frame, before submitting.
+
+#define R_Upload_Budget_Default u64_megabytes(8)
+
+typedef void R_Upload_Callback(void *user_data);
+
+typedef U32 R_Upload_Kind;
+enum {
+  R_Upload_Kind_Buffer,
+  R_Upload_Kind_Texture_2D,
+  R_Upload_Kind_Texture_3D,
+};
+
+typedef struct R_Upload {
+  struct R_Upload   *next;
+  R_Upload_Kind      kind;
+  R_Resource         resource;
+  R_Texture_Format   format;
+  R3I                region;
+  U64                offset;
+  U64                bytes;
+  U64                bytes_done;
+  U08               *data;
+  R_Upload_Callback *callback;
+  void              *user_data;
+} R_Upload;
+
+typedef struct R_Upload_Stats {
+  U64 frame_bytes;
+  U64 frame_slices;
+  U64 frame_completed;
+  U64 pending_bytes;
+  U64 pending_count;
+} R_Upload_Stats;
+
+typedef struct R_Upload_Belt {
+  Arena           arena;
+  B32             initialized;
+  U64             budget_bytes;
+  R_Upload       *first;
+  R_Upload       *last;
+  R_Upload       *free;
+  R_Upload_Stats  stats;
+} R_Upload_Belt;
+
+var_external R_Upload_Belt R_Uploads;
+
+fn_internal void            r_upload_buffer       (R_Buffer buffer, U64 offset, U64 bytes, void *data, R_Upload_Callback *callback, void *user_data);
+fn_internal void            r_upload_texture_2D   (R_Texture_2D texture, R_Texture_Format format, R2I region, void *data, R_Upload_Callback *callback, void *user_data);
+fn_internal void            r_upload_texture_3D   (R_Texture_3D texture, R_Texture_Format format, R3I region, void *data, R_Upload_Callback *callback, void *user_data);
+fn_internal void            r_upload_budget_set   (U64 bytes_per_frame);
+fn_internal void            r_upload_flush        (void);
+fn_internal R_Upload_Stats  r_upload_stats        (void);
+
 // ------------------------------------------------------------
 // #-- Default Resources
 
@@ -235,6 +482,7 @@ var_external R_Shader  R_Shader_Flat_3D;
 var_external R_Shader  R_Shader_Grid_3D;
 var_external R_Shader  R_Shader_DVR_3D;
 var_external R_Shader  R_Shader_SLI_3D;
+var_external R_Shader  R_Shader_Quad_2D;
 
 var_external R_Texture_2D R_Texture_2D_White;
 var_external R_Texture_3D R_Texture_3D_White;
@@ -251,3 +499,167 @@ typedef struct {
   alignas(16) V3F Eye_Position;
 } R_Constant_Buffer_World_3D;
 
+
+// ------------------------------------------------------------
+// #-- Render Capture
+
+// NOTE(cmat): Binary capture of the r_* API, written by the recording backend (build with
+// - BUILD_RENDER_RECORD=1, no GPU needed) and re-issued against any backend by r_capture_replay.
+// - The stream is a R_Capture_File_Header followed by records, each a R_Capture_Record header
+// - then op specific payload (uploads carry their data inline). Handles are the recorder's own,
+// - replay remaps them to the handles the live backend returns. Every frame ends with
+// - R_Capture_Op_Frame_End, so captures can be benchmarked and diffed frame by frame.
+
+#define R_Capture_Magic   0x50414352 // 'RCAP'
+#define R_Capture_Version 4
+
+typedef U32 R_Capture_Op;
+enum {
+  R_Capture_Op_Shader_Builtin,
+  R_Capture_Op_Buffer_Allocate,
+  R_Capture_Op_Buffer_Download,
+  R_Capture_Op_Buffer_Destroy,
+  R_Capture_Op_Texture_2D_Allocate,
+  R_Capture_Op_Texture_2D_Download,
+  R_Capture_Op_Texture_2D_Destroy,
+  R_Capture_Op_Texture_3D_Allocate,
+  R_Capture_Op_Texture_3D_Download,
+  R_Capture_Op_Texture_3D_Destroy,
+  R_Capture_Op_Sampler_Create,
+  R_Capture_Op_Sampler_Destroy,
+  R_Capture_Op_Pipeline_Create,
+  R_Capture_Op_Pipeline_Destroy,
+  R_Capture_Op_Draw,
+  R_Capture_Op_Frame_End,
+
+  R_Capture_Op_Count,
+};
+
+// NOTE(cmat): Built-in shaders are captured by name, their source is backend specific.
+typedef U32 R_Capture_Shader;
+enum {
+  R_Capture_Shader_Flat_2D,
+  R_Capture_Shader_Flat_3D,
+  R_Capture_Shader_Grid_3D,
+  R_Capture_Shader_DVR_3D,
+  R_Capture_Shader_SLI_3D,
+  R_Capture_Shader_Quad_2D,
+
+  R_Capture_Shader_Count,
+};
+
+#pragma pack(push, 1)
+
+typedef struct R_Capture_File_Header {
+  U32 magic;
+  U32 version;
+} R_Capture_File_Header;
+
+typedef struct R_Capture_Record {
+  R_Capture_Op op;
+  U32          bytes;
+} R_Capture_Record;
+
+typedef struct R_Capture_Shader_Builtin {
+  R_Shader          shader;
+  R_Capture_Shader  builtin;
+} R_Capture_Shader_Builtin;
+
+typedef struct R_Capture_Buffer_Allocate {
+  R_Buffer      buffer;
+  R_Buffer_Mode mode;
+  U64           capacity;
+} R_Capture_Buffer_Allocate;
+
+typedef struct R_Capture_Buffer_Download {
+  R_Buffer buffer;
+  U64      offset;
+  U64      bytes;
+} R_Capture_Buffer_Download;
+
+typedef struct R_Capture_Texture_Allocate {
+  R_Resource        texture;
+  R_Texture_Format  format;
+  U32               width;
+  U32               height;
+  U32               depth;
+} R_Capture_Texture_Allocate;
+
+typedef struct R_Capture_Texture_Download {
+  R_Resource        texture;
+  R_Texture_Format  format;
+  R3I               region;
+  U64               bytes;
+} R_Capture_Texture_Download;
+
+typedef struct R_Capture_Sampler_Create {
+  R_Sampler         sampler;
+  R_Sampler_Filter  mag_filter;
+  R_Sampler_Filter  min_filter;
+} R_Capture_Sampler_Create;
+
+typedef struct R_Capture_Pipeline_Create {
+  R_Pipeline      pipeline;
+  R_Shader        shader;
+  B32             depth_buffer;
+  R_Vertex_Format format;
+} R_Capture_Pipeline_Create;
+
+typedef struct R_Capture_Destroy {
+  R_Resource resource;
+} R_Capture_Destroy;
+
+typedef struct R_Capture_Frame_End {
+  U64 frame_index;
+} R_Capture_Frame_End;
+
+#pragma pack(pop)
+
+typedef struct R_Capture_Stats {
+  U64 frame_count;
+  U64 record_count;
+  U64 draw_count;
+  U64 upload_count;
+  U64 upload_bytes;
+  U64 stream_bytes;
+} R_Capture_Stats;
+
+#define R_Capture_Handle_Max 65536
+
+typedef struct R_Capture_Replay {
+  Str             capture;
+  U64             at;
+  R_Resource     *handles;
+  R_Capture_Stats total;
+  R_Capture_Stats frame;
+} R_Capture_Replay;
+
+fn_internal U64  r_texture_format_bytes (R_Texture_Format format);
+
+fn_internal B32  r_capture_replay_init  (R_Capture_Replay *replay, Arena *arena, Str capture);
+fn_internal B32  r_capture_replay_frame (R_Capture_Replay *replay);
+fn_internal void r_capture_stats_log    (Str name, R_Capture_Stats *stats);
+
+// NOTE(cmat): Only with BUILD_RENDER_RECORD. An empty R_Capture_Path keeps the capture in
+// - memory instead of streaming it to disk, r_record_capture flattens it into arena.
+var_external Str R_Capture_Path;
+fn_internal  Str r_record_capture       (Arena *arena);
+
+// ------------------------------------------------------------
+// #-- Software Target
+
+// NOTE(cmat): Only with BUILD_RENDER_SOFTWARE (CPU rasterizer, render_software.c). Flushed frames
+// - land in color, top-down rows of RGBA8 premultiplied pixels (r in the lowest byte). Depth rows
+// - are stride floats apart (width padded to 4). The target follows pl_display()->resolution
+// - unless r_software_target_resize fixed its size.
+typedef struct R_Software_Target {
+  U32  width;
+  U32  height;
+  U32  stride;
+  U32 *color;
+  F32 *depth;
+} R_Software_Target;
+
+fn_internal void               r_software_target_resize (U32 width, U32 height);
+fn_internal R_Software_Target *r_software_target        (void);
+fn_internal Str                r_software_target_ppm    (Arena *arena);
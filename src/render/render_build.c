@@ -2,15 +2,20 @@
 // Licensed under the MIT License (https://opensource.org/license/mit/)
 
 #include "render.c"
+#include "render_capture.c"
 
-#if OS_MACOS
+#if BUILD_RENDER_RECORD
+# include "render_record.c"
+
+#elif BUILD_RENDER_SOFTWARE
+# include "render_software.c"
+
+#elif OS_MACOS
 # include "render_shader/render_shader_metal.gen.c"
 
 # include "render_metal.m"
 
 #elif OS_LINUX
-# include "render_shader/render_shader_opengl4.gen.c"
-
 # include "render_opengl_corearb.c"
 # include "render_opengl4.c"
 
@@ -1,4 +1,14 @@
 // (C) Copyright 2025 Matyas Constans
 // Licensed under the MIT License (https://opensource.org/license/mit/)
 
+// NOTE(cmat): BUILD_RENDER_RECORD swaps the GPU backend for the recording one (render_record.c).
+#if !defined(BUILD_RENDER_RECORD)
+# define BUILD_RENDER_RECORD 0
+#endif
+
+// NOTE(cmat): BUILD_RENDER_SOFTWARE swaps it for the CPU rasterizer (render_software.c).
+#if !defined(BUILD_RENDER_SOFTWARE)
+# define BUILD_RENDER_SOFTWARE 0
+#endif
+
 #include "render.h"
@@ -0,0 +1,199 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+// ------------------------------------------------------------
+// #-- Capture Replay
+
+fn_internal B32 r_capture_replay_init(R_Capture_Replay *replay, Arena *arena, Str capture) {
+  zero_fill(replay);
+
+  R_Capture_File_Header header = { };
+  if (capture.len < sizeof(header)) {
+    return 0;
+  }
+
+  memory_copy(&header, capture.txt, sizeof(header));
+  if (header.magic != R_Capture_Magic || header.version != R_Capture_Version) {
+    return 0;
+  }
+
+  replay->capture = capture;
+  replay->at      = sizeof(header);
+  replay->handles = arena_push_count(arena, R_Resource, R_Capture_Handle_Max);
+  return 1;
+}
+
+// NOTE(cmat): Captured handles are generational, at most one is live per slot at any point in
+// - the stream, so the remap table is indexed by slot.
+force_inline fn_internal R_Resource r_capture_handle(R_Capture_Replay *replay, R_Resource captured) {
+  Assert(r_handle_index(captured) < R_Capture_Handle_Max, "capture handle out of range");
+  return replay->handles[r_handle_index(captured)];
+}
+
+force_inline fn_internal void r_capture_handle_map(R_Capture_Replay *replay, R_Resource captured, R_Resource live) {
+  Assert(r_handle_index(captured) < R_Capture_Handle_Max, "capture handle out of range");
+  replay->handles[r_handle_index(captured)] = live;
+}
+
+fn_internal void r_capture_replay_destroy(R_Capture_Replay *replay, R_Capture_Op op, R_Resource captured) {
+  R_Resource live = r_capture_handle(replay, captured);
+  switch (op) {
+    case R_Capture_Op_Buffer_Destroy:     { r_buffer_destroy(&live);      } break;
+    case R_Capture_Op_Texture_2D_Destroy: { r_texture_2D_destroy(&live);  } break;
+    case R_Capture_Op_Texture_3D_Destroy: { r_texture_3D_destroy(&live);  } break;
+    case R_Capture_Op_Sampler_Destroy:    { r_sampler_destroy(&live);     } break;
+    case R_Capture_Op_Pipeline_Destroy:   { r_pipeline_destroy(&live);    } break;
+    Invalid_Default;
+  }
+
+  r_capture_handle_map(replay, captured, R_Resource_None);
+}
+
+// NOTE(cmat): Re-issues records up to and including the next Frame_End (which flushes the
+// - frame on the live backend). Returns 0 once the capture is exhausted, or on a truncated record.
+fn_internal B32 r_capture_replay_frame(R_Capture_Replay *replay) {
+  var_local_persist R_Shader *builtin_shaders[R_Capture_Shader_Count] = {
+    [R_Capture_Shader_Flat_2D] = &R_Shader_Flat_2D,
+    [R_Capture_Shader_Flat_3D] = &R_Shader_Flat_3D,
+    [R_Capture_Shader_Grid_3D] = &R_Shader_Grid_3D,
+    [R_Capture_Shader_DVR_3D]  = &R_Shader_DVR_3D,
+    [R_Capture_Shader_SLI_3D]  = &R_Shader_SLI_3D,
+    [R_Capture_Shader_Quad_2D] = &R_Shader_Quad_2D,
+  };
+
+  zero_fill(&replay->frame);
+
+  B32 frame_end = 0;
+  while (!frame_end) {
+    R_Capture_Record record = { };
+    if (replay->at + sizeof(record) > replay->capture.len) {
+      break;
+    }
+
+    memory_copy(&record, replay->capture.txt + replay->at, sizeof(record));
+    if (replay->at + sizeof(record) + record.bytes > replay->capture.len) {
+      break;
+    }
+
+    U08 *payload = replay->capture.txt + replay->at + sizeof(record);
+    replay->at  += sizeof(record) + record.bytes;
+
+    replay->frame.record_count += 1;
+    replay->frame.stream_bytes += sizeof(record) + record.bytes;
+
+    switch (record.op) {
+      case R_Capture_Op_Shader_Builtin: {
+        R_Capture_Shader_Builtin *shader = (R_Capture_Shader_Builtin *)payload;
+        Assert(shader->builtin < R_Capture_Shader_Count, "unknown built-in shader in capture");
+        r_capture_handle_map(replay, shader->shader, *builtin_shaders[shader->builtin]);
+      } break;
+
+      case R_Capture_Op_Buffer_Allocate: {
+        R_Capture_Buffer_Allocate *buffer = (R_Capture_Buffer_Allocate *)payload;
+        r_capture_handle_map(replay, buffer->buffer, r_buffer_allocate(buffer->capacity, buffer->mode));
+      } break;
+
+      case R_Capture_Op_Buffer_Download: {
+        R_Capture_Buffer_Download *download = (R_Capture_Buffer_Download *)payload;
+        r_buffer_download(r_capture_handle(replay, download->buffer), download->offset, download->bytes, download + 1);
+
+        replay->frame.upload_count += 1;
+        replay->frame.upload_bytes += download->bytes;
+      } break;
+
+      case R_Capture_Op_Texture_2D_Allocate: {
+        R_Capture_Texture_Allocate *texture = (R_Capture_Texture_Allocate *)payload;
+        r_capture_handle_map(replay, texture->texture, r_texture_2D_allocate(texture->format, texture->width, texture->height));
+      } break;
+
+      case R_Capture_Op_Texture_2D_Download: {
+        R_Capture_Texture_Download *download = (R_Capture_Texture_Download *)payload;
+        R2I region = r2i(download->region.x0, download->region.y0, download->region.x1, download->region.y1);
+        r_texture_2D_download(r_capture_handle(replay, download->texture), download->format, region, download + 1);
+
+        replay->frame.upload_count += 1;
+        replay->frame.upload_bytes += download->bytes;
+      } break;
+
+      case R_Capture_Op_Texture_3D_Allocate: {
+        R_Capture_Texture_Allocate *texture = (R_Capture_Texture_Allocate *)payload;
+        r_capture_handle_map(replay, texture->texture, r_texture_3D_allocate(texture->format, texture->width, texture->height, texture->depth));
+      } break;
+
+      case R_Capture_Op_Texture_3D_Download: {
+        R_Capture_Texture_Download *download = (R_Capture_Texture_Download *)payload;
+        r_texture_3D_download(r_capture_handle(replay, download->texture), download->format, download->region, download + 1);
+
+        replay->frame.upload_count += 1;
+        replay->frame.upload_bytes += download->bytes;
+      } break;
+
+      case R_Capture_Op_Sampler_Create: {
+        R_Capture_Sampler_Create *sampler = (R_Capture_Sampler_Create *)payload;
+        r_capture_handle_map(replay, sampler->sampler, r_sampler_create(sampler->mag_filter, sampler->min_filter));
+      } break;
+
+      case R_Capture_Op_Pipeline_Create: {
+        R_Capture_Pipeline_Create *pipeline = (R_Capture_Pipeline_Create *)payload;
+        R_Vertex_Format            format   = pipeline->format;
+        R_Shader                   shader   = r_capture_handle(replay, pipeline->shader);
+        r_capture_handle_map(replay, pipeline->pipeline, r_pipeline_create(shader, &format, pipeline->depth_buffer));
+      } break;
+
+      case R_Capture_Op_Buffer_Destroy:
+      case R_Capture_Op_Texture_2D_Destroy:
+      case R_Capture_Op_Texture_3D_Destroy:
+      case R_Capture_Op_Sampler_Destroy:
+      case R_Capture_Op_Pipeline_Destroy: {
+        R_Capture_Destroy *destroy = (R_Capture_Destroy *)payload;
+        r_capture_replay_destroy(replay, record.op, destroy->resource);
+      } break;
+
+      case R_Capture_Op_Draw: {
+        R_Command_Draw draw = { };
+        memory_copy(&draw, payload, sizeof(draw));
+
+        draw.constant_buffer = r_capture_handle(replay, draw.constant_buffer);
+        draw.vertex_buffer   = r_capture_handle(replay, draw.vertex_buffer);
+        draw.index_buffer    = r_capture_handle(replay, draw.index_buffer);
+        draw.instance_buffer = r_capture_handle(replay, draw.instance_buffer);
+        draw.pipeline        = r_capture_handle(replay, draw.pipeline);
+        draw.texture         = r_capture_handle(replay, draw.texture);
+        draw.texture_volume  = r_capture_handle(replay, draw.texture_volume);
+        draw.sampler         = r_capture_handle(replay, draw.sampler);
+        r_command_push_draw(&draw);
+
+        replay->frame.draw_count += 1;
+      } break;
+
+      case R_Capture_Op_Frame_End: {
+        r_frame_flush();
+
+        replay->frame.frame_count = 1;
+        frame_end = 1;
+      } break;
+
+      Invalid_Default;
+    }
+  }
+
+  replay->total.frame_count  += replay->frame.frame_count;
+  replay->total.record_count += replay->frame.record_count;
+  replay->total.draw_count   += replay->frame.draw_count;
+  replay->total.upload_count += replay->frame.upload_count;
+  replay->total.upload_bytes += replay->frame.upload_bytes;
+  replay->total.stream_bytes += replay->frame.stream_bytes;
+
+  return frame_end;
+}
+
+fn_internal void r_capture_stats_log(Str name, R_Capture_Stats *stats) {
+  Log_Zone_Scope("render capture") {
+    U64 frames = u64_max(stats->frame_count, 1);
+    log_info("%.*s - %llu frames", str_expand(name), stats->frame_count);
+    log_info("records - %llu (%.1f / frame)",   stats->record_count, (F64)stats->record_count / (F64)frames);
+    log_info("draws   - %llu (%.1f / frame)",   stats->draw_count,   (F64)stats->draw_count   / (F64)frames);
+    log_info("uploads - %llu, %$$llu (%$$llu / frame)", stats->upload_count, stats->upload_bytes, stats->upload_bytes / frames);
+    log_info("stream  - %$$llu (%$$llu / frame)",       stats->stream_bytes, stats->stream_bytes / frames);
+  }
+}
@@ -0,0 +1,587 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+// NOTE(cmat): Standalone entry point, built by render_compare.sh. Renders a fixed set of scenes
+// - and writes every frame as a PPM image. Built with BUILD_RENDER_SOFTWARE it writes the
+// - reference frames, otherwise it renders on OpenGL 4.5 through a surfaceless EGL pbuffer (no
+// - window, no display server) and compares every frame with the software reference.
+
+#include "core/core_build.h"
+#include "core/core_build.c"
+
+#include "base/base_build.h"
+#include "base/base_build.c"
+
+#include "platform/platform.h"
+
+#if !BUILD_RENDER_SOFTWARE
+# include <X11/Xlib.h>
+# include <GL/gl.h>
+# include <GL/glx.h>
+# include <EGL/egl.h>
+# include <EGL/eglext.h>
+#endif
+
+// NOTE(cmat): The render backends only ask the platform layer for the display resolution.
+var_global PL_Frame_State Compare_Frame_State = { };
+fn_internal PL_Frame_State *pl_frame_state(void) { return &Compare_Frame_State; }
+
+#include "render/render_build.h"
+#include "render/render_build.c"
+
+enum {
+  Compare_Width     = 160,
+  Compare_Height    = 120,
+
+  // NOTE(cmat): Rasterization rules differ slightly between the backends, shared edges can land
+  // - on either side and filtering rounds differently. A frame fails when more than 1% of its
+  // - pixels are off by more than Compare_Tolerance in any channel.
+  Compare_Tolerance = 8,
+};
+
+typedef U32 Compare_Mode;
+enum {
+  // NOTE(cmat): Compared with the software reference.
+  Compare_Mode_Reference,
+
+  // NOTE(cmat): The software backend doesn't implement the shader, GL only has to draw something.
+  Compare_Mode_Drawn,
+};
+
+#if BUILD_RENDER_SOFTWARE
+# define Compare_Folder "render_compare/software"
+#else
+# define Compare_Folder "render_compare/opengl4"
+#endif
+
+#define Compare_Reference_Folder "render_compare/software"
+
+var_global U32 Compare_Failed_Count = 0;
+
+// ------------------------------------------------------------
+// #-- Frames
+
+fn_internal Str compare_frame_ppm(Arena *arena) {
+#if BUILD_RENDER_SOFTWARE
+  return r_software_target_ppm(arena);
+#else
+  enum { Header_Bytes = 32 };
+  U64  pixel_count = (U64)Compare_Width * Compare_Height;
+  U32 *pixels      = arena_push_count(arena, U32, pixel_count, .flags = 0);
+  U08 *buffer      = arena_push_size(arena, Header_Bytes + 3 * pixel_count, .flags = 0);
+  U64  at          = (U64)stbsp_snprintf((char *)buffer, Header_Bytes, "P6\n%u %u\n255\n", Compare_Width, Compare_Height);
+
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, Compare_Width, Compare_Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+  // NOTE(cmat): GL rows are bottom-up, PPM rows (and the software target) are top-down.
+  For_U32(y, Compare_Height) {
+    U32 *row = pixels + (U64)(Compare_Height - 1 - y) * Compare_Width;
+    For_U32(x, Compare_Width) {
+      buffer[at++] = (U08)(row[x] >>  0);
+      buffer[at++] = (U08)(row[x] >>  8);
+      buffer[at++] = (U08)(row[x] >> 16);
+    }
+  }
+
+  return str(at, buffer);
+#endif
+}
+
+fn_internal void compare_file_write(Str path, Str data) {
+  CO_File file = co_file_open(path, CO_File_Access_Flag_Write | CO_File_Access_Flag_Create | CO_File_Access_Flag_Truncate);
+  if ((I64)file.os_handle_1 < 0) {
+    log_warning("failed to write '%.*s'", str_expand(path));
+    Compare_Failed_Count++;
+    return;
+  }
+
+  co_file_write(&file, 0, data.len, data.txt);
+  co_file_close(&file);
+}
+
+fn_internal Str compare_file_read(Arena *arena, Str path) {
+  Str     result = { };
+  CO_File file   = co_file_open(path, CO_File_Access_Flag_Read);
+  if ((I64)file.os_handle_1 >= 0) {
+    result.len = co_file_size(&file);
+    result.txt = arena_push_size(arena, result.len, .flags = 0);
+    co_file_read(&file, 0, result.len, result.txt);
+    co_file_close(&file);
+  }
+
+  return result;
+}
+
+// NOTE(cmat): Call after the scene's r_frame_flush.
+fn_internal void compare_frame(char *name, Compare_Mode mode) {
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    char path[256] = { };
+    stbsp_snprintf(path, sizeof(path), "%s/%s.ppm", Compare_Folder, name);
+
+    Str frame = compare_frame_ppm(scratch.arena);
+    compare_file_write(str_from_cstr(path), frame);
+
+#if !BUILD_RENDER_SOFTWARE
+    U64 pixel_count  = (U64)Compare_Width * Compare_Height;
+    U64 header_bytes = frame.len - 3 * pixel_count;
+    U08 *pixels      = frame.txt + header_bytes;
+
+    if (mode == Compare_Mode_Reference) {
+      stbsp_snprintf(path, sizeof(path), "%s/%s.ppm", Compare_Reference_Folder, name);
+      Str reference = compare_file_read(scratch.arena, str_from_cstr(path));
+      if (reference.len != frame.len || !memory_compare(reference.txt, frame.txt, header_bytes)) {
+        log_warning("%-16s missing or mismatched reference '%s'", name, path);
+        Compare_Failed_Count++;
+      } else {
+        U08 *expected = reference.txt + header_bytes;
+        U64  differ   = 0;
+        For_U64(it, pixel_count) {
+          B32 pixel_differs = 0;
+          For_U32(channel, 3) {
+            I32 delta      = (I32)pixels[3 * it + channel] - (I32)expected[3 * it + channel];
+            pixel_differs |= delta > Compare_Tolerance || delta < -Compare_Tolerance;
+          }
+
+          differ += pixel_differs;
+        }
+
+        B32 failed = differ * 100 > pixel_count;
+        Compare_Failed_Count += failed;
+        log_info("%-16s %5llu of %llu pixels differ - %s", name, differ, pixel_count, failed ? "FAILED" : "ok");
+      }
+    } else {
+      U64 lit = 0;
+      For_U64(it, 3 * pixel_count) lit += pixels[it] != 0;
+
+      Compare_Failed_Count += !lit;
+      log_info("%-16s drawn - %s", name, lit ? "ok" : "FAILED");
+    }
+#else
+    log_info("%-16s written", name);
+#endif
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Scenes
+
+fn_internal R_Buffer compare_buffer(U64 bytes, void *data, R_Buffer_Mode mode) {
+  R_Buffer result = r_buffer_allocate(bytes, mode);
+  r_buffer_download(result, 0, bytes, data);
+  return result;
+}
+
+fn_internal void compare_quad(R_Vertex_XUC_2D *vertices, R2F rect, U32 color) {
+  vertices[0] = (R_Vertex_XUC_2D) { .X = v2f(rect.min.x, rect.min.y), .U = v2f(0, 0), .C = color };
+  vertices[1] = (R_Vertex_XUC_2D) { .X = v2f(rect.max.x, rect.min.y), .U = v2f(1, 0), .C = color };
+  vertices[2] = (R_Vertex_XUC_2D) { .X = v2f(rect.max.x, rect.max.y), .U = v2f(1, 1), .C = color };
+  vertices[3] = (R_Vertex_XUC_2D) { .X = v2f(rect.min.x, rect.max.y), .U = v2f(0, 1), .C = color };
+}
+
+fn_internal void compare_scenes_2D(void) {
+  R2I full = r2i(0, 0, Compare_Width, Compare_Height);
+
+  // NOTE(cmat): Three overlapping rects, the last one half transparent.
+  R2F rects[]  = { r2f(-.9f, -.9f, -.1f, .3f), r2f(.05f, -.5f, .8f, .9f), r2f(-.5f, -.2f, .3f, .5f) };
+  U32 colors[] = { 0xFF0000FF, 0xFF00FF00, 0x80800000 };
+
+  R_Vertex_XUC_2D vertices[4 * sarray_len(rects)] = { };
+  U32             indices [6 * sarray_len(rects)] = { };
+  For_U32(it, sarray_len(rects)) {
+    compare_quad(vertices + 4 * it, rects[it], colors[it]);
+
+    U32 quad_indices[] = { 0, 1, 2, 0, 2, 3 };
+    For_U32(corner, 6) indices[6 * it + corner] = 4 * it + quad_indices[corner];
+  }
+
+  R_Buffer   vertex_buffer = compare_buffer(sizeof(vertices), vertices, R_Buffer_Mode_Dynamic);
+  R_Buffer   index_buffer  = compare_buffer(sizeof(indices),  indices,  R_Buffer_Mode_Static);
+  R_Pipeline flat_pipeline = r_pipeline_create(R_Shader_Flat_2D, &R_Vertex_Format_XUC_2D, 0);
+
+  R_Constant_Buffer_Viewport_2D viewport = { .NDC_From_Screen = m4f_id() };
+  R_Uniform_Slice               slice    = r_uniform_push_type(&viewport);
+
+  R_Command_Draw flat = {
+    .constant_buffer  = slice.buffer,
+    .constant_offset  = slice.offset,
+    .vertex_buffer    = vertex_buffer,
+    .index_buffer     = index_buffer,
+    .pipeline         = flat_pipeline,
+    .texture          = R_Texture_2D_White,
+    .sampler          = R_Sampler_Nearest_Clamp,
+    .draw_index_count = sarray_len(indices),
+    .draw_region      = full,
+    .clip_region      = full,
+  };
+
+  r_command_push_draw(&flat);
+  r_frame_flush();
+  compare_frame("flat_2D", Compare_Mode_Reference);
+
+  // NOTE(cmat): Sub viewport with a scissor, then a second draw from an index offset.
+  {
+    slice                  = r_uniform_push_type(&viewport);
+    R_Command_Draw first   = flat;
+    first.constant_buffer  = slice.buffer;
+    first.constant_offset  = slice.offset;
+    first.draw_region      = r2i(20, 10, 140, 100);
+    first.clip_region      = r2i(40, 30, 200, 90);
+    first.draw_index_count = 12;
+
+    R_Command_Draw second    = first;
+    second.draw_region       = r2i(0, 0, 80, 60);
+    second.clip_region       = r2i(0, 0, 80, 60);
+    second.draw_index_offset = 12;
+    second.draw_index_count  = 6;
+
+    r_command_push_draw(&first);
+    r_command_push_draw(&second);
+    r_frame_flush();
+    compare_frame("scissor", Compare_Mode_Reference);
+  }
+
+  // NOTE(cmat): The same rects as instanced quads, skipping the first instance.
+  {
+    R_Vertex_K_2D     corners[]            = { { .K = v2f(0, 0) }, { .K = v2f(1, 0) }, { .K = v2f(1, 1) }, { .K = v2f(0, 1) } };
+    U32               corner_indices[]     = { 0, 1, 2, 0, 2, 3 };
+    R_Instance_XUC_2D instances[1 + sarray_len(rects)] = { };
+    For_U32(it, sarray_len(rects)) {
+      instances[1 + it] = (R_Instance_XUC_2D) { .X = rects[it], .U = r2f(0, 0, 1, 1), .C = colors[it] };
+    }
+
+    R_Buffer   corner_buffer   = compare_buffer(sizeof(corners),        corners,        R_Buffer_Mode_Static);
+    R_Buffer   corner_index    = compare_buffer(sizeof(corner_indices), corner_indices, R_Buffer_Mode_Static);
+    R_Buffer   instance_buffer = compare_buffer(sizeof(instances),      instances,      R_Buffer_Mode_Dynamic);
+    R_Pipeline quad_pipeline   = r_pipeline_create(R_Shader_Quad_2D, &R_Vertex_Format_Quad_2D, 0);
+
+    slice                 = r_uniform_push_type(&viewport);
+    R_Command_Draw quad   = flat;
+    quad.constant_buffer  = slice.buffer;
+    quad.constant_offset  = slice.offset;
+    quad.vertex_buffer    = corner_buffer;
+    quad.index_buffer     = corner_index;
+    quad.instance_buffer  = instance_buffer;
+    quad.instance_count   = sarray_len(rects);
+    quad.instance_offset  = 1;
+    quad.pipeline         = quad_pipeline;
+    quad.draw_index_count = 6;
+
+    r_command_push_draw(&quad);
+    r_frame_flush();
+    compare_frame("quad_2D", Compare_Mode_Reference);
+
+    r_pipeline_destroy(&quad_pipeline);
+    r_buffer_destroy(&instance_buffer);
+    r_buffer_destroy(&corner_index);
+    r_buffer_destroy(&corner_buffer);
+  }
+
+  // NOTE(cmat): A 4x4 checker, with nearest and linear filtering.
+  {
+    U32 checker[16] = { };
+    For_U32(it, 16) checker[it] = ((it ^ (it >> 2)) & 1) ? 0xFFFFFFFF : 0xFF2040C0;
+
+    R_Texture_2D texture = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 4, 4);
+    r_texture_2D_download(texture, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 4, 4), checker);
+
+    R_Vertex_XUC_2D textured[4] = { };
+    compare_quad(textured, r2f(-.8f, -.8f, .8f, .8f), 0xFFFFFFFF);
+    r_buffer_download(vertex_buffer, 0, sizeof(textured), textured);
+
+    For_U32(linear, 2) {
+      slice                 = r_uniform_push_type(&viewport);
+      R_Command_Draw draw   = flat;
+      draw.constant_buffer  = slice.buffer;
+      draw.constant_offset  = slice.offset;
+      draw.texture          = texture;
+      draw.sampler          = linear ? R_Sampler_Linear_Clamp : R_Sampler_Nearest_Clamp;
+      draw.draw_index_count = 6;
+
+      r_command_push_draw(&draw);
+      r_frame_flush();
+      compare_frame(linear ? "texture_linear" : "texture_nearest", Compare_Mode_Reference);
+    }
+
+    r_texture_2D_destroy(&texture);
+  }
+
+  // NOTE(cmat): Partial updates of a dynamic buffer, every frame moves the second rect. On GL,
+  // - the untouched bytes are carried forward from the previous region.
+  r_buffer_download(vertex_buffer, 0, sizeof(vertices), vertices);
+  For_U32(frame, 5) {
+    R_Vertex_XUC_2D moved[4] = { };
+    memory_copy(moved, vertices + 4, sizeof(moved));
+    For_U32(it, 4) moved[it].X.x -= .1f * frame;
+    r_buffer_download(vertex_buffer, sizeof(moved), sizeof(moved), moved);
+
+    slice                = r_uniform_push_type(&viewport);
+    R_Command_Draw draw  = flat;
+    draw.constant_buffer = slice.buffer;
+    draw.constant_offset = slice.offset;
+
+    r_command_push_draw(&draw);
+    r_frame_flush();
+
+    char name[32] = { };
+    stbsp_snprintf(name, sizeof(name), "stream_%u", frame);
+    compare_frame(name, Compare_Mode_Reference);
+  }
+
+  r_pipeline_destroy(&flat_pipeline);
+  r_buffer_destroy(&index_buffer);
+  r_buffer_destroy(&vertex_buffer);
+}
+
+fn_internal void compare_scenes_3D(void) {
+  R2I full = r2i(0, 0, Compare_Width, Compare_Height);
+  V3F eye  = v3f(4, 3, 7);
+
+  M4F view       = m4f_hom_look_at(v3f(0, 1, 0), eye, v3f(0, 0, 0));
+  M4F projection = m4f_hom_perspective((F32)Compare_Width / Compare_Height, f32_radians_from_degrees(60.f), .1f, 100.f);
+
+  R_Constant_Buffer_World_3D world = { .World_View_Projection = m4f_mul(view, projection), .Eye_Position = eye };
+
+  R_Command_Draw base = {
+    .texture        = R_Texture_2D_White,
+    .texture_volume = R_Texture_3D_White,
+    .sampler        = R_Sampler_Linear_Clamp,
+    .draw_region    = full,
+    .clip_region    = full,
+  };
+
+  // NOTE(cmat): Two intersecting triangles, depth tested, the second one from both sides.
+  {
+    R_Vertex_XUC_3D vertices[] = {
+      { .X = v3f(-2, -1,  0), .U = v2f(0, 0), .C = 0xFF0000FF },
+      { .X = v3f( 2, -1,  0), .U = v2f(1, 0), .C = 0xFF0000FF },
+      { .X = v3f( 0,  2,  0), .U = v2f(0, 1), .C = 0xFF0000FF },
+      { .X = v3f(-2,  0, -1), .U = v2f(0, 0), .C = 0xFF00FF00 },
+      { .X = v3f( 2,  0,  1), .U = v2f(1, 0), .C = 0xFF00FF00 },
+      { .X = v3f( 0, -2,  0), .U = v2f(0, 1), .C = 0xFF00FF00 },
+    };
+
+    U32 indices[] = { 0, 1, 2, 3, 4, 5, 3, 5, 4 };
+
+    R_Buffer   vertex_buffer = compare_buffer(sizeof(vertices), vertices, R_Buffer_Mode_Static);
+    R_Buffer   index_buffer  = compare_buffer(sizeof(indices),  indices,  R_Buffer_Mode_Static);
+    R_Pipeline pipeline      = r_pipeline_create(R_Shader_Flat_3D, &R_Vertex_Format_XUC_3D, 1);
+
+    R_Uniform_Slice slice  = r_uniform_push_type(&world);
+    R_Command_Draw  draw   = base;
+    draw.constant_buffer   = slice.buffer;
+    draw.constant_offset   = slice.offset;
+    draw.vertex_buffer     = vertex_buffer;
+    draw.index_buffer      = index_buffer;
+    draw.pipeline          = pipeline;
+    draw.draw_index_count  = sarray_len(indices);
+
+    r_command_push_draw(&draw);
+    r_frame_flush();
+    compare_frame("flat_3D", Compare_Mode_Reference);
+
+    r_pipeline_destroy(&pipeline);
+    r_buffer_destroy(&index_buffer);
+    r_buffer_destroy(&vertex_buffer);
+  }
+
+  // NOTE(cmat): Ground grid, as drawn by the viewport.
+  {
+    F32 scale = 20.f;
+    R_Vertex_XUC_3D vertices[] = {
+      { .X = v3f(-scale, 0, -scale), .U = v2f(0,     0),     .C = 0xFF0000FF },
+      { .X = v3f(+scale, 0, -scale), .U = v2f(scale, 0),     .C = 0xFF00FFFF },
+      { .X = v3f(+scale, 0, +scale), .U = v2f(scale, scale), .C = 0xFFFF00FF },
+      { .X = v3f(-scale, 0, +scale), .U = v2f(0,     scale), .C = 0xFFFFFFFF },
+    };
+
+    U32 indices[] = { 0, 2, 1, 0, 3, 2 };
+
+    R_Buffer   vertex_buffer = compare_buffer(sizeof(vertices), vertices, R_Buffer_Mode_Static);
+    R_Buffer   index_buffer  = compare_buffer(sizeof(indices),  indices,  R_Buffer_Mode_Static);
+    R_Pipeline pipeline      = r_pipeline_create(R_Shader_Grid_3D, &R_Vertex_Format_XUC_3D, 0);
+
+    R_Uniform_Slice slice  = r_uniform_push_type(&world);
+    R_Command_Draw  draw   = base;
+    draw.constant_buffer   = slice.buffer;
+    draw.constant_offset   = slice.offset;
+    draw.vertex_buffer     = vertex_buffer;
+    draw.index_buffer      = index_buffer;
+    draw.pipeline          = pipeline;
+    draw.draw_index_count  = sarray_len(indices);
+
+    r_command_push_draw(&draw);
+    r_frame_flush();
+    compare_frame("grid_3D", Compare_Mode_Drawn);
+
+    r_pipeline_destroy(&pipeline);
+    r_buffer_destroy(&index_buffer);
+    r_buffer_destroy(&vertex_buffer);
+  }
+
+  // NOTE(cmat): A 16x8x8 blob, ray marched through a box, then sliced by a plane through it.
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    enum { Volume_Width = 16, Volume_Height = 8, Volume_Depth = 8 };
+
+    F32 *density = arena_push_count(scratch.arena, F32, Volume_Width * Volume_Height * Volume_Depth, .flags = 0);
+    For_U32(z, Volume_Depth) {
+      For_U32(y, Volume_Height) {
+        For_U32(x, Volume_Width) {
+          F32 dx = (x - 7.5f) / 8.f;
+          F32 dy = (y - 3.5f) / 4.f;
+          F32 dz = (z - 3.5f) / 4.f;
+          density[(z * Volume_Height + y) * Volume_Width + x] = f32_max(0.f, 1.f - (dx * dx + dy * dy + dz * dz)) * 80.f;
+        }
+      }
+    }
+
+    R_Texture_3D volume = r_texture_3D_allocate(R_Texture_Format_F32, Volume_Width, Volume_Height, Volume_Depth);
+    r_texture_3D_download(volume, R_Texture_Format_F32, r3i(0, 0, 0, Volume_Width, Volume_Height, Volume_Depth), density);
+
+    U32 ramp[256] = { };
+    For_U32(it, 256) ramp[it] = 0xFF000000 | (it << 16) | ((255 - it) << 8) | 0x40;
+
+    R_Texture_2D transfer = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 256, 1);
+    r_texture_2D_download(transfer, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 256, 1), ramp);
+
+    R_Vertex_XUC_3D box[8] = { };
+    For_U32(it, 8) {
+      box[it] = (R_Vertex_XUC_3D) { .X = v3f(it & 1 ? 5 : -5, it & 2 ? 1 : -1, it & 4 ? 1 : -1), .C = 0xFFFFFFFF };
+    }
+
+    U32 box_indices[] = {
+      0, 2, 3, 0, 3, 1,  4, 5, 7, 4, 7, 6,  0, 1, 5, 0, 5, 4,
+      2, 6, 7, 2, 7, 3,  0, 4, 6, 0, 6, 2,  1, 3, 7, 1, 7, 5,
+    };
+
+    R_Vertex_XUC_3D plane[] = {
+      { .X = v3f(-5, .2f, -1), .U = v2f(0, 0), .C = 0xFFFFFFFF },
+      { .X = v3f( 5, .2f, -1), .U = v2f(1, 0), .C = 0xFFFFFFFF },
+      { .X = v3f( 5, .2f,  1), .U = v2f(1, 1), .C = 0xFFFFFFFF },
+      { .X = v3f(-5, .2f,  1), .U = v2f(0, 1), .C = 0xFFFFFFFF },
+    };
+
+    U32 plane_indices[] = { 0, 2, 1, 0, 3, 2, 0, 1, 2, 0, 2, 3 };
+
+    R_Buffer   box_buffer       = compare_buffer(sizeof(box),           box,           R_Buffer_Mode_Static);
+    R_Buffer   box_index        = compare_buffer(sizeof(box_indices),   box_indices,   R_Buffer_Mode_Static);
+    R_Buffer   plane_buffer     = compare_buffer(sizeof(plane),         plane,         R_Buffer_Mode_Static);
+    R_Buffer   plane_index      = compare_buffer(sizeof(plane_indices), plane_indices, R_Buffer_Mode_Static);
+    R_Pipeline volume_pipeline  = r_pipeline_create(R_Shader_DVR_3D, &R_Vertex_Format_XUC_3D, 1);
+    R_Pipeline slice_pipeline   = r_pipeline_create(R_Shader_SLI_3D, &R_Vertex_Format_XUC_3D, 1);
+
+    R_Uniform_Slice slice  = r_uniform_push_type(&world);
+    R_Command_Draw  draw   = base;
+    draw.constant_buffer   = slice.buffer;
+    draw.constant_offset   = slice.offset;
+    draw.vertex_buffer     = box_buffer;
+    draw.index_buffer      = box_index;
+    draw.pipeline          = volume_pipeline;
+    draw.texture           = transfer;
+    draw.texture_volume    = volume;
+    draw.draw_index_count  = sarray_len(box_indices);
+
+    r_command_push_draw(&draw);
+    r_frame_flush();
+    compare_frame("volume_3D", Compare_Mode_Drawn);
+
+    slice                  = r_uniform_push_type(&world);
+    draw.constant_buffer   = slice.buffer;
+    draw.constant_offset   = slice.offset;
+    draw.vertex_buffer     = plane_buffer;
+    draw.index_buffer      = plane_index;
+    draw.pipeline          = slice_pipeline;
+    draw.draw_index_count  = sarray_len(plane_indices);
+
+    r_command_push_draw(&draw);
+    r_frame_flush();
+    compare_frame("slice_3D", Compare_Mode_Drawn);
+
+    r_pipeline_destroy(&slice_pipeline);
+    r_pipeline_destroy(&volume_pipeline);
+    r_buffer_destroy(&plane_index);
+    r_buffer_destroy(&plane_buffer);
+    r_buffer_destroy(&box_index);
+    r_buffer_destroy(&box_buffer);
+    r_texture_2D_destroy(&transfer);
+    r_texture_3D_destroy(&volume);
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Entry Point
+
+#if !BUILD_RENDER_SOFTWARE
+
+fn_internal void compare_context_init(void) {
+  EGLDisplay display = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+  if (!eglInitialize(display, 0, 0)) {
+    co_panic(str_lit("failed to initialize a surfaceless EGL display"));
+  }
+
+  EGLint config_attributes[] = {
+    EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+    EGL_RED_SIZE,        8,
+    EGL_GREEN_SIZE,      8,
+    EGL_BLUE_SIZE,       8,
+    EGL_ALPHA_SIZE,      8,
+    EGL_DEPTH_SIZE,      24,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE,
+  };
+
+  EGLConfig config       = 0;
+  EGLint    config_count = 0;
+  if (!eglChooseConfig(display, config_attributes, &config, 1, &config_count) || !config_count) {
+    co_panic(str_lit("no EGL pbuffer config"));
+  }
+
+  EGLint surface_attributes[] = { EGL_WIDTH, Compare_Width, EGL_HEIGHT, Compare_Height, EGL_NONE };
+  EGLSurface surface = eglCreatePbufferSurface(display, config, surface_attributes);
+
+  EGLint context_attributes[] = {
+    EGL_CONTEXT_MAJOR_VERSION,       4,
+    EGL_CONTEXT_MINOR_VERSION,       5,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE,
+  };
+
+  eglBindAPI(EGL_OPENGL_API);
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+  if (!context || !eglMakeCurrent(display, surface, surface, context)) {
+    co_panic(str_lit("failed to create an OpenGL 4.5 context"));
+  }
+
+  log_info("OpenGL %s, %s", glGetString(GL_VERSION), glGetString(GL_RENDERER));
+}
+
+#endif
+
+fn_internal void base_entry_point(Array_Str command_line) {
+  logger_push_hook(logger_write_entry_standard_stream, logger_format_entry_minimal);
+
+  co_directory_create(str_lit("render_compare"));
+  co_directory_create(str_lit(Compare_Folder));
+
+  Compare_Frame_State.display.resolution = v2f(Compare_Width, Compare_Height);
+
+#if BUILD_RENDER_SOFTWARE
+  r_init(0);
+  r_software_target_resize(Compare_Width, Compare_Height);
+#else
+  compare_context_init();
+  r_init(0);
+#endif
+
+  log_zone_start("render compare (" Compare_Folder ")");
+  compare_scenes_2D();
+  compare_scenes_3D();
+  log_zone_end();
+
+  if (Compare_Failed_Count) {
+    log_fatal("%u frames failed", Compare_Failed_Count);
+    co_panic(str_lit("render compare failed"));
+  }
+}
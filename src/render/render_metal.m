@@ -112,6 +112,8 @@ fn_internal R_Texture r_texture_allocate(R_Texture_Config *config) {
       MTLPixelFormatRGBA8Snorm, // R_Texture_Format_RGBA_I08_Normalized,
       MTLPixelFormatR8Unorm,    // R_Texture_Format_R_U08_Normalized,
       MTLPixelFormatR8Snorm,    // R_Texture_Format_R_I08_Normalized,
+      MTLPixelFormatR32Float,   // R_Texture_Format_F32,
+      MTLPixelFormatR16Float,   // R_Texture_Format_F16,
     };
     
     MTLTextureDescriptor *texture_desc = [[[MTLTextureDescriptor alloc] init] autorelease];
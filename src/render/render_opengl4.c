@@ -1,26 +1,83 @@
 // (C) Copyright 2025 Matyas Constans
 // Licensed under the MIT License (https://opensource.org/license/mit/)
 
-
-// NOTE(cmat): OGL4 prototypes to be loaded.
-var_global PFNGLCREATEBUFFERSPROC      glCreateBuffers;
-var_global PFNGLBINDBUFFERPROC         glBindBuffer;
-var_global PFNGLBUFFERDATAPROC         glBufferData;
-var_global PFNGLBUFFERSUBDATAPROC      glBufferSubData;
-var_global PFNGLCREATETEXTURESPROC     glCreateTextures;
-var_global PFNGLCREATESHADERPROC       glCreateShader;
-var_global PFNGLSHADERSOURCEPROC       glShaderSource;
-var_global PFNGLCOMPILESHADERPROC      glCompileShader;
-var_global PFNGLATTACHSHADERPROC       glAttachShader;
-var_global PFNGLCREATEPROGRAMPROC      glCreateProgram;
-var_global PFNGLLINKPROGRAMPROC        glLinkProgram;
-var_global PFNGLDETACHSHADERPROC       glDetachShader;
-var_global PFNGLDELETESHADERPROC       glDeleteShader;
-
-var_global PFNGLGETSHADERIVPROC        glGetShaderiv;
-var_global PFNGLGETSHADERINFOLOGPROC   glGetShaderInfoLog;
-var_global PFNGLGETPROGRAMIVPROC       glGetProgramiv;
-var_global PFNGLGETPROGRAMINFOLOGPROC  glGetProgramInfoLog;
+// ------------------------------------------------------------
+// #-- Default handles.
+
+R_Shader      R_Shader_Flat_2D        = { };
+R_Shader      R_Shader_Flat_3D        = { };
+R_Shader      R_Shader_Grid_3D        = { };
+R_Shader      R_Shader_DVR_3D         = { };
+R_Shader      R_Shader_SLI_3D         = { };
+R_Shader      R_Shader_Quad_2D        = { };
+R_Texture_2D  R_Texture_2D_White      = { };
+R_Texture_3D  R_Texture_3D_White      = { };
+R_Sampler     R_Sampler_Linear_Clamp  = { };
+R_Sampler     R_Sampler_Nearest_Clamp = { };
+
+// ------------------------------------------------------------
+// #-- OpenGL 4.5 API.
+
+// NOTE(cmat): Core profile, direct state access only: objects are edited by name, nothing is
+// - bound to be modified. libGL only exports GL 1.x, everything newer is loaded in r_init.
+
+var_global PFNGLCREATEBUFFERSPROC                      glCreateBuffers;
+var_global PFNGLNAMEDBUFFERSTORAGEPROC                 glNamedBufferStorage;
+var_global PFNGLNAMEDBUFFERSUBDATAPROC                 glNamedBufferSubData;
+var_global PFNGLCOPYNAMEDBUFFERSUBDATAPROC             glCopyNamedBufferSubData;
+var_global PFNGLMAPNAMEDBUFFERRANGEPROC                glMapNamedBufferRange;
+var_global PFNGLUNMAPNAMEDBUFFERPROC                   glUnmapNamedBuffer;
+var_global PFNGLDELETEBUFFERSPROC                      glDeleteBuffers;
+var_global PFNGLBINDBUFFERRANGEPROC                    glBindBufferRange;
+
+var_global PFNGLCREATETEXTURESPROC                     glCreateTextures;
+var_global PFNGLTEXTURESTORAGE2DPROC                   glTextureStorage2D;
+var_global PFNGLTEXTURESTORAGE3DPROC                   glTextureStorage3D;
+var_global PFNGLTEXTURESUBIMAGE2DPROC                  glTextureSubImage2D;
+var_global PFNGLTEXTURESUBIMAGE3DPROC                  glTextureSubImage3D;
+var_global PFNGLTEXTUREPARAMETERIPROC                  glTextureParameteri;
+var_global PFNGLBINDTEXTUREUNITPROC                    glBindTextureUnit;
+
+var_global PFNGLCREATESAMPLERSPROC                     glCreateSamplers;
+var_global PFNGLSAMPLERPARAMETERIPROC                  glSamplerParameteri;
+var_global PFNGLBINDSAMPLERPROC                        glBindSampler;
+var_global PFNGLDELETESAMPLERSPROC                     glDeleteSamplers;
+
+var_global PFNGLCREATESHADERPROC                       glCreateShader;
+var_global PFNGLSHADERSOURCEPROC                       glShaderSource;
+var_global PFNGLCOMPILESHADERPROC                      glCompileShader;
+var_global PFNGLATTACHSHADERPROC                       glAttachShader;
+var_global PFNGLDETACHSHADERPROC                       glDetachShader;
+var_global PFNGLDELETESHADERPROC                       glDeleteShader;
+var_global PFNGLCREATEPROGRAMPROC                      glCreateProgram;
+var_global PFNGLLINKPROGRAMPROC                        glLinkProgram;
+var_global PFNGLUSEPROGRAMPROC                         glUseProgram;
+var_global PFNGLDELETEPROGRAMPROC                      glDeleteProgram;
+
+var_global PFNGLGETSHADERIVPROC                        glGetShaderiv;
+var_global PFNGLGETSHADERINFOLOGPROC                   glGetShaderInfoLog;
+var_global PFNGLGETPROGRAMIVPROC                       glGetProgramiv;
+var_global PFNGLGETPROGRAMINFOLOGPROC                  glGetProgramInfoLog;
+
+var_global PFNGLCREATEVERTEXARRAYSPROC                 glCreateVertexArrays;
+var_global PFNGLDELETEVERTEXARRAYSPROC                 glDeleteVertexArrays;
+var_global PFNGLBINDVERTEXARRAYPROC                    glBindVertexArray;
+var_global PFNGLENABLEVERTEXARRAYATTRIBPROC            glEnableVertexArrayAttrib;
+var_global PFNGLVERTEXARRAYATTRIBFORMATPROC            glVertexArrayAttribFormat;
+var_global PFNGLVERTEXARRAYATTRIBIFORMATPROC           glVertexArrayAttribIFormat;
+var_global PFNGLVERTEXARRAYATTRIBBINDINGPROC           glVertexArrayAttribBinding;
+var_global PFNGLVERTEXARRAYBINDINGDIVISORPROC          glVertexArrayBindingDivisor;
+var_global PFNGLVERTEXARRAYVERTEXBUFFERPROC            glVertexArrayVertexBuffer;
+var_global PFNGLVERTEXARRAYELEMENTBUFFERPROC           glVertexArrayElementBuffer;
+
+var_global PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC  glDrawElementsInstancedBaseInstance;
+var_global PFNGLCLIPCONTROLPROC                        glClipControl;
+
+var_global PFNGLFENCESYNCPROC                          glFenceSync;
+var_global PFNGLCLIENTWAITSYNCPROC                     glClientWaitSync;
+var_global PFNGLDELETESYNCPROC                         glDeleteSync;
+
+var_global PFNGLDEBUGMESSAGECALLBACKPROC               glDebugMessageCallback;
 
 #define OGL4_Load_Proc(proc_) proc_ = ogl4_load_proc(Macro_Stringize(proc_))
 
@@ -38,163 +95,499 @@ fn_internal void *ogl4_load_proc(char *proc_name) {
 fn_internal void ogl4_load_api(void) {
   // NOTE(cmat): Load all OpenGL4 function pointers.
   OGL4_Load_Proc(glCreateBuffers);
-  OGL4_Load_Proc(glBindBuffer);
-  OGL4_Load_Proc(glBufferData);
-  OGL4_Load_Proc(glBufferSubData);
+  OGL4_Load_Proc(glNamedBufferStorage);
+  OGL4_Load_Proc(glNamedBufferSubData);
+  OGL4_Load_Proc(glCopyNamedBufferSubData);
+  OGL4_Load_Proc(glMapNamedBufferRange);
+  OGL4_Load_Proc(glUnmapNamedBuffer);
+  OGL4_Load_Proc(glDeleteBuffers);
+  OGL4_Load_Proc(glBindBufferRange);
+
   OGL4_Load_Proc(glCreateTextures);
+  OGL4_Load_Proc(glTextureStorage2D);
+  OGL4_Load_Proc(glTextureStorage3D);
+  OGL4_Load_Proc(glTextureSubImage2D);
+  OGL4_Load_Proc(glTextureSubImage3D);
+  OGL4_Load_Proc(glTextureParameteri);
+  OGL4_Load_Proc(glBindTextureUnit);
+
+  OGL4_Load_Proc(glCreateSamplers);
+  OGL4_Load_Proc(glSamplerParameteri);
+  OGL4_Load_Proc(glBindSampler);
+  OGL4_Load_Proc(glDeleteSamplers);
+
   OGL4_Load_Proc(glCreateShader);
   OGL4_Load_Proc(glShaderSource);
   OGL4_Load_Proc(glCompileShader);
   OGL4_Load_Proc(glAttachShader);
-  OGL4_Load_Proc(glCreateProgram);
-  OGL4_Load_Proc(glLinkProgram);
   OGL4_Load_Proc(glDetachShader);
   OGL4_Load_Proc(glDeleteShader);
+  OGL4_Load_Proc(glCreateProgram);
+  OGL4_Load_Proc(glLinkProgram);
+  OGL4_Load_Proc(glUseProgram);
+  OGL4_Load_Proc(glDeleteProgram);
+
   OGL4_Load_Proc(glGetShaderiv);
   OGL4_Load_Proc(glGetShaderInfoLog);
   OGL4_Load_Proc(glGetProgramiv);
   OGL4_Load_Proc(glGetProgramInfoLog);
+
+  OGL4_Load_Proc(glCreateVertexArrays);
+  OGL4_Load_Proc(glDeleteVertexArrays);
+  OGL4_Load_Proc(glBindVertexArray);
+  OGL4_Load_Proc(glEnableVertexArrayAttrib);
+  OGL4_Load_Proc(glVertexArrayAttribFormat);
+  OGL4_Load_Proc(glVertexArrayAttribIFormat);
+  OGL4_Load_Proc(glVertexArrayAttribBinding);
+  OGL4_Load_Proc(glVertexArrayBindingDivisor);
+  OGL4_Load_Proc(glVertexArrayVertexBuffer);
+  OGL4_Load_Proc(glVertexArrayElementBuffer);
+
+  OGL4_Load_Proc(glDrawElementsInstancedBaseInstance);
+  OGL4_Load_Proc(glClipControl);
+
+  OGL4_Load_Proc(glFenceSync);
+  OGL4_Load_Proc(glClientWaitSync);
+  OGL4_Load_Proc(glDeleteSync);
+
+  OGL4_Load_Proc(glDebugMessageCallback);
 }
 
+// ------------------------------------------------------------
+// #-- Built-in shaders.
 
+// NOTE(cmat): GLSL ports of the WGSL shaders, both stages in one file. ogl4_compile_shader
+// - prepends the #version line and VERTEX_SHADER / PIXEL_SHADER to pick the stage.
 
-R_Shader  R_Shader_Flat_2D        = { };
-R_Shader  R_Shader_Flat_3D        = { };
-R_Shader  R_Shader_MTSDF_2D       = { };
-R_Texture R_Texture_White         = { };
-R_Sampler R_Sampler_Linear_Clamp  = { };
-R_Sampler R_Sampler_Nearest_Clamp = { };
+var_global U08 ogl4_shader_source_flat_2D_dat[] = {
+#embed "flat_2D.glsl"
+};
 
-#define OGL4_Max_Buffers   1024
-#define OGL4_Max_Shaders   256
-#define OGL4_Max_Samplers  64
+var_global Str ogl4_shader_source_flat_2D = {
+  .len = sizeof(ogl4_shader_source_flat_2D_dat),
+  .txt = ogl4_shader_source_flat_2D_dat,
+};
+
+var_global U08 ogl4_shader_source_flat_3D_dat[] = {
+#embed "flat_3D.glsl"
+};
+
+var_global Str ogl4_shader_source_flat_3D = {
+  .len = sizeof(ogl4_shader_source_flat_3D_dat),
+  .txt = ogl4_shader_source_flat_3D_dat,
+};
+
+var_global U08 ogl4_shader_source_grid_3D_dat[] = {
+#embed "grid_3D.glsl"
+};
+
+var_global Str ogl4_shader_source_grid_3D = {
+  .len = sizeof(ogl4_shader_source_grid_3D_dat),
+  .txt = ogl4_shader_source_grid_3D_dat,
+};
+
+var_global U08 ogl4_shader_source_dvr_3D_dat[] = {
+#embed "dvr_3D.glsl"
+};
+
+var_global Str ogl4_shader_source_dvr_3D = {
+  .len = sizeof(ogl4_shader_source_dvr_3D_dat),
+  .txt = ogl4_shader_source_dvr_3D_dat,
+};
+
+var_global U08 ogl4_shader_source_sli_3D_dat[] = {
+#embed "sli_3D.glsl"
+};
+
+var_global Str ogl4_shader_source_sli_3D = {
+  .len = sizeof(ogl4_shader_source_sli_3D_dat),
+  .txt = ogl4_shader_source_sli_3D_dat,
+};
+
+var_global U08 ogl4_shader_source_quad_2D_dat[] = {
+#embed "quad_2D.glsl"
+};
+
+var_global Str ogl4_shader_source_quad_2D = {
+  .len = sizeof(ogl4_shader_source_quad_2D_dat),
+  .txt = ogl4_shader_source_quad_2D_dat,
+};
+
+// ------------------------------------------------------------
+// #-- OpenGL4 Resources.
+
+// NOTE(cmat): Resources live in dense arrays indexed by generational handles (R_Handle_Pool).
+// - Binding points match the WGSL @binding()s, the sampler goes with the texture's unit.
+
+#define OGL4_Max_Buffers   4096
 #define OGL4_Max_Textures  1024
+#define OGL4_Max_Samplers  64
+#define OGL4_Max_Shaders   64
 #define OGL4_Max_Pipelines 512
 
+// NOTE(cmat): Frames the CPU may run ahead of the GPU. Matches the uniform ring, which reuses
+// - a frame's blocks R_Uniform_Frame_Count frames later.
+#define OGL4_Frame_Count   R_Uniform_Frame_Count
+
+enum {
+  OGL4_Binding_Texture          = 0,
+  OGL4_Binding_Constant_Buffer  = 2,
+  OGL4_Binding_Texture_Volume   = 3,
+};
+
+enum {
+  OGL4_Binding_Vertex   = 0,
+  OGL4_Binding_Instance = 1,
+};
+
+// NOTE(cmat): Static buffers are immutable storage updated with glNamedBufferSubData. Dynamic
+// - buffers are persistently mapped, with OGL4_Frame_Count regions of capacity bytes each. The
+// - first write of a frame moves the buffer to its next region and writes go straight through
+// - the mapping, draws bind the region last written. Stepping round-robin, the next region was
+// - last read OGL4_Frame_Count frames ago at the latest, which r_frame_flush fences, so writes
+// - never stall and never race the GPU. A first write that doesn't cover everything written
+// - before copies the previous region forward on the GPU, and the rest of that frame's writes
+// - are queued behind the copy (glNamedBufferSubData) instead of going through the mapping.
+// - Buffers their owner already multi-buffers (the uniform ring's blocks) are allocated static.
 typedef struct OGL4_Buffer {
-  GLuint buffer;
-  U64    capacity;
+  R_Buffer_Info  info;
+  GLuint         buffer;
+  U08           *mapped;
+  U64            region_bytes;
+  U32            region;
+  B32            region_staged;
+  U64            region_frame;
+  U64            valid_bytes;
 } OGL4_Buffer;
 
 typedef struct OGL4_Texture {
   GLuint texture;
-  U32    width;
-  U32    height;
+  GLenum target;
 } OGL4_Texture;
 
+typedef struct OGL4_Sampler {
+  GLuint sampler;
+} OGL4_Sampler;
+
 typedef struct OGL4_Shader {
   GLuint program;
 } OGL4_Shader;
 
-var_global struct {
-  B32 initialized;
- 
-  U32 buffer_last_id;
-  U32 shader_last_id;
-  U32 sampler_last_id;
-  U32 texture_last_id;
-  U32 pipeline_last_id;
-
-  OGL4_Buffer   buffers   [OGL4_Max_Buffers];
-  OGL4_Texture  textures  [OGL4_Max_Textures];
-  OGL4_Shader   shaders   [OGL4_Max_Shaders];
-//  OGL4_Sampler  samplers  [OGL4_Max_Samplers];
-//  OGL4_Pipeline pipelines [OGL4_Max_Pipelines];
+typedef struct OGL4_Pipeline {
+  GLuint program;
+  GLuint vertex_array;
+  U16    stride;
+  U16    instance_stride;
+  B32    depth_buffer;
+} OGL4_Pipeline;
+
+typedef struct OGL4_Texture_Format {
+  GLenum internal_format;
+  GLenum format;
+  GLenum type;
+} OGL4_Texture_Format;
+
+var_global OGL4_Texture_Format OGL4_Texture_Format_Table[] = {
+  { GL_RGBA8,       GL_RGBA, GL_UNSIGNED_BYTE }, // R_Texture_Format_RGBA_U08_Normalized
+  { GL_RGBA8_SNORM, GL_RGBA, GL_BYTE          }, // R_Texture_Format_RGBA_I08_Normalized
+  { GL_R8,          GL_RED,  GL_UNSIGNED_BYTE }, // R_Texture_Format_R_U08_Normalized
+  { GL_R8_SNORM,    GL_RED,  GL_BYTE          }, // R_Texture_Format_R_I08_Normalized
+  { GL_R32F,        GL_RED,  GL_FLOAT         }, // R_Texture_Format_F32
+  { GL_R16F,        GL_RED,  GL_HALF_FLOAT    }, // R_Texture_Format_F16
+};
+
+typedef struct OGL4_Vertex_Attribute_Format {
+  GLint  size;
+  GLenum type;
+  B32    integer;
+} OGL4_Vertex_Attribute_Format;
+
+// NOTE(cmat): Packed colors are fetched as one integer and unpacked in the shader, as on WebGPU.
+var_global OGL4_Vertex_Attribute_Format OGL4_Vertex_Attribute_Format_Table[] = {
+  { 1, GL_FLOAT,          0 }, // R_Vertex_Attribute_Format_F32
+  { 2, GL_FLOAT,          0 }, // R_Vertex_Attribute_Format_V2_F32
+  { 3, GL_FLOAT,          0 }, // R_Vertex_Attribute_Format_V3_F32
+  { 4, GL_FLOAT,          0 }, // R_Vertex_Attribute_Format_V4_F32
+
+  { 1, GL_UNSIGNED_SHORT, 1 }, // R_Vertex_Attribute_Format_U16
+  { 2, GL_UNSIGNED_SHORT, 1 }, // R_Vertex_Attribute_Format_V2_U16
+  { 3, GL_UNSIGNED_SHORT, 1 }, // R_Vertex_Attribute_Format_V3_U16
+  { 4, GL_UNSIGNED_SHORT, 1 }, // R_Vertex_Attribute_Format_V4_U16
+
+  { 1, GL_UNSIGNED_INT,   1 }, // R_Vertex_Attribute_Format_U32
+  { 2, GL_UNSIGNED_INT,   1 }, // R_Vertex_Attribute_Format_V2_U32
+  { 3, GL_UNSIGNED_INT,   1 }, // R_Vertex_Attribute_Format_V3_U32
+  { 4, GL_UNSIGNED_INT,   1 }, // R_Vertex_Attribute_Format_V4_U32
+
+  { 1, GL_UNSIGNED_INT,   1 }, // R_Vertex_Attribute_Format_V4_U08_Normalized
+};
 
+var_global struct {
+  B32             initialized;
+  Arena           arena;
+  R_Handle_Pool   buffer_handles;
+  R_Handle_Pool   texture_handles;
+  R_Handle_Pool   sampler_handles;
+  R_Handle_Pool   shader_handles;
+  R_Handle_Pool   pipeline_handles;
+
+  OGL4_Buffer     buffers   [OGL4_Max_Buffers];
+  OGL4_Texture    textures  [OGL4_Max_Textures];
+  OGL4_Sampler    samplers  [OGL4_Max_Samplers];
+  OGL4_Shader     shaders   [OGL4_Max_Shaders];
+  OGL4_Pipeline   pipelines [OGL4_Max_Pipelines];
+
+  U64             frame_index;
+  GLsync          frame_fences[OGL4_Frame_Count];
 } OGL4_State;
 
-fn_internal R_Buffer r_buffer_allocate(U64 capacity, R_Buffer_Mode mode) {
-  OGL4_Buffer *ogl4_buffer = &OGL4_State.buffers[OGL4_State.buffer_last_id++];
-  glCreateBuffers(1, &ogl4_buffer->buffer);
+fn_internal OGL4_Buffer *ogl4_buffer(R_Buffer buffer) {
+  r_handle_check(&OGL4_State.buffer_handles, buffer);
+  return &OGL4_State.buffers[r_handle_index(buffer)];
+}
 
-  var_local_persist GLenum OGL4_Mode_Map[] = {
-    GL_STATIC_DRAW,  // R_Buffer_Mode_Static
-    GL_DYNAMIC_DRAW, // R_Buffer_Mode_Dynamic
-  };
+fn_internal OGL4_Texture *ogl4_texture(R_Resource texture) {
+  r_handle_check(&OGL4_State.texture_handles, texture);
+  return &OGL4_State.textures[r_handle_index(texture)];
+}
 
-  glBindBuffer(GL_ARRAY_BUFFER, ogl4_buffer->buffer);
-  glBufferData(GL_ARRAY_BUFFER, capacity, 0, OGL4_Mode_Map[mode]);
+fn_internal OGL4_Sampler *ogl4_sampler(R_Sampler sampler) {
+  r_handle_check(&OGL4_State.sampler_handles, sampler);
+  return &OGL4_State.samplers[r_handle_index(sampler)];
+}
 
-  R_Buffer result = {
-    .id = OGL4_State.buffer_last_id
-  };
+fn_internal OGL4_Shader *ogl4_shader(R_Shader shader) {
+  r_handle_check(&OGL4_State.shader_handles, shader);
+  return &OGL4_State.shaders[r_handle_index(shader)];
+}
+
+fn_internal OGL4_Pipeline *ogl4_pipeline(R_Pipeline pipeline) {
+  r_handle_check(&OGL4_State.pipeline_handles, pipeline);
+  return &OGL4_State.pipelines[r_handle_index(pipeline)];
+}
+
+// NOTE(cmat): Byte offset of the region draws read from.
+fn_internal U64 ogl4_buffer_base(OGL4_Buffer *buffer) {
+  return buffer->region * buffer->region_bytes;
+}
+
+// ------------------------------------------------------------
+// #-- Render API implementation.
+
+fn_internal R_Buffer r_buffer_allocate(U64 capacity, R_Buffer_Mode mode) {
+  R_Buffer     result = r_handle_pool_alloc(&OGL4_State.buffer_handles);
+  OGL4_Buffer *buffer = ogl4_buffer(result);
+  buffer->info        = (R_Buffer_Info) { .capacity = capacity, .mode = mode };
+  glCreateBuffers(1, &buffer->buffer);
+
+  if (mode == R_Buffer_Mode_Dynamic) {
+    GLbitfield map_flags  = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    buffer->region_bytes  = address_align(capacity, R_Uniform_Alignment);
+    buffer->region_frame  = u64_limit_max;
+
+    glNamedBufferStorage(buffer->buffer, OGL4_Frame_Count * buffer->region_bytes, 0, map_flags | GL_DYNAMIC_STORAGE_BIT);
+    buffer->mapped = (U08 *)glMapNamedBufferRange(buffer->buffer, 0, OGL4_Frame_Count * buffer->region_bytes, map_flags);
+  } else {
+    glNamedBufferStorage(buffer->buffer, capacity, 0, GL_DYNAMIC_STORAGE_BIT);
+  }
 
   return result;
 }
 
-fn_internal void r_buffer_download(R_Buffer *buffer, U64 offset, U64 bytes, void *data) {
-  OGL4_Buffer *ogl4_buffer = &OGL4_State.buffers[buffer->id - 1];
-  glBindBuffer(GL_ARRAY_BUFFER, ogl4_buffer->buffer);
-  glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, data);
+fn_internal void r_buffer_download(R_Buffer buffer, U64 offset, U64 bytes, void *data) {
+  OGL4_Buffer *target = ogl4_buffer(buffer);
+  Assert(offset + bytes <= target->info.capacity, "buffer download out of bounds");
+
+  if (target->info.mode == R_Buffer_Mode_Static) {
+    glNamedBufferSubData(target->buffer, offset, bytes, data);
+    return;
+  }
+
+  if (target->region_frame != OGL4_State.frame_index) {
+    U64 last_base         = ogl4_buffer_base(target);
+    target->region        = (target->region + 1) % OGL4_Frame_Count;
+    target->region_frame  = OGL4_State.frame_index;
+    target->region_staged = target->valid_bytes > 0 && (offset > 0 || offset + bytes < target->valid_bytes);
+
+    if (target->region_staged) {
+      glCopyNamedBufferSubData(target->buffer, target->buffer, last_base, ogl4_buffer_base(target), target->valid_bytes);
+    }
+  }
+
+  target->valid_bytes = u64_max(target->valid_bytes, offset + bytes);
+  if (target->region_staged) {
+    glNamedBufferSubData(target->buffer, ogl4_buffer_base(target) + offset, bytes, data);
+  } else {
+    memory_copy(target->mapped + ogl4_buffer_base(target) + offset, data, bytes);
+  }
+}
+
+fn_internal R_Buffer_Info r_buffer_info(R_Buffer buffer) {
+  return ogl4_buffer(buffer)->info;
 }
 
-// TODO(cmat): Implement this.
 fn_internal void r_buffer_destroy(R_Buffer *buffer) {
-  Not_Implemented;
+  OGL4_Buffer *target = ogl4_buffer(*buffer);
+  if (target->mapped) {
+    glUnmapNamedBuffer(target->buffer);
+  }
+
+  glDeleteBuffers(1, &target->buffer);
+  zero_fill(target);
+  r_handle_pool_free(&OGL4_State.buffer_handles, *buffer);
+  *buffer = R_Resource_None;
 }
 
-fn_internal R_Texture r_texture_allocate (R_Texture_Config *config) {
-  OGL4_Texture *ogl4_texture = &OGL4_State.textures[OGL4_State.texture_last_id++];
-  ogl4_texture->width   = config->width;
-  ogl4_texture->height  = config->height;
+fn_internal R_Resource ogl4_texture_allocate(GLenum texture_target, R_Texture_Format format, U32 width, U32 height, U32 depth) {
+  R_Resource    result  = r_handle_pool_alloc(&OGL4_State.texture_handles);
+  OGL4_Texture *texture = ogl4_texture(result);
+  texture->target       = texture_target;
 
-  glCreateTextures(GL_TEXTURE_2D, 1, &ogl4_texture->texture);
-  glBindTexture(GL_TEXTURE_2D, ogl4_texture->texture);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, config->width, config->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+  glCreateTextures(texture_target, 1, &texture->texture);
+  if (texture_target == GL_TEXTURE_3D) {
+    glTextureStorage3D(texture->texture, 1, OGL4_Texture_Format_Table[format].internal_format, width, height, depth);
+  } else {
+    glTextureStorage2D(texture->texture, 1, OGL4_Texture_Format_Table[format].internal_format, width, height);
+  }
 
-  R_Texture result = { .id = OGL4_State.texture_last_id };
+  // NOTE(cmat): Sampled through sampler objects, this only matters for texelFetch (volumes).
+  glTextureParameteri(texture->texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTextureParameteri(texture->texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
   return result;
 }
 
-fn_internal void r_texture_download (R_Texture *texture, U08 *texture_data) {
-  OGL4_Texture *ogl4_texture = &OGL4_State.textures[texture->id - 1];
-  glBindTexture(GL_TEXTURE_2D, ogl4_texture->texture);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ogl4_texture->width, ogl4_texture->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture_data);
+fn_internal void ogl4_texture_download(R_Resource texture, R_Texture_Format download_format, R3I region, void *data) {
+  OGL4_Texture        *target = ogl4_texture(texture);
+  OGL4_Texture_Format *format = &OGL4_Texture_Format_Table[download_format];
+
+  if (target->target == GL_TEXTURE_3D) {
+    glTextureSubImage3D(target->texture, 0, region.x0, region.y0, region.z0, region.x1 - region.x0, region.y1 - region.y0, region.z1 - region.z0, format->format, format->type, data);
+  } else {
+    glTextureSubImage2D(target->texture, 0, region.x0, region.y0, region.x1 - region.x0, region.y1 - region.y0, format->format, format->type, data);
+  }
+}
+
+fn_internal void ogl4_texture_destroy(R_Resource *texture) {
+  OGL4_Texture *target = ogl4_texture(*texture);
+  glDeleteTextures(1, &target->texture);
+  zero_fill(target);
+  r_handle_pool_free(&OGL4_State.texture_handles, *texture);
+  *texture = R_Resource_None;
+}
+
+fn_internal R_Texture_2D r_texture_2D_allocate(R_Texture_Format format, U32 width, U32 height) {
+  return ogl4_texture_allocate(GL_TEXTURE_2D, format, width, height, 1);
+}
+
+fn_internal void r_texture_2D_download(R_Texture_2D texture, R_Texture_Format download_format, R2I region, void *data) {
+  ogl4_texture_download(texture, download_format, r3i(region.x0, region.y0, 0, region.x1, region.y1, 1), data);
+}
+
+fn_internal void r_texture_2D_destroy(R_Texture_2D *texture) {
+  ogl4_texture_destroy(texture);
+}
+
+fn_internal R_Texture_3D r_texture_3D_allocate(R_Texture_Format format, U32 width, U32 height, U32 depth) {
+  return ogl4_texture_allocate(GL_TEXTURE_3D, format, width, height, depth);
+}
+
+fn_internal void r_texture_3D_download(R_Texture_3D texture, R_Texture_Format download_format, R3I region, void *data) {
+  ogl4_texture_download(texture, download_format, region, data);
 }
 
-fn_internal void r_texture_destroy  (R_Texture *texture) {
+fn_internal void r_texture_3D_destroy(R_Texture_3D *texture) {
+  ogl4_texture_destroy(texture);
 }
 
+fn_internal R_Sampler r_sampler_create(R_Sampler_Filter mag_filter, R_Sampler_Filter min_filter) {
+  R_Sampler     result  = r_handle_pool_alloc(&OGL4_State.sampler_handles);
+  OGL4_Sampler *sampler = ogl4_sampler(result);
 
-fn_internal R_Pipeline r_pipeline_create(R_Shader shader, R_Vertex_Format format) {
-  R_Pipeline result = { };
+  glCreateSamplers(1, &sampler->sampler);
+  glSamplerParameteri(sampler->sampler, GL_TEXTURE_MAG_FILTER, mag_filter == R_Sampler_Filter_Linear ? GL_LINEAR : GL_NEAREST);
+  glSamplerParameteri(sampler->sampler, GL_TEXTURE_MIN_FILTER, min_filter == R_Sampler_Filter_Linear ? GL_LINEAR : GL_NEAREST);
+  glSamplerParameteri(sampler->sampler, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
+  glSamplerParameteri(sampler->sampler, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
+  glSamplerParameteri(sampler->sampler, GL_TEXTURE_WRAP_R,     GL_CLAMP_TO_EDGE);
   return result;
 }
 
-// TODO(cmat): Redundant.
-fn_internal void ogl4_create_default_textures(void) {
-  R_Texture_Config white_texture_conf = {
-    .format = R_Texture_Format_RGBA_U08_Normalized,
-    .width  = 2,
-    .height = 2,
-  };
+fn_internal void r_sampler_destroy(R_Sampler *sampler) {
+  OGL4_Sampler *target = ogl4_sampler(*sampler);
+  glDeleteSamplers(1, &target->sampler);
+  zero_fill(target);
+  r_handle_pool_free(&OGL4_State.sampler_handles, *sampler);
+  *sampler = R_Resource_None;
+}
 
-  U32 white_texture_data[] = {
-    0xFFAAFFFF, 0xFFFFFFFF,
-    0xFFFFAAFF, 0xFFFFFFFF,
+fn_internal R_Pipeline r_pipeline_create(R_Shader shader, R_Vertex_Format *format, B32 depth_buffer) {
+  R_Pipeline     result   = r_handle_pool_alloc(&OGL4_State.pipeline_handles);
+  OGL4_Pipeline *pipeline = ogl4_pipeline(result);
+  *pipeline = (OGL4_Pipeline) {
+    .program          = ogl4_shader(shader)->program,
+    .stride           = format->stride,
+    .instance_stride  = format->instance_stride,
+    .depth_buffer     = depth_buffer,
   };
-  
-  R_Texture_White = r_texture_allocate(&white_texture_conf);
-  r_texture_download(&R_Texture_White, (U08 *)white_texture_data);
+
+  // NOTE(cmat): Shader locations follow entry_array order, per-instance attributes read from
+  // - the second vertex buffer binding (divisor 1).
+  glCreateVertexArrays(1, &pipeline->vertex_array);
+  For_U32 (it, format->entry_count) {
+    R_Vertex_Attribute           *attribute        = &format->entry_array[it];
+    OGL4_Vertex_Attribute_Format *attribute_format = &OGL4_Vertex_Attribute_Format_Table[attribute->format];
+    GLuint                        binding          = attribute->step == R_Vertex_Step_Instance ? OGL4_Binding_Instance : OGL4_Binding_Vertex;
+
+    glEnableVertexArrayAttrib(pipeline->vertex_array, it);
+    if (attribute_format->integer) {
+      glVertexArrayAttribIFormat(pipeline->vertex_array, it, attribute_format->size, attribute_format->type, attribute->offset);
+    } else {
+      glVertexArrayAttribFormat(pipeline->vertex_array, it, attribute_format->size, attribute_format->type, GL_FALSE, attribute->offset);
+    }
+
+    glVertexArrayAttribBinding(pipeline->vertex_array, it, binding);
+  }
+
+  glVertexArrayBindingDivisor(pipeline->vertex_array, OGL4_Binding_Instance, 1);
+  return result;
 }
 
-fn_internal GLuint ogl4_compile_shader(char *source, GLenum type) {
+fn_internal void r_pipeline_destroy(R_Pipeline *pipeline) {
+  OGL4_Pipeline *target = ogl4_pipeline(*pipeline);
+  glDeleteVertexArrays(1, &target->vertex_array);
+  zero_fill(target);
+  r_handle_pool_free(&OGL4_State.pipeline_handles, *pipeline);
+  *pipeline = R_Resource_None;
+}
+
+// ------------------------------------------------------------
+// #-- OpenGL4 Initialization.
+
+fn_internal GLuint ogl4_compile_shader(Str source, GLenum type) {
   GLuint shader = glCreateShader(type);
 
-  const char *gl_source = (const char *)source;
-  glShaderSource(shader, 1, &gl_source, 0);
+  const GLchar *sources[] = {
+    "#version 450 core\n",
+    type == GL_VERTEX_SHADER ? "#define VERTEX_SHADER 1\n" : "#define PIXEL_SHADER 1\n",
+    (const GLchar *)source.txt,
+  };
+
+  GLint lengths[] = { -1, -1, (GLint)source.len };
+  glShaderSource(shader, sarray_len(sources), sources, lengths);
   glCompileShader(shader);
 
-  GLint log_length = 0;
-  glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
-  log_info("log length :: %d", log_length);
-  if (log_length > 1) {
+  GLint status = 0;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+  if (!status) {
+    GLint log_length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+
     Scratch scratch = { };
     Scratch_Scope(&scratch, 0) {
-      char *log_buffer = arena_push_count(scratch.arena, char, log_length);
-      glGetShaderInfoLog(shader, log_length, 0, log_buffer);
+      char *log_buffer = arena_push_count(scratch.arena, char, log_length + 1);
+      glGetShaderInfoLog(shader, log_length + 1, 0, log_buffer);
       log_fatal("OpenGL4: Shader compilation error.\n%s", log_buffer);
-      log_info("Full shader source:\n%s\n", source);
+      log_info("Full shader source:\n%.*s\n", str_expand(source));
     }
 
     co_panic(str_lit("OpenGL4: Failed to compile shader, can't continue."));
@@ -203,23 +596,25 @@ fn_internal GLuint ogl4_compile_shader(char *source, GLenum type) {
   return shader;
 }
 
-fn_internal GLuint ogl4_create_program(char *vertex_source, char *fragment_source) {
-  GLuint vertex_shader    = ogl4_compile_shader(vertex_source,   GL_VERTEX_SHADER);
-  GLuint fragment_shader  = ogl4_compile_shader(fragment_source, GL_FRAGMENT_SHADER);
+fn_internal GLuint ogl4_create_program(Str source) {
+  GLuint vertex_shader    = ogl4_compile_shader(source, GL_VERTEX_SHADER);
+  GLuint fragment_shader  = ogl4_compile_shader(source, GL_FRAGMENT_SHADER);
 
   GLuint program = glCreateProgram();
   glAttachShader(program, vertex_shader);
   glAttachShader(program, fragment_shader);
   glLinkProgram(program);
 
-  GLint log_length = 0;
-  glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
-  log_info("log length :: %d", log_length);
-  if (log_length > 1) {
+  GLint status = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &status);
+  if (!status) {
+    GLint log_length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
+
     Scratch scratch = { };
     Scratch_Scope(&scratch, 0) {
-      char *log_buffer = arena_push_count(scratch.arena, char, log_length);
-      glGetProgramInfoLog(program, log_length, 0, log_buffer);
+      char *log_buffer = arena_push_count(scratch.arena, char, log_length + 1);
+      glGetProgramInfoLog(program, log_length + 1, 0, log_buffer);
       log_fatal("OpenGL4: Program link error.\n%s", log_buffer);
     }
 
@@ -234,32 +629,235 @@ fn_internal GLuint ogl4_create_program(char *vertex_source, char *fragment_sourc
   return program;
 }
 
+fn_internal R_Shader ogl4_shader_create(Str source) {
+  R_Shader result = r_handle_pool_alloc(&OGL4_State.shader_handles);
+  ogl4_shader(result)->program = ogl4_create_program(source);
+  return result;
+}
+
 fn_internal void ogl4_create_default_shaders(void) {
-  OGL4_Shader *flat_2D_shader  = &OGL4_State.shaders[OGL4_State.shader_last_id++];
-  flat_2D_shader->program      = ogl4_create_program(ogl4_shader_vertex_flat_2D, ogl4_shader_pixel_flat_2D);
-  R_Shader_Flat_2D             = (R_Shader) { .id = OGL4_State.shader_last_id };
+  R_Shader_Flat_2D = ogl4_shader_create(ogl4_shader_source_flat_2D);
+  R_Shader_Flat_3D = ogl4_shader_create(ogl4_shader_source_flat_3D);
+  R_Shader_Grid_3D = ogl4_shader_create(ogl4_shader_source_grid_3D);
+  R_Shader_DVR_3D  = ogl4_shader_create(ogl4_shader_source_dvr_3D);
+  R_Shader_SLI_3D  = ogl4_shader_create(ogl4_shader_source_sli_3D);
+  R_Shader_Quad_2D = ogl4_shader_create(ogl4_shader_source_quad_2D);
+}
+
+fn_internal void ogl4_create_default_textures(void) {
+  U32 white_texture_data[] = {
+    0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF,
+  };
+
+  R_Texture_2D_White = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 2, 2);
+  r_texture_2D_download(R_Texture_2D_White, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 2, 2), (U08 *)white_texture_data);
+
+  F32 white_texture_volume_data[] = {
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+  };
 
-  OGL4_Shader *flat_3D_shader  = &OGL4_State.shaders[OGL4_State.shader_last_id++];
-  flat_3D_shader->program      = ogl4_create_program(ogl4_shader_vertex_flat_3D, ogl4_shader_pixel_flat_3D);
-  R_Shader_Flat_3D             = (R_Shader) { .id = OGL4_State.shader_last_id };
+  R_Texture_3D_White = r_texture_3D_allocate(R_Texture_Format_F32, 2, 2, 2);
+  r_texture_3D_download(R_Texture_3D_White, R_Texture_Format_F32, r3i(0, 0, 0, 2, 2, 2), (U08 *)white_texture_volume_data);
+}
 
-  OGL4_Shader *mtsdf_2D_shader = &OGL4_State.shaders[OGL4_State.shader_last_id++];
-  mtsdf_2D_shader->program     = ogl4_create_program(ogl4_shader_vertex_mtsdf_2D, ogl4_shader_pixel_mtsdf_2D);
-  R_Shader_MTSDF_2D            = (R_Shader) { .id = OGL4_State.shader_last_id };
+fn_internal void ogl4_create_default_samplers(void) {
+  R_Sampler_Linear_Clamp  = r_sampler_create(R_Sampler_Filter_Linear,  R_Sampler_Filter_Linear);
+  R_Sampler_Nearest_Clamp = r_sampler_create(R_Sampler_Filter_Nearest, R_Sampler_Filter_Nearest);
+}
+
+fn_internal void APIENTRY ogl4_debug_message(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *user_data) {
+  if (severity == GL_DEBUG_SEVERITY_HIGH || severity == GL_DEBUG_SEVERITY_MEDIUM) {
+    log_warning("OpenGL4: %.*s", (I32)length, message);
+  }
 }
 
 fn_internal void r_init(PL_Render_Context *render_context) {
   ogl4_load_api();
 
-  // NOTE(cmat): Create default resources.
-  // ogl4_create_default_samplers();
+  arena_init(&OGL4_State.arena);
+  r_handle_pool_init(&OGL4_State.buffer_handles,   &OGL4_State.arena, OGL4_Max_Buffers);
+  r_handle_pool_init(&OGL4_State.texture_handles,  &OGL4_State.arena, OGL4_Max_Textures);
+  r_handle_pool_init(&OGL4_State.sampler_handles,  &OGL4_State.arena, OGL4_Max_Samplers);
+  r_handle_pool_init(&OGL4_State.shader_handles,   &OGL4_State.arena, OGL4_Max_Shaders);
+  r_handle_pool_init(&OGL4_State.pipeline_handles, &OGL4_State.arena, OGL4_Max_Pipelines);
+
+#if BUILD_DEBUG
+  glEnable(GL_DEBUG_OUTPUT);
+  glDebugMessageCallback(ogl4_debug_message, 0);
+#endif
+
+  // NOTE(cmat): Uniform ring offsets are R_Uniform_Alignment aligned, so are buffer regions.
+  GLint uniform_alignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+  Assert(uniform_alignment > 0 && R_Uniform_Alignment % uniform_alignment == 0, "uniform ring alignment too small for this GL");
+
+  // NOTE(cmat): Same conventions as the WebGPU backend: depth in [0, 1], counter clockwise
+  // - front faces with back faces culled, premultiplied alpha blending.
+  glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+  glEnable(GL_CULL_FACE);
+  glCullFace(GL_BACK);
+  glFrontFace(GL_CCW);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_SCISSOR_TEST);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
   ogl4_create_default_shaders();
   ogl4_create_default_textures();
+  ogl4_create_default_samplers();
+
+  OGL4_State.initialized = 1;
 }
 
+// ------------------------------------------------------------
+// #-- OpenGL4 Command Submission.
+
+// NOTE(cmat): Draws go out in key order into the default framebuffer, the platform swaps.
+// - State that doesn't change between consecutive draws is only set once. Regions are y up,
+// - like GL's window coordinates, and clamped the same way as on WebGPU.
 fn_internal void r_frame_flush(void) {
-  glClearColor(.1f, .1f, .8f, 1.f);
-  glClear(GL_COLOR_BUFFER_BIT);
-}
+  r_uniform_flush();
+  r_upload_flush();
+
+  V2F resolution    = pl_display()->resolution;
+  I32 target_width  = (I32)f32_max(resolution.x, 1.f);
+  I32 target_height = (I32)f32_max(resolution.y, 1.f);
+
+  glDisable(GL_SCISSOR_TEST);
+  glDepthMask(GL_TRUE);
+  glClearColor(0.f, 0.f, 0.f, 1.f);
+  glClearDepth(1.0);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glEnable(GL_SCISSOR_TEST);
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U32              draw_count = 0;
+    R_Command_Draw **draws      = r_command_sort(scratch.arena, &draw_count);
+
+    OGL4_Pipeline *pipeline             = 0;
+    R_Pipeline     last_pipeline        = R_Resource_None;
+    R_Buffer       last_vertex_buffer   = R_Resource_None;
+    R_Buffer       last_index_buffer    = R_Resource_None;
+    R_Buffer       last_instance_buffer = R_Resource_None;
+    R_Buffer       last_constant_buffer = R_Resource_None;
+    U32            last_constant_offset = u32_limit_max;
+    R_Texture_2D   last_texture         = R_Resource_None;
+    R_Texture_3D   last_texture_volume  = R_Resource_None;
+    R_Sampler      last_sampler         = R_Resource_None;
+    R2I            last_viewport        = r2i(-1, -1, -1, -1);
+    R2I            last_scissor         = r2i(-1, -1, -1, -1);
+    U64            index_base           = 0;
+
+    For_U32 (draw_it, draw_count) {
+      R_Command_Draw *draw = draws[draw_it];
+
+      // NOTE(cmat): Buffer bindings live in the pipeline's vertex array, rebind on switch.
+      if (draw->pipeline != last_pipeline) {
+        pipeline = ogl4_pipeline(draw->pipeline);
+        glUseProgram(pipeline->program);
+        glBindVertexArray(pipeline->vertex_array);
+        glDepthFunc(pipeline->depth_buffer ? GL_LESS : GL_ALWAYS);
+        glDepthMask(pipeline->depth_buffer ? GL_TRUE : GL_FALSE);
+
+        last_pipeline        = draw->pipeline;
+        last_vertex_buffer   = R_Resource_None;
+        last_index_buffer    = R_Resource_None;
+        last_instance_buffer = R_Resource_None;
+      }
+
+      R2I viewport = { };
+      viewport.x0  = i32_clamp(draw->draw_region.x0, 0,           target_width);
+      viewport.y0  = i32_clamp(draw->draw_region.y0, 0,           target_height);
+      viewport.x1  = i32_clamp(draw->draw_region.x1, viewport.x0, target_width);
+      viewport.y1  = i32_clamp(draw->draw_region.y1, viewport.y0, target_height);
+
+      R2I scissor  = { };
+      scissor.x0   = i32_clamp(draw->clip_region.x0, viewport.x0, viewport.x1);
+      scissor.y0   = i32_clamp(draw->clip_region.y0, viewport.y0, viewport.y1);
+      scissor.x1   = i32_clamp(draw->clip_region.x1, scissor.x0,  viewport.x1);
+      scissor.y1   = i32_clamp(draw->clip_region.y1, scissor.y0,  viewport.y1);
+
+      if (!memory_compare(&viewport, &last_viewport, sizeof(R2I))) {
+        glViewport(viewport.x0, viewport.y0, viewport.x1 - viewport.x0, viewport.y1 - viewport.y0);
+        last_viewport = viewport;
+      }
+
+      if (!memory_compare(&scissor, &last_scissor, sizeof(R2I))) {
+        glScissor(scissor.x0, scissor.y0, scissor.x1 - scissor.x0, scissor.y1 - scissor.y0);
+        last_scissor = scissor;
+      }
+
+      if (draw->texture != last_texture) {
+        glBindTextureUnit(OGL4_Binding_Texture, draw->texture ? ogl4_texture(draw->texture)->texture : 0);
+        last_texture = draw->texture;
+      }
+
+      if (draw->sampler != last_sampler) {
+        glBindSampler(OGL4_Binding_Texture, draw->sampler ? ogl4_sampler(draw->sampler)->sampler : 0);
+        last_sampler = draw->sampler;
+      }
+
+      if (draw->texture_volume != last_texture_volume) {
+        glBindTextureUnit(OGL4_Binding_Texture_Volume, draw->texture_volume ? ogl4_texture(draw->texture_volume)->texture : 0);
+        last_texture_volume = draw->texture_volume;
+      }
+
+      if (draw->constant_buffer != last_constant_buffer || draw->constant_offset != last_constant_offset) {
+        OGL4_Buffer *constants = ogl4_buffer(draw->constant_buffer);
+        U64          bytes     = u64_min(R_Uniform_Binding_Bytes, constants->info.capacity - draw->constant_offset);
+        glBindBufferRange(GL_UNIFORM_BUFFER, OGL4_Binding_Constant_Buffer, constants->buffer, ogl4_buffer_base(constants) + draw->constant_offset, bytes);
+
+        last_constant_buffer = draw->constant_buffer;
+        last_constant_offset = draw->constant_offset;
+      }
+
+      if (draw->vertex_buffer != last_vertex_buffer) {
+        OGL4_Buffer *vertices = ogl4_buffer(draw->vertex_buffer);
+        glVertexArrayVertexBuffer(pipeline->vertex_array, OGL4_Binding_Vertex, vertices->buffer, ogl4_buffer_base(vertices), pipeline->stride);
+        last_vertex_buffer = draw->vertex_buffer;
+      }
+
+      if (draw->instance_buffer && draw->instance_buffer != last_instance_buffer) {
+        OGL4_Buffer *instances = ogl4_buffer(draw->instance_buffer);
+        glVertexArrayVertexBuffer(pipeline->vertex_array, OGL4_Binding_Instance, instances->buffer, ogl4_buffer_base(instances), pipeline->instance_stride);
+        last_instance_buffer = draw->instance_buffer;
+      }
+
+      if (draw->index_buffer != last_index_buffer) {
+        OGL4_Buffer *indices = ogl4_buffer(draw->index_buffer);
+        glVertexArrayElementBuffer(pipeline->vertex_array, indices->buffer);
+        index_base        = ogl4_buffer_base(indices);
+        last_index_buffer = draw->index_buffer;
+      }
+
+      glDrawElementsInstancedBaseInstance(
+        GL_TRIANGLES,
+        draw->draw_index_count,
+        GL_UNSIGNED_INT,
+        (void *)(UAddr)(index_base + sizeof(U32) * draw->draw_index_offset),
+        u32_max(draw->instance_count, 1),
+        draw->instance_offset);
+    }
+  }
 
+  // NOTE(cmat): Fence this frame, then wait for the frame OGL4_Frame_Count back, the oldest
+  // - one that may still read the dynamic buffer regions the next frame writes.
+  OGL4_State.frame_fences[OGL4_State.frame_index % OGL4_Frame_Count] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  OGL4_State.frame_index += 1;
 
+  GLsync *oldest_fence = &OGL4_State.frame_fences[OGL4_State.frame_index % OGL4_Frame_Count];
+  if (*oldest_fence) {
+    while (glClientWaitSync(*oldest_fence, GL_SYNC_FLUSH_COMMANDS_BIT, u64_millions(100)) == GL_TIMEOUT_EXPIRED) { }
+    glDeleteSync(*oldest_fence);
+    *oldest_fence = 0;
+  }
+
+  r_command_reset();
+}
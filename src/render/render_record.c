@@ -0,0 +1,350 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+// ------------------------------------------------------------
+// #-- Default handles.
+
+R_Shader      R_Shader_Flat_2D        = { };
+R_Shader      R_Shader_Flat_3D        = { };
+R_Shader      R_Shader_Grid_3D        = { };
+R_Shader      R_Shader_DVR_3D         = { };
+R_Shader      R_Shader_SLI_3D         = { };
+R_Shader      R_Shader_Quad_2D        = { };
+R_Texture_2D  R_Texture_2D_White      = { };
+R_Texture_3D  R_Texture_3D_White      = { };
+R_Sampler     R_Sampler_Linear_Clamp  = { };
+R_Sampler     R_Sampler_Nearest_Clamp = { };
+
+#if OS_WASM
+Str R_Capture_Path = { };
+#else
+Str R_Capture_Path = str_lit("alice_capture.rcap");
+#endif
+
+// ------------------------------------------------------------
+// #-- Recording State.
+
+// NOTE(cmat): Records are buffered per frame as a list of chunks (one per r_* call), then
+// - flattened and written to the capture file in one go on r_frame_flush. Without a capture
+// - path the chunks are kept around until r_record_capture.
+
+typedef struct Record_Chunk {
+  struct Record_Chunk *next;
+  U64                  bytes;
+} Record_Chunk;
+
+typedef struct Record_Buffer {
+  R_Buffer_Info info;
+} Record_Buffer;
+
+var_global struct {
+  B32            initialized;
+  Arena          arena;
+  Record_Chunk  *first;
+  Record_Chunk  *last;
+  U64            pending_bytes;
+
+  B32            streaming;
+  CO_File        file;
+  U64            file_offset;
+
+  U64            frame_index;
+  Arena          handle_arena;
+  R_Handle_Pool  handles;
+  Record_Buffer  buffers[R_Capture_Handle_Max];
+} Record_State;
+
+fn_internal U08 *record_chunk_push(U64 bytes) {
+  Record_Chunk *chunk = (Record_Chunk *)arena_push_size(&Record_State.arena, sizeof(Record_Chunk) + bytes);
+  chunk->bytes        = bytes;
+  queue_push(Record_State.first, Record_State.last, chunk);
+  Record_State.pending_bytes += bytes;
+
+  return (U08 *)(chunk + 1);
+}
+
+fn_internal U08 *record_push(R_Capture_Op op, U64 payload_bytes, U64 data_bytes, void *data) {
+  Assert(payload_bytes + data_bytes <= u32_limit_max, "capture record too large");
+
+  R_Capture_Record *record = (R_Capture_Record *)record_chunk_push(sizeof(R_Capture_Record) + payload_bytes + data_bytes);
+  record->op               = op;
+  record->bytes            = (U32)(payload_bytes + data_bytes);
+
+  U08 *payload = (U08 *)(record + 1);
+  if (data_bytes) {
+    memory_copy(payload + payload_bytes, data, data_bytes);
+  }
+
+  return payload;
+}
+
+#define record_push_type(op_, type_) ((type_ *)record_push(op_, sizeof(type_), 0, 0))
+
+// NOTE(cmat): All resource kinds share one handle pool, captured handles are written as is
+// - (generation included) and replay remaps them by slot.
+fn_internal R_Resource record_handle_next(void) {
+  return r_handle_pool_alloc(&Record_State.handles);
+}
+
+fn_internal Record_Buffer *record_buffer(R_Buffer buffer) {
+  r_handle_check(&Record_State.handles, buffer);
+  return &Record_State.buffers[r_handle_index(buffer)];
+}
+
+fn_internal void record_destroy(R_Capture_Op op, R_Resource *resource) {
+  record_push_type(op, R_Capture_Destroy)->resource = *resource;
+  r_handle_pool_free(&Record_State.handles, *resource);
+  *resource = R_Resource_None;
+}
+
+// NOTE(cmat): Unset handles are left to the live backend, only stale ones are caught here.
+fn_internal void record_draw_check(R_Command_Draw *draw) {
+  R_Resource handles[] = {
+    draw->pipeline, draw->vertex_buffer,  draw->index_buffer, draw->instance_buffer,
+    draw->constant_buffer, draw->texture, draw->texture_volume, draw->sampler,
+  };
+
+  For_U32 (it, sarray_len(handles)) {
+    if (handles[it] != R_Resource_None) {
+      r_handle_check(&Record_State.handles, handles[it]);
+    }
+  }
+}
+
+fn_internal Str record_flatten(Arena *arena) {
+  Str result = {
+    .len = Record_State.pending_bytes,
+    .txt = arena_push_size(arena, Record_State.pending_bytes, .flags = 0),
+  };
+
+  U64 at = 0;
+  for (Record_Chunk *it = Record_State.first; it; it = it->next) {
+    memory_copy(result.txt + at, it + 1, it->bytes);
+    at += it->bytes;
+  }
+
+  return result;
+}
+
+fn_internal Str r_record_capture(Arena *arena) {
+  Assert(!Record_State.streaming, "capture is streamed to R_Capture_Path");
+  return record_flatten(arena);
+}
+
+// ------------------------------------------------------------
+// #-- Render API implementation.
+
+fn_internal R_Buffer r_buffer_allocate(U64 capacity, R_Buffer_Mode mode) {
+  R_Buffer result = record_handle_next();
+  record_buffer(result)->info = (R_Buffer_Info) { .capacity = capacity, .mode = mode };
+
+  R_Capture_Buffer_Allocate *record = record_push_type(R_Capture_Op_Buffer_Allocate, R_Capture_Buffer_Allocate);
+  record->buffer   = result;
+  record->mode     = mode;
+  record->capacity = capacity;
+  return result;
+}
+
+fn_internal void r_buffer_download(R_Buffer buffer, U64 offset, U64 bytes, void *data) {
+  Assert(offset + bytes <= record_buffer(buffer)->info.capacity, "buffer download out of bounds");
+
+  R_Capture_Buffer_Download *record = (R_Capture_Buffer_Download *)record_push(R_Capture_Op_Buffer_Download, sizeof(R_Capture_Buffer_Download), bytes, data);
+  record->buffer = buffer;
+  record->offset = offset;
+  record->bytes  = bytes;
+}
+
+fn_internal R_Buffer_Info r_buffer_info(R_Buffer buffer) {
+  return record_buffer(buffer)->info;
+}
+
+fn_internal void r_buffer_destroy(R_Buffer *buffer) {
+  record_buffer(*buffer)->info = (R_Buffer_Info) { };
+  record_destroy(R_Capture_Op_Buffer_Destroy, buffer);
+}
+
+fn_internal R_Texture_2D r_texture_2D_allocate(R_Texture_Format format, U32 width, U32 height) {
+  R_Texture_2D result = record_handle_next();
+
+  R_Capture_Texture_Allocate *record = record_push_type(R_Capture_Op_Texture_2D_Allocate, R_Capture_Texture_Allocate);
+  record->texture = result;
+  record->format  = format;
+  record->width   = width;
+  record->height  = height;
+  record->depth   = 1;
+  return result;
+}
+
+fn_internal void r_texture_2D_download(R_Texture_2D texture, R_Texture_Format download_format, R2I region, void *data) {
+  r_handle_check(&Record_State.handles, texture);
+  U64 bytes = r_texture_format_bytes(download_format) * (U64)(region.x1 - region.x0) * (U64)(region.y1 - region.y0);
+
+  R_Capture_Texture_Download *record = (R_Capture_Texture_Download *)record_push(R_Capture_Op_Texture_2D_Download, sizeof(R_Capture_Texture_Download), bytes, data);
+  record->texture = texture;
+  record->format  = download_format;
+  record->region  = r3i(region.x0, region.y0, 0, region.x1, region.y1, 1);
+  record->bytes   = bytes;
+}
+
+fn_internal void r_texture_2D_destroy(R_Texture_2D *texture) {
+  record_destroy(R_Capture_Op_Texture_2D_Destroy, texture);
+}
+
+fn_internal R_Texture_3D r_texture_3D_allocate(R_Texture_Format format, U32 width, U32 height, U32 depth) {
+  R_Texture_3D result = record_handle_next();
+
+  R_Capture_Texture_Allocate *record = record_push_type(R_Capture_Op_Texture_3D_Allocate, R_Capture_Texture_Allocate);
+  record->texture = result;
+  record->format  = format;
+  record->width   = width;
+  record->height  = height;
+  record->depth   = depth;
+  return result;
+}
+
+fn_internal void r_texture_3D_download(R_Texture_3D texture, R_Texture_Format download_format, R3I region, void *data) {
+  r_handle_check(&Record_State.handles, texture);
+  U64 bytes = r_texture_format_bytes(download_format) * (U64)(region.x1 - region.x0) * (U64)(region.y1 - region.y0) * (U64)(region.z1 - region.z0);
+
+  R_Capture_Texture_Download *record = (R_Capture_Texture_Download *)record_push(R_Capture_Op_Texture_3D_Download, sizeof(R_Capture_Texture_Download), bytes, data);
+  record->texture = texture;
+  record->format  = download_format;
+  record->region  = region;
+  record->bytes   = bytes;
+}
+
+fn_internal void r_texture_3D_destroy(R_Texture_3D *texture) {
+  record_destroy(R_Capture_Op_Texture_3D_Destroy, texture);
+}
+
+fn_internal R_Sampler r_sampler_create(R_Sampler_Filter mag_filter, R_Sampler_Filter min_filter) {
+  R_Sampler result = record_handle_next();
+
+  R_Capture_Sampler_Create *record = record_push_type(R_Capture_Op_Sampler_Create, R_Capture_Sampler_Create);
+  record->sampler    = result;
+  record->mag_filter = mag_filter;
+  record->min_filter = min_filter;
+  return result;
+}
+
+fn_internal void r_sampler_destroy(R_Sampler *sampler) {
+  record_destroy(R_Capture_Op_Sampler_Destroy, sampler);
+}
+
+fn_internal R_Pipeline r_pipeline_create(R_Shader shader, R_Vertex_Format *format, B32 depth_buffer) {
+  r_handle_check(&Record_State.handles, shader);
+  R_Pipeline result = record_handle_next();
+
+  R_Capture_Pipeline_Create *record = record_push_type(R_Capture_Op_Pipeline_Create, R_Capture_Pipeline_Create);
+  record->pipeline     = result;
+  record->shader       = shader;
+  record->depth_buffer = depth_buffer;
+  record->format       = *format;
+  return result;
+}
+
+fn_internal void r_pipeline_destroy(R_Pipeline *pipeline) {
+  record_destroy(R_Capture_Op_Pipeline_Destroy, pipeline);
+}
+
+// ------------------------------------------------------------
+// #-- Recording Initialization.
+
+fn_internal R_Shader record_shader_builtin(R_Capture_Shader builtin) {
+  R_Shader result = record_handle_next();
+
+  R_Capture_Shader_Builtin *record = record_push_type(R_Capture_Op_Shader_Builtin, R_Capture_Shader_Builtin);
+  record->shader  = result;
+  record->builtin = builtin;
+  return result;
+}
+
+fn_internal void r_init(PL_Render_Context *render_context) {
+  Assert(!Record_State.initialized, "recording backend initialized twice");
+  Record_State.initialized = 1;
+  arena_init(&Record_State.arena);
+  arena_init(&Record_State.handle_arena);
+  r_handle_pool_init(&Record_State.handles, &Record_State.handle_arena, R_Capture_Handle_Max);
+
+  R_Capture_File_Header *header = (R_Capture_File_Header *)record_chunk_push(sizeof(R_Capture_File_Header));
+  header->magic                 = R_Capture_Magic;
+  header->version               = R_Capture_Version;
+
+  // NOTE(cmat): If the capture file can't be opened, keep recording in memory, r_record_capture
+  // - still hands the frames out.
+  if (R_Capture_Path.len) {
+    CO_File file = co_file_open(R_Capture_Path, CO_File_Access_Flag_Write | CO_File_Access_Flag_Create | CO_File_Access_Flag_Truncate);
+    if ((I64)file.os_handle_1 < 0) {
+      log_warning("render record: failed to open '%.*s', capturing in memory", str_expand(R_Capture_Path));
+    } else {
+      Record_State.streaming = 1;
+      Record_State.file      = file;
+    }
+  }
+
+  R_Shader_Flat_2D = record_shader_builtin(R_Capture_Shader_Flat_2D);
+  R_Shader_Flat_3D = record_shader_builtin(R_Capture_Shader_Flat_3D);
+  R_Shader_Grid_3D = record_shader_builtin(R_Capture_Shader_Grid_3D);
+  R_Shader_DVR_3D  = record_shader_builtin(R_Capture_Shader_DVR_3D);
+  R_Shader_SLI_3D  = record_shader_builtin(R_Capture_Shader_SLI_3D);
+  R_Shader_Quad_2D = record_shader_builtin(R_Capture_Shader_Quad_2D);
+
+  U32 white_texture_data[] = {
+    0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF,
+  };
+
+  R_Texture_2D_White = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 2, 2);
+  r_texture_2D_download(R_Texture_2D_White, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 2, 2), white_texture_data);
+
+  F32 white_texture_volume_data[] = {
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+  };
+
+  R_Texture_3D_White = r_texture_3D_allocate(R_Texture_Format_F32, 2, 2, 2);
+  r_texture_3D_download(R_Texture_3D_White, R_Texture_Format_F32, r3i(0, 0, 0, 2, 2, 2), white_texture_volume_data);
+
+  R_Sampler_Linear_Clamp  = r_sampler_create(R_Sampler_Filter_Linear,  R_Sampler_Filter_Linear);
+  R_Sampler_Nearest_Clamp = r_sampler_create(R_Sampler_Filter_Nearest, R_Sampler_Filter_Nearest);
+}
+
+// ------------------------------------------------------------
+// #-- Recording Command Submission.
+
+// NOTE(cmat): Draws are recorded in key order, so a replay (which pushes them unkeyed, in
+// - order) flushes them exactly as the recorded frame did.
+fn_internal void r_frame_flush(void) {
+  r_uniform_flush();
+  r_upload_flush();
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U32              draw_count = 0;
+    R_Command_Draw **draws      = r_command_sort(scratch.arena, &draw_count);
+    For_U32 (it, draw_count) {
+      record_draw_check(draws[it]);
+      record_push(R_Capture_Op_Draw, 0, sizeof(R_Command_Draw), draws[it]);
+    }
+  }
+
+  record_push_type(R_Capture_Op_Frame_End, R_Capture_Frame_End)->frame_index = Record_State.frame_index++;
+  r_command_reset();
+
+  if (Record_State.streaming) {
+    Scratch scratch = { };
+    Scratch_Scope(&scratch, 0) {
+      Str frame = record_flatten(scratch.arena);
+      co_file_write(&Record_State.file, Record_State.file_offset, frame.len, frame.txt);
+      Record_State.file_offset += frame.len;
+    }
+
+    Record_State.first         = 0;
+    Record_State.last          = 0;
+    Record_State.pending_bytes = 0;
+    arena_clear(&Record_State.arena);
+  }
+}
@@ -0,0 +1,881 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+#if !F32_X04_Available
+# error "the software renderer needs F32_X04"
+#endif
+
+// ------------------------------------------------------------
+// #-- Default handles.
+
+R_Shader      R_Shader_Flat_2D        = { };
+R_Shader      R_Shader_Flat_3D        = { };
+R_Shader      R_Shader_Grid_3D        = { };
+R_Shader      R_Shader_DVR_3D         = { };
+R_Shader      R_Shader_SLI_3D         = { };
+R_Shader      R_Shader_Quad_2D        = { };
+R_Texture_2D  R_Texture_2D_White      = { };
+R_Texture_3D  R_Texture_3D_White      = { };
+R_Sampler     R_Sampler_Linear_Clamp  = { };
+R_Sampler     R_Sampler_Nearest_Clamp = { };
+
+// ------------------------------------------------------------
+// #-- Software Resources.
+
+// NOTE(cmat): Resources live in plain memory, in per-kind tables indexed by generational
+// - handles (R_Handle_Pool). Only the flat and quad shaders are rasterized, draws with the
+// - grid / volume shaders are skipped.
+
+#define Software_Max_Buffers   4096
+#define Software_Max_Textures  1024
+#define Software_Max_Samplers  64
+#define Software_Max_Pipelines 512
+
+#define Software_Tile_Size     64
+#define Software_Subpixel      16.f
+
+typedef U32 Software_Shader;
+enum {
+  Software_Shader_None,
+  Software_Shader_Flat_2D,
+  Software_Shader_Flat_3D,
+  Software_Shader_Grid_3D,
+  Software_Shader_DVR_3D,
+  Software_Shader_SLI_3D,
+  Software_Shader_Quad_2D,
+};
+
+typedef struct Software_Buffer {
+  R_Buffer_Info  info;
+  U08           *data;
+} Software_Buffer;
+
+typedef struct Software_Texture {
+  R_Texture_Format  format;
+  U32               width;
+  U32               height;
+  U32               depth;
+  U64               bytes;
+  U08              *data;
+} Software_Texture;
+
+typedef struct Software_Sampler {
+  R_Sampler_Filter mag_filter;
+  R_Sampler_Filter min_filter;
+} Software_Sampler;
+
+typedef struct Software_Pipeline {
+  Software_Shader shader;
+  R_Vertex_Format format;
+  B32             depth_buffer;
+} Software_Pipeline;
+
+// NOTE(cmat): Per-draw state the tiles need, triangles point at it by index.
+typedef struct Software_Draw_State {
+  Software_Texture *texture;
+  R_Sampler_Filter  filter;
+  B32               depth_buffer;
+} Software_Draw_State;
+
+// NOTE(cmat): Setup triangle, in pixel space (origin top-left, y down), wound so every edge
+// - function is positive inside. Each edge is evaluated from its lexicographically smaller
+// - endpoint and negated as needed, so a shared edge gives bit-exact opposite values in both
+// - triangles, and the top-left rule then hands each pixel on it to exactly one of them.
+typedef struct Software_Triangle {
+  F32 edge_x[3];
+  F32 edge_y[3];
+  F32 edge_dx[3];
+  F32 edge_dy[3];
+  F32 edge_sign[3];
+  B32 edge_top_left[3];
+
+  F32 inverse_area;
+  F32 z[3];
+  F32 inverse_w[3];
+  V2F uv[3];
+  V4F color[3];
+
+  I32 x0, y0, x1, y1;
+  U32 state;
+} Software_Triangle;
+
+typedef Array_Type(Software_Triangle) Software_Triangle_Array;
+
+typedef struct Software_Vertex {
+  V4F clip;
+  V2F uv;
+  V4F color;
+} Software_Vertex;
+
+var_global struct {
+  B32               initialized;
+  Arena             frame_arena;
+  R_Software_Target target;
+  B32               target_fixed;
+
+  Arena             arena;
+  R_Handle_Pool     buffer_handles;
+  R_Handle_Pool     texture_handles;
+  R_Handle_Pool     sampler_handles;
+  R_Handle_Pool     pipeline_handles;
+
+  Software_Buffer   buffers   [Software_Max_Buffers];
+  Software_Texture  textures  [Software_Max_Textures];
+  Software_Sampler  samplers  [Software_Max_Samplers];
+  Software_Pipeline pipelines [Software_Max_Pipelines];
+} Software_State;
+
+fn_internal U08 *software_memory_allocate(U64 bytes) {
+  U08 *result = co_memory_reserve(bytes);
+  co_memory_commit(result, bytes, CO_Commit_Flag_Read | CO_Commit_Flag_Write);
+  memory_fill(result, 0, bytes);
+  return result;
+}
+
+fn_internal void software_memory_free(U08 *data, U64 bytes) {
+  if (data) {
+    co_memory_unreserve(data, bytes);
+  }
+}
+
+// NOTE(cmat): Resources live in dense arrays indexed by the handle's slot, every lookup goes
+// - through these so stale handles are caught (see r_handle_check).
+fn_internal Software_Buffer *software_buffer(R_Buffer buffer) {
+  r_handle_check(&Software_State.buffer_handles, buffer);
+  return &Software_State.buffers[r_handle_index(buffer)];
+}
+
+fn_internal Software_Texture *software_texture(R_Resource texture) {
+  r_handle_check(&Software_State.texture_handles, texture);
+  return &Software_State.textures[r_handle_index(texture)];
+}
+
+fn_internal Software_Sampler *software_sampler(R_Sampler sampler) {
+  r_handle_check(&Software_State.sampler_handles, sampler);
+  return &Software_State.samplers[r_handle_index(sampler)];
+}
+
+fn_internal Software_Pipeline *software_pipeline(R_Pipeline pipeline) {
+  r_handle_check(&Software_State.pipeline_handles, pipeline);
+  return &Software_State.pipelines[r_handle_index(pipeline)];
+}
+
+// ------------------------------------------------------------
+// #-- Render API implementation.
+
+fn_internal R_Buffer r_buffer_allocate(U64 capacity, R_Buffer_Mode mode) {
+  R_Buffer         result = r_handle_pool_alloc(&Software_State.buffer_handles);
+  Software_Buffer *buffer = software_buffer(result);
+  buffer->info            = (R_Buffer_Info) { .capacity = capacity, .mode = mode };
+  buffer->data            = software_memory_allocate(capacity);
+  return result;
+}
+
+fn_internal void r_buffer_download(R_Buffer buffer, U64 offset, U64 bytes, void *data) {
+  Software_Buffer *target = software_buffer(buffer);
+  Assert(offset + bytes <= target->info.capacity, "buffer download out of bounds");
+  memory_copy(target->data + offset, data, bytes);
+}
+
+fn_internal R_Buffer_Info r_buffer_info(R_Buffer buffer) {
+  return software_buffer(buffer)->info;
+}
+
+fn_internal void r_buffer_destroy(R_Buffer *buffer) {
+  Software_Buffer *target = software_buffer(*buffer);
+  software_memory_free(target->data, target->info.capacity);
+  zero_fill(target);
+  r_handle_pool_free(&Software_State.buffer_handles, *buffer);
+  *buffer = R_Resource_None;
+}
+
+fn_internal R_Resource software_texture_allocate(R_Texture_Format format, U32 width, U32 height, U32 depth) {
+  R_Resource        result  = r_handle_pool_alloc(&Software_State.texture_handles);
+  Software_Texture *texture = software_texture(result);
+  texture->format           = format;
+  texture->width            = width;
+  texture->height           = height;
+  texture->depth            = depth;
+  texture->bytes            = r_texture_format_bytes(format) * width * height * depth;
+  texture->data             = software_memory_allocate(texture->bytes);
+  return result;
+}
+
+fn_internal void software_texture_download(R_Resource texture, R_Texture_Format download_format, R3I region, void *data) {
+  Software_Texture *target = software_texture(texture);
+  Assert(download_format == target->format, "software textures don't convert on download");
+
+  U64 texel_bytes = r_texture_format_bytes(download_format);
+  U64 row_bytes   = texel_bytes * (U64)(region.x1 - region.x0);
+  U08 *source     = (U08 *)data;
+
+  for (I32 z = region.z0; z < region.z1; ++z) {
+    for (I32 y = region.y0; y < region.y1; ++y) {
+      U64 texel = ((U64)z * target->height + (U64)y) * target->width + (U64)region.x0;
+      memory_copy(target->data + texel * texel_bytes, source, row_bytes);
+      source += row_bytes;
+    }
+  }
+}
+
+fn_internal void software_texture_destroy(R_Resource *texture) {
+  Software_Texture *target = software_texture(*texture);
+  software_memory_free(target->data, target->bytes);
+  zero_fill(target);
+  r_handle_pool_free(&Software_State.texture_handles, *texture);
+  *texture = R_Resource_None;
+}
+
+fn_internal R_Texture_2D r_texture_2D_allocate(R_Texture_Format format, U32 width, U32 height) {
+  return software_texture_allocate(format, width, height, 1);
+}
+
+fn_internal void r_texture_2D_download(R_Texture_2D texture, R_Texture_Format download_format, R2I region, void *data) {
+  software_texture_download(texture, download_format, r3i(region.x0, region.y0, 0, region.x1, region.y1, 1), data);
+}
+
+fn_internal void r_texture_2D_destroy(R_Texture_2D *texture) {
+  software_texture_destroy(texture);
+}
+
+fn_internal R_Texture_3D r_texture_3D_allocate(R_Texture_Format format, U32 width, U32 height, U32 depth) {
+  return software_texture_allocate(format, width, height, depth);
+}
+
+fn_internal void r_texture_3D_download(R_Texture_3D texture, R_Texture_Format download_format, R3I region, void *data) {
+  software_texture_download(texture, download_format, region, data);
+}
+
+fn_internal void r_texture_3D_destroy(R_Texture_3D *texture) {
+  software_texture_destroy(texture);
+}
+
+fn_internal R_Sampler r_sampler_create(R_Sampler_Filter mag_filter, R_Sampler_Filter min_filter) {
+  R_Sampler result = r_handle_pool_alloc(&Software_State.sampler_handles);
+  *software_sampler(result) = (Software_Sampler) { .mag_filter = mag_filter, .min_filter = min_filter };
+  return result;
+}
+
+fn_internal void r_sampler_destroy(R_Sampler *sampler) {
+  zero_fill(software_sampler(*sampler));
+  r_handle_pool_free(&Software_State.sampler_handles, *sampler);
+  *sampler = R_Resource_None;
+}
+
+fn_internal R_Pipeline r_pipeline_create(R_Shader shader, R_Vertex_Format *format, B32 depth_buffer) {
+  R_Pipeline result = r_handle_pool_alloc(&Software_State.pipeline_handles);
+  *software_pipeline(result) = (Software_Pipeline) {
+    .shader       = shader,
+    .format       = *format,
+    .depth_buffer = depth_buffer,
+  };
+
+  return result;
+}
+
+fn_internal void r_pipeline_destroy(R_Pipeline *pipeline) {
+  zero_fill(software_pipeline(*pipeline));
+  r_handle_pool_free(&Software_State.pipeline_handles, *pipeline);
+  *pipeline = R_Resource_None;
+}
+
+// ------------------------------------------------------------
+// #-- Software Target.
+
+fn_internal void software_target_allocate(U32 width, U32 height) {
+  R_Software_Target *target = &Software_State.target;
+  if (target->width == width && target->height == height) {
+    return;
+  }
+
+  software_memory_free((U08 *)target->color, sizeof(U32) * target->width  * target->height);
+  software_memory_free((U08 *)target->depth, sizeof(F32) * target->stride * target->height);
+
+  // NOTE(cmat): Depth rows are padded to 4 pixels so the rasterizer can load them as F32_X04.
+  target->width  = width;
+  target->height = height;
+  target->stride = (U32)address_align(width, 4);
+  target->color  = (U32 *)software_memory_allocate(sizeof(U32) * width * height);
+  target->depth  = (F32 *)software_memory_allocate(sizeof(F32) * target->stride * height);
+}
+
+fn_internal void r_software_target_resize(U32 width, U32 height) {
+  Software_State.target_fixed = 1;
+  software_target_allocate(width, height);
+}
+
+fn_internal R_Software_Target *r_software_target(void) {
+  return &Software_State.target;
+}
+
+// NOTE(cmat): Binary PPM (P6), alpha is dropped.
+fn_internal Str r_software_target_ppm(Arena *arena) {
+  R_Software_Target *target = &Software_State.target;
+
+  enum { Header_Bytes = 32 };
+  U64  pixel_count = (U64)target->width * target->height;
+  U08 *buffer      = arena_push_size(arena, Header_Bytes + 3 * pixel_count, .flags = 0);
+  U64  at          = (U64)stbsp_snprintf((char *)buffer, Header_Bytes, "P6\n%u %u\n255\n", target->width, target->height);
+
+  For_U64(it, pixel_count) {
+    U32 color    = target->color[it];
+    buffer[at++] = (U08)(color >>  0);
+    buffer[at++] = (U08)(color >>  8);
+    buffer[at++] = (U08)(color >> 16);
+  }
+
+  return str(at, buffer);
+}
+
+// ------------------------------------------------------------
+// #-- Software Initialization.
+
+fn_internal void r_init(PL_Render_Context *render_context) {
+  Software_State.initialized = 1;
+  arena_init(&Software_State.arena);
+  arena_init(&Software_State.frame_arena);
+
+  r_handle_pool_init(&Software_State.buffer_handles,   &Software_State.arena, Software_Max_Buffers);
+  r_handle_pool_init(&Software_State.texture_handles,  &Software_State.arena, Software_Max_Textures);
+  r_handle_pool_init(&Software_State.sampler_handles,  &Software_State.arena, Software_Max_Samplers);
+  r_handle_pool_init(&Software_State.pipeline_handles, &Software_State.arena, Software_Max_Pipelines);
+
+  R_Shader_Flat_2D = Software_Shader_Flat_2D;
+  R_Shader_Flat_3D = Software_Shader_Flat_3D;
+  R_Shader_Grid_3D = Software_Shader_Grid_3D;
+  R_Shader_DVR_3D  = Software_Shader_DVR_3D;
+  R_Shader_SLI_3D  = Software_Shader_SLI_3D;
+  R_Shader_Quad_2D = Software_Shader_Quad_2D;
+
+  U32 white_texture_data[] = {
+    0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF,
+  };
+
+  R_Texture_2D_White = r_texture_2D_allocate(R_Texture_Format_RGBA_U08_Normalized, 2, 2);
+  r_texture_2D_download(R_Texture_2D_White, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 2, 2), white_texture_data);
+
+  F32 white_texture_volume_data[] = {
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+
+    1.0f, 1.0f,
+    1.0f, 1.0f,
+  };
+
+  R_Texture_3D_White = r_texture_3D_allocate(R_Texture_Format_F32, 2, 2, 2);
+  r_texture_3D_download(R_Texture_3D_White, R_Texture_Format_F32, r3i(0, 0, 0, 2, 2, 2), white_texture_volume_data);
+
+  R_Sampler_Linear_Clamp  = r_sampler_create(R_Sampler_Filter_Linear,  R_Sampler_Filter_Linear);
+  R_Sampler_Nearest_Clamp = r_sampler_create(R_Sampler_Filter_Nearest, R_Sampler_Filter_Nearest);
+}
+
+// ------------------------------------------------------------
+// #-- Geometry Setup.
+
+fn_internal V4F software_texel_fetch(Software_Texture *texture, I32 x, I32 y) {
+  U64 texel = (U64)y * texture->width + (U64)x;
+  V4F result = v4f(0, 0, 0, 1);
+
+  switch (texture->format) {
+    case R_Texture_Format_RGBA_U08_Normalized: {
+      U08 *rgba = texture->data + 4 * texel;
+      result = v4f(rgba[0] / 255.f, rgba[1] / 255.f, rgba[2] / 255.f, rgba[3] / 255.f);
+    } break;
+
+    case R_Texture_Format_RGBA_I08_Normalized: {
+      I08 *rgba = (I08 *)texture->data + 4 * texel;
+      result = v4f(f32_max(rgba[0] / 127.f, -1.f), f32_max(rgba[1] / 127.f, -1.f), f32_max(rgba[2] / 127.f, -1.f), f32_max(rgba[3] / 127.f, -1.f));
+    } break;
+
+    case R_Texture_Format_R_U08_Normalized: { result.r = texture->data[texel] / 255.f;                      } break;
+    case R_Texture_Format_R_I08_Normalized: { result.r = f32_max(((I08 *)texture->data)[texel] / 127.f, -1.f); } break;
+    case R_Texture_Format_F32:              { result.r = ((F32 *)texture->data)[texel];                     } break;
+    case R_Texture_Format_F16:              { result.r = f32_from_f16(((F16 *)texture->data)[texel]);       } break;
+    Invalid_Default;
+  }
+
+  return result;
+}
+
+// NOTE(cmat): Clamp-to-edge addressing, linear taps sit on texel centers (as textureSample).
+fn_internal V4F software_texture_sample(Software_Texture *texture, R_Sampler_Filter filter, V2F uv) {
+  I32 w = (I32)texture->width;
+  I32 h = (I32)texture->height;
+
+  if (filter == R_Sampler_Filter_Nearest) {
+    I32 x = i32_clamp((I32)f32_floor(uv.x * w), 0, w - 1);
+    I32 y = i32_clamp((I32)f32_floor(uv.y * h), 0, h - 1);
+    return software_texel_fetch(texture, x, y);
+  }
+
+  F32 u  = uv.x * w - .5f;
+  F32 v  = uv.y * h - .5f;
+  F32 fu = f32_floor(u);
+  F32 fv = f32_floor(v);
+  F32 tu = u - fu;
+  F32 tv = v - fv;
+
+  I32 x0 = i32_clamp((I32)fu,     0, w - 1);
+  I32 x1 = i32_clamp((I32)fu + 1, 0, w - 1);
+  I32 y0 = i32_clamp((I32)fv,     0, h - 1);
+  I32 y1 = i32_clamp((I32)fv + 1, 0, h - 1);
+
+  V4F top    = v4f_lerp(tu, software_texel_fetch(texture, x0, y0), software_texel_fetch(texture, x1, y0));
+  V4F bottom = v4f_lerp(tu, software_texel_fetch(texture, x0, y1), software_texel_fetch(texture, x1, y1));
+  return v4f_lerp(tv, top, bottom);
+}
+
+force_inline fn_internal U08 *software_attribute(R_Vertex_Format *format, U32 index, U08 *vertex, U08 *instance) {
+  R_Vertex_Attribute *attribute = &format->entry_array[index];
+  return (attribute->step == R_Vertex_Step_Instance ? instance : vertex) + attribute->offset;
+}
+
+// NOTE(cmat): Flat shaders read X, U, C. The quad shader reads the unit corner K, then places it
+// - in the instance's rect X and UV rect U.
+fn_internal Software_Vertex software_vertex_fetch(Software_Pipeline *pipeline, U08 *vertex, U08 *instance, M4F *clip_from_vertex) {
+  R_Vertex_Format *format   = &pipeline->format;
+  V4F              position = v4f(0.f, 0.f, 0.f, 1.f);
+  V2F              uv       = v2f(0.f, 0.f);
+  U32              c        = 0;
+
+  if (pipeline->shader == Software_Shader_Quad_2D) {
+    F32 *k = (F32 *)software_attribute(format, 0, vertex, instance);
+    R2F *x = (R2F *)software_attribute(format, 1, vertex, instance);
+    R2F *u = (R2F *)software_attribute(format, 2, vertex, instance);
+    c      = *(U32 *)software_attribute(format, 3, vertex, instance);
+
+    position.x = f32_lerp(k[0], x->x0, x->x1);
+    position.y = f32_lerp(k[1], x->y0, x->y1);
+    uv         = v2f(f32_lerp(k[0], u->x0, u->x1), f32_lerp(k[1], u->y0, u->y1));
+  } else {
+    F32 *x = (F32 *)software_attribute(format, 0, vertex, instance);
+    F32 *u = (F32 *)software_attribute(format, 1, vertex, instance);
+    c      = *(U32 *)software_attribute(format, 2, vertex, instance);
+
+    position.x = x[0];
+    position.y = x[1];
+    if (format->entry_array[0].format == R_Vertex_Attribute_Format_V3_F32) {
+      position.z = x[2];
+    }
+
+    uv = v2f(u[0], u[1]);
+  }
+
+  Software_Vertex result = {
+    .clip  = m4f_mul_v4f(position, *clip_from_vertex),
+    .uv    = uv,
+    .color = v4f(((c >> 0) & 0xFF) / 255.f, ((c >> 8) & 0xFF) / 255.f, ((c >> 16) & 0xFF) / 255.f, ((c >> 24) & 0xFF) / 255.f),
+  };
+
+  return result;
+}
+
+fn_internal F32 software_clip_distance(Software_Vertex *vertex, U32 plane) {
+  F32 result = 0;
+  switch (plane) {
+    case 0: { result = vertex->clip.w - 1e-5f;          } break;
+    case 1: { result = vertex->clip.z;                  } break;
+    case 2: { result = vertex->clip.w - vertex->clip.z; } break;
+  }
+
+  return result;
+}
+
+fn_internal Software_Vertex software_vertex_lerp(F32 t, Software_Vertex *a, Software_Vertex *b) {
+  Software_Vertex result = {
+    .clip  = v4f_lerp(t, a->clip,  b->clip),
+    .uv    = v2f_lerp(t, a->uv,    b->uv),
+    .color = v4f_lerp(t, a->color, b->color),
+  };
+
+  return result;
+}
+
+// NOTE(cmat): Sutherland-Hodgman against w > 0 and the WebGPU depth range 0 <= z <= w.
+// - x / y are left to the scissor, pixel space floats have plenty of guard band.
+fn_internal U32 software_clip_polygon(Software_Vertex *polygon, U32 count) {
+  Software_Vertex clipped[8] = { };
+  For_U32 (plane, 3) {
+    U32 clipped_count = 0;
+    For_U32 (it, count) {
+      Software_Vertex *a  = polygon + it;
+      Software_Vertex *b  = polygon + (it + 1) % count;
+      F32              da = software_clip_distance(a, plane);
+      F32              db = software_clip_distance(b, plane);
+
+      if (da >= 0) {
+        clipped[clipped_count++] = *a;
+      }
+
+      if ((da >= 0) != (db >= 0)) {
+        clipped[clipped_count++] = software_vertex_lerp(da / (da - db), a, b);
+      }
+    }
+
+    memory_copy(polygon, clipped, clipped_count * sizeof(Software_Vertex));
+    count = clipped_count;
+  }
+
+  return count;
+}
+
+force_inline fn_internal B32 software_vertex_less(F32 ax, F32 ay, F32 bx, F32 by) {
+  return ay < by || (ay == by && ax < bx);
+}
+
+typedef struct Software_Viewport {
+  F32 x, y, w, h;
+  R2I scissor;
+} Software_Viewport;
+
+fn_internal void software_triangle_setup(Arena *arena, Software_Triangle_Array *triangles, Software_Vertex *vertices, Software_Viewport *viewport, U32 state) {
+  F32 x[3], y[3];
+  For_U32 (it, 3) {
+    F32 inverse_w = 1.f / vertices[it].clip.w;
+    F32 ndc_x     = vertices[it].clip.x * inverse_w;
+    F32 ndc_y     = vertices[it].clip.y * inverse_w;
+
+    x[it] = f32_floor((viewport->x + (ndc_x * .5f + .5f) * viewport->w) * Software_Subpixel + .5f) / Software_Subpixel;
+    y[it] = f32_floor((viewport->y + (.5f - ndc_y * .5f) * viewport->h) * Software_Subpixel + .5f) / Software_Subpixel;
+  }
+
+  // NOTE(cmat): Counter-clockwise in NDC (y up) is front facing, that's clockwise once y
+  // - points down. Back faces are culled, front faces are flipped so the area is positive.
+  F32 area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+  if (area >= 0) {
+    return;
+  }
+
+  U32 order[3] = { 0, 2, 1 };
+  area = -area;
+
+  Software_Triangle triangle = { .inverse_area = 1.f / area, .state = state };
+  For_U32 (it, 3) {
+    Software_Vertex *vertex = &vertices[order[it]];
+    triangle.z[it]          = vertex->clip.z / vertex->clip.w;
+    triangle.inverse_w[it]  = 1.f / vertex->clip.w;
+    triangle.uv[it]         = vertex->uv;
+    triangle.color[it]      = vertex->color;
+  }
+
+  F32 px[3] = { x[order[0]], x[order[1]], x[order[2]] };
+  F32 py[3] = { y[order[0]], y[order[1]], y[order[2]] };
+
+  // NOTE(cmat): Edge i is opposite vertex i, from a = v[i + 1] to b = v[i + 2].
+  For_U32 (it, 3) {
+    U32 a = (it + 1) % 3;
+    U32 b = (it + 2) % 3;
+
+    F32 dx = px[b] - px[a];
+    F32 dy = py[b] - py[a];
+    triangle.edge_top_left[it] = dy < 0 || (dy == 0 && dx > 0);
+
+    if (software_vertex_less(px[a], py[a], px[b], py[b])) {
+      triangle.edge_x[it]    = px[a];
+      triangle.edge_y[it]    = py[a];
+      triangle.edge_dx[it]   = dx;
+      triangle.edge_dy[it]   = dy;
+      triangle.edge_sign[it] = 1.f;
+    } else {
+      triangle.edge_x[it]    = px[b];
+      triangle.edge_y[it]    = py[b];
+      triangle.edge_dx[it]   = -dx;
+      triangle.edge_dy[it]   = -dy;
+      triangle.edge_sign[it] = -1.f;
+    }
+  }
+
+  F32 min_x = f32_min(px[0], f32_min(px[1], px[2]));
+  F32 min_y = f32_min(py[0], f32_min(py[1], py[2]));
+  F32 max_x = f32_max(px[0], f32_max(px[1], px[2]));
+  F32 max_y = f32_max(py[0], f32_max(py[1], py[2]));
+
+  triangle.x0 = i32_max((I32)f32_max(f32_floor(min_x), -1.f), viewport->scissor.x0);
+  triangle.y0 = i32_max((I32)f32_max(f32_floor(min_y), -1.f), viewport->scissor.y0);
+  triangle.x1 = i32_min((I32)f32_min(f32_ceil(max_x) + 1.f, 65536.f), viewport->scissor.x1);
+  triangle.y1 = i32_min((I32)f32_min(f32_ceil(max_y) + 1.f, 65536.f), viewport->scissor.y1);
+
+  if (triangle.x0 >= triangle.x1 || triangle.y0 >= triangle.y1) {
+    return;
+  }
+
+  if (triangles->len == triangles->cap) {
+    Software_Triangle *grown = arena_push_count(arena, Software_Triangle, 2 * triangles->cap, .flags = 0);
+    memory_copy(grown, triangles->dat, triangles->len * sizeof(Software_Triangle));
+    triangles->dat = grown;
+    triangles->cap = 2 * triangles->cap;
+  }
+
+  array_push(triangles, triangle);
+}
+
+// ------------------------------------------------------------
+// #-- Tile Rasterization.
+
+typedef struct Software_Frame {
+  Software_Triangle   *triangles;
+  Software_Draw_State *states;
+  U32                 *bin_first;
+  U32                 *bin_triangles;
+  U32                  tiles_x;
+  U32                  tiles_y;
+} Software_Frame;
+
+force_inline fn_internal U32 software_color_pack(V4F color) {
+  U32 r = (U32)(f32_clamp(color.r, 0.f, 1.f) * 255.f + .5f);
+  U32 g = (U32)(f32_clamp(color.g, 0.f, 1.f) * 255.f + .5f);
+  U32 b = (U32)(f32_clamp(color.b, 0.f, 1.f) * 255.f + .5f);
+  U32 a = (U32)(f32_clamp(color.a, 0.f, 1.f) * 255.f + .5f);
+  return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+force_inline fn_internal V4F software_color_unpack(U32 color) {
+  return v4f(((color >> 0) & 0xFF) / 255.f, ((color >> 8) & 0xFF) / 255.f, ((color >> 16) & 0xFF) / 255.f, ((color >> 24) & 0xFF) / 255.f);
+}
+
+fn_internal void software_triangle_rasterize(R_Software_Target *target, Software_Triangle *triangle, Software_Draw_State *state, I32 x0, I32 y0, I32 x1, I32 y1) {
+  F32_X04 lane_offset = { .data = { .5f, 1.5f, 2.5f, 3.5f } };
+  F32_X04 zero        = f32_x04_load_f32(0.f);
+
+  for (I32 y = y0; y < y1; ++y) {
+    F32_X04 edge_row[3];
+    For_U32 (edge, 3) {
+      F32 row = triangle->edge_dx[edge] * ((F32)y + .5f - triangle->edge_y[edge]);
+      edge_row[edge] = f32_x04_load_f32(row);
+    }
+
+    for (I32 x = x0 & ~3; x < x1; x += 4) {
+      F32_X04 pixel_x = f32_x04_add(f32_x04_load_f32((F32)x), lane_offset);
+
+      // NOTE(cmat): E = sign * (dx * (py - ey) - dy * (px - ex)), evaluated the same way for
+      // - every pixel, independent of which tile it falls in.
+      F32_X04  edge_value[3];
+      Mask_X04 inside = { };
+      For_U32 (edge, 3) {
+        F32_X04 across = f32_x04_mul(f32_x04_load_f32(triangle->edge_dy[edge]), f32_x04_sub(pixel_x, f32_x04_load_f32(triangle->edge_x[edge])));
+        edge_value[edge] = f32_x04_mul(f32_x04_sub(edge_row[edge], across), f32_x04_load_f32(triangle->edge_sign[edge]));
+
+        Mask_X04 edge_inside = triangle->edge_top_left[edge] ? f32_x04_mask_greater_than_or_equal(edge_value[edge], zero)
+                                                             : f32_x04_mask_greater_than(edge_value[edge], zero);
+        inside = edge ? mask_x04_and(inside, edge_inside) : edge_inside;
+      }
+
+      U32 lanes = mask_x04_bits(inside);
+      For_U32 (lane, 4) {
+        I32 lane_x = x + (I32)lane;
+        if (lane_x < x0 || lane_x >= x1) lanes &= ~(1u << lane);
+      }
+
+      if (!lanes) {
+        continue;
+      }
+
+      F32_X04 depth = f32_x04_mul(f32_x04_add(f32_x04_add(
+                        f32_x04_mul(edge_value[0], f32_x04_load_f32(triangle->z[0])),
+                        f32_x04_mul(edge_value[1], f32_x04_load_f32(triangle->z[1]))),
+                        f32_x04_mul(edge_value[2], f32_x04_load_f32(triangle->z[2]))),
+                        f32_x04_load_f32(triangle->inverse_area));
+
+      F32 *depth_row = target->depth + (U64)y * target->stride + (U64)x;
+      if (state->depth_buffer) {
+        lanes &= mask_x04_bits(f32_x04_mask_greater_than(f32_x04_load(depth_row), depth));
+      }
+
+      U32 *color_row = target->color + (U64)y * target->width;
+      For_U32 (lane, 4) {
+        if (!(lanes & (1u << lane))) continue;
+
+        // NOTE(cmat): Perspective correct attributes, weights are edge values over w.
+        F32 weight[3] = {
+          edge_value[0].data[lane] * triangle->inverse_w[0],
+          edge_value[1].data[lane] * triangle->inverse_w[1],
+          edge_value[2].data[lane] * triangle->inverse_w[2],
+        };
+
+        F32 normalize = 1.f / (weight[0] + weight[1] + weight[2]);
+        weight[0] *= normalize;
+        weight[1] *= normalize;
+        weight[2] *= normalize;
+
+        V2F uv    = v2f_add(v2f_add(v2f_mul(weight[0], triangle->uv[0]),    v2f_mul(weight[1], triangle->uv[1])),    v2f_mul(weight[2], triangle->uv[2]));
+        V4F color = v4f_add(v4f_add(v4f_mul(weight[0], triangle->color[0]), v4f_mul(weight[1], triangle->color[1])), v4f_mul(weight[2], triangle->color[2]));
+
+        if (state->texture) {
+          V4F texel = software_texture_sample(state->texture, state->filter, uv);
+          color = v4f(texel.r * color.r, texel.g * color.g, texel.b * color.b, texel.a * color.a);
+        }
+
+        // NOTE(cmat): Premultiplied alpha, src + dst * (1 - src.a).
+        I32 pixel_x     = x + (I32)lane;
+        V4F destination = software_color_unpack(color_row[pixel_x]);
+        color_row[pixel_x] = software_color_pack(v4f_add(color, v4f_mul(1.f - color.a, destination)));
+
+        if (state->depth_buffer) {
+          depth_row[lane] = depth.data[lane];
+        }
+      }
+    }
+  }
+}
+
+fn_internal void software_tile_proc(void *user_data, Range_U64 range) {
+  Software_Frame    *frame  = (Software_Frame *)user_data;
+  R_Software_Target *target = &Software_State.target;
+
+  For_U64_Range (tile, range.min, range.max) {
+    I32 tile_x0 = (I32)(tile % frame->tiles_x) * Software_Tile_Size;
+    I32 tile_y0 = (I32)(tile / frame->tiles_x) * Software_Tile_Size;
+    I32 tile_x1 = i32_min(tile_x0 + Software_Tile_Size, (I32)target->width);
+    I32 tile_y1 = i32_min(tile_y0 + Software_Tile_Size, (I32)target->height);
+
+    // NOTE(cmat): Clear, then draw the binned triangles in submission order.
+    for (I32 y = tile_y0; y < tile_y1; ++y) {
+      U32 *color_row = target->color + (U64)y * target->width;
+      F32 *depth_row = target->depth + (U64)y * target->stride;
+      for (I32 x = tile_x0; x < tile_x1; ++x) {
+        color_row[x] = 0xFF000000;
+        depth_row[x] = 1.f;
+      }
+    }
+
+    for (U32 it = frame->bin_first[tile]; it < frame->bin_first[tile + 1]; ++it) {
+      Software_Triangle *triangle = frame->triangles + frame->bin_triangles[it];
+      I32 x0 = i32_max(triangle->x0, tile_x0);
+      I32 y0 = i32_max(triangle->y0, tile_y0);
+      I32 x1 = i32_min(triangle->x1, tile_x1);
+      I32 y1 = i32_min(triangle->y1, tile_y1);
+
+      if (x0 < x1 && y0 < y1) {
+        software_triangle_rasterize(target, triangle, frame->states + triangle->state, x0, y0, x1, y1);
+      }
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// #-- Software Command Submission.
+
+// NOTE(cmat): Draws are transformed, clipped and set up on the calling thread, triangles are
+// - binned into Software_Tile_Size tiles, then tiles are rasterized in parallel. Each tile
+// - owns its pixels, so there is no synchronization past the parallel_for.
+fn_internal void r_frame_flush(void) {
+  Arena *arena = &Software_State.frame_arena;
+  arena_clear(arena);
+  r_uniform_flush();
+  r_upload_flush();
+
+  if (!Software_State.target_fixed) {
+    V2F resolution = pl_display()->resolution;
+    software_target_allocate((U32)f32_max(resolution.x, 1.f), (U32)f32_max(resolution.y, 1.f));
+  }
+
+  R_Software_Target *target = &Software_State.target;
+
+  U32              draw_count = 0;
+  R_Command_Draw **draws      = r_command_sort(arena, &draw_count);
+
+  Software_Triangle_Array triangles = { };
+  array_reserve(arena, &triangles, 1024);
+
+  Software_Draw_State *states = arena_push_count(arena, Software_Draw_State, u32_max(draw_count, 1));
+  U32                  state  = 0;
+
+  For_U32 (draw_it, draw_count) {
+    R_Command_Draw    *draw     = draws[draw_it];
+    Software_Pipeline *pipeline = software_pipeline(draw->pipeline);
+    if (pipeline->shader != Software_Shader_Flat_2D && pipeline->shader != Software_Shader_Flat_3D && pipeline->shader != Software_Shader_Quad_2D) {
+      continue;
+    }
+
+    Software_Sampler *sampler = software_sampler(draw->sampler);
+    states[state] = (Software_Draw_State) {
+      .texture      = draw->texture ? software_texture(draw->texture) : 0,
+      .filter       = sampler->mag_filter,
+      .depth_buffer = pipeline->depth_buffer,
+    };
+
+    // NOTE(cmat): Same viewport / scissor clamping as the WebGPU backend, regions are y up.
+    I32 height = (I32)target->height;
+    Software_Viewport viewport = { };
+    viewport.x = (F32)i32_clamp(draw->draw_region.x0,          0, (I32)target->width);
+    viewport.y = (F32)i32_clamp(height - draw->draw_region.y1, 0, height);
+    viewport.w = (F32)i32_clamp(draw->draw_region.x1 - draw->draw_region.x0, 0, (I32)target->width - (I32)viewport.x);
+    viewport.h = (F32)i32_clamp(draw->draw_region.y1 - draw->draw_region.y0, 0, height - (I32)viewport.y);
+
+    viewport.scissor.x0 = i32_clamp(draw->clip_region.x0,          (I32)viewport.x, (I32)(viewport.x + viewport.w));
+    viewport.scissor.y0 = i32_clamp(height - draw->clip_region.y1, (I32)viewport.y, (I32)(viewport.y + viewport.h));
+    viewport.scissor.x1 = i32_clamp(draw->clip_region.x1,          viewport.scissor.x0, (I32)(viewport.x + viewport.w));
+    viewport.scissor.y1 = i32_clamp(height - draw->clip_region.y0, viewport.scissor.y0, (I32)(viewport.y + viewport.h));
+
+    M4F  clip_from_vertex = { };
+    U08 *vertex_data      = software_buffer(draw->vertex_buffer)->data;
+    U32 *index_data       = (U32 *)software_buffer(draw->index_buffer)->data;
+    U08 *instance_data    = draw->instance_buffer ? software_buffer(draw->instance_buffer)->data : 0;
+    memory_copy(&clip_from_vertex, software_buffer(draw->constant_buffer)->data + draw->constant_offset, sizeof(M4F));
+
+    // NOTE(cmat): Instance major, same primitive order as the GPU backends.
+    For_U32 (instance_it, u32_max(draw->instance_count, 1)) {
+      U08 *instance = 0;
+      if (instance_data) {
+        instance = instance_data + (U64)(draw->instance_offset + instance_it) * pipeline->format.instance_stride;
+      }
+
+      for (U32 index = 0; index + 3 <= draw->draw_index_count; index += 3) {
+        Software_Vertex polygon[8] = { };
+        For_U32 (corner, 3) {
+          U32 vertex = index_data[draw->draw_index_offset + index + corner];
+          polygon[corner] = software_vertex_fetch(pipeline, vertex_data + (U64)vertex * pipeline->format.stride, instance, &clip_from_vertex);
+        }
+
+        U32 count = software_clip_polygon(polygon, 3);
+        for (U32 fan = 1; fan + 1 < count; ++fan) {
+          Software_Vertex corners[3] = { polygon[0], polygon[fan], polygon[fan + 1] };
+          software_triangle_setup(arena, &triangles, corners, &viewport, state);
+        }
+      }
+    }
+
+    state += 1;
+  }
+
+  // NOTE(cmat): Bin triangles by tile (counting sort, keeps submission order within a tile).
+  Software_Frame frame = {
+    .triangles = triangles.dat,
+    .states    = states,
+    .tiles_x   = (target->width  + Software_Tile_Size - 1) / Software_Tile_Size,
+    .tiles_y   = (target->height + Software_Tile_Size - 1) / Software_Tile_Size,
+  };
+
+  U32 tile_count  = frame.tiles_x * frame.tiles_y;
+  frame.bin_first = arena_push_count(arena, U32, tile_count + 1);
+
+  For_U64 (it, triangles.len) {
+    Software_Triangle *triangle = triangles.dat + it;
+    for (I32 ty = triangle->y0 / Software_Tile_Size; ty <= (triangle->y1 - 1) / Software_Tile_Size; ++ty) {
+      for (I32 tx = triangle->x0 / Software_Tile_Size; tx <= (triangle->x1 - 1) / Software_Tile_Size; ++tx) {
+        frame.bin_first[ty * frame.tiles_x + tx + 1] += 1;
+      }
+    }
+  }
+
+  For_U32 (it, tile_count) {
+    frame.bin_first[it + 1] += frame.bin_first[it];
+  }
+
+  U32 *bin_at         = arena_push_count(arena, U32, tile_count, .flags = 0);
+  frame.bin_triangles = arena_push_count(arena, U32, u32_max(frame.bin_first[tile_count], 1), .flags = 0);
+  memory_copy(bin_at, frame.bin_first, tile_count * sizeof(U32));
+
+  For_U64 (it, triangles.len) {
+    Software_Triangle *triangle = triangles.dat + it;
+    for (I32 ty = triangle->y0 / Software_Tile_Size; ty <= (triangle->y1 - 1) / Software_Tile_Size; ++ty) {
+      for (I32 tx = triangle->x0 / Software_Tile_Size; tx <= (triangle->x1 - 1) / Software_Tile_Size; ++tx) {
+        frame.bin_triangles[bin_at[ty * frame.tiles_x + tx]++] = (U32)it;
+      }
+    }
+  }
+
+  parallel_for(range_u64(0, tile_count), 1, software_tile_proc, &frame);
+  r_command_reset();
+}
@@ -0,0 +1,477 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+// NOTE(cmat): Render tests run against the headless backends (BUILD_RENDER_RECORD,
+// - BUILD_RENDER_SOFTWARE), after r_init. The recording tests read the capture back, so they
+// - need an empty R_Capture_Path.
+
+// ------------------------------------------------------------
+// #-- Resource Handles
+
+fn_internal void test_render_handles(void) {
+  log_zone_start("handle pool testing");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    R_Handle_Pool pool = { };
+    r_handle_pool_init(&pool, scratch.arena, 8);
+
+    R_Resource a = r_handle_pool_alloc(&pool);
+    R_Resource b = r_handle_pool_alloc(&pool);
+    Assert(r_handle_index(a) == 1 && r_handle_index(b) == 2,           "slot 0 is reserved");
+    Assert(!r_handle_generation(a) && r_handle_pool_valid(&pool, a),   "fresh handles");
+    Assert(!r_handle_pool_valid(&pool, R_Resource_None),               "none is invalid");
+    Assert(!r_handle_pool_valid(&pool, r_handle_make(5, 0)),           "unallocated slot is invalid");
+
+    // NOTE(cmat): Freed slots are reused under the next generation, the old handle goes stale.
+    r_handle_pool_free(&pool, b);
+    R_Resource c = r_handle_pool_alloc(&pool);
+    Assert(r_handle_index(c) == r_handle_index(b) && r_handle_generation(c) == 1, "slot reuse bumps the generation");
+    Assert(!r_handle_pool_valid(&pool, b) && r_handle_pool_valid(&pool, c),       "stale handle rejected");
+
+    // NOTE(cmat): Stale, double and none frees leave the pool alone.
+    r_handle_pool_free(&pool, b);
+    r_handle_pool_free(&pool, R_Resource_None);
+    Assert(pool.free_count == 0 && r_handle_pool_valid(&pool, c), "stale free is ignored");
+
+    r_handle_pool_free(&pool, c);
+    r_handle_pool_free(&pool, c);
+    Assert(pool.free_count == 1, "double free is ignored");
+
+    R_Resource d = r_handle_pool_alloc(&pool);
+    R_Resource e = r_handle_pool_alloc(&pool);
+    Assert(r_handle_index(d) == r_handle_index(c) && r_handle_index(e) == 3, "double freed slot handed out once");
+
+    // NOTE(cmat): Generations wrap after R_Handle_Generation_Mask + 1 frees of a slot.
+    R_Resource first = r_handle_pool_alloc(&pool);
+    R_Resource last  = first;
+    For_U32(it, R_Handle_Generation_Mask + 1) {
+      r_handle_pool_free(&pool, last);
+      last = r_handle_pool_alloc(&pool);
+      Assert(r_handle_index(last) == r_handle_index(first), "slot reused");
+    }
+
+    Assert(last == first && r_handle_generation(last) == 0, "generation wraps");
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+// ------------------------------------------------------------
+// #-- Software Rasterizer
+
+#if BUILD_RENDER_SOFTWARE
+
+fn_internal R_Buffer test_render_buffer(U64 bytes, void *data, R_Buffer_Mode mode) {
+  R_Buffer result = r_buffer_allocate(bytes, mode);
+  r_buffer_download(result, 0, bytes, data);
+  return result;
+}
+
+// NOTE(cmat): A flat rect, then an instanced quad over part of it, both opaque and pixel
+// - aligned in a 64x64 target, so every pixel has exactly one expected color.
+fn_internal void test_render_software(void) {
+  log_zone_start("software rasterizer testing");
+
+  enum { Width = 64, Height = 64 };
+  U32 black = 0xFF000000;
+  U32 red   = 0xFF0000FF;
+  U32 green = 0xFF00FF00;
+
+  r_software_target_resize(Width, Height);
+  R2I full = r2i(0, 0, Width, Height);
+
+  R_Vertex_XUC_2D flat_vertices[] = {
+    { .X = v2f(-.5f, -.5f), .U = v2f(0, 0), .C = red },
+    { .X = v2f(+.5f, -.5f), .U = v2f(1, 0), .C = red },
+    { .X = v2f(+.5f, +.5f), .U = v2f(1, 1), .C = red },
+    { .X = v2f(-.5f, +.5f), .U = v2f(0, 1), .C = red },
+  };
+
+  R_Vertex_K_2D     quad_vertices[] = { { .K = v2f(0, 0) }, { .K = v2f(1, 0) }, { .K = v2f(1, 1) }, { .K = v2f(0, 1) } };
+  R_Instance_XUC_2D quad_instance   = { .X = r2f(-1.f, -1.f, 0.f, 0.f), .U = r2f(0, 0, 1, 1), .C = green };
+  U32               quad_indices[]  = { 0, 1, 2, 0, 2, 3 };
+
+  R_Buffer vertex_buffer   = test_render_buffer(sizeof(flat_vertices), flat_vertices,  R_Buffer_Mode_Static);
+  R_Buffer index_buffer    = test_render_buffer(sizeof(quad_indices),  quad_indices,   R_Buffer_Mode_Static);
+  R_Buffer corner_buffer   = test_render_buffer(sizeof(quad_vertices), quad_vertices,  R_Buffer_Mode_Static);
+  R_Buffer instance_buffer = test_render_buffer(sizeof(quad_instance), &quad_instance, R_Buffer_Mode_Static);
+
+  R_Pipeline flat_pipeline = r_pipeline_create(R_Shader_Flat_2D, &R_Vertex_Format_XUC_2D,  0);
+  R_Pipeline quad_pipeline = r_pipeline_create(R_Shader_Quad_2D, &R_Vertex_Format_Quad_2D, 0);
+
+  R_Constant_Buffer_Viewport_2D viewport = { .NDC_From_Screen = m4f_id() };
+  R_Uniform_Slice               slice    = r_uniform_push_type(&viewport);
+
+  R_Command_Draw flat = {
+    .constant_buffer  = slice.buffer,
+    .constant_offset  = slice.offset,
+    .vertex_buffer    = vertex_buffer,
+    .index_buffer     = index_buffer,
+    .pipeline         = flat_pipeline,
+    .texture          = R_Texture_2D_White,
+    .sampler          = R_Sampler_Nearest_Clamp,
+    .draw_index_count = 6,
+    .draw_region      = full,
+    .clip_region      = full,
+  };
+
+  R_Command_Draw quad   = flat;
+  quad.vertex_buffer    = corner_buffer;
+  quad.instance_buffer  = instance_buffer;
+  quad.instance_count   = 1;
+  quad.pipeline         = quad_pipeline;
+
+  r_command_push_draw(&flat);
+  r_command_push_draw(&quad);
+  r_frame_flush();
+
+  // NOTE(cmat): Rows are top-down, NDC y is up.
+  R_Software_Target *target     = r_software_target();
+  U32                mismatches = 0;
+  For_U32(y, Height) {
+    For_U32(x, Width) {
+      U32 expected = black;
+      if (x >= 16 && x < 48 && y >= 16 && y < 48) expected = red;
+      if (x < 32 && y >= 32)                      expected = green;
+
+      mismatches += target->color[y * target->width + x] != expected;
+    }
+  }
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    Str ppm = r_software_target_ppm(scratch.arena);
+    Assert(ppm.len == 13 + 3 * Width * Height && str_starts_with(ppm, str_lit("P6\n64 64\n255\n")), "ppm header");
+
+    if (mismatches) {
+      CO_File file = co_file_open(str_lit("test_render_software.ppm"), CO_File_Access_Flag_Write | CO_File_Access_Flag_Create | CO_File_Access_Flag_Truncate);
+      co_file_write(&file, 0, ppm.len, ppm.txt);
+      co_file_close(&file);
+      log_warning("%u pixels differ, frame written to test_render_software.ppm", mismatches);
+    }
+  }
+
+  Assert(!mismatches, "software rasterized frame");
+
+  r_pipeline_destroy(&quad_pipeline);
+  r_pipeline_destroy(&flat_pipeline);
+  r_buffer_destroy(&instance_buffer);
+  r_buffer_destroy(&corner_buffer);
+  r_buffer_destroy(&index_buffer);
+  r_buffer_destroy(&vertex_buffer);
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+#endif
+
+// ------------------------------------------------------------
+// #-- Recording Backend
+
+#if BUILD_RENDER_RECORD
+
+// NOTE(cmat): Draws recorded since capture_at, in the order the frame flushed them.
+fn_internal R_Command_Draw *test_render_recorded_draws(Arena *arena, U64 capture_at, U32 *draw_count) {
+  Str             capture = r_record_capture(arena);
+  R_Command_Draw *result  = arena_push_count(arena, R_Command_Draw, capture.len / sizeof(R_Command_Draw) + 1);
+  *draw_count             = 0;
+
+  for (U64 at = capture_at; at < capture.len; ) {
+    R_Capture_Record *record = (R_Capture_Record *)(capture.txt + at);
+    if (record->op == R_Capture_Op_Draw) {
+      memory_copy(&result[(*draw_count)++], record + 1, sizeof(R_Command_Draw));
+    }
+
+    at += sizeof(R_Capture_Record) + record->bytes;
+  }
+
+  return result;
+}
+
+fn_internal U32 test_render_recorded_op_count(Arena *arena, U64 capture_at, R_Capture_Op op) {
+  Str capture = r_record_capture(arena);
+  U32 result  = 0;
+
+  for (U64 at = capture_at; at < capture.len; ) {
+    R_Capture_Record *record = (R_Capture_Record *)(capture.txt + at);
+    result += record->op == op;
+    at     += sizeof(R_Capture_Record) + record->bytes;
+  }
+
+  return result;
+}
+
+// NOTE(cmat): Mirrors draw_viewport inside a UI panel: panel background, viewport background,
+// - grid, volume, then chrome drawn over the viewport. All of it overlaps, so it has to flush as
+// - submitted. Draws side by side are grouped by state.
+fn_internal void test_render_pass_order(void) {
+  log_zone_start("pass order testing");
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    R_Pipeline flat   = r_pipeline_create(R_Shader_Flat_2D, &R_Vertex_Format_XUC_2D, 0);
+    R_Pipeline grid   = r_pipeline_create(R_Shader_Grid_3D, &R_Vertex_Format_XUC_3D, 0);
+    R_Pipeline volume = r_pipeline_create(R_Shader_DVR_3D,  &R_Vertex_Format_XUC_3D, 1);
+
+    R_Pipeline submitted[] = { flat, flat, grid, volume, flat };
+    R2I        bounds[]    = { r2i(0, 0, 800, 600), r2i(100, 100, 500, 400), r2i(100, 100, 500, 400), r2i(100, 100, 500, 400), r2i(90, 90, 510, 120) };
+    U64        capture_at  = r_record_capture(scratch.arena).len;
+
+    For_U32(it, sarray_len(submitted)) {
+      R_Command_Draw draw = { .pipeline = submitted[it], .texture = R_Texture_2D_White, .sampler = R_Sampler_Linear_Clamp };
+      r_command_push_draw_keyed(&draw, r_draw_key_layered(R_Pass_Overlay, &draw, bounds[it]));
+    }
+
+    r_frame_flush();
+
+    U32             draw_count = 0;
+    R_Command_Draw *draws      = test_render_recorded_draws(scratch.arena, capture_at, &draw_count);
+    Assert(draw_count == sarray_len(submitted), "every draw recorded");
+    For_U32(it, draw_count) {
+      Assert(draws[it].pipeline == submitted[it], "viewport draws flushed out of submission order");
+    }
+
+    // NOTE(cmat): Side by side flat and grid draws over one background group into two runs,
+    // - an ordered draw after them stays last even though it overlaps none of them.
+    capture_at = r_record_capture(scratch.arena).len;
+
+    R_Command_Draw background = { .pipeline = flat, .texture = R_Texture_2D_White, .sampler = R_Sampler_Linear_Clamp };
+    r_command_push_draw_keyed(&background, r_draw_key_layered(R_Pass_Overlay, &background, r2i(0, 0, 800, 600)));
+
+    R_Pipeline side_by_side[] = { grid, flat, grid, flat, grid, flat };
+    For_U32(it, sarray_len(side_by_side)) {
+      R_Command_Draw draw = { .pipeline = side_by_side[it], .texture = R_Texture_2D_White, .sampler = R_Sampler_Linear_Clamp };
+      r_command_push_draw_keyed(&draw, r_draw_key_layered(R_Pass_Overlay, &draw, r2i(100 * it, 0, 100 * it + 90, 90)));
+    }
+
+    R_Command_Draw last = { .pipeline = volume, .texture = R_Texture_2D_White, .sampler = R_Sampler_Linear_Clamp };
+    r_command_push_draw(&last);
+    r_frame_flush();
+
+    draws = test_render_recorded_draws(scratch.arena, capture_at, &draw_count);
+    Assert(draw_count == 2 + sarray_len(side_by_side), "every draw recorded");
+    Assert(draws[0].pipeline == flat && draws[draw_count - 1].pipeline == volume, "layers flush in order");
+    For_U32_Range(it, 1, 4) {
+      Assert(draws[it].pipeline == draws[1].pipeline && draws[it + 3].pipeline == draws[4].pipeline && draws[1].pipeline != draws[4].pipeline, "draws side by side grouped by state");
+    }
+
+    R_Command_Stats stats = r_command_stats();
+    Assert(stats.state_changes_sorted < stats.state_changes_submitted, "grouping saves state changes");
+
+    // NOTE(cmat): Passes still flush in enum order, ahead of overlay draws submitted earlier.
+    capture_at = r_record_capture(scratch.arena).len;
+
+    R_Command_Draw overlay = { .pipeline = flat, .texture = R_Texture_2D_White, .sampler = R_Sampler_Linear_Clamp };
+    R_Command_Draw opaque  = overlay;
+    opaque.pipeline        = grid;
+    r_command_push_draw(&overlay);
+    r_command_push_draw_keyed(&opaque, r_draw_key(R_Pass_Opaque, &opaque, 0.f));
+    r_frame_flush();
+
+    draws = test_render_recorded_draws(scratch.arena, capture_at, &draw_count);
+    Assert(draw_count == 2 && draws[0].pipeline == grid && draws[1].pipeline == flat, "opaque pass flushes first");
+
+    r_pipeline_destroy(&volume);
+    r_pipeline_destroy(&grid);
+    r_pipeline_destroy(&flat);
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+fn_internal void test_render_uniform_ring(void) {
+  log_zone_start("uniform ring testing");
+
+  enum { Slices_Per_Block = R_Uniform_Block_Bytes / R_Uniform_Alignment, Frame_Slices = Slices_Per_Block + 1 };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U08 constants[R_Uniform_Binding_Bytes] = { };
+
+    // NOTE(cmat): Start from a fresh frame, its first block is empty.
+    r_frame_flush();
+
+    U64 capture_at = r_record_capture(scratch.arena).len;
+
+    R_Uniform_Slice *slices = arena_push_count(scratch.arena, R_Uniform_Slice, Frame_Slices);
+    For_U32(it, Frame_Slices) {
+      constants[0] = (U08)it;
+      slices[it]   = r_uniform_push(constants, 1 + it % R_Uniform_Binding_Bytes);
+      Assert(slices[it].offset % R_Uniform_Alignment == 0, "slice offset alignment");
+    }
+
+    For_U32(it, Slices_Per_Block) {
+      Assert(slices[it].buffer == slices[0].buffer && slices[it].offset == it * R_Uniform_Alignment, "slices pack one block");
+    }
+
+    Assert(slices[Slices_Per_Block].buffer != slices[0].buffer && slices[Slices_Per_Block].offset == 0, "full block moves to a new one");
+
+    // NOTE(cmat): The ring multi-buffers its blocks itself, the backend must not do it again.
+    Str capture = r_record_capture(scratch.arena);
+    for (U64 at = capture_at; at < capture.len; ) {
+      R_Capture_Record *record = (R_Capture_Record *)(capture.txt + at);
+      if (record->op == R_Capture_Op_Buffer_Allocate) {
+        R_Capture_Buffer_Allocate *allocate = (R_Capture_Buffer_Allocate *)(record + 1);
+        Assert(allocate->mode == R_Buffer_Mode_Static, "uniform blocks are static buffers");
+      }
+
+      at += sizeof(R_Capture_Record) + record->bytes;
+    }
+
+    // NOTE(cmat): One download per block the frame used, of the bytes it used.
+    capture_at = r_record_capture(scratch.arena).len;
+    r_frame_flush();
+    Assert(test_render_recorded_op_count(scratch.arena, capture_at, R_Capture_Op_Buffer_Download) == 2, "one download per used block");
+
+    // NOTE(cmat): Every frame of the ring now holds two blocks. A frame's blocks come back
+    // - R_Uniform_Frame_Count flushes later, and nothing new is allocated.
+    For_U32(frame, R_Uniform_Frame_Count - 1) {
+      For_U32(it, Frame_Slices) r_uniform_push_type(&constants);
+      r_frame_flush();
+    }
+
+    capture_at = r_record_capture(scratch.arena).len;
+
+    enum { Steady_Frames = 4 * R_Uniform_Frame_Count };
+    R_Buffer first_buffers[Steady_Frames] = { };
+    For_U32(frame, Steady_Frames) {
+      first_buffers[frame] = r_uniform_push_type(&constants).buffer;
+      For_U32(it, Frame_Slices - 1) r_uniform_push_type(&constants);
+      r_frame_flush();
+    }
+
+    For_U32(frame, Steady_Frames) {
+      For_U32(other, frame) {
+        B32 same_frame = (frame - other) % R_Uniform_Frame_Count == 0;
+        Assert((first_buffers[frame] == first_buffers[other]) == same_frame, "blocks reused every R_Uniform_Frame_Count frames");
+      }
+    }
+
+    Assert(!test_render_recorded_op_count(scratch.arena, capture_at, R_Capture_Op_Buffer_Allocate), "steady state allocates no buffers");
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+fn_internal void test_render_upload_done(void *user_data) {
+  *(U32 *)user_data += 1;
+}
+
+// NOTE(cmat): Copies the volume slabs recorded since capture_at into volume, returns their bytes.
+fn_internal U64 test_render_recorded_volume(Arena *arena, U64 capture_at, F32 *volume, U32 width, U32 height) {
+  Str capture = r_record_capture(arena);
+  U64 result  = 0;
+
+  for (U64 at = capture_at; at < capture.len; ) {
+    R_Capture_Record *record = (R_Capture_Record *)(capture.txt + at);
+    if (record->op == R_Capture_Op_Texture_3D_Download) {
+      R_Capture_Texture_Download *download = (R_Capture_Texture_Download *)(record + 1);
+      F32                        *data     = (F32 *)(download + 1);
+      R3I                         region   = download->region;
+
+      for (I32 z = region.z0; z < region.z1; ++z) {
+        for (I32 y = region.y0; y < region.y1; ++y) {
+          for (I32 x = region.x0; x < region.x1; ++x) {
+            volume[((U64)z * height + (U64)y) * width + (U64)x] = *data++;
+          }
+        }
+      }
+
+      result += download->bytes;
+    }
+
+    at += sizeof(R_Capture_Record) + record->bytes;
+  }
+
+  return result;
+}
+
+fn_internal void test_render_upload_belt(void) {
+  log_zone_start("upload belt testing");
+
+  enum { Width = 8, Height = 8, Depth = 8, Volume_Bytes = Width * Height * Depth * sizeof(F32) };
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    F32 *source  = arena_push_count(scratch.arena, F32, Width * Height * Depth);
+    F32 *rebuilt = arena_push_count(scratch.arena, F32, Width * Height * Depth);
+    For_U32(it, Width * Height * Depth) source[it] = (F32)it;
+
+    R_Texture_3D volume = r_texture_3D_allocate(R_Texture_Format_F32, Width, Height, Depth);
+
+    // NOTE(cmat): Frames fill up with whole rows (32 bytes) across slice boundaries, 600 bytes
+    // - send two whole slices and two rows of the next, 100 bytes three rows.
+    U64 budgets[]       = { 600, 100 };
+    U32 frames_needed[] = { 4, 22 };
+
+    For_U32(test, sarray_len(budgets)) {
+      r_upload_budget_set(budgets[test]);
+      memory_fill(rebuilt, 0xFF, Volume_Bytes);
+
+      U32 done = 0;
+      r_upload_texture_3D(volume, R_Texture_Format_F32, r3i(0, 0, 0, Width, Height, Depth), source, test_render_upload_done, &done);
+
+      U32 frames = 0;
+      U64 bytes  = 0;
+      while (!done) {
+        Assert(frames < 4 * frames_needed[test], "upload never completes");
+
+        U64 capture_at = r_record_capture(scratch.arena).len;
+        r_frame_flush();
+        frames += 1;
+
+        U64            frame_bytes = test_render_recorded_volume(scratch.arena, capture_at, rebuilt, Width, Height);
+        R_Upload_Stats stats       = r_upload_stats();
+        bytes += frame_bytes;
+
+        Assert(frame_bytes && frame_bytes <= budgets[test] && stats.frame_bytes == frame_bytes, "per-frame byte cap");
+        Assert(done == (bytes == Volume_Bytes),                                                  "callback fires after the last slab only");
+        Assert(stats.pending_bytes == Volume_Bytes - bytes,                                      "pending bytes");
+      }
+
+      Assert(frames == frames_needed[test],                 "frames to stream the volume");
+      Assert(memory_compare(rebuilt, source, Volume_Bytes), "slabs tile the volume");
+    }
+
+    // NOTE(cmat): Zero extents complete on the next flush without sending anything.
+    U32 done       = 0;
+    U64 capture_at = r_record_capture(scratch.arena).len;
+    r_upload_texture_3D(volume, R_Texture_Format_F32, r3i(0, 0, 0, 0, Height, Depth), source, test_render_upload_done, &done);
+    r_upload_texture_3D(volume, R_Texture_Format_F32, r3i(0, 0, 0, Width, 0, Depth),  source, test_render_upload_done, &done);
+    r_upload_texture_2D(R_Texture_2D_White, R_Texture_Format_RGBA_U08_Normalized, r2i(0, 0, 2, 0), source, test_render_upload_done, &done);
+    r_frame_flush();
+
+    Assert(done == 3 && !r_upload_stats().pending_count, "empty uploads complete");
+    Assert(!test_render_recorded_op_count(scratch.arena, capture_at, R_Capture_Op_Texture_3D_Download) &&
+           !test_render_recorded_op_count(scratch.arena, capture_at, R_Capture_Op_Texture_2D_Download), "empty uploads send nothing");
+
+    r_upload_budget_set(R_Upload_Budget_Default);
+    r_texture_3D_destroy(&volume);
+  }
+
+  log_info("correctness - ok");
+  log_zone_end();
+}
+
+#endif
+
+fn_internal void test_render_all(void) {
+  Log_Zone_Scope("testing render subsystem") {
+    test_render_handles();
+
+#if BUILD_RENDER_RECORD
+    test_render_pass_order();
+    test_render_uniform_ring();
+    test_render_upload_belt();
+#endif
+
+#if BUILD_RENDER_SOFTWARE
+    test_render_software();
+#endif
+  }
+}
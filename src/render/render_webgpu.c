@@ -6,8 +6,10 @@
 
 R_Shader      R_Shader_Flat_2D        = { };
 R_Shader      R_Shader_Flat_3D        = { };
+R_Shader      R_Shader_Grid_3D        = { };
 R_Shader      R_Shader_DVR_3D         = { };
 R_Shader      R_Shader_SLI_3D         = { };
+R_Shader      R_Shader_Quad_2D        = { };
 R_Texture_2D  R_Texture_2D_White      = { };
 R_Texture_3D  R_Texture_3D_White      = { };
 R_Sampler     R_Sampler_Linear_Clamp  = { };
@@ -37,7 +39,7 @@ fn_external U32  js_webgpu_shader_destroy    (U32 shader_handle);
 fn_external U32  js_webgpu_pipeline_create   (U32 shader_handle, void *vertex_format_ptr, B32 depth_buffer);
 fn_external U32  js_webgpu_pipeline_destroy  (U32 pipeline_handle);
 
-fn_external void js_webgpu_frame_flush       (void *command_draw_ptr);
+fn_external void js_webgpu_frame_submit      (U32 draw_count, void *draw_array_ptr);
 
 // ------------------------------------------------------------
 // #-- Built-in shaders.
@@ -88,6 +90,15 @@ var_global Str webgpu_shader_source_sli_3D = {
   .txt = webgpu_shader_source_sli_3D_dat,
 };
 
+var_global U08 webgpu_shader_source_quad_2D_dat[] = {
+#embed "quad_2D.wgsl"
+};
+
+var_global Str webgpu_shader_source_quad_2D = {
+  .len = sizeof(webgpu_shader_source_quad_2D_dat),
+  .txt = webgpu_shader_source_quad_2D_dat,
+};
+
 
 
 
@@ -166,6 +177,7 @@ fn_internal void webgpu_create_default_shaders(void) {
   R_Shader_Grid_3D = js_webgpu_shader_create((U32)webgpu_shader_source_grid_3D.len, webgpu_shader_source_grid_3D.txt);
   R_Shader_DVR_3D  = js_webgpu_shader_create((U32)webgpu_shader_source_dvr_3D.len,  webgpu_shader_source_dvr_3D.txt);
   R_Shader_SLI_3D  = js_webgpu_shader_create((U32)webgpu_shader_source_sli_3D.len,  webgpu_shader_source_sli_3D.txt);
+  R_Shader_Quad_2D = js_webgpu_shader_create((U32)webgpu_shader_source_quad_2D.len, webgpu_shader_source_quad_2D.txt);
 }
 
 fn_internal void webgpu_create_default_textures(void) {
@@ -204,15 +216,22 @@ fn_internal void r_init(PL_Render_Context *render_context) {
 // ------------------------------------------------------------
 // #-- WebGPU Command Submission.
 
+// NOTE(cmat): The frame's draws are packed back to back (in key order) into one R_Command_Draw array, and
+// - handed to JS in a single call that encodes all of them into one render pass and submits it.
 fn_internal void r_frame_flush(void) {
-          
-  for(R_Command_Header *it = R_Commands.first; it; it = it->next) {
-    switch (it->type) {
-      case R_Command_Type_Draw: {
-        R_Command_Draw *draw = (R_Command_Draw *)pointer_offset_bytes(it, sizeof(R_Command_Header));
-        js_webgpu_frame_flush(draw);
-      } break;
+  r_uniform_flush();
+  r_upload_flush();
+
+  Scratch scratch = { };
+  Scratch_Scope(&scratch, 0) {
+    U32              draw_count = 0;
+    R_Command_Draw **draws      = r_command_sort(scratch.arena, &draw_count);
+    R_Command_Draw  *draw_array = arena_push_count(scratch.arena, R_Command_Draw, draw_count, .flags = 0);
+    For_U32 (it, draw_count) {
+      draw_array[it] = *draws[it];
     }
+
+    js_webgpu_frame_submit(draw_count, draw_array);
   }
 
   r_command_reset();
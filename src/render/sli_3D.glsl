@@ -0,0 +1,93 @@
+layout(binding = 0) uniform sampler2D Texture;
+
+layout(std140, binding = 2) uniform World_3D_Type {
+  mat4 World_View_Projection;
+  vec3 Eye_Position;
+} World_3D;
+
+layout(binding = 3) uniform sampler3D Texture_Volume;
+
+vec4 vec4_unpack_u32(uint packed_color) {
+  float r = float((packed_color >> 0)  & 0xFFu) / 255.0;
+  float g = float((packed_color >> 8)  & 0xFFu) / 255.0;
+  float b = float((packed_color >> 16) & 0xFFu) / 255.0;
+  float a = float((packed_color >> 24) & 0xFFu) / 255.0;
+
+    return vec4(r, g, b, a);
+}
+
+#if defined(VERTEX_SHADER)
+
+layout(location = 0) in vec3 X;
+layout(location = 1) in vec2 U;
+layout(location = 2) in uint C;
+
+layout(location = 0) out VS_Out {
+  vec3 X;
+  vec4 C;
+  vec2 U;
+} Out;
+
+void main() {
+   gl_Position = transpose(World_3D.World_View_Projection) * vec4(X, 1.0);
+   Out.X       = X;
+   Out.C       = vec4_unpack_u32(C);
+   Out.U       = U;
+}
+
+#elif defined(PIXEL_SHADER)
+
+layout(location = 0) in VS_Out {
+  vec3 X;
+  vec4 C;
+  vec2 U;
+} In;
+
+layout(location = 0) out vec4 Color;
+
+const vec3 box_min = vec3(-1.0, -1.0, -1.0);
+const vec3 box_max = vec3( 1.0,  1.0,  1.0);
+
+// NOTE(cmat): texelFetch is undefined out of bounds (textureLoad clamps), so the +1 neighbours
+// - are clamped to the last voxel.
+float sample_volume(vec3 position) {
+    vec3 p = clamp(
+        (position - box_min) / (box_max - box_min),
+        vec3(0.0),
+        vec3(1.0)
+    );
+
+    ivec3 voxels = textureSize(Texture_Volume, 0);
+    vec3 size = vec3(voxels);
+    vec3 coord = p * (size - 1.0);
+
+    ivec3 base = ivec3(floor(coord));
+    ivec3 last = voxels - 1;
+    vec3 frac = fract(coord);
+
+    float c000 = texelFetch(Texture_Volume, min(base + ivec3(0,0,0), last), 0).r;
+    float c100 = texelFetch(Texture_Volume, min(base + ivec3(1,0,0), last), 0).r;
+    float c010 = texelFetch(Texture_Volume, min(base + ivec3(0,1,0), last), 0).r;
+    float c110 = texelFetch(Texture_Volume, min(base + ivec3(1,1,0), last), 0).r;
+    float c001 = texelFetch(Texture_Volume, min(base + ivec3(0,0,1), last), 0).r;
+    float c101 = texelFetch(Texture_Volume, min(base + ivec3(1,0,1), last), 0).r;
+    float c011 = texelFetch(Texture_Volume, min(base + ivec3(0,1,1), last), 0).r;
+    float c111 = texelFetch(Texture_Volume, min(base + ivec3(1,1,1), last), 0).r;
+
+    float c00 = mix(c000, c100, frac.x);
+    float c10 = mix(c010, c110, frac.x);
+    float c01 = mix(c001, c101, frac.x);
+    float c11 = mix(c011, c111, frac.x);
+
+    float c0 = mix(c00, c10, frac.y);
+    float c1 = mix(c01, c11, frac.y);
+
+    return mix(c0, c1, frac.z);
+}
+
+void main() {
+  float value = sample_volume(In.X);
+  Color       = texture(Texture, vec2(value, 0));
+}
+
+#endif
@@ -17,6 +17,30 @@ typedef struct STL_Binary_Triangle {
 
 #pragma pack(pop)
 
+typedef struct STL_Parse {
+  STL_Binary_Triangle *triangles;
+  R_Vertex_XUC_3D     *vertices;
+  U32                  tri_count;
+} STL_Parse;
+
+fn_internal void stl_parse_triangles(void *user_data, Range_U64 range) {
+  STL_Parse *parse = (STL_Parse *)user_data;
+  For_U64_Range(it, range.min, range.max) {
+    STL_Binary_Triangle tri = parse->triangles[it];
+
+    V3F R = rgb_from_hsv(v3f(it / (F32)parse->tri_count, .8f, .8f));
+    U32 C = abgr_u32_from_rgba_premul(v4f(R.x, R.y, R.z, 1.f));
+
+    tri.position_1 = v3f_had(tri.position_1, v3f(5, 1, 1));
+    tri.position_2 = v3f_had(tri.position_2, v3f(5, 1, 1));
+    tri.position_3 = v3f_had(tri.position_3, v3f(5, 1, 1));
+
+    parse->vertices[3 * it + 0] = (R_Vertex_XUC_3D) { .X = tri.position_1, .C = C, .U = v2f(0, 0) };
+    parse->vertices[3 * it + 1] = (R_Vertex_XUC_3D) { .X = tri.position_2, .C = C, .U = v2f(1, 0) };
+    parse->vertices[3 * it + 2] = (R_Vertex_XUC_3D) { .X = tri.position_3, .C = C, .U = v2f(0, 1) };
+  }
+}
+
 fn_internal R_Vertex_XUC_3D *stl_parse_binary(Arena *arena, U64 bytes, U08 *data, U32 *tri_count) {
   R_Vertex_XUC_3D *result = 0;
   if (bytes >= sizeof(STL_Binary_Header)) {
@@ -30,23 +54,12 @@ fn_internal R_Vertex_XUC_3D *stl_parse_binary(Arena *arena, U64 bytes, U08 *data
       result = arena_push_count(arena, R_Vertex_XUC_3D, 3 * header->tri_count);
       *tri_count = header->tri_count;
 
-      Random_Seed rng = 1234;
-
-      STL_Binary_Triangle *triangles = (STL_Binary_Triangle *)(data + sizeof(STL_Binary_Header));
-      For_U32 (it, header->tri_count) {
-        STL_Binary_Triangle tri = triangles[it];
-
-        V3F R = rgb_from_hsv(v3f(it / (F32)header->tri_count, .8f, .8f));
-        U32 C = abgr_u32_from_rgba_premul(v4f(R.x, R.y, R.z, 1.f));
-
-        tri.position_1 = v3f_had(tri.position_1, v3f(5, 1, 1));
-        tri.position_2 = v3f_had(tri.position_2, v3f(5, 1, 1));
-        tri.position_3 = v3f_had(tri.position_3, v3f(5, 1, 1));
+      STL_Parse parse = { };
+      parse.triangles = (STL_Binary_Triangle *)(data + sizeof(STL_Binary_Header));
+      parse.vertices  = result;
+      parse.tri_count = header->tri_count;
 
-        result[3 * it + 0] = (R_Vertex_XUC_3D) { .X = tri.position_1, .C = C, .U = v2f(0, 0) };
-        result[3 * it + 1] = (R_Vertex_XUC_3D) { .X = tri.position_2, .C = C, .U = v2f(1, 0) };
-        result[3 * it + 2] = (R_Vertex_XUC_3D) { .X = tri.position_3, .C = C, .U = v2f(0, 1) };
-      }
+      parallel_for(range_u64(0, header->tri_count), 4096, stl_parse_triangles, &parse);
     } else {
       log_fatal("STL parse error");
     }
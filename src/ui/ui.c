@@ -66,11 +66,13 @@ fn_internal void ui_init(FO_Font *font) {
 }
 
 fn_internal Str ui_label_from_key(UI_Key key) {
-  Str result = key.label;
+  Str result = str_from_atom(key.label);
   return result;
 }
 
-fn_internal UI_Node *ui_cache(UI_Key key) {
+// NOTE(cmat): Two labels hashing to the same id under the same parent get their own nodes,
+// - the interned names tell them apart. The label is interned once, when the node is created.
+fn_internal UI_Node *ui_cache(UI_Key key, Str label) {
   U64 bucket_index   = key.id % UI_State.hash_count;
   UI_Node_List *list = UI_State.hash_array + bucket_index;
 
@@ -79,15 +81,16 @@ fn_internal UI_Node *ui_cache(UI_Key key) {
     list->first = arena_push_type(&UI_State.arena, UI_Node);
     list->last  = list->first;
 
-    result      = list->last;
-    result->key = (UI_Key) { .id = key.id, .label = arena_push_str(&UI_State.arena, key.label) };
+    result            = list->last;
+    result->key       = key;
+    result->key.label = atom_from_str(label);
 
-    log_debug("Created UI element '%.*s' with id # %u", str_expand(result->key.label), result->key.id);
+    log_debug("Created UI element '%.*s' with id # %u", str_expand(ui_label_from_key(result->key)), result->key.id);
 
   } else {
     UI_Node *entry = list->first;
     while (entry) {
-      if (entry->key.id == key.id) {
+      if (entry->key.id == key.id && entry->key.name == key.name) {
         result = entry;
         break;
       }
@@ -96,9 +99,10 @@ fn_internal UI_Node *ui_cache(UI_Key key) {
         list->last->hash_next  = arena_push_type(&UI_State.arena, UI_Node);
         list->last             = list->last->hash_next;
         result                 = list->last;
-        result->key            = (UI_Key) { .id = key.id, .label = arena_push_str(&UI_State.arena, key.label) };
+        result->key            = key;
+        result->key.label      = atom_from_str(label);
 
-        log_debug("(Hash-Collision) Created UI element '%.*s' with id # %u", str_expand(result->key.label), result->key.id);
+        log_debug("(Hash-Collision) Created UI element '%.*s' with id # %u", str_expand(ui_label_from_key(result->key)), result->key.id);
       }
 
       entry = entry->hash_next;
@@ -221,32 +225,22 @@ fn_internal void ui_node_update_animation(UI_Node *node) {
 #endif
 }
 
-fn_internal UI_ID ui_node_id(Str label, UI_ID parent_id) {
+fn_internal Str_Atom ui_node_name(Str label) {
 
   // NOTE(cmat): If the string contains ###, only hash the part after "###"
   // NOTE(cmat): If the string contains ##, we hash everything but ignore things after ## for the label.
-  if (str_contains(label, str_lit("###"))) {
-    U32 it = 0;
-    while (label.txt[it] != '#') {
-      it++;
-    }
-
-    it += 2;
-    label = str_slice(label, it, label.len - it);
+  U64 id_at = str_find(label, str_lit("###"));
+  if (id_at != str_find_none) {
+    id_at += 3;
+    label  = str_slice(label, id_at, label.len - id_at);
   }
 
-  UI_ID hash = 0;
-  Scratch scratch = { };
-  Scratch_Scope(&scratch, 0) {
-    U32  bytes = label.len + sizeof(UI_ID);
-    U08 *data  = arena_push_size(scratch.arena, bytes);
-
-    memory_copy(data, &parent_id, sizeof(UI_ID));
-    memory_copy(data + sizeof(UI_ID), label.txt, label.len);
-
-    hash = crc32(bytes, data);
-  }
+  return atom_from_str(label);
+}
 
+// NOTE(cmat): The interned name already carries its hash, mixing in the parent id is enough.
+fn_internal UI_ID ui_node_id(Str_Atom name, UI_ID parent_id) {
+  UI_ID hash = (UI_ID)hash_u64(atom_hash(name) ^ parent_id);
   return hash;
 }
 
@@ -264,9 +258,9 @@ fn_internal UI_Node *ui_node_push(Str label, UI_Flags flags) {
   }
 
   UI_ID    parent_id = parent ? parent->key.id : 0;
-  UI_ID    id        = ui_node_id(label, parent_id);
-  UI_Key   key       = (UI_Key) { .id = id, .label = label };
-  UI_Node *node      = ui_cache(key);
+  Str_Atom name      = ui_node_name(label);
+  UI_Key   key       = (UI_Key) { .id = ui_node_id(name, parent_id), .name = name };
+  UI_Node *node      = ui_cache(key, label);
 
   node->flags       = flags;
   node->draw.font   = ui_font_current();
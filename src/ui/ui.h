@@ -119,10 +119,13 @@ typedef struct UI_Node_Tree {
   UI_Node *first_child;
 } UI_Node_Tree;
 
+// NOTE(cmat): name is the interned part of the label the id is hashed from (after "###"), label
+// - the interned label itself. Nodes are matched on id and name, both integer compares.
 typedef U32 UI_ID;
 typedef struct UI_Key {
-  UI_ID id;
-  Str   label;
+  UI_ID    id;
+  Str_Atom name;
+  Str_Atom label;
 } UI_Key;
 
 typedef struct UI_Node {
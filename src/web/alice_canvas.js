@@ -135,9 +135,6 @@ const wasm_context = {
   shared_memory: {
     frame_state: null,
   },
-
-  // TODO(cmat): Temporary.
-  webgpu_pass_encoder: null,
 };
 
 function js_string_from_c_string(string_len, string_txt) {
@@ -159,6 +156,10 @@ function js_co_unix_time() {
   return Date.now() - local_offset;
 }
 
+function js_co_timer() {
+  return performance.now();
+}
+
 function js_co_stream_write(stream_mode, string_len, string_txt) {
   const js_string = js_string_from_c_string(string_len, string_txt);
 
@@ -174,6 +175,88 @@ function js_co_panic(string_len, string_txt) {
   alert(js_string);
   throw "PANIC ## " + js_string;
 }
+// ------------------------------------------------------------
+// #-- NOTE(cmat): JS - WASM fibers (asyncify).
+// - js_co_fiber_switch unwinds the wasm stack into the from fiber's asyncify buffer, which
+// - returns out of whichever export wasm_call is running. wasm_call then resumes the to fiber:
+// - a fresh one through wasm_fiber_entry, a suspended one by rewinding its root export call.
+// - Every fiber runs on its own shadow stack, so __stack_pointer is swapped along with it.
+// - Only exports called through wasm_call may switch fibers.
+
+const Asyncify_State_Normal    = 0;
+const Asyncify_State_Unwinding = 1;
+const Asyncify_State_Rewinding = 2;
+
+const wasm_fiber = {
+  roots:    new Map(),  // NOTE(cmat): Suspended CO_Fiber pointer -> export call that owns its wasm stack.
+  pending:  null,
+};
+
+function wasm_fiber_field(fiber_ptr, index) {
+  return new Uint32Array(wasm_context.memory.buffer, fiber_ptr, 4)[index];
+}
+
+function js_co_fiber_switch(from_ptr, to_ptr) {
+  const exports = wasm_context.export_table;
+  if (!exports.asyncify_start_unwind) {
+    throw "PANIC ## fibers need the asyncify pass, build with build.sh (wasm-opt)";
+  }
+
+  if (exports.asyncify_get_state() === Asyncify_State_Rewinding) {
+    exports.asyncify_stop_rewind();
+    return;
+  }
+
+  // NOTE(cmat): Save the shadow stack pointer, reset the asyncify buffer header (current, end).
+  const from_fields = new Uint32Array(wasm_context.memory.buffer, from_ptr, 4);
+  from_fields[0]    = exports.__stack_pointer.value;
+
+  const buffer_ptr  = from_fields[1];
+  const buffer      = new Uint32Array(wasm_context.memory.buffer, buffer_ptr, 2);
+  buffer[0]         = buffer_ptr + 8;
+  buffer[1]         = from_fields[2];
+
+  wasm_fiber.pending = { from: from_ptr, to: to_ptr };
+  exports.asyncify_start_unwind(buffer_ptr);
+}
+
+function wasm_call(root) {
+  const exports = wasm_context.export_table;
+  if (!exports.asyncify_get_state) {
+    return root();
+  }
+
+  let result = root();
+  while (exports.asyncify_get_state() === Asyncify_State_Unwinding) {
+    exports.asyncify_stop_unwind();
+
+    const { from, to } = wasm_fiber.pending;
+    wasm_fiber.pending = null;
+
+    // NOTE(cmat): A finished fiber (started cleared) is never resumed, don't keep its root.
+    if (wasm_fiber_field(from, 3)) {
+      wasm_fiber.roots.set(from, root);
+    } else {
+      wasm_fiber.roots.delete(from);
+    }
+
+    exports.__stack_pointer.value = wasm_fiber_field(to, 0);
+
+    if (!wasm_fiber_field(to, 3)) {
+      new Uint32Array(wasm_context.memory.buffer, to, 4)[3] = 1;
+      root = () => exports.wasm_fiber_entry(to);
+    } else {
+      root = wasm_fiber.roots.get(to);
+      wasm_fiber.roots.delete(to);
+      exports.asyncify_start_rewind(wasm_fiber_field(to, 1));
+    }
+
+    result = root();
+  }
+
+  return result;
+}
+
 // ------------------------------------------------------------
 // #-- NOTE(cmat): JS - WASM http API.
 
@@ -298,26 +381,50 @@ async function webgpu_init(canvas) {
     alphaMode: 'premultiplied'
   });
 
-  webgpu_handle_map = {
-    next_user_handle: 1,
-    map:              new Map(),
+  // NOTE(cmat): Every builtin shader uses the same bindings, so all pipelines share one layout
+  // - and a bind group only depends on the resources bound to it.
+  const webgpu_bind_group_layout = webgpu_device.createBindGroupLayout({
+    entries: [
+      {
+        binding: 0,
+        visibility: GPUShaderStage.FRAGMENT,
+        texture: { sampleType: 'float', viewDimension: '2d' },
+      },
 
-    store(webgpu_handle) {
-      const user_handle = this.next_user_handle++;
-      this.map.set(user_handle, webgpu_handle);
-      return user_handle;
-    },
+      {
+        binding: 1,
+        visibility: GPUShaderStage.FRAGMENT,
+        sampler: { type: 'filtering' },
+      },
 
-    get(user_handle)     { return this.map.get(user_handle); },
-    remove(user_handle)  { this.map.delete(user_handle);     }
-  };
+      {
+        binding: 2,
+        visibility: GPUShaderStage.VERTEX | GPUShaderStage.FRAGMENT,
+        buffer: { type: 'uniform', hasDynamicOffset: true },
+      },
+
+      {
+        binding: 3,
+        visibility: GPUShaderStage.FRAGMENT,
+        texture: { sampleType: 'unfilterable-float', viewDimension: '3d' },
+      }
+    ]
+  });
+
+  const webgpu_pipeline_layout = webgpu_device.createPipelineLayout({
+    bindGroupLayouts: [ webgpu_bind_group_layout ],
+  });
 
   return {
     device:             webgpu_device,
     context:            webgpu_context,
-    handle_map:         webgpu_handle_map,
+    handle_pool:        webgpu_handle_pool_create(),
     backbuffer_format:  webgpu_format,
 
+    bind_group_layout:  webgpu_bind_group_layout,
+    pipeline_layout:    webgpu_pipeline_layout,
+    bind_group_cache:   webgpu_bind_group_cache_create(),
+
     color_texture:      null,
     color_texture_view: null,
 
@@ -326,6 +433,151 @@ async function webgpu_init(canvas) {
   };
 }
 
+// NOTE(cmat): Mirrors R_Handle_Pool (render.h). Handles pack a slot index (low 20 bits) and the
+// - slot's generation (high 12 bits), objects and texture views live in dense arrays indexed by
+// - slot. Removing bumps the generation, so a stale handle throws instead of aliasing whatever
+// - reuses the slot. Slot 0 is reserved. Wasm passes handles as i32, so generations past 2047
+// - arrive negative: every js_webgpu_* entry point taking a handle normalizes it with >>> 0.
+const WebGPU_Handle_Index_Bits      = 20;
+const WebGPU_Handle_Index_Mask      = (1 << WebGPU_Handle_Index_Bits) - 1;
+const WebGPU_Handle_Generation_Mask = (1 << (32 - WebGPU_Handle_Index_Bits)) - 1;
+
+function webgpu_handle_pool_create() {
+  return {
+    objects:     [ null ],
+    views:       [ null ],
+    generations: [ 0 ],
+    free_slots:  [ ],
+
+    store(object, view = null) {
+      let index = this.free_slots.pop();
+      if (index === undefined) {
+        index = this.objects.length;
+        this.generations.push(0);
+      }
+
+      this.objects[index] = object;
+      this.views[index]   = view;
+      return ((this.generations[index] << WebGPU_Handle_Index_Bits) | index) >>> 0;
+    },
+
+    slot(handle) {
+      const index = handle & WebGPU_Handle_Index_Mask;
+      if (index == 0 || index >= this.objects.length || this.generations[index] != (handle >>> WebGPU_Handle_Index_Bits)) {
+        throw new Error("stale or invalid webgpu handle " + (handle >>> 0));
+      }
+
+      return index;
+    },
+
+    get(handle)  { return this.objects[this.slot(handle)]; },
+    view(handle) { return this.views[this.slot(handle)];   },
+
+    remove(handle) {
+      const index = this.slot(handle);
+      this.objects[index]     = null;
+      this.views[index]       = null;
+      this.generations[index] = (this.generations[index] + 1) & WebGPU_Handle_Generation_Mask;
+      this.free_slots.push(index);
+    },
+  };
+}
+
+// NOTE(cmat): Bind groups are cached by the handles they bind (texture, sampler, constant
+// - buffer, volume texture), in nested Maps one handle per level, so a hit looks up four
+// - numbers without building a key. A handle only repeats once its slot's generation wraps,
+// - and destroying a resource drops every bind group that references it first.
+const WebGPU_Bind_Group_Handle_Count = 4;
+
+function webgpu_bind_group_cache_create() {
+  return {
+    root:     new Map(),  // NOTE(cmat): Texture -> sampler -> constant buffer -> volume -> { bind_group, handles }.
+    users:    new Map(),  // NOTE(cmat): Handle -> Set of entries that bind it.
+    size:     0,
+    hits:     0,
+    misses:   0,
+
+    get(texture, sampler, constant_buffer, texture_volume, create) {
+      const samplers  = this.root.get(texture);
+      const constants = samplers  && samplers.get(sampler);
+      const volumes   = constants && constants.get(constant_buffer);
+      const entry     = volumes   && volumes.get(texture_volume);
+      if (entry) {
+        this.hits++;
+        return entry.bind_group;
+      }
+
+      this.misses++;
+      const bind_group = create(texture, sampler, constant_buffer, texture_volume);
+      const handles    = [ texture, sampler, constant_buffer, texture_volume ];
+
+      let level = this.root;
+      for (let it = 0; it < WebGPU_Bind_Group_Handle_Count - 1; it++) {
+        let next = level.get(handles[it]);
+        if (!next) {
+          next = new Map();
+          level.set(handles[it], next);
+        }
+
+        level = next;
+      }
+
+      const created = { bind_group, handles };
+      level.set(handles[WebGPU_Bind_Group_Handle_Count - 1], created);
+      this.size++;
+
+      for (const handle of handles) {
+        let entries = this.users.get(handle);
+        if (!entries) {
+          entries = new Set();
+          this.users.set(handle, entries);
+        }
+
+        entries.add(created);
+      }
+
+      return bind_group;
+    },
+
+    // NOTE(cmat): Drops the entry and every level it leaves empty.
+    remove(entry) {
+      const levels = [ this.root ];
+      for (let it = 0; it < WebGPU_Bind_Group_Handle_Count - 1; it++) {
+        levels.push(levels[it].get(entry.handles[it]));
+      }
+
+      levels[WebGPU_Bind_Group_Handle_Count - 1].delete(entry.handles[WebGPU_Bind_Group_Handle_Count - 1]);
+      for (let it = WebGPU_Bind_Group_Handle_Count - 1; it > 0 && levels[it].size == 0; it--) {
+        levels[it - 1].delete(entry.handles[it - 1]);
+      }
+
+      this.size--;
+    },
+
+    invalidate(handle) {
+      const entries = this.users.get(handle);
+      if (!entries) {
+        return;
+      }
+
+      this.users.delete(handle);
+      for (const entry of entries) {
+        this.remove(entry);
+
+        for (const other of entry.handles) {
+          const other_entries = this.users.get(other);
+          if (other != handle && other_entries) {
+            other_entries.delete(entry);
+            if (other_entries.size == 0) {
+              this.users.delete(other);
+            }
+          }
+        }
+      }
+    },
+  };
+}
+
 function js_webgpu_buffer_allocate(bytes, mode) {
   const buffer = wasm_context.webgpu.device.createBuffer({
     size:   bytes,
@@ -336,30 +588,34 @@ function js_webgpu_buffer_allocate(bytes, mode) {
             GPUBufferUsage.COPY_DST,
   });
 
-  return wasm_context.webgpu.handle_map.store(buffer)
+  return wasm_context.webgpu.handle_pool.store(buffer)
 }
 
 function js_webgpu_buffer_download(buffer_handle, offset, bytes, data_ptr) {
-  const buffer = wasm_context.webgpu.handle_map.get(buffer_handle);
+  buffer_handle = buffer_handle >>> 0;
+  const buffer = wasm_context.webgpu.handle_pool.get(buffer_handle);
   const data   = new Uint8Array(wasm_context.memory.buffer, data_ptr, bytes);
   wasm_context.webgpu.device.queue.writeBuffer(buffer, offset, data, 0, bytes);
 }
 
 function js_webgpu_buffer_destroy(buffer_handle) {
-  buffer = wasm_context.webgpu.handle_map.get(buffer_handle);
-  wasm_context.webgpu.handle_map.remove(buffer_handle);
+  buffer_handle = buffer_handle >>> 0;
+  buffer = wasm_context.webgpu.handle_pool.get(buffer_handle);
+  wasm_context.webgpu.handle_pool.remove(buffer_handle);
+  wasm_context.webgpu.bind_group_cache.invalidate(buffer_handle);
   buffer.destroy();
 }
 
 function js_webgpu_shader_create(shader_code_c_string_len, shader_code_c_string_str) {
   const shader_code = js_string_from_c_string(shader_code_c_string_len, shader_code_c_string_str);
   const shader = wasm_context.webgpu.device.createShaderModule({ code: shader_code });
-  return wasm_context.webgpu.handle_map.store(shader);
+  return wasm_context.webgpu.handle_pool.store(shader);
 }
 
 function js_webgpu_shader_destroy(shader_handle) {
-  shader = wasm_context.webgpu.handle_map.get(shader_handle);
-  wasm_context.webgpu.handle_map.remove(shader_handle);
+  shader_handle = shader_handle >>> 0;
+  shader = wasm_context.webgpu.handle_pool.get(shader_handle);
+  wasm_context.webgpu.handle_pool.remove(shader_handle);
   shader.destroy();
 }
 
@@ -369,6 +625,7 @@ const WebGPU_Texture_Format_Lookup_Name = [
   'r8unorm',
   'r8snorm',
   'r32float',
+  'r16float',
 ];
 
 const WebGPU_Texture_Format_Lookup_Bytes = [
@@ -376,7 +633,8 @@ const WebGPU_Texture_Format_Lookup_Bytes = [
   4,
   1,
   1,
-  4
+  4,
+  2,
 ];
 
 function js_webgpu_texture_3D_allocate(format, width, height, depth) {
@@ -387,11 +645,12 @@ function js_webgpu_texture_3D_allocate(format, width, height, depth) {
     usage:    GPUTextureUsage.TEXTURE_BINDING | GPUTextureUsage.COPY_DST,
   });
 
-  return wasm_context.webgpu.handle_map.store(texture);
+  return wasm_context.webgpu.handle_pool.store(texture, texture.createView());
 }
 
 function js_webgpu_texture_3D_download(texture_handle, download_format, region_x0, region_y0, region_z0, region_x1, region_y1, region_z1, data_ptr) {
-  const texture = wasm_context.webgpu.handle_map.get(texture_handle);
+  texture_handle = texture_handle >>> 0;
+  const texture = wasm_context.webgpu.handle_pool.get(texture_handle);
 
   const region_width  = (region_x1 - region_x0);
   const region_height = (region_y1 - region_y0);
@@ -410,8 +669,10 @@ function js_webgpu_texture_3D_download(texture_handle, download_format, region_x
 }
 
 function js_webgpu_texture_3D_destroy(texture_handle) {
-  const texture = wasm_context.webgpu.handle_map.get(texture_handle);
-  wasm_context.webgpu.handle_map.remove(texture_handle);
+  texture_handle = texture_handle >>> 0;
+  const texture = wasm_context.webgpu.handle_pool.get(texture_handle);
+  wasm_context.webgpu.handle_pool.remove(texture_handle);
+  wasm_context.webgpu.bind_group_cache.invalidate(texture_handle);
   texture.destroy();
 }
 
@@ -422,11 +683,12 @@ function js_webgpu_texture_2D_allocate(format, width, height) {
     usage:    GPUTextureUsage.TEXTURE_BINDING | GPUTextureUsage.COPY_DST,
   });
 
-  return wasm_context.webgpu.handle_map.store(texture);
+  return wasm_context.webgpu.handle_pool.store(texture, texture.createView());
 }
 
 function js_webgpu_texture_2D_download(texture_handle, download_format, region_x0, region_y0, region_x1, region_y1, data_ptr) {
-  const texture = wasm_context.webgpu.handle_map.get(texture_handle);
+  texture_handle = texture_handle >>> 0;
+  const texture = wasm_context.webgpu.handle_pool.get(texture_handle);
 
   const region_width  = (region_x1 - region_x0);
   const region_height = (region_y1 - region_y0);
@@ -443,8 +705,10 @@ function js_webgpu_texture_2D_download(texture_handle, download_format, region_x
 }
 
 function js_webgpu_texture_2D_destroy(texture_handle) {
-  const texture = wasm_context.webgpu.handle_map.get(texture_handle);
-  wasm_context.webgpu.handle_map.remove(texture_handle);
+  texture_handle = texture_handle >>> 0;
+  const texture = wasm_context.webgpu.handle_pool.get(texture_handle);
+  wasm_context.webgpu.handle_pool.remove(texture_handle);
+  wasm_context.webgpu.bind_group_cache.invalidate(texture_handle);
   texture.destroy();
 }
 
@@ -459,12 +723,14 @@ function js_webgpu_sampler_create(mag_filter_mode, min_filter_mode) {
     minFilter: WebGPU_Sampler_Filter_Lookup_Mode[min_filter_mode]
   });
 
-  return wasm_context.webgpu.handle_map.store(sampler);
+  return wasm_context.webgpu.handle_pool.store(sampler);
 }
 
 function js_webgpu_sampler_destroy(sampler_handle) {
-  const sampler = wasm_context.webgpu.handle_map.get(sampler_handle);
-  wasm_context.webgpu.handle_map.remove(sampler_handle);
+  sampler_handle = sampler_handle >>> 0;
+  const sampler = wasm_context.webgpu.handle_pool.get(sampler_handle);
+  wasm_context.webgpu.handle_pool.remove(sampler_handle);
+  wasm_context.webgpu.bind_group_cache.invalidate(sampler_handle);
   sampler.destroy();
 }
 
@@ -487,51 +753,38 @@ const WebGPU_Vertex_Attribute_Format_Lookup_Name = [
   'uint32',
 ]
 
-function js_webgpu_pipeline_create(shader_handle, vertex_format_ptr, depth_buffer) {
-  const pipeline_layout = wasm_context.webgpu.device.createPipelineLayout({
-    bindGroupLayouts: [
-      wasm_context.webgpu.device.createBindGroupLayout({
-        entries: [
-          {
-            binding: 0,
-            visibility: GPUShaderStage.FRAGMENT,
-            texture: { sampleType: 'float', viewDimension: '2d' },
-          },
-
-          {
-            binding: 1,
-            visibility: GPUShaderStage.FRAGMENT,
-            sampler: { type: 'filtering' },
-          },
-
-          {
-            binding: 2,
-            visibility: GPUShaderStage.VERTEX | GPUShaderStage.FRAGMENT,
-            buffer: { type: 'uniform' },
-          },
-
-          {
-            binding: 3,
-            visibility: GPUShaderStage.FRAGMENT,
-            texture: { sampleType: 'unfilterable-float', viewDimension: '3d' },
-          }
-        ]
-      })
-    ]
-  });
+// NOTE(cmat): R_Vertex_Format (packed): stride, instance stride, entry count, then up to 16
+// - entries of (offset, format, step). Attributes stepped per instance go in vertex buffer slot 1.
+const WebGPU_Vertex_Max_Attribute_Count = 16;
+const WebGPU_Vertex_Step_Instance       = 1;
 
-  const vertex_format_view = new DataView(wasm_context.memory.buffer, vertex_format_ptr, 2 * 2 + 2 * 2 * 8);
+function js_webgpu_pipeline_create(shader_handle, vertex_format_ptr, depth_buffer) {
+  shader_handle = shader_handle >>> 0;
+  const vertex_format_view = new DataView(wasm_context.memory.buffer, vertex_format_ptr, 3 * 2 + 3 * 2 * WebGPU_Vertex_Max_Attribute_Count);
 
   let offset = 0;
-  const stride      = vertex_format_view.getUint16(offset, true); offset += 2;
-  const entry_count = vertex_format_view.getUint16(offset, true); offset += 2;
+  const stride          = vertex_format_view.getUint16(offset, true); offset += 2;
+  const instance_stride = vertex_format_view.getUint16(offset, true); offset += 2;
+  const entry_count     = vertex_format_view.getUint16(offset, true); offset += 2;
 
-  attribute_list = [ ]
+  const vertex_attribute_list   = [ ];
+  const instance_attribute_list = [ ];
   for (let it = 0; it < entry_count; it++) {
     const attribute_offset = vertex_format_view.getUint16(offset, true); offset += 2;
     const attribute_format = vertex_format_view.getUint16(offset, true); offset += 2;
+    const attribute_step   = vertex_format_view.getUint16(offset, true); offset += 2;
+
+    const attribute = { shaderLocation: it, offset: attribute_offset, format: WebGPU_Vertex_Attribute_Format_Lookup_Name[attribute_format] };
+    if (attribute_step == WebGPU_Vertex_Step_Instance) {
+      instance_attribute_list.push(attribute);
+    } else {
+      vertex_attribute_list.push(attribute);
+    }
+  }
 
-    attribute_list.push({ shaderLocation: it, offset: attribute_offset, format: WebGPU_Vertex_Attribute_Format_Lookup_Name[attribute_format] });
+  const vertex_buffer_layouts = [ { arrayStride: stride, stepMode: 'vertex', attributes: vertex_attribute_list } ];
+  if (instance_attribute_list.length) {
+    vertex_buffer_layouts.push({ arrayStride: instance_stride, stepMode: 'instance', attributes: instance_attribute_list });
   }
 
   var depth_stencil = null;
@@ -550,21 +803,16 @@ function js_webgpu_pipeline_create(shader_handle, vertex_format_ptr, depth_buffe
   }
 
   const render_pipeline = wasm_context.webgpu.device.createRenderPipeline({
-    layout: pipeline_layout,
+    layout: wasm_context.webgpu.pipeline_layout,
     
     vertex: {
-      module: wasm_context.webgpu.handle_map.get(shader_handle),
+      module: wasm_context.webgpu.handle_pool.get(shader_handle),
       entryPoint: 'vs_main',
-      buffers: [
-        {
-          arrayStride: stride,
-          attributes: attribute_list,
-        }
-      ]
+      buffers: vertex_buffer_layouts,
     },
 
     fragment: {
-      module: wasm_context.webgpu.handle_map.get(shader_handle),
+      module: wasm_context.webgpu.handle_pool.get(shader_handle),
       entryPoint: 'fs_main',
       targets: [
         {
@@ -586,94 +834,177 @@ function js_webgpu_pipeline_create(shader_handle, vertex_format_ptr, depth_buffe
     multisample: { count: MSAA_Sample_Count, },
   });
 
-  return wasm_context.webgpu.handle_map.store(render_pipeline);
+  return wasm_context.webgpu.handle_pool.store(render_pipeline);
 }
 
 function js_webgpu_pipeline_destroy(pipeline_handle) {
-  const pipeline = wasm_context.webgpu.handle_map.get(pipeline_handle);
-  wasm_context.webgpu.handle_map.remove(pipeline_handle);
+  pipeline_handle = pipeline_handle >>> 0;
+  const pipeline = wasm_context.webgpu.handle_pool.get(pipeline_handle);
+  wasm_context.webgpu.handle_pool.remove(pipeline_handle);
 }
 
-function js_webgpu_frame_flush(draw_command_ptr) {
-  const draw_command_view = new DataView(wasm_context.memory.buffer, draw_command_ptr, 18 * 4);
-  
-  let offset = 0;
-  const constant_buffer_handle = draw_command_view.getUint32 (offset, true); offset += 4;
-  const vertex_buffer_handle   = draw_command_view.getUint32 (offset, true); offset += 4;
-  const index_buffer_handle    = draw_command_view.getUint32 (offset, true); offset += 4;
-  const pipeline_handle        = draw_command_view.getUint32 (offset, true); offset += 4;
-  const texture_handle         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const texture_volume_handle  = draw_command_view.getUint32 (offset, true); offset += 4;
-  const sampler_handle         = draw_command_view.getUint32 (offset, true); offset += 4;
-
-  const draw_index_count       = draw_command_view.getUint32 (offset, true); offset += 4;
-  const draw_index_offset      = draw_command_view.getUint32 (offset, true); offset += 4;
-
-  const depth_test             = draw_command_view.getUint32 (offset, true); offset += 4;
-  
-  const draw_region_x0         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const draw_region_y0         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const draw_region_x1         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const draw_region_y1         = draw_command_view.getUint32 (offset, true); offset += 4;
- 
-  const clip_region_x0         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const clip_region_y0         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const clip_region_x1         = draw_command_view.getUint32 (offset, true); offset += 4;
-  const clip_region_y1         = draw_command_view.getUint32 (offset, true); offset += 4;
-
-  // NOTE(cmat): Retrieve handles.
-  const constant_buffer = wasm_context.webgpu.handle_map.get(constant_buffer_handle);
-  const vertex_buffer   = wasm_context.webgpu.handle_map.get(vertex_buffer_handle);
-  const index_buffer    = wasm_context.webgpu.handle_map.get(index_buffer_handle);
-  const pipeline        = wasm_context.webgpu.handle_map.get(pipeline_handle);
-  const texture         = wasm_context.webgpu.handle_map.get(texture_handle);
-  const texture_volume  = wasm_context.webgpu.handle_map.get(texture_volume_handle);
-  const sampler         = wasm_context.webgpu.handle_map.get(sampler_handle);
-
-  const bind_group = wasm_context.webgpu.device.createBindGroup({
-    layout: pipeline.getBindGroupLayout(0),
-    entries: [ 
-      { binding: 0, resource: texture.createView(), },
-      { binding: 1, resource: sampler, },
-      { binding: 2, resource: { buffer: constant_buffer } },
-      { binding: 3, resource: texture_volume.createView(), },
-    ]
-  });
+// NOTE(cmat): One R_Command_Draw (packed, 22 x 32-bit fields) per draw, back to back.
+// - Constants are bound with a dynamic offset (constant_offset), R_Uniform_Binding_Bytes wide.
+const WebGPU_Draw_Command_Fields   = 22;
+const WebGPU_Uniform_Binding_Bytes = 256;
+
+function webgpu_render_pass_begin(command_encoder) {
+  const backbuffer_texture_view = wasm_context.webgpu.context.getCurrentTexture().createView();
+  const render_pass_descriptor = {
+    colorAttachments: [{
+      view: wasm_context.webgpu.color_texture_view,
+      resolveTarget: backbuffer_texture_view,
+      clearValue: { r:0, g:0, b:0, a:1 },
+      loadOp: 'clear',
+      storeOp: 'store',
+    }],
 
+    depthStencilAttachment: {
+      view: wasm_context.webgpu.depth_texture_view,
+      depthClearValue: 1.0,
+      depthLoadOp: 'clear',
+      depthStoreOp: 'store',
+    },
+  };
 
-  // NOTE(cmat): Set viewport.
-  let draw_x = draw_region_x0;
-  let draw_y = wasm_context.canvas.height - draw_region_y1;
-  let draw_w = draw_region_x1 - draw_region_x0;
-  let draw_h = draw_region_y1 - draw_region_y0;
-  
-  draw_x = Math.max(Math.min(draw_x, wasm_context.canvas.width),  0);
-  draw_y = Math.max(Math.min(draw_y, wasm_context.canvas.height), 0);
+  return command_encoder.beginRenderPass(render_pass_descriptor);
+}
 
-  draw_w = Math.max(Math.min(draw_w, wasm_context.canvas.width - draw_x),  0);
-  draw_h = Math.max(Math.min(draw_h, wasm_context.canvas.height - draw_y), 0);
+// NOTE(cmat): Encodes the whole frame into one render pass and submits it. State that
+// - doesn't change between consecutive draws (pipeline, bind group, buffers, viewport,
+// - scissor) is only set once.
+function js_webgpu_frame_submit(draw_count, draw_array_ptr) {
+  const draw_array      = new Uint32Array(wasm_context.memory.buffer, draw_array_ptr, draw_count * WebGPU_Draw_Command_Fields);
+  const command_encoder = wasm_context.webgpu.device.createCommandEncoder();
+  const pass_encoder    = webgpu_render_pass_begin(command_encoder);
+
+  const canvas_width    = wasm_context.canvas.width;
+  const canvas_height   = wasm_context.canvas.height;
+
+  let last_pipeline_handle        = 0;
+  let last_bind_group             = null;
+  let last_constant_offset        = -1;
+  const dynamic_offsets           = new Uint32Array(1);
+  let last_vertex_buffer_handle   = 0;
+  let last_index_buffer_handle    = 0;
+  let last_instance_buffer_handle = 0;
+  const last_viewport             = [ -1, -1, -1, -1 ];
+  const last_scissor              = [ -1, -1, -1, -1 ];
+
+  // NOTE(cmat): Only called on a cache miss, defined once per frame instead of once per draw.
+  const bind_group_cache  = wasm_context.webgpu.bind_group_cache;
+  const bind_group_create = (texture_handle, sampler_handle, constant_buffer_handle, texture_volume_handle) => {
+    const constant_buffer = wasm_context.webgpu.handle_pool.get(constant_buffer_handle);
+    return wasm_context.webgpu.device.createBindGroup({
+      layout: wasm_context.webgpu.bind_group_layout,
+      entries: [
+        { binding: 0, resource: wasm_context.webgpu.handle_pool.view(texture_handle), },
+        { binding: 1, resource: wasm_context.webgpu.handle_pool.get(sampler_handle), },
+        { binding: 2, resource: { buffer: constant_buffer, size: Math.min(constant_buffer.size, WebGPU_Uniform_Binding_Bytes) } },
+        { binding: 3, resource: wasm_context.webgpu.handle_pool.view(texture_volume_handle), },
+      ]
+    });
+  };
 
-  wasm_context.webgpu_pass_encoder.setViewport(draw_x, draw_y, draw_w, draw_h, 0.0, 1.0);
+  for (let draw_it = 0; draw_it < draw_count; draw_it++) {
+    let offset = draw_it * WebGPU_Draw_Command_Fields;
 
-  // NOTE(cmat): Set scissor rect
-  let clip_x = clip_region_x0;
-  let clip_y = wasm_context.canvas.height - clip_region_y1;
-  let clip_w = clip_region_x1 - clip_region_x0;
-  let clip_h = clip_region_y1 - clip_region_y0;
-  
-  clip_x = Math.max(Math.min(clip_x, draw_x + draw_w), draw_x);
-  clip_y = Math.max(Math.min(clip_y, draw_y + draw_h), draw_y);
+    const constant_buffer_handle = draw_array[offset++];
+    const constant_offset        = draw_array[offset++];
+    const vertex_buffer_handle   = draw_array[offset++];
+    const index_buffer_handle    = draw_array[offset++];
+    const instance_buffer_handle = draw_array[offset++];
+    const pipeline_handle        = draw_array[offset++];
+    const texture_handle         = draw_array[offset++];
+    const texture_volume_handle  = draw_array[offset++];
+    const sampler_handle         = draw_array[offset++];
+
+    const draw_index_count       = draw_array[offset++];
+    const draw_index_offset      = draw_array[offset++];
+
+    const instance_count         = draw_array[offset++];
+    const instance_offset        = draw_array[offset++];
+
+    const depth_test             = draw_array[offset++];
+
+    const draw_region_x0         = draw_array[offset++];
+    const draw_region_y0         = draw_array[offset++];
+    const draw_region_x1         = draw_array[offset++];
+    const draw_region_y1         = draw_array[offset++];
+
+    const clip_region_x0         = draw_array[offset++];
+    const clip_region_y0         = draw_array[offset++];
+    const clip_region_x1         = draw_array[offset++];
+    const clip_region_y1         = draw_array[offset++];
+
+    const bind_group = bind_group_cache.get(texture_handle, sampler_handle, constant_buffer_handle, texture_volume_handle, bind_group_create);
 
-  clip_w = Math.max(Math.min(clip_w, draw_w - (clip_x - draw_x)), 0);
-  clip_h = Math.max(Math.min(clip_h, draw_h - (clip_y - draw_y)), 0);
+    // NOTE(cmat): Set viewport.
+    let draw_x = draw_region_x0;
+    let draw_y = canvas_height - draw_region_y1;
+    let draw_w = draw_region_x1 - draw_region_x0;
+    let draw_h = draw_region_y1 - draw_region_y0;
 
-  wasm_context.webgpu_pass_encoder.setScissorRect(clip_x, clip_y, clip_w, clip_h);
+    draw_x = Math.max(Math.min(draw_x, canvas_width),  0);
+    draw_y = Math.max(Math.min(draw_y, canvas_height), 0);
 
-  wasm_context.webgpu_pass_encoder.setPipeline(pipeline);
-  wasm_context.webgpu_pass_encoder.setBindGroup(0, bind_group);
-  wasm_context.webgpu_pass_encoder.setVertexBuffer(0, vertex_buffer);
-  wasm_context.webgpu_pass_encoder.setIndexBuffer(index_buffer, "uint32");
-  wasm_context.webgpu_pass_encoder.drawIndexed(draw_index_count, 1, draw_index_offset, 0, 0);
+    draw_w = Math.max(Math.min(draw_w, canvas_width - draw_x),  0);
+    draw_h = Math.max(Math.min(draw_h, canvas_height - draw_y), 0);
+
+    if (draw_x != last_viewport[0] || draw_y != last_viewport[1] || draw_w != last_viewport[2] || draw_h != last_viewport[3]) {
+      pass_encoder.setViewport(draw_x, draw_y, draw_w, draw_h, 0.0, 1.0);
+      last_viewport[0] = draw_x; last_viewport[1] = draw_y; last_viewport[2] = draw_w; last_viewport[3] = draw_h;
+    }
+
+    // NOTE(cmat): Set scissor rect
+    let clip_x = clip_region_x0;
+    let clip_y = canvas_height - clip_region_y1;
+    let clip_w = clip_region_x1 - clip_region_x0;
+    let clip_h = clip_region_y1 - clip_region_y0;
+
+    clip_x = Math.max(Math.min(clip_x, draw_x + draw_w), draw_x);
+    clip_y = Math.max(Math.min(clip_y, draw_y + draw_h), draw_y);
+
+    clip_w = Math.max(Math.min(clip_w, draw_w - (clip_x - draw_x)), 0);
+    clip_h = Math.max(Math.min(clip_h, draw_h - (clip_y - draw_y)), 0);
+
+    if (clip_x != last_scissor[0] || clip_y != last_scissor[1] || clip_w != last_scissor[2] || clip_h != last_scissor[3]) {
+      pass_encoder.setScissorRect(clip_x, clip_y, clip_w, clip_h);
+      last_scissor[0] = clip_x; last_scissor[1] = clip_y; last_scissor[2] = clip_w; last_scissor[3] = clip_h;
+    }
+
+    if (pipeline_handle !== last_pipeline_handle) {
+      pass_encoder.setPipeline(wasm_context.webgpu.handle_pool.get(pipeline_handle));
+      last_pipeline_handle = pipeline_handle;
+    }
+
+    if (bind_group !== last_bind_group || constant_offset !== last_constant_offset) {
+      dynamic_offsets[0] = constant_offset;
+      pass_encoder.setBindGroup(0, bind_group, dynamic_offsets, 0, 1);
+      last_bind_group      = bind_group;
+      last_constant_offset = constant_offset;
+    }
+
+    if (vertex_buffer_handle !== last_vertex_buffer_handle) {
+      pass_encoder.setVertexBuffer(0, wasm_context.webgpu.handle_pool.get(vertex_buffer_handle));
+      last_vertex_buffer_handle = vertex_buffer_handle;
+    }
+
+    if (index_buffer_handle !== last_index_buffer_handle) {
+      pass_encoder.setIndexBuffer(wasm_context.webgpu.handle_pool.get(index_buffer_handle), "uint32");
+      last_index_buffer_handle = index_buffer_handle;
+    }
+
+    if (instance_buffer_handle && instance_buffer_handle !== last_instance_buffer_handle) {
+      pass_encoder.setVertexBuffer(1, wasm_context.webgpu.handle_pool.get(instance_buffer_handle));
+      last_instance_buffer_handle = instance_buffer_handle;
+    }
+
+    pass_encoder.drawIndexed(draw_index_count, Math.max(instance_count, 1), draw_index_offset, 0, instance_offset);
+  }
+
+  pass_encoder.end();
+  wasm_context.webgpu.device.queue.submit([command_encoder.finish()]);
 }
 
 function wasm_pack_frame_state(frame_state) {
@@ -709,29 +1040,7 @@ function canvas_next_frame(timestamp) {
   wasm_context.frame_state.display.frame_delta = Math.min(wasm_context.frame_state.display.frame_delta, 1 / 60);
 
   wasm_pack_frame_state(wasm_context.frame_state)
-  const command_encoder = wasm_context.webgpu.device.createCommandEncoder();
-  const backbuffer_texture_view = wasm_context.webgpu.context.getCurrentTexture().createView();
-  const render_pass_descriptor = {
-    colorAttachments: [{
-      view: wasm_context.webgpu.color_texture_view,
-      resolveTarget: backbuffer_texture_view,
-      clearValue: { r:0, g:0, b:0, a:1 },
-      loadOp: 'clear',
-      storeOp: 'store',
-    }],
-
-    depthStencilAttachment: {
-      view: wasm_context.webgpu.depth_texture_view,
-      depthClearValue: 1.0,
-      depthLoadOp: 'clear',
-      depthStoreOp: 'store',
-    },
-  };
-
-  wasm_context.webgpu_pass_encoder = command_encoder.beginRenderPass(render_pass_descriptor);
-  wasm_context.export_table.wasm_next_frame();
-  wasm_context.webgpu_pass_encoder.end();
-  wasm_context.webgpu.device.queue.submit([command_encoder.finish()]);
+  wasm_call(() => wasm_context.export_table.wasm_next_frame());
 
   // NOTE(cmat): Reset scroll delta.
   wasm_context.frame_state.input.mouse.scroll_dt.x = 0;
@@ -761,7 +1070,9 @@ function wasm_module_load(wasm_bytecode) {
       // NOTE(cmat): Core API.
       js_co_stream_write:           js_co_stream_write,
       js_co_unix_time:              js_co_unix_time,
+      js_co_timer:                  js_co_timer,
       js_co_panic:                  js_co_panic,
+      js_co_fiber_switch:           js_co_fiber_switch,
 
       // NOTE(cmat): HTTP API.
       js_http_request_send:           js_http_request_send,
@@ -791,7 +1102,7 @@ function wasm_module_load(wasm_bytecode) {
       js_webgpu_pipeline_create:      js_webgpu_pipeline_create,
       js_webgpu_pipeline_destroy:     js_webgpu_pipeline_destroy,
 
-      js_webgpu_frame_flush:          js_webgpu_frame_flush,
+      js_webgpu_frame_submit:         js_webgpu_frame_submit,
     }
   };
 
@@ -873,7 +1184,7 @@ function wasm_module_load(wasm_bytecode) {
 
       // NOTE(cmat): Call into entry point
       const cpu_logical_cores = navigator.hardwareConcurrency;
-      wasm_context.export_table.wasm_entry_point(cpu_logical_cores);
+      wasm_call(() => wasm_context.export_table.wasm_entry_point(cpu_logical_cores));
 
       // NOTE(cmat): Start animation frame requests
       wasm_context.frame_time_last = 0;
@@ -0,0 +1,293 @@
+// (C) Copyright 2025 Matyas Constans
+// Licensed under the MIT License (https://opensource.org/license/mit/)
+
+// NOTE(cmat): Headless checks for the WebGPU glue in alice_canvas.js, run with
+// - node src/web/alice_canvas_test.js
+// - The script is loaded into a sandbox with a mocked GPU device that counts allocations.
+
+const fs   = require('fs');
+const path = require('path');
+const vm   = require('vm');
+
+function Assert(condition, message) {
+  if (!condition) {
+    throw new Error("assertion failed: " + message);
+  }
+}
+
+function throws(proc) {
+  try {
+    proc();
+  } catch (error) {
+    return true;
+  }
+
+  return false;
+}
+
+function mock_gpu_create(counters) {
+  const count = (name) => { counters[name] = (counters[name] || 0) + 1; };
+
+  const mock_texture = () => ({
+    createView() { count('createView'); return { kind: 'view' }; },
+    destroy()    { count('texture.destroy'); },
+  });
+
+  const device = {
+    queue: {
+      writeBuffer()  { },
+      writeTexture() { },
+      submit()       { count('submit'); },
+    },
+
+    createCommandEncoder() {
+      count('createCommandEncoder');
+      return {
+        beginRenderPass() { count('beginRenderPass'); return mock_pass_encoder_create(counters); },
+        finish()          { return { kind: 'command_buffer' }; },
+      };
+    },
+
+    createBuffer(desc)      { count('createBuffer');          return { size: desc.size, destroy() { } }; },
+    createTexture()         { count('createTexture');         return mock_texture();    },
+    createSampler()         { count('createSampler');         return { destroy() { } }; },
+    createShaderModule()    { count('createShaderModule');    return { destroy() { } }; },
+    createBindGroupLayout() { count('createBindGroupLayout'); return { kind: 'bind_group_layout' }; },
+    createPipelineLayout()  { count('createPipelineLayout');  return { kind: 'pipeline_layout' }; },
+    createRenderPipeline(desc) { count('createRenderPipeline'); return { kind: 'pipeline', desc }; },
+    createBindGroup()       { count('createBindGroup');       return { kind: 'bind_group' }; },
+  };
+
+  return {
+    requestAdapter: async () => ({ requestDevice: async () => device }),
+    getPreferredCanvasFormat: () => 'bgra8unorm',
+  };
+}
+
+function mock_pass_encoder_create(counters) {
+  const pass_encoder = { };
+  for (const name of [ 'setViewport', 'setScissorRect', 'setPipeline', 'setBindGroup', 'setVertexBuffer', 'setIndexBuffer', 'drawIndexed', 'end' ]) {
+    pass_encoder[name] = (...args) => { counters[name] = (counters[name] || 0) + 1; counters['last_' + name] = args; };
+  }
+
+  return pass_encoder;
+}
+
+async function test_webgpu_frame_submit() {
+  const counters = { };
+  const sandbox  = {
+    console,
+    navigator:          { gpu: mock_gpu_create(counters) },
+    fetch:              () => new Promise(() => { }),
+    alert:              () => { },
+    GPUBufferUsage:     { VERTEX: 1, INDEX: 2, STORAGE: 4, UNIFORM: 8, COPY_DST: 16 },
+    GPUTextureUsage:    { TEXTURE_BINDING: 1, COPY_DST: 2, RENDER_ATTACHMENT: 4 },
+    GPUShaderStage:     { VERTEX: 1, FRAGMENT: 2 },
+  };
+
+  vm.createContext(sandbox);
+  vm.runInContext(fs.readFileSync(path.join(__dirname, 'alice_canvas.js'), 'utf8'), sandbox);
+
+  const wasm_context   = vm.runInContext('wasm_context', sandbox);
+  wasm_context.memory  = { buffer: new ArrayBuffer(64 * 1024) };
+  wasm_context.canvas  = {
+    width:      640,
+    height:     480,
+    getContext: () => ({ configure() { }, getCurrentTexture: () => ({ createView: () => ({ kind: 'backbuffer_view' }) }) }),
+  };
+
+  wasm_context.webgpu  = await sandbox.webgpu_init(wasm_context.canvas);
+
+  // NOTE(cmat): R_Vertex_Format (stride, instance stride, entry count, entries of offset / format
+  // - step), one V2_F32 attribute.
+  const vertex_format_ptr  = 1024;
+  const vertex_format_view = new DataView(wasm_context.memory.buffer, vertex_format_ptr, 3 * 2 + 3 * 2 * 16);
+  vertex_format_view.setUint16(0, 8, true);
+  vertex_format_view.setUint16(2, 0, true);
+  vertex_format_view.setUint16(4, 1, true);
+  vertex_format_view.setUint16(6, 0, true);
+  vertex_format_view.setUint16(8, 1, true);
+  vertex_format_view.setUint16(10, 0, true);
+
+  const shader          = sandbox.js_webgpu_shader_create(0, 0);
+  const pipeline_2D     = sandbox.js_webgpu_pipeline_create(shader, vertex_format_ptr, 0);
+  const pipeline_3D     = sandbox.js_webgpu_pipeline_create(shader, vertex_format_ptr, 1);
+  const constant_buffer = sandbox.js_webgpu_buffer_allocate(256, 0);
+  const vertex_buffer   = sandbox.js_webgpu_buffer_allocate(1024, 0);
+  const index_buffer    = sandbox.js_webgpu_buffer_allocate(1024, 0);
+  const sampler         = sandbox.js_webgpu_sampler_create(0, 0);
+  const volume          = sandbox.js_webgpu_texture_3D_allocate(4, 2, 2, 2);
+  const textures        = [ 0, 1, 2, 3 ].map(() => sandbox.js_webgpu_texture_2D_allocate(0, 16, 16));
+
+  Assert(counters.createPipelineLayout == 1, "pipelines share one layout");
+  Assert(counters.createView == 5, "one view per texture, at allocation");
+
+  // NOTE(cmat): Frames are packed R_Command_Draw arrays (22 fields each), submitted in one call.
+  const draw_array_ptr = 2048;
+  const frame_submit = (draws) => {
+    const fields = draws.flatMap(([ pipeline, texture, constant_offset = 0, instance_buffer = 0, instance_count = 0, instance_offset = 0 ]) =>
+      [ constant_buffer, constant_offset, vertex_buffer, index_buffer, instance_buffer, pipeline, texture, volume, sampler, 6, 0, instance_count, instance_offset, 0, 0, 0, 640, 480, 0, 0, 640, 480 ]);
+    new Uint32Array(wasm_context.memory.buffer, draw_array_ptr, fields.length).set(fields);
+    sandbox.js_webgpu_frame_submit(draws.length, draw_array_ptr);
+  };
+
+  const draw = (pipeline, texture) => frame_submit([ [ pipeline, texture ] ]);
+
+  // NOTE(cmat): A UI-like frame, 200 draws over 4 textures and 2 pipelines, for 10 frames.
+  const frame_count = 10;
+  const draw_count  = 200;
+  for (let frame = 0; frame < frame_count; frame++) {
+    const draws = [ ];
+    for (let it = 0; it < draw_count; it++) {
+      draws.push([ it % 3 ? pipeline_2D : pipeline_3D, textures[it % textures.length] ]);
+    }
+
+    frame_submit(draws);
+  }
+
+  Assert(counters.beginRenderPass == frame_count && counters.end == frame_count, "one render pass per frame");
+  Assert(counters.submit          == frame_count,                                "one submit per frame");
+  Assert(counters.setViewport     == frame_count,                                "unchanged viewport set once per frame");
+  Assert(counters.setVertexBuffer == frame_count,                                "unchanged vertex buffer set once per frame");
+
+  const cache = wasm_context.webgpu.bind_group_cache;
+  Assert(counters.drawIndexed     == frame_count * draw_count, "every draw is issued");
+  Assert(counters.createBindGroup == textures.length,          "one bind group per texture");
+  Assert(counters.createView      == 5,                        "no views created per draw");
+  Assert(cache.misses             == textures.length,          "misses");
+  Assert(cache.hits               == frame_count * draw_count - textures.length, "hits");
+
+  // NOTE(cmat): Destroying a texture drops its bind group only, a new texture gets its own.
+  sandbox.js_webgpu_texture_2D_destroy(textures[0]);
+  Assert(cache.size == textures.length - 1, "destroyed texture invalidates its bind group");
+  Assert(!cache.users.has(textures[0]),          "destroyed texture is unreferenced");
+  Assert(!cache.root.has(textures[0]),           "destroyed texture's level is dropped");
+
+  // NOTE(cmat): The freed slot is reused under a new generation, the stale handle no longer resolves.
+  const stale_texture = textures[0];
+  textures[0] = sandbox.js_webgpu_texture_2D_allocate(0, 16, 16);
+  Assert((textures[0] & 0xFFFFF) == (stale_texture & 0xFFFFF), "freed slot is reused");
+  Assert(textures[0] != stale_texture,                          "reused slot gets a new generation");
+  Assert(throws(() => draw(pipeline_2D, stale_texture)),        "stale handle is rejected");
+  Assert(throws(() => sandbox.js_webgpu_texture_2D_destroy(stale_texture)), "stale handle can't destroy the new texture");
+
+  draw(pipeline_2D, textures[0]);
+  draw(pipeline_2D, textures[1]);
+  Assert(counters.createBindGroup == textures.length + 1, "new texture misses once, others still hit");
+
+  // NOTE(cmat): Constants at different offsets of one buffer share a bind group (dynamic offset).
+  const bind_groups_before = counters.createBindGroup;
+  const set_before         = counters.setBindGroup;
+  frame_submit([ [ pipeline_2D, textures[1], 0 ], [ pipeline_2D, textures[1], 256 ], [ pipeline_2D, textures[1], 256 ] ]);
+  Assert(counters.createBindGroup == bind_groups_before, "dynamic offsets reuse the bind group");
+  Assert(counters.setBindGroup    == set_before + 2,     "bind group is rebound when the offset changes");
+
+  // NOTE(cmat): Per-instance attributes get their own stepped vertex buffer layout, instanced
+  // - draws bind the instance buffer to slot 1 and pass the instance range through.
+  const quad_format_view = new DataView(wasm_context.memory.buffer, vertex_format_ptr, 3 * 2 + 3 * 2 * 16);
+  quad_format_view.setUint16(0, 16, true);
+  quad_format_view.setUint16(2, 48, true);
+  quad_format_view.setUint16(4, 2,  true);
+  quad_format_view.setUint16(12, 0,  true);
+  quad_format_view.setUint16(14, 3,  true);
+  quad_format_view.setUint16(16, 1,  true);
+
+  const pipeline_quad = sandbox.js_webgpu_pipeline_create(shader, vertex_format_ptr, 0);
+  const quad_layouts  = wasm_context.webgpu.handle_pool.get(pipeline_quad).desc.vertex.buffers;
+  Assert(quad_layouts.length == 2 && quad_layouts[1].stepMode == 'instance' && quad_layouts[1].arrayStride == 48, "instance buffer layout");
+  Assert(quad_layouts[1].attributes[0].shaderLocation == 1,                                                     "instance attributes keep their location");
+
+  const instance_buffer = sandbox.js_webgpu_buffer_allocate(48 * 64, 0);
+  frame_submit([ [ pipeline_quad, textures[1], 0, instance_buffer, 64, 8 ] ]);
+  Assert(counters.last_setVertexBuffer[0] == 1,                                  "instance buffer bound to slot 1");
+  Assert(counters.last_drawIndexed[1] == 64 && counters.last_drawIndexed[4] == 8, "instance count and offset");
+
+  draw(pipeline_2D, textures[1]);
+  Assert(counters.last_drawIndexed[1] == 1, "non-instanced draws draw once");
+
+  // NOTE(cmat): Wasm passes handles as i32, a slot past generation 2047 comes back negative.
+  let churned = sandbox.js_webgpu_texture_2D_allocate(0, 16, 16);
+  while (churned < 0x80000000) {
+    sandbox.js_webgpu_texture_2D_destroy(churned);
+    churned = sandbox.js_webgpu_texture_2D_allocate(0, 16, 16);
+  }
+
+  const churned_signed = churned | 0;
+  Assert(churned_signed < 0, "high generation handle is negative as i32");
+
+  draw(pipeline_2D, churned);
+  const cached_before = cache.size;
+  Assert(!throws(() => sandbox.js_webgpu_texture_2D_download(churned_signed, 0, 0, 0, 16, 16, 0)), "signed handle resolves");
+  sandbox.js_webgpu_texture_2D_destroy(churned_signed);
+  Assert(cache.size == cached_before - 1 && !cache.users.has(churned), "signed handle invalidates its bind groups");
+  Assert(throws(() => draw(pipeline_2D, churned)),                     "signed destroy removed the texture");
+
+  // NOTE(cmat): Destroying a resource every bind group shares empties the cache.
+  sandbox.js_webgpu_sampler_destroy(sampler);
+  Assert(cache.size       == 0, "sampler invalidates all bind groups");
+  Assert(cache.root.size  == 0, "emptied levels are dropped");
+  Assert(cache.users.size == 0, "no stale references");
+
+  console.log(`bind group cache - ${cache.hits} hits, ${cache.misses} misses (${(100 * cache.hits / (cache.hits + cache.misses)).toFixed(2)}% hit rate)`);
+}
+
+// NOTE(cmat): Mocks the asyncify exports of a wasm-opt build. Every frame, the root export switches
+// - to a fresh fiber at a new address, which finishes right away and switches back.
+function test_wasm_fiber_roots() {
+  const sandbox = { console, navigator: { gpu: mock_gpu_create({ }) }, fetch: () => new Promise(() => { }), alert: () => { } };
+  vm.createContext(sandbox);
+  vm.runInContext(fs.readFileSync(path.join(__dirname, 'alice_canvas.js'), 'utf8'), sandbox);
+
+  const wasm_context  = vm.runInContext('wasm_context', sandbox);
+  const wasm_fiber    = vm.runInContext('wasm_fiber',   sandbox);
+  wasm_context.memory = { buffer: new ArrayBuffer(64 * 1024) };
+
+  const fields = (fiber_ptr) => new Uint32Array(wasm_context.memory.buffer, fiber_ptr, 4);
+  const fiber_create = (fiber_ptr, started) => {
+    fields(fiber_ptr).set([ 0x8000 + fiber_ptr, fiber_ptr + 64, fiber_ptr + 256, started ]);
+  };
+
+  const root_ptr = 1024;
+  let   fiber_ptr = 0;
+  let   state     = 0;
+
+  wasm_context.export_table = {
+    __stack_pointer:        { value: 0xF000 },
+    asyncify_get_state:     () => state,
+    asyncify_start_unwind:  () => { state = 1; },
+    asyncify_stop_unwind:   () => { state = 0; },
+    asyncify_start_rewind:  () => { state = 2; },
+    asyncify_stop_rewind:   () => { state = 0; },
+
+    // NOTE(cmat): fiber_scheduler_run, either switching to the fiber or rewound after it finished.
+    wasm_next_frame: () => {
+      if (state != 2) {
+        fiber_create(root_ptr, 1);
+        fiber_create(fiber_ptr, 0);
+      }
+
+      sandbox.js_co_fiber_switch(root_ptr, fiber_ptr);
+    },
+
+    // NOTE(cmat): co_fiber_main, the finished fiber clears started before its last switch.
+    wasm_fiber_entry: (to) => {
+      fields(to)[3] = 0;
+      sandbox.js_co_fiber_switch(to, root_ptr);
+    },
+  };
+
+  for (let frame = 0; frame < 64; frame++) {
+    fiber_ptr = 2048 + 512 * frame;
+    sandbox.wasm_call(() => wasm_context.export_table.wasm_next_frame());
+    Assert(state == 0, "frame returns with asyncify idle");
+  }
+
+  Assert(wasm_fiber.roots.size == 0, "finished fibers don't keep their roots");
+}
+
+test_webgpu_frame_submit().then(
+  ()    => { test_wasm_fiber_roots(); },
+).then(
+  ()    => { console.log("alice_canvas tests passed"); },
+  error => { console.error(error); process.exitCode = 1; }
+);